@@ -564,6 +564,8 @@ export function raycastAll (
     pool: RecyclePool<PhysicsRayResult>,
     results: PhysicsRayResult[],
 ): boolean {
+    // a pending multi-thread step has to finish before the scene can be queried
+    world.endStep();
     const maxDistance = options.maxDistance;
     const flags = PxHitFlag.ePOSITION | PxHitFlag.eNORMAL;
     const word3 = EFilterDataWord3.QUERY_FILTER | (options.queryTrigger ? 0 : EFilterDataWord3.QUERY_CHECK_TRIGGER);
@@ -632,6 +634,7 @@ export function raycastAll (
 }
 
 export function raycastClosest (world: PhysXWorld, worldRay: geometry.Ray, options: IRaycastOptions, result: PhysicsRayResult): boolean {
+    world.endStep();
     const maxDistance = options.maxDistance;
     const flags = PxHitFlag.ePOSITION | PxHitFlag.eNORMAL;
     const word3 = EFilterDataWord3.QUERY_FILTER | (options.queryTrigger ? 0 : EFilterDataWord3.QUERY_CHECK_TRIGGER)
@@ -690,6 +693,7 @@ export function sweepAll (
     pool: RecyclePool<PhysicsRayResult>,
     results: PhysicsRayResult[],
 ): boolean {
+    world.endStep();
     const maxDistance = options.maxDistance;
     const flags = PxHitFlag.ePOSITION | PxHitFlag.eNORMAL;
     const word3 = EFilterDataWord3.QUERY_FILTER | (options.queryTrigger ? 0 : EFilterDataWord3.QUERY_CHECK_TRIGGER);
@@ -742,6 +746,7 @@ export function sweepClosest (
     options: IRaycastOptions,
     result: PhysicsRayResult,
 ): boolean {
+    world.endStep();
     const maxDistance = options.maxDistance;
     const flags = PxHitFlag.ePOSITION | PxHitFlag.eNORMAL;
     const word3 = EFilterDataWord3.QUERY_FILTER | (options.queryTrigger ? 0 : EFilterDataWord3.QUERY_CHECK_TRIGGER)
@@ -985,7 +990,7 @@ function hackForMultiThread (): void {
                 sys._accumulator += deltaTime;
                 sys._subStepCount = 1;
                 sys.physicsWorld.syncSceneToPhysics();
-                sys.physicsWorld.step(sys._fixedTimeStep);
+                sys.physicsWorld.beginStep(sys._fixedTimeStep);
                 sys._accumulator -= sys._fixedTimeStep;
                 sys._mutiThreadYield = performance.now();
             }
@@ -997,7 +1002,7 @@ function hackForMultiThread (): void {
 
             if (sys._autoSimulation) {
                 const yieldTime = performance.now() - sys._mutiThreadYield;
-                sys.physicsWorld.syncPhysicsToScene();
+                sys.physicsWorld.endStep();
                 sys.physicsWorld.emitEvents();
                 if (cclegacy.profiler && cclegacy.profiler._stats) {
                     cclegacy.profiler._stats.physics.counter._time += yieldTime;
@@ -101,6 +101,28 @@ export class PhysXWorld extends PhysXInstance implements IPhysicsWorld {
         this._debugDraw();
     }
 
+    /**
+     * Starts simulating a step without waiting for it, the results are applied by endStep().
+     */
+    beginStep (deltaTime: number): void {
+        this.endStep();
+        if (this.wrappedBodies.length === 0) return;
+        this._simulate(deltaTime);
+    }
+
+    /**
+     * Waits for the step started by beginStep() and syncs its results to the scene, no-op if none is running.
+     */
+    endStep (): void {
+        if (!this._isNeedFetch) return;
+        this.syncPhysicsToScene();
+        this._debugDraw();
+    }
+
+    isStepping (): boolean {
+        return this._isNeedFetch;
+    }
+
     private _simulate (dt: number): void {
         if (!this._isNeedFetch) {
             simulateScene(this.scene, dt);
@@ -601,6 +601,20 @@ export class PipelineStatistics {
         this.numFreeDescriptorSets = 0;
         this.numInstancingBuffers = 0;
         this.numInstancingUniformBlocks = 0;
+        this.numInstances = 0;
+        this.numInstancedDrawCalls = 0;
+        this.numInstancingBufferResizes = 0;
+        this.instancingUploadedBytes = 0;
+        this.numRenderGraphCacheHits = 0;
+        this.numRenderGraphCompiles = 0;
+        this.renderGraphCompileMicroseconds = 0;
+        this.numTransientTextures = 0;
+        this.numTransientBuffers = 0;
+        this.numTransientAcquires = 0;
+        this.numTransientReuses = 0;
+        this.numTransientEvictions = 0;
+        this.peakTransientMemoryKB = 0;
+        this.totalTransientMemoryKB = 0;
     }
     numRenderPasses = 0;
     numManagedTextures = 0;
@@ -613,6 +627,20 @@ export class PipelineStatistics {
     numFreeDescriptorSets = 0;
     numInstancingBuffers = 0;
     numInstancingUniformBlocks = 0;
+    numInstances = 0;
+    numInstancedDrawCalls = 0;
+    numInstancingBufferResizes = 0;
+    instancingUploadedBytes = 0;
+    numRenderGraphCacheHits = 0;
+    numRenderGraphCompiles = 0;
+    renderGraphCompileMicroseconds = 0;
+    numTransientTextures = 0;
+    numTransientBuffers = 0;
+    numTransientAcquires = 0;
+    numTransientReuses = 0;
+    numTransientEvictions = 0;
+    peakTransientMemoryKB = 0;
+    totalTransientMemoryKB = 0;
 }
 
 export class RenderCommonObjectPoolSettings {
@@ -972,6 +1000,20 @@ export function savePipelineStatistics (ar: OutputArchive, v: PipelineStatistics
     ar.writeNumber(v.numFreeDescriptorSets);
     ar.writeNumber(v.numInstancingBuffers);
     ar.writeNumber(v.numInstancingUniformBlocks);
+    ar.writeNumber(v.numInstances);
+    ar.writeNumber(v.numInstancedDrawCalls);
+    ar.writeNumber(v.numInstancingBufferResizes);
+    ar.writeNumber(v.instancingUploadedBytes);
+    ar.writeNumber(v.numRenderGraphCacheHits);
+    ar.writeNumber(v.numRenderGraphCompiles);
+    ar.writeNumber(v.renderGraphCompileMicroseconds);
+    ar.writeNumber(v.numTransientTextures);
+    ar.writeNumber(v.numTransientBuffers);
+    ar.writeNumber(v.numTransientAcquires);
+    ar.writeNumber(v.numTransientReuses);
+    ar.writeNumber(v.numTransientEvictions);
+    ar.writeNumber(v.peakTransientMemoryKB);
+    ar.writeNumber(v.totalTransientMemoryKB);
 }
 
 export function loadPipelineStatistics (ar: InputArchive, v: PipelineStatistics): void {
@@ -986,4 +1028,18 @@ export function loadPipelineStatistics (ar: InputArchive, v: PipelineStatistics)
     v.numFreeDescriptorSets = ar.readNumber();
     v.numInstancingBuffers = ar.readNumber();
     v.numInstancingUniformBlocks = ar.readNumber();
+    v.numInstances = ar.readNumber();
+    v.numInstancedDrawCalls = ar.readNumber();
+    v.numInstancingBufferResizes = ar.readNumber();
+    v.instancingUploadedBytes = ar.readNumber();
+    v.numRenderGraphCacheHits = ar.readNumber();
+    v.numRenderGraphCompiles = ar.readNumber();
+    v.renderGraphCompileMicroseconds = ar.readNumber();
+    v.numTransientTextures = ar.readNumber();
+    v.numTransientBuffers = ar.readNumber();
+    v.numTransientAcquires = ar.readNumber();
+    v.numTransientReuses = ar.readNumber();
+    v.numTransientEvictions = ar.readNumber();
+    v.peakTransientMemoryKB = ar.readNumber();
+    v.totalTransientMemoryKB = ar.readNumber();
 }
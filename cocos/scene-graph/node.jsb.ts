@@ -87,6 +87,51 @@ const Destroying = CCObject.Flags.Destroying;
 // issue: https://github.com/cocos/cocos-engine/issues/14644
 (Node as any)._setTempFloatArray(_tempFloatArray.buffer);
 
+// Local transform records shared with native `NodeTransformBatch`, Uint32 0 is the record count and each record is
+// slot (Uint32), dirty bits (Uint32), position (3 x Float32), rotation (4 x Float32), scale (3 x Float32).
+const TRANSFORM_BATCH_RECORD_SIZE = 12;
+const _transformBatchBuffer: ArrayBuffer = (Node as any)._getTransformBatchBuffer();
+const _transformBatchUint32 = new Uint32Array(_transformBatchBuffer);
+const _transformBatchFloat32 = new Float32Array(_transformBatchBuffer);
+const _transformBatchCapacity = Math.floor((_transformBatchUint32.length - 1) / TRANSFORM_BATCH_RECORD_SIZE);
+let _transformBatchEnabled = false;
+
+function pushTransformBatchRecord (node: any, dirtyBits: TransformBit): void {
+    let count = _transformBatchUint32[0];
+    if (count >= _transformBatchCapacity) {
+        // native resets the record count once the batch is applied
+        (Node as any)._applyTransformBatch();
+        count = _transformBatchUint32[0];
+    }
+    if (node._transformBatchSlot < 0) {
+        node._transformBatchSlot = node._getTransformBatchSlot();
+    }
+    const offset = 1 + count * TRANSFORM_BATCH_RECORD_SIZE;
+    _transformBatchUint32[offset] = node._transformBatchSlot;
+    _transformBatchUint32[offset + 1] = dirtyBits;
+    const lpos = node._lpos;
+    const lrot = node._lrot;
+    const lscale = node._lscale;
+    _transformBatchFloat32[offset + 2] = lpos.x;
+    _transformBatchFloat32[offset + 3] = lpos.y;
+    _transformBatchFloat32[offset + 4] = lpos.z;
+    _transformBatchFloat32[offset + 5] = lrot.x;
+    _transformBatchFloat32[offset + 6] = lrot.y;
+    _transformBatchFloat32[offset + 7] = lrot.z;
+    _transformBatchFloat32[offset + 8] = lrot.w;
+    _transformBatchFloat32[offset + 9] = lscale.x;
+    _transformBatchFloat32[offset + 10] = lscale.y;
+    _transformBatchFloat32[offset + 11] = lscale.z;
+    _transformBatchUint32[0] = count + 1;
+}
+
+NodeCls.setTransformBatchEnabled = function setTransformBatchEnabled (enabled: boolean): void {
+    if (_transformBatchEnabled && !enabled) {
+        (Node as any)._applyTransformBatch();
+    }
+    _transformBatchEnabled = enabled;
+};
+
 function getConstructor<T>(typeOrClassName) {
     if (!typeOrClassName) {
         return null;
@@ -638,6 +683,13 @@ nodeProto.setRTS = function setRTS(rot?: Quat | Vec3, pos?: Vec3, scale?: Vec3)
     } else {
         _tempFloatArray[9] = 0;
     }
+    if (_transformBatchEnabled) {
+        const dirtyBits = (rot ? TransformBit.ROTATION : 0) | (pos ? TransformBit.POSITION : 0) | (scale ? TransformBit.SCALE : 0);
+        if (dirtyBits) {
+            pushTransformBatchRecord(this, dirtyBits);
+        }
+        return;
+    }
     this._setRTS();
 };
 
@@ -665,6 +717,10 @@ nodeProto.setPosition = function setPosition(val: Readonly<Vec3> | number, y?: n
         this._lpos.y = _tempFloatArray[2] = y as number;
         this._lpos.z = _tempFloatArray[3] = z as number;
     }
+    if (_transformBatchEnabled) {
+        pushTransformBatchRecord(this, TransformBit.POSITION);
+        return;
+    }
     this._setPosition();
 };
 
@@ -690,6 +746,10 @@ nodeProto.setRotation = function setRotation(val: Readonly<Quat> | number, y?: n
         this._lrot.w = _tempFloatArray[3] = w;
     }
 
+    if (_transformBatchEnabled) {
+        pushTransformBatchRecord(this, TransformBit.ROTATION);
+        return;
+    }
     this._setRotation();
 };
 
@@ -734,6 +794,10 @@ nodeProto.setScale = function setScale(val: Readonly<Vec3> | number, y?: number,
         this._lscale.y = _tempFloatArray[2] = y as number;
         this._lscale.z = _tempFloatArray[3] = z;
     }
+    if (_transformBatchEnabled) {
+        pushTransformBatchRecord(this, TransformBit.SCALE);
+        return;
+    }
     this._setScale();
 };
 
@@ -1388,6 +1452,8 @@ nodeProto._ctor = function (name?: string) {
     this._lrot = new Quat();
     this._lscale = new Vec3(1, 1, 1);
     this._euler = new Vec3();
+    // slot in the transform batch, assigned by native on the first batched update
+    this._transformBatchSlot = -1;
 
     this._registeredNodeEventTypeMask = 0;
 };
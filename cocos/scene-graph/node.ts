@@ -2723,6 +2723,20 @@ export class Node extends CCObject implements ISchedulable, CustomSerializable {
         globalFlagChangeVersion += 1;
     }
 
+    /**
+     * @en
+     * Enable or disable batching of local position, rotation and scale updates. On native platforms the updates are
+     * written to a buffer shared with the native engine and applied together before the native engine reads any
+     * transform, and at latest when the frame is rendered. Transform events of batched updates are emitted at that time.
+     * It takes no effect on other platforms.
+     * @zh
+     * 开启或关闭本地位置、旋转和缩放更新的批处理。在原生平台上，这些更新会写入与原生引擎共享的缓冲区，
+     * 并在原生引擎读取任何变换之前统一应用，最迟在渲染该帧时应用，批处理更新的变换事件也在此时派发。其他平台上无效。
+     */
+    public static setTransformBatchEnabled (enabled: boolean): void {
+        // Only batched on native platforms.
+    }
+
     /**
      * @en
      * clear node array
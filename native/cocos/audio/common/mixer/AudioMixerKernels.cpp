@@ -0,0 +1,274 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "audio/common/mixer/AudioMixerKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define CC_MIXER_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define CC_MIXER_NEON 1
+#endif
+
+namespace cc {
+namespace mixer {
+
+namespace {
+
+// Lerps 4 lanes: a + (b - a) * t
+inline void lerp4(const float *a, const float *b, const float *t, float *out) {
+#if defined(CC_MIXER_SSE)
+    __m128 va = _mm_loadu_ps(a);
+    __m128 vb = _mm_loadu_ps(b);
+    __m128 vt = _mm_loadu_ps(t);
+    _mm_storeu_ps(out, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vt)));
+#elif defined(CC_MIXER_NEON)
+    float32x4_t va = vld1q_f32(a);
+    float32x4_t vb = vld1q_f32(b);
+    float32x4_t vt = vld1q_f32(t);
+    vst1q_f32(out, vmlaq_f32(va, vsubq_f32(vb, va), vt));
+#else
+    for (int i = 0; i < 4; ++i) {
+        out[i] = a[i] + (b[i] - a[i]) * t[i];
+    }
+#endif
+}
+
+} // namespace
+
+uint32_t resampleLinear(const float *src, uint32_t srcFrames, uint32_t channels, double &position, double step, float *dst, uint32_t dstFrames) {
+    if (srcFrames == 0 || position >= static_cast<double>(srcFrames)) {
+        return 0;
+    }
+
+    const double base = position;
+    uint32_t written = 0;
+
+    // Unit step on an integral position is a plain copy, the common case for sounds authored at the output rate.
+    if (step == 1.0 && base == std::floor(base)) {
+        const auto start = static_cast<uint32_t>(base);
+        written = std::min(dstFrames, srcFrames - start);
+        memcpy(dst, src + static_cast<size_t>(start) * channels, sizeof(float) * written * channels);
+        position = base + written;
+        return written;
+    }
+
+    // Frames whose right neighbour is still inside the source can be interpolated without bounds checks.
+    uint32_t safe = 0;
+    const double lastPair = static_cast<double>(srcFrames) - 1.0;
+    if (base < lastPair) {
+        const double count = std::floor((lastPair - base) / step);
+        safe = static_cast<uint32_t>(std::min(static_cast<double>(dstFrames), count + 1.0));
+        // floor() on the boundary may round up one frame too many.
+        while (safe > 0 && static_cast<uint32_t>(base + (safe - 1) * step) + 1 >= srcFrames) {
+            --safe;
+        }
+    }
+
+    float a[4];
+    float b[4];
+    float t[4];
+    if (channels == 1) {
+        for (; written + 4 <= safe; written += 4) {
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                const double pos = base + (written + lane) * step;
+                const auto idx = static_cast<uint32_t>(pos);
+                a[lane] = src[idx];
+                b[lane] = src[idx + 1];
+                t[lane] = static_cast<float>(pos - idx);
+            }
+            lerp4(a, b, t, dst + written);
+        }
+    } else {
+        for (; written + 2 <= safe; written += 2) {
+            for (uint32_t frame = 0; frame < 2; ++frame) {
+                const double pos = base + (written + frame) * step;
+                const auto idx = static_cast<uint32_t>(pos);
+                const auto frac = static_cast<float>(pos - idx);
+                a[frame * 2] = src[idx * 2];
+                a[frame * 2 + 1] = src[idx * 2 + 1];
+                b[frame * 2] = src[idx * 2 + 2];
+                b[frame * 2 + 1] = src[idx * 2 + 3];
+                t[frame * 2] = frac;
+                t[frame * 2 + 1] = frac;
+            }
+            lerp4(a, b, t, dst + static_cast<size_t>(written) * 2);
+        }
+    }
+
+    // Remainder of the safe run plus the final source frame, which has no right neighbour.
+    for (; written < dstFrames; ++written) {
+        const double pos = base + written * step;
+        const auto idx = static_cast<uint32_t>(pos);
+        if (idx >= srcFrames) {
+            break;
+        }
+        const uint32_t next = std::min(idx + 1, srcFrames - 1);
+        const auto frac = static_cast<float>(pos - idx);
+        for (uint32_t c = 0; c < channels; ++c) {
+            const float s0 = src[idx * channels + c];
+            const float s1 = src[next * channels + c];
+            dst[written * channels + c] = s0 + (s1 - s0) * frac;
+        }
+    }
+
+    position = base + written * step;
+    return written;
+}
+
+void mixMonoToStereoRamp(const float *src, uint32_t frames, float *dst, float gainL, float gainR, float incL, float incR) {
+    uint32_t i = 0;
+#if defined(CC_MIXER_SSE)
+    __m128 gain0 = _mm_setr_ps(gainL, gainR, gainL + incL, gainR + incR);
+    __m128 gain1 = _mm_setr_ps(gainL + 2 * incL, gainR + 2 * incR, gainL + 3 * incL, gainR + 3 * incR);
+    const __m128 inc = _mm_setr_ps(4 * incL, 4 * incR, 4 * incL, 4 * incR);
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 s = _mm_loadu_ps(src + i);
+        float *out = dst + static_cast<size_t>(i) * 2;
+        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(_mm_unpacklo_ps(s, s), gain0)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(_mm_unpackhi_ps(s, s), gain1)));
+        gain0 = _mm_add_ps(gain0, inc);
+        gain1 = _mm_add_ps(gain1, inc);
+    }
+#elif defined(CC_MIXER_NEON)
+    const float g0[4] = {gainL, gainR, gainL + incL, gainR + incR};
+    const float g1[4] = {gainL + 2 * incL, gainR + 2 * incR, gainL + 3 * incL, gainR + 3 * incR};
+    const float gi[4] = {4 * incL, 4 * incR, 4 * incL, 4 * incR};
+    float32x4_t gain0 = vld1q_f32(g0);
+    float32x4_t gain1 = vld1q_f32(g1);
+    const float32x4_t inc = vld1q_f32(gi);
+    for (; i + 4 <= frames; i += 4) {
+        const float32x4_t s = vld1q_f32(src + i);
+        const float32x4x2_t dup = vzipq_f32(s, s);
+        float *out = dst + static_cast<size_t>(i) * 2;
+        vst1q_f32(out, vmlaq_f32(vld1q_f32(out), dup.val[0], gain0));
+        vst1q_f32(out + 4, vmlaq_f32(vld1q_f32(out + 4), dup.val[1], gain1));
+        gain0 = vaddq_f32(gain0, inc);
+        gain1 = vaddq_f32(gain1, inc);
+    }
+#endif
+    for (; i < frames; ++i) {
+        dst[i * 2] += src[i] * (gainL + static_cast<float>(i) * incL);
+        dst[i * 2 + 1] += src[i] * (gainR + static_cast<float>(i) * incR);
+    }
+}
+
+void mixStereoToStereoRamp(const float *src, uint32_t frames, float *dst, float gainL, float gainR, float incL, float incR) {
+    uint32_t i = 0;
+#if defined(CC_MIXER_SSE)
+    __m128 gain = _mm_setr_ps(gainL, gainR, gainL + incL, gainR + incR);
+    const __m128 inc = _mm_setr_ps(2 * incL, 2 * incR, 2 * incL, 2 * incR);
+    for (; i + 2 <= frames; i += 2) {
+        const size_t offset = static_cast<size_t>(i) * 2;
+        _mm_storeu_ps(dst + offset, _mm_add_ps(_mm_loadu_ps(dst + offset), _mm_mul_ps(_mm_loadu_ps(src + offset), gain)));
+        gain = _mm_add_ps(gain, inc);
+    }
+#elif defined(CC_MIXER_NEON)
+    const float g[4] = {gainL, gainR, gainL + incL, gainR + incR};
+    const float gi[4] = {2 * incL, 2 * incR, 2 * incL, 2 * incR};
+    float32x4_t gain = vld1q_f32(g);
+    const float32x4_t inc = vld1q_f32(gi);
+    for (; i + 2 <= frames; i += 2) {
+        const size_t offset = static_cast<size_t>(i) * 2;
+        vst1q_f32(dst + offset, vmlaq_f32(vld1q_f32(dst + offset), vld1q_f32(src + offset), gain));
+        gain = vaddq_f32(gain, inc);
+    }
+#endif
+    for (; i < frames; ++i) {
+        dst[i * 2] += src[i * 2] * (gainL + static_cast<float>(i) * incL);
+        dst[i * 2 + 1] += src[i * 2 + 1] * (gainR + static_cast<float>(i) * incR);
+    }
+}
+
+void convertS16ToFloat(const int16_t *src, size_t samples, float *dst) {
+    constexpr float SCALE = 1.0F / 32768.0F;
+    size_t i = 0;
+#if defined(CC_MIXER_SSE)
+    const __m128 scale = _mm_set1_ps(SCALE);
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 v = _mm_setr_ps(src[i], src[i + 1], src[i + 2], src[i + 3]);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(v, scale));
+    }
+#elif defined(CC_MIXER_NEON)
+    for (; i + 4 <= samples; i += 4) {
+        const int32x4_t v = vmovl_s16(vld1_s16(src + i));
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(v), SCALE));
+    }
+#endif
+    for (; i < samples; ++i) {
+        dst[i] = static_cast<float>(src[i]) * SCALE;
+    }
+}
+
+void convertFloatToS16(const float *src, size_t samples, int16_t *dst) {
+    size_t i = 0;
+#if defined(CC_MIXER_SSE)
+    const __m128 lo = _mm_set1_ps(-1.0F);
+    const __m128 hi = _mm_set1_ps(1.0F);
+    const __m128 scale = _mm_set1_ps(32767.0F);
+    float tmp[4];
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 v = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), lo), hi), scale);
+        _mm_storeu_ps(tmp, v);
+        for (int lane = 0; lane < 4; ++lane) {
+            dst[i + lane] = static_cast<int16_t>(std::lrintf(tmp[lane]));
+        }
+    }
+#elif defined(CC_MIXER_NEON)
+    const float32x4_t lo = vdupq_n_f32(-1.0F);
+    const float32x4_t hi = vdupq_n_f32(1.0F);
+    for (; i + 4 <= samples; i += 4) {
+        const float32x4_t v = vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(src + i), lo), hi), 32767.0F);
+        // vcvtq_s32_f32 truncates, round to nearest like lrintf in the SSE and scalar paths
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        const int32x4_t rounded = vcvtnq_s32_f32(v);
+    #else
+        // no round to nearest conversion before ARMv8, add 0.5 with the sign of v, only exact halves differ from lrintf
+        const float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000U), v, vdupq_n_f32(0.5F));
+        const int32x4_t rounded = vcvtq_s32_f32(vaddq_f32(v, half));
+    #endif
+        vst1_s16(dst + i, vqmovn_s32(rounded));
+    }
+#endif
+    for (; i < samples; ++i) {
+        const float v = std::min(std::max(src[i], -1.0F), 1.0F);
+        dst[i] = static_cast<int16_t>(std::lrintf(v * 32767.0F));
+    }
+}
+
+void panGains(float volume, float pan, float &gainL, float &gainR) {
+    constexpr float QUARTER_PI = 0.78539816339F;
+    const float p = std::min(std::max(pan, -1.0F), 1.0F);
+    const float angle = (p + 1.0F) * 0.5F * (2.0F * QUARTER_PI);
+    gainL = std::cos(angle) * volume;
+    gainR = std::sin(angle) * volume;
+}
+
+} // namespace mixer
+} // namespace cc
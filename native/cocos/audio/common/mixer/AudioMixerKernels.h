@@ -0,0 +1,78 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cc {
+namespace mixer {
+
+/**
+ * @brief Inner loops of AudioSoftMixer. Every function has a SSE, NEON and scalar implementation
+ * selected at compile time, all of them operate on 32-bit float samples.
+ */
+
+/**
+ * @brief Resamples interleaved frames with linear interpolation.
+ * @param src Source frames, |channels| interleaved samples per frame.
+ * @param srcFrames Number of frames in |src|.
+ * @param channels 1 or 2.
+ * @param position In/out read cursor in source frames, advanced by |step| per output frame.
+ * @param step Source frames consumed per output frame, e.g. srcRate / dstRate * pitch.
+ * @param dst Destination frames, |channels| interleaved samples per frame.
+ * @param dstFrames Capacity of |dst| in frames.
+ * @return The number of frames written, less than |dstFrames| when the source runs out.
+ */
+uint32_t resampleLinear(const float *src, uint32_t srcFrames, uint32_t channels, double &position, double step, float *dst, uint32_t dstFrames);
+
+/**
+ * @brief Accumulates mono frames into an interleaved stereo bus with a linear gain ramp per channel.
+ * The gain of frame i is (gainL + i * incL, gainR + i * incR).
+ */
+void mixMonoToStereoRamp(const float *src, uint32_t frames, float *dst, float gainL, float gainR, float incL, float incR);
+
+/**
+ * @brief Accumulates interleaved stereo frames into an interleaved stereo bus with a linear gain ramp per channel.
+ */
+void mixStereoToStereoRamp(const float *src, uint32_t frames, float *dst, float gainL, float gainR, float incL, float incR);
+
+/**
+ * @brief Converts signed 16-bit samples to floats in [-1, 1).
+ */
+void convertS16ToFloat(const int16_t *src, size_t samples, float *dst);
+
+/**
+ * @brief Converts floats to signed 16-bit samples, clamping to [-1, 1].
+ */
+void convertFloatToS16(const float *src, size_t samples, int16_t *dst);
+
+/**
+ * @brief Computes constant power gains for |pan| in [-1, 1] scaled by |volume|.
+ */
+void panGains(float volume, float pan, float &gainL, float &gainR);
+
+} // namespace mixer
+} // namespace cc
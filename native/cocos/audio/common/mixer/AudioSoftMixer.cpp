@@ -0,0 +1,400 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "audio/common/mixer/AudioSoftMixer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "audio/common/mixer/AudioMixerKernels.h"
+#include "base/Log.h"
+
+namespace cc {
+
+namespace {
+
+// Frames resampled per kernel invocation, bounds the scratch buffer.
+constexpr uint32_t RESAMPLE_CHUNK_FRAMES = 1024;
+constexpr uint32_t MAX_VOICE_SLOTS = 0xFFFF;
+
+void writeLE16(FILE *fp, uint16_t v) {
+    const uint8_t bytes[2] = {static_cast<uint8_t>(v & 0xFF), static_cast<uint8_t>(v >> 8)};
+    fwrite(bytes, 1, 2, fp);
+}
+
+void writeLE32(FILE *fp, uint32_t v) {
+    const uint8_t bytes[4] = {static_cast<uint8_t>(v & 0xFF), static_cast<uint8_t>((v >> 8) & 0xFF),
+                              static_cast<uint8_t>((v >> 16) & 0xFF), static_cast<uint8_t>(v >> 24)};
+    fwrite(bytes, 1, 4, fp);
+}
+
+} // namespace
+
+AudioSoftMixer::AudioSoftMixer(uint32_t sampleRate, uint32_t maxVoices, uint32_t maxMixedVoices)
+: _sampleRate(sampleRate),
+  _maxMixedVoices(std::min(maxMixedVoices, maxVoices)) {
+    if (maxVoices > MAX_VOICE_SLOTS) {
+        CC_LOG_WARNING("AudioSoftMixer: maxVoices %u clamped to %u", maxVoices, MAX_VOICE_SLOTS);
+        maxVoices = MAX_VOICE_SLOTS;
+    }
+    _voices.resize(maxVoices);
+    _order.reserve(maxVoices);
+    _resampled.resize(RESAMPLE_CHUNK_FRAMES * 2);
+}
+
+AudioSoftMixer::~AudioSoftMixer() = default;
+
+AudioSoftMixer::SoundId AudioSoftMixer::addSound(const int16_t *pcm, uint32_t frames, uint32_t channels, uint32_t sampleRate) {
+    if (pcm == nullptr || channels == 0 || channels > 2 || sampleRate == 0) {
+        return INVALID_SOUND;
+    }
+    auto sound = std::make_shared<Sound>();
+    sound->samples.resize(static_cast<size_t>(frames) * channels);
+    mixer::convertS16ToFloat(pcm, sound->samples.size(), sound->samples.data());
+    sound->frames = frames;
+    sound->channels = channels;
+    sound->sampleRate = sampleRate;
+    return addSoundInternal(std::move(sound));
+}
+
+AudioSoftMixer::SoundId AudioSoftMixer::addSound(const float *pcm, uint32_t frames, uint32_t channels, uint32_t sampleRate) {
+    if (pcm == nullptr || channels == 0 || channels > 2 || sampleRate == 0) {
+        return INVALID_SOUND;
+    }
+    auto sound = std::make_shared<Sound>();
+    sound->samples.assign(pcm, pcm + static_cast<size_t>(frames) * channels);
+    sound->frames = frames;
+    sound->channels = channels;
+    sound->sampleRate = sampleRate;
+    return addSoundInternal(std::move(sound));
+}
+
+AudioSoftMixer::SoundId AudioSoftMixer::addSoundInternal(std::shared_ptr<Sound> sound) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = std::find(_sounds.begin(), _sounds.end(), nullptr);
+    if (iter != _sounds.end()) {
+        *iter = std::move(sound);
+        return static_cast<SoundId>(iter - _sounds.begin());
+    }
+    _sounds.emplace_back(std::move(sound));
+    return static_cast<SoundId>(_sounds.size() - 1);
+}
+
+void AudioSoftMixer::removeSound(SoundId sound) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (sound >= _sounds.size() || !_sounds[sound]) {
+        return;
+    }
+    for (auto &voice : _voices) {
+        if (voice.active && voice.sound == _sounds[sound]) {
+            voice.active = false;
+            voice.sound.reset();
+        }
+    }
+    _sounds[sound].reset();
+}
+
+AudioSoftMixer::VoiceId AudioSoftMixer::makeVoiceId(uint32_t slot, uint16_t generation) {
+    return (static_cast<uint32_t>(generation) << 16) | slot;
+}
+
+AudioSoftMixer::Voice *AudioSoftMixer::findVoice(VoiceId voice) {
+    const uint32_t slot = voice & 0xFFFF;
+    if (voice == INVALID_VOICE || slot >= _voices.size()) {
+        return nullptr;
+    }
+    auto &v = _voices[slot];
+    if (!v.active || v.generation != static_cast<uint16_t>(voice >> 16)) {
+        return nullptr;
+    }
+    return &v;
+}
+
+const AudioSoftMixer::Voice *AudioSoftMixer::findVoice(VoiceId voice) const {
+    return const_cast<AudioSoftMixer *>(this)->findVoice(voice);
+}
+
+uint32_t AudioSoftMixer::acquireSlot(int32_t priority) {
+    uint32_t victim = UINT32_MAX;
+    for (uint32_t i = 0; i < _voices.size(); ++i) {
+        const auto &voice = _voices[i];
+        if (!voice.active) {
+            return i;
+        }
+        if (victim == UINT32_MAX) {
+            victim = i;
+            continue;
+        }
+        const auto &current = _voices[victim];
+        if (voice.params.priority < current.params.priority ||
+            (voice.params.priority == current.params.priority && audibility(voice) < audibility(current))) {
+            victim = i;
+        }
+    }
+    if (victim == UINT32_MAX || _voices[victim].params.priority > priority) {
+        ++_stats.rejectedVoices;
+        return UINT32_MAX;
+    }
+    ++_stats.stolenVoices;
+    return victim;
+}
+
+AudioSoftMixer::VoiceId AudioSoftMixer::play(SoundId sound, const VoiceParams &params) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (sound >= _sounds.size() || !_sounds[sound]) {
+        return INVALID_VOICE;
+    }
+    const uint32_t slot = acquireSlot(params.priority);
+    if (slot == UINT32_MAX) {
+        return INVALID_VOICE;
+    }
+    auto &voice = _voices[slot];
+    const uint16_t generation = voice.generation + 1;
+    voice = Voice{};
+    voice.sound = _sounds[sound];
+    voice.params = params;
+    voice.generation = generation;
+    voice.active = true;
+    return makeVoiceId(slot, generation);
+}
+
+void AudioSoftMixer::stop(VoiceId voice) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto *v = findVoice(voice)) {
+        v->active = false;
+        v->sound.reset();
+    }
+}
+
+void AudioSoftMixer::stopAll() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &voice : _voices) {
+        voice.active = false;
+        voice.sound.reset();
+    }
+}
+
+void AudioSoftMixer::setPaused(VoiceId voice, bool paused) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto *v = findVoice(voice)) {
+        v->paused = paused;
+    }
+}
+
+void AudioSoftMixer::setVolume(VoiceId voice, float volume) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto *v = findVoice(voice)) {
+        v->params.volume = std::max(volume, 0.0F);
+    }
+}
+
+void AudioSoftMixer::setPan(VoiceId voice, float pan) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto *v = findVoice(voice)) {
+        v->params.pan = pan;
+    }
+}
+
+void AudioSoftMixer::setPitch(VoiceId voice, float pitch) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto *v = findVoice(voice)) {
+        v->params.pitch = std::max(pitch, 0.0F);
+    }
+}
+
+void AudioSoftMixer::setLoop(VoiceId voice, bool loop) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto *v = findVoice(voice)) {
+        v->params.loop = loop;
+    }
+}
+
+bool AudioSoftMixer::isPlaying(VoiceId voice) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto *v = findVoice(voice);
+    return v != nullptr && !v->paused;
+}
+
+void AudioSoftMixer::setMasterVolume(float volume) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _masterVolume = std::max(volume, 0.0F);
+}
+
+void AudioSoftMixer::setAudibilityThreshold(float threshold) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _audibilityThreshold = std::max(threshold, 0.0F);
+}
+
+AudioSoftMixer::Stats AudioSoftMixer::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void AudioSoftMixer::mix(float *out, uint32_t frames) {
+    memset(out, 0, sizeof(float) * frames * 2);
+    if (frames == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _order.clear();
+    for (uint32_t i = 0; i < _voices.size(); ++i) {
+        const auto &voice = _voices[i];
+        if (voice.active && !voice.paused) {
+            _order.push_back(i);
+        }
+    }
+
+    // Rank voices by priority then loudness, only the head of the list is mixed.
+    const auto mixable = static_cast<uint32_t>(std::min<size_t>(_maxMixedVoices, _order.size()));
+    auto byImportance = [this](uint32_t lhs, uint32_t rhs) {
+        const auto &a = _voices[lhs];
+        const auto &b = _voices[rhs];
+        if (a.params.priority != b.params.priority) {
+            return a.params.priority > b.params.priority;
+        }
+        return audibility(a) > audibility(b);
+    };
+    if (mixable < _order.size()) {
+        std::nth_element(_order.begin(), _order.begin() + mixable, _order.end(), byImportance);
+    }
+
+    _stats.activeVoices = static_cast<uint32_t>(_order.size());
+    _stats.mixedVoices = 0;
+    _stats.virtualVoices = 0;
+    for (uint32_t i = 0; i < _order.size(); ++i) {
+        auto &voice = _voices[_order[i]];
+        if (i < mixable && audibility(voice) >= _audibilityThreshold) {
+            mixVoice(voice, out, frames);
+            ++_stats.mixedVoices;
+        } else {
+            advanceVirtual(voice, frames);
+            ++_stats.virtualVoices;
+        }
+    }
+}
+
+void AudioSoftMixer::mixVoice(Voice &voice, float *out, uint32_t frames) {
+    const Sound &sound = *voice.sound;
+    const double step = static_cast<double>(sound.sampleRate) / _sampleRate * voice.params.pitch;
+
+    float targetL = 0.0F;
+    float targetR = 0.0F;
+    mixer::panGains(voice.params.volume * _masterVolume, voice.params.pan, targetL, targetR);
+    // A voice heard for the first time starts at its target gain to keep the attack intact,
+    // a voice coming back from virtualization fades in to avoid a click.
+    if (!voice.wasMixed) {
+        const bool fresh = voice.position == 0.0;
+        voice.lastGainL = fresh ? targetL : 0.0F;
+        voice.lastGainR = fresh ? targetR : 0.0F;
+    }
+    const float incL = (targetL - voice.lastGainL) / static_cast<float>(frames);
+    const float incR = (targetR - voice.lastGainR) / static_cast<float>(frames);
+
+    uint32_t done = 0;
+    while (done < frames) {
+        const uint32_t want = std::min(frames - done, RESAMPLE_CHUNK_FRAMES);
+        const uint32_t got = mixer::resampleLinear(sound.samples.data(), sound.frames, sound.channels, voice.position, step, _resampled.data(), want);
+        if (got > 0) {
+            const float gainL = voice.lastGainL + incL * static_cast<float>(done);
+            const float gainR = voice.lastGainR + incR * static_cast<float>(done);
+            float *dst = out + static_cast<size_t>(done) * 2;
+            if (sound.channels == 1) {
+                mixer::mixMonoToStereoRamp(_resampled.data(), got, dst, gainL, gainR, incL, incR);
+            } else {
+                mixer::mixStereoToStereoRamp(_resampled.data(), got, dst, gainL, gainR, incL, incR);
+            }
+            done += got;
+        }
+        if (got < want) {
+            if (!voice.params.loop || sound.frames == 0 || step <= 0.0) {
+                voice.active = false;
+                voice.sound.reset();
+                return;
+            }
+            voice.position = std::fmod(voice.position, static_cast<double>(sound.frames));
+        }
+    }
+
+    voice.lastGainL = targetL;
+    voice.lastGainR = targetR;
+    voice.wasMixed = true;
+}
+
+void AudioSoftMixer::advanceVirtual(Voice &voice, uint32_t frames) {
+    const Sound &sound = *voice.sound;
+    const double step = static_cast<double>(sound.sampleRate) / _sampleRate * voice.params.pitch;
+    voice.position += step * frames;
+    voice.wasMixed = false;
+    if (voice.position >= static_cast<double>(sound.frames)) {
+        if (voice.params.loop && sound.frames > 0) {
+            voice.position = std::fmod(voice.position, static_cast<double>(sound.frames));
+        } else {
+            voice.active = false;
+            voice.sound.reset();
+        }
+    }
+}
+
+bool AudioSoftMixer::renderToWav(const ccstd::string &path, uint32_t frames, uint32_t blockFrames) {
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr) {
+        CC_LOG_ERROR("AudioSoftMixer: failed to open %s", path.c_str());
+        return false;
+    }
+
+    constexpr uint16_t CHANNELS = 2;
+    constexpr uint16_t BITS_PER_SAMPLE = 16;
+    const uint32_t dataBytes = frames * CHANNELS * (BITS_PER_SAMPLE / 8);
+    fwrite("RIFF", 1, 4, fp);
+    writeLE32(fp, 36 + dataBytes);
+    fwrite("WAVEfmt ", 1, 8, fp);
+    writeLE32(fp, 16);
+    writeLE16(fp, 1); // PCM
+    writeLE16(fp, CHANNELS);
+    writeLE32(fp, _sampleRate);
+    writeLE32(fp, _sampleRate * CHANNELS * (BITS_PER_SAMPLE / 8));
+    writeLE16(fp, CHANNELS * (BITS_PER_SAMPLE / 8));
+    writeLE16(fp, BITS_PER_SAMPLE);
+    fwrite("data", 1, 4, fp);
+    writeLE32(fp, dataBytes);
+
+    blockFrames = std::max(blockFrames, 1U);
+    ccstd::vector<float> block(static_cast<size_t>(blockFrames) * CHANNELS);
+    ccstd::vector<int16_t> pcm(block.size());
+    bool ok = true;
+    for (uint32_t rendered = 0; rendered < frames && ok;) {
+        const uint32_t count = std::min(blockFrames, frames - rendered);
+        mix(block.data(), count);
+        mixer::convertFloatToS16(block.data(), static_cast<size_t>(count) * CHANNELS, pcm.data());
+        ok = fwrite(pcm.data(), sizeof(int16_t) * CHANNELS, count, fp) == count;
+        rendered += count;
+    }
+    fclose(fp);
+    return ok;
+}
+
+} // namespace cc
@@ -0,0 +1,182 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "audio/include/Export.h"
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * @brief Portable float mixer that renders any number of voices into an interleaved stereo bus.
+ *
+ * Only the |maxMixedVoices| loudest voices are resampled and mixed, the others are virtual: their play
+ * cursor keeps advancing so they resume in sync once they become audible again, but they cost no DSP.
+ * When all |maxVoices| slots are taken, a new voice steals the slot of the lowest priority (then quietest)
+ * voice, provided its own priority is not lower.
+ *
+ * The mixer is backend agnostic, a platform backend only has to pull blocks with `mix()`. `renderToWav()`
+ * drives it offline, which is how it is tested.
+ */
+class EXPORT_DLL AudioSoftMixer {
+public:
+    using SoundId = uint32_t;
+    using VoiceId = uint32_t;
+
+    static constexpr SoundId INVALID_SOUND = UINT32_MAX;
+    static constexpr VoiceId INVALID_VOICE = UINT32_MAX;
+
+    struct VoiceParams {
+        float volume{1.0F};
+        // -1 is full left, 1 is full right.
+        float pan{0.0F};
+        // Playback rate multiplier, applied on top of the sample rate conversion.
+        float pitch{1.0F};
+        // Higher priorities are kept when voices have to be stolen.
+        int32_t priority{0};
+        bool loop{false};
+    };
+
+    struct Stats {
+        uint32_t activeVoices{0};
+        uint32_t mixedVoices{0};
+        uint32_t virtualVoices{0};
+        uint32_t stolenVoices{0};
+        uint32_t rejectedVoices{0};
+    };
+
+    /**
+     * @param sampleRate Output sample rate in Hz.
+     * @param maxVoices Number of voices tracked at the same time, mixed or virtual.
+     * @param maxMixedVoices Number of voices actually mixed per block.
+     */
+    AudioSoftMixer(uint32_t sampleRate, uint32_t maxVoices, uint32_t maxMixedVoices);
+    ~AudioSoftMixer();
+
+    /**
+     * @brief Registers interleaved 16-bit PCM data (mono or stereo), which is converted to float once.
+     * @return The sound id, or INVALID_SOUND if the format is not supported.
+     */
+    SoundId addSound(const int16_t *pcm, uint32_t frames, uint32_t channels, uint32_t sampleRate);
+
+    /**
+     * @brief Registers interleaved float PCM data (mono or stereo).
+     */
+    SoundId addSound(const float *pcm, uint32_t frames, uint32_t channels, uint32_t sampleRate);
+
+    /**
+     * @brief Stops every voice playing the sound and releases its data.
+     */
+    void removeSound(SoundId sound);
+
+    /**
+     * @brief Starts a voice, stealing one if the pool is full.
+     * @return The voice id, or INVALID_VOICE if no voice could be allocated.
+     */
+    VoiceId play(SoundId sound, const VoiceParams &params);
+    void stop(VoiceId voice);
+    void stopAll();
+    void setPaused(VoiceId voice, bool paused);
+    void setVolume(VoiceId voice, float volume);
+    void setPan(VoiceId voice, float pan);
+    void setPitch(VoiceId voice, float pitch);
+    void setLoop(VoiceId voice, bool loop);
+    bool isPlaying(VoiceId voice) const;
+
+    void setMasterVolume(float volume);
+    inline float getMasterVolume() const { return _masterVolume; }
+
+    /**
+     * @brief Voices whose effective gain is below the threshold are virtualized even if mixing slots are free.
+     */
+    void setAudibilityThreshold(float threshold);
+
+    /**
+     * @brief Renders |frames| interleaved stereo frames into |out|, overwriting its content.
+     */
+    void mix(float *out, uint32_t frames);
+
+    /**
+     * @brief Renders |frames| frames offline and writes them as a 16-bit stereo WAV file.
+     * @return true if the file was written.
+     */
+    bool renderToWav(const ccstd::string &path, uint32_t frames, uint32_t blockFrames = 512);
+
+    inline uint32_t getSampleRate() const { return _sampleRate; }
+    Stats getStats() const;
+
+private:
+    struct Sound {
+        ccstd::vector<float> samples;
+        uint32_t frames{0};
+        uint32_t channels{0};
+        uint32_t sampleRate{0};
+    };
+
+    struct Voice {
+        std::shared_ptr<Sound> sound;
+        double position{0.0};
+        VoiceParams params;
+        // Gains applied at the end of the previous mixed block, ramped towards the new target.
+        float lastGainL{0.0F};
+        float lastGainR{0.0F};
+        // Incremented each time the slot is reused so stale ids are rejected.
+        uint16_t generation{0};
+        bool active{false};
+        bool paused{false};
+        bool wasMixed{false};
+    };
+
+    SoundId addSoundInternal(std::shared_ptr<Sound> sound);
+    Voice *findVoice(VoiceId voice);
+    const Voice *findVoice(VoiceId voice) const;
+    uint32_t acquireSlot(int32_t priority);
+    static VoiceId makeVoiceId(uint32_t slot, uint16_t generation);
+    inline float audibility(const Voice &voice) const { return voice.params.volume * _masterVolume; }
+    void mixVoice(Voice &voice, float *out, uint32_t frames);
+    void advanceVirtual(Voice &voice, uint32_t frames);
+
+    mutable std::mutex _mutex;
+    ccstd::vector<std::shared_ptr<Sound>> _sounds;
+    ccstd::vector<Voice> _voices;
+    // Scratch buffers reused across blocks so mix() does not allocate.
+    ccstd::vector<uint32_t> _order;
+    ccstd::vector<float> _resampled;
+    uint32_t _sampleRate{0};
+    uint32_t _maxMixedVoices{0};
+    float _masterVolume{1.0F};
+    float _audibilityThreshold{0.001F};
+    Stats _stats;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(AudioSoftMixer)
+};
+
+} // namespace cc
@@ -29,88 +29,120 @@
 #include "base/Scheduler.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <climits>
 #include "base/Log.h"
 #include "base/Macros.h"
 #include "base/memory/Memory.h"
+#include "concurrentqueue/concurrentqueue.h"
 
 namespace {
 constexpr unsigned CC_REPEAT_FOREVER{UINT_MAX - 1};
-constexpr int MAX_FUNC_TO_PERFORM{30};
-constexpr int INITIAL_TIMER_COUND{10};
+constexpr size_t PERFORM_BATCH_SIZE{16};
+constexpr size_t TIMER_BLOCK_SIZE{64};
+constexpr double TIMER_TICKS_PER_SECOND{1000.0};
+
+// keys interned by Scheduler::internKey may be held by the caller, they are never released
+constexpr uint32_t PINNED_KEY{UINT32_MAX};
+
+struct KeyTable {
+    ccstd::unordered_map<ccstd::string, uint32_t> ids;
+    // null for released ids
+    ccstd::vector<const ccstd::string *> names;
+    // number of timers using each key
+    ccstd::vector<uint32_t> refs;
+    ccstd::vector<uint32_t> freeIds;
+
+    KeyTable() {
+        names.emplace_back(&ids.emplace(ccstd::string(), 0).first->first);
+        refs.emplace_back(PINNED_KEY);
+    }
+};
+
+KeyTable &getKeyTable() {
+    static KeyTable table;
+    return table;
+}
+
+// Interns a key for the timers scheduled with it, it's released with the last of them.
+uint32_t acquireKey(const ccstd::string &key) {
+    auto &table = getKeyTable();
+    auto iter = table.ids.find(key);
+    if (iter != table.ids.end()) {
+        return iter->second;
+    }
+    uint32_t id = 0;
+    if (table.freeIds.empty()) {
+        id = static_cast<uint32_t>(table.names.size());
+        table.names.emplace_back(nullptr);
+        table.refs.emplace_back(0);
+    } else {
+        id = table.freeIds.back();
+        table.freeIds.pop_back();
+    }
+    table.names[id] = &table.ids.emplace(key, id).first->first;
+    return id;
+}
+
+void retainKey(uint32_t id) {
+    auto &refs = getKeyTable().refs[id];
+    if (refs != PINNED_KEY) {
+        ++refs;
+    }
+}
+
+void releaseKey(uint32_t id) {
+    auto &table = getKeyTable();
+    auto &refs = table.refs[id];
+    if (refs == PINNED_KEY) {
+        return;
+    }
+    CC_ASSERT(refs > 0);
+    if (--refs == 0) {
+        // keys of unique strings, like ones built from a pointer, would grow the table forever
+        table.ids.erase(table.ids.find(*table.names[id]));
+        table.names[id] = nullptr;
+        table.freeIds.emplace_back(id);
+    }
+}
+
+// Looks up a key without interning it, 0 if it has never been interned.
+uint32_t findKey(const ccstd::string &key) {
+    const auto &ids = getKeyTable().ids;
+    auto iter = ids.find(key);
+    return iter != ids.end() ? iter->second : 0;
+}
 } // namespace
 
 namespace cc {
 // implementation Timer
 
 void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float delay) {
-    _elapsed = -1;
     _interval = seconds;
     _delay = delay;
     _useDelay = _delay > 0.0F;
     _repeat = repeat;
     _runForever = _repeat == CC_REPEAT_FOREVER;
-}
-
-void Timer::update(float dt) {
-    if (_elapsed == -1) {
-        _elapsed = 0;
-        _timesExecuted = 0;
-        return;
-    }
-
-    // accumulate elapsed time
-    _elapsed += dt;
-
-    // deal with delay
-    if (_useDelay) {
-        if (_elapsed < _delay) {
-            return;
-        }
-        trigger(_delay);
-        _elapsed = _elapsed - _delay;
-        _timesExecuted += 1;
-        _useDelay = false;
-        // after delay, the rest time should compare with interval
-        if (!_runForever && _timesExecuted > _repeat) { //unschedule timer
-            cancel();
-            return;
-        }
-    }
-
-    // if _interval == 0, should trigger once every frame
-    float interval = (_interval > 0) ? _interval : _elapsed;
-    while (_elapsed >= interval) {
-        trigger(interval);
-        _elapsed -= interval;
-        _timesExecuted += 1;
-
-        if (!_runForever && _timesExecuted > _repeat) {
-            cancel();
-            break;
-        }
-
-        if (_elapsed <= 0.F) {
-            break;
-        }
-
-        if (_scheduler->isCurrentTargetSalvaged()) {
-            break;
-        }
-    }
+    _timesExecuted = 0;
 }
 
 // TimerTargetCallback
 
-bool TimerTargetCallback::initWithCallback(Scheduler *scheduler, const ccSchedulerFunc &callback, void *target, const ccstd::string &key, float seconds, unsigned int repeat, float delay) {
+bool TimerTargetCallback::initWithCallback(Scheduler *scheduler, const ccSchedulerFunc &callback, void *target, uint32_t key, float seconds, unsigned int repeat, float delay) {
     _scheduler = scheduler;
     _target = target;
     _callback = callback;
     _key = key;
+    retainKey(key);
     setupTimerWithInterval(seconds, repeat, delay);
     return true;
 }
 
+const ccstd::string &TimerTargetCallback::getKey() const {
+    return Scheduler::getKeyName(_key);
+}
+
 void TimerTargetCallback::trigger(float dt) {
     if (_callback) {
         _callback(dt);
@@ -121,27 +153,184 @@ void TimerTargetCallback::cancel() {
     _scheduler->unschedule(_key, _target);
 }
 
+void TimerTargetCallback::reset() {
+    _callback = nullptr;
+    _target = nullptr;
+    releaseKey(_key);
+    _key = 0;
+}
+
 // implementation of Scheduler
 
-Scheduler::Scheduler() {
-    // I don't expect to have more than 30 functions to all per frame
-    _functionsToPerform.reserve(MAX_FUNC_TO_PERFORM);
+// FIFO per producer only, see performFunctionInCocosThread
+struct Scheduler::FunctionQueues {
+    std::array<moodycamel::ConcurrentQueue<InlineTask>, static_cast<size_t>(TaskPriority::COUNT)> lanes;
+};
+
+Scheduler::Scheduler()
+: _functionsToPerform(std::make_unique<FunctionQueues>()) {
 }
 
 Scheduler::~Scheduler() {
     unscheduleAll();
 }
 
-void Scheduler::removeHashElement(HashTimerEntry *element) {
-    if (element) {
-        for (auto &timer : element->timers) {
-            timer->release();
+uint32_t Scheduler::internKey(const ccstd::string &key) {
+    const uint32_t id = acquireKey(key);
+    getKeyTable().refs[id] = PINNED_KEY;
+    return id;
+}
+
+const ccstd::string &Scheduler::getKeyName(uint32_t key) {
+    const auto &table = getKeyTable();
+    CC_ASSERT(key < table.names.size() && table.names[key]);
+    return *table.names[key];
+}
+
+size_t Scheduler::getKeyCount() {
+    return getKeyTable().ids.size();
+}
+
+uint64_t Scheduler::toTick(double time) {
+    return static_cast<uint64_t>(time * TIMER_TICKS_PER_SECOND);
+}
+
+TimerTargetCallback *Scheduler::acquireTimer() {
+    if (_freeTimers.empty()) {
+        _timerBlocks.emplace_back(std::make_unique<TimerTargetCallback[]>(TIMER_BLOCK_SIZE));
+        auto *block = _timerBlocks.back().get();
+        for (size_t i = TIMER_BLOCK_SIZE; i > 0; --i) {
+            _freeTimers.emplace_back(block + i - 1);
         }
-        element->timers.clear();
+    }
+    auto *timer = _freeTimers.back();
+    _freeTimers.pop_back();
+    return timer;
+}
+
+void Scheduler::recycleTimer(TimerTargetCallback *timer) {
+    CC_ASSERT(!timer->isLinked());
+    timer->reset();
+    timer->_state = Timer::State::IDLE;
+    timer->_started = false;
+    timer->_listed = false;
+    _freeTimers.emplace_back(timer);
+}
+
+void Scheduler::listTimer(ccstd::vector<TimerTargetCallback *> &timers, TimerTargetCallback *timer) {
+    // A timer stays in its list until the list is compacted, it may still be there after being paused and resumed.
+    if (!timer->_listed) {
+        timer->_listed = true;
+        timers.emplace_back(timer);
+    }
+}
+
+void Scheduler::insertTimer(TimerTargetCallback *timer) {
+    timer->_state = Timer::State::WHEEL;
+    _timerWheel.insert(timer, toTick(timer->_deadline));
+}
+
+void Scheduler::startTimer(TimerTargetCallback *timer) {
+    timer->_started = true;
+    if (timer->_useDelay || timer->_interval > 0.F) {
+        timer->_deadline = _currentTime + (timer->_useDelay ? timer->_delay : timer->_interval);
+        insertTimer(timer);
+    } else {
+        timer->_state = Timer::State::FRAME;
+        listTimer(_frameTimers, timer);
+    }
+}
+
+void Scheduler::fireTimer(TimerTargetCallback *timer) {
+    timer->_state = Timer::State::DUE;
+    // catch up with the intervals that elapsed during the frame
+    do {
+        const float dt = timer->_useDelay ? timer->_delay : timer->_interval;
+        timer->_useDelay = false;
+        timer->trigger(dt);
+        // counted even if the callback paused its target, the timer must not fire again once resumed
+        timer->_timesExecuted += 1;
+        const bool finished = !timer->_runForever && timer->_timesExecuted > timer->_repeat;
+        if (timer->_state != Timer::State::DUE) {
+            // unscheduled or paused by the callback
+            if (finished && timer->_state == Timer::State::PAUSED) {
+                timer->cancel();
+            }
+            return;
+        }
+
+        if (finished) {
+            timer->cancel();
+            return;
+        }
+
+        // if _interval == 0, should trigger once every frame
+        if (timer->_interval <= 0.F) {
+            timer->_state = Timer::State::FRAME;
+            listTimer(_frameTimers, timer);
+            return;
+        }
+        timer->_deadline += timer->_interval;
+    } while (timer->_deadline <= _currentTime);
+
+    insertTimer(timer);
+}
+
+void Scheduler::pauseTimer(TimerTargetCallback *timer) {
+    switch (timer->_state) {
+        case Timer::State::WHEEL:
+            _timerWheel.remove(timer);
+            timer->_deadline = std::max(timer->_deadline - _currentTime, 0.0);
+            break;
+        case Timer::State::DUE:
+            timer->_deadline = std::max(timer->_deadline + timer->_interval - _currentTime, 0.0);
+            break;
+        case Timer::State::FRAME:
+            timer->_deadline = std::max(timer->_interval, 0.F);
+            break;
+        case Timer::State::PENDING:
+            break;
+        default:
+            return;
+    }
+    timer->_state = Timer::State::PAUSED;
+}
+
+void Scheduler::resumeTimer(TimerTargetCallback *timer) {
+    if (timer->_state != Timer::State::PAUSED) {
+        return;
+    }
+    if (!timer->_started) {
+        timer->_state = Timer::State::PENDING;
+        listTimer(_pendingTimers, timer);
+    } else if (!timer->_useDelay && timer->_interval <= 0.F) {
+        timer->_state = Timer::State::FRAME;
+        listTimer(_frameTimers, timer);
+    } else {
+        timer->_deadline += _currentTime;
+        insertTimer(timer);
+    }
+}
 
-        _hashForTimers.erase(element->target);
-        delete element;
+void Scheduler::cancelTimer(TimerTargetCallback *timer) {
+    const auto state = timer->_state;
+    if (state == Timer::State::WHEEL) {
+        _timerWheel.remove(timer);
     }
+    timer->_state = Timer::State::CANCELLED;
+    if (state == Timer::State::DUE) {
+        // the callback is still running
+        if (!timer->_listed) {
+            _cancelledTimers.emplace_back(timer);
+        }
+        return;
+    }
+    if (timer->_listed) {
+        // recycled when its list is compacted
+        timer->reset();
+        return;
+    }
+    recycleTimer(timer);
 }
 
 void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float interval, bool paused, const ccstd::string &key) {
@@ -149,30 +338,27 @@ void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float in
 }
 
 void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float interval, unsigned int repeat, float delay, bool paused, const ccstd::string &key) {
-    CC_ASSERT(target);
     CC_ASSERT(!key.empty());
+    this->schedule(callback, target, interval, repeat, delay, paused, acquireKey(key));
+}
 
-    auto iter = _hashForTimers.find(target);
-    HashTimerEntry *element = nullptr;
-    if (iter == _hashForTimers.end()) {
-        element = ccnew HashTimerEntry();
-        element->target = target;
+void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float interval, bool paused, uint32_t key) {
+    this->schedule(callback, target, interval, CC_REPEAT_FOREVER, 0.0F, paused, key);
+}
 
-        _hashForTimers[target] = element;
+void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float interval, unsigned int repeat, float delay, bool paused, uint32_t key) {
+    CC_ASSERT(target);
+    CC_ASSERT(key != 0);
 
+    auto result = _hashForTimers.emplace(target, HashTimerEntry{});
+    auto &element = result.first->second;
+    if (result.second) {
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        element->paused = paused;
+        element.paused = paused;
     } else {
-        element = iter->second;
-        CC_ASSERT(element->paused == paused);
-    }
-
-    if (element->timers.empty()) {
-        element->timers.reserve(INITIAL_TIMER_COUND);
-    } else {
-        for (auto &e : element->timers) {
-            auto *timer = dynamic_cast<TimerTargetCallback *>(e);
-            if (key == timer->getKey()) {
+        CC_ASSERT(element.paused == paused);
+        for (auto *timer : element.timers) {
+            if (key == timer->getKeyId()) {
                 CC_LOG_DEBUG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
                 timer->setInterval(interval);
                 return;
@@ -180,10 +366,15 @@ void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float in
         }
     }
 
-    auto *timer = ccnew TimerTargetCallback();
-    timer->addRef();
+    auto *timer = acquireTimer();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
-    element->timers.emplace_back(timer);
+    element.timers.emplace_back(timer);
+    if (element.paused) {
+        timer->_state = Timer::State::PAUSED;
+    } else {
+        timer->_state = Timer::State::PENDING;
+        listTimer(_pendingTimers, timer);
+    }
 }
 
 void Scheduler::unschedule(const ccstd::string &key, void *target) {
@@ -191,48 +382,39 @@ void Scheduler::unschedule(const ccstd::string &key, void *target) {
     if (target == nullptr || key.empty()) {
         return;
     }
+    unschedule(findKey(key), target);
+}
 
-    auto iter = _hashForTimers.find(target);
-    if (iter != _hashForTimers.end()) {
-        HashTimerEntry *element = iter->second;
-        int i = 0;
-        auto &timers = element->timers;
-
-        for (auto *t : timers) {
-            auto *timer = dynamic_cast<TimerTargetCallback *>(t);
-
-            if (timer && key == timer->getKey()) {
-                if (timer == element->currentTimer && (!element->currentTimerSalvaged)) {
-                    element->currentTimer->addRef();
-                    element->currentTimerSalvaged = true;
-                }
-
-                timers.erase(timers.begin() + i);
-                timer->release();
-
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i) {
-                    element->timerIndex--;
-                }
-
-                if (timers.empty()) {
-                    if (_currentTarget == element) {
-                        _currentTargetSalvaged = true;
-                    } else {
-                        removeHashElement(element);
-                    }
-                }
+void Scheduler::unschedule(uint32_t key, void *target) {
+    if (target == nullptr || key == 0) {
+        return;
+    }
 
-                return;
-            }
+    auto iter = _hashForTimers.find(target);
+    if (iter == _hashForTimers.end()) {
+        return;
+    }
 
-            ++i;
+    auto &timers = iter->second.timers;
+    auto timerIter = std::find_if(timers.begin(), timers.end(), [key](TimerTargetCallback *timer) {
+        return key == timer->getKeyId();
+    });
+    if (timerIter != timers.end()) {
+        auto *timer = *timerIter;
+        timers.erase(timerIter);
+        if (timers.empty()) {
+            _hashForTimers.erase(iter);
         }
+        cancelTimer(timer);
     }
 }
 
 bool Scheduler::isScheduled(const ccstd::string &key, void *target) {
     CC_ASSERT(!key.empty());
+    return isScheduled(findKey(key), target);
+}
+
+bool Scheduler::isScheduled(uint32_t key, void *target) {
     CC_ASSERT(target);
 
     auto iter = _hashForTimers.find(target);
@@ -240,15 +422,9 @@ bool Scheduler::isScheduled(const ccstd::string &key, void *target) {
         return false;
     }
 
-    HashTimerEntry *element = iter->second;
-    if (element->timers.empty()) {
-        return false;
-    }
-
-    const auto &timers = element->timers;
-    return std::any_of(timers.begin(), timers.end(), [&key](Timer *t) {
-        auto *timer = dynamic_cast<TimerTargetCallback *>(t);
-        return (timer && key == timer->getKey());
+    const auto &timers = iter->second.timers;
+    return std::any_of(timers.begin(), timers.end(), [key](TimerTargetCallback *timer) {
+        return key == timer->getKeyId();
     });
 }
 
@@ -268,23 +444,10 @@ void Scheduler::unscheduleAllForTarget(void *target) {
 
     auto iter = _hashForTimers.find(target);
     if (iter != _hashForTimers.end()) {
-        HashTimerEntry *element = iter->second;
-        auto &timers = element->timers;
-        if (std::find(timers.begin(), timers.end(), element->currentTimer) != timers.end() &&
-            (!element->currentTimerSalvaged)) {
-            element->currentTimer->addRef();
-            element->currentTimerSalvaged = true;
-        }
-
-        for (auto *t : timers) {
-            t->release();
-        }
-        timers.clear();
-
-        if (_currentTarget == element) {
-            _currentTargetSalvaged = true;
-        } else {
-            removeHashElement(element);
+        auto timers = std::move(iter->second.timers);
+        _hashForTimers.erase(iter);
+        for (auto *timer : timers) {
+            cancelTimer(timer);
         }
     }
 }
@@ -294,8 +457,11 @@ void Scheduler::resumeTarget(void *target) {
 
     // custom selectors
     auto iter = _hashForTimers.find(target);
-    if (iter != _hashForTimers.end()) {
-        iter->second->paused = false;
+    if (iter != _hashForTimers.end() && iter->second.paused) {
+        iter->second.paused = false;
+        for (auto *timer : iter->second.timers) {
+            resumeTimer(timer);
+        }
     }
 }
 
@@ -304,8 +470,11 @@ void Scheduler::pauseTarget(void *target) {
 
     // custom selectors
     auto iter = _hashForTimers.find(target);
-    if (iter != _hashForTimers.end()) {
-        iter->second->paused = true;
+    if (iter != _hashForTimers.end() && !iter->second.paused) {
+        iter->second.paused = true;
+        for (auto *timer : iter->second.timers) {
+            pauseTimer(timer);
+        }
     }
 }
 
@@ -315,84 +484,157 @@ bool Scheduler::isTargetPaused(void *target) {
     // Custom selectors
     auto iter = _hashForTimers.find(target);
     if (iter != _hashForTimers.end()) {
-        return iter->second->paused;
+        return iter->second.paused;
     }
 
     return false; // should never get here
 }
 
-void Scheduler::performFunctionInCocosThread(const std::function<void()> &function) {
-    _performMutex.lock();
-    _functionsToPerform.push_back(function);
-    _performMutex.unlock();
+void Scheduler::performFunctionInCocosThread(InlineTask &&function, TaskPriority priority) {
+    CC_ASSERT(priority < TaskPriority::COUNT);
+    _functionsToPerform->lanes[static_cast<size_t>(priority)].enqueue(std::move(function));
 }
 
 void Scheduler::removeAllFunctionsToBePerformedInCocosThread() {
-    std::unique_lock<std::mutex> lock(_performMutex);
-    _functionsToPerform.clear();
+    InlineTask tasks[PERFORM_BATCH_SIZE];
+    for (auto &queue : _functionsToPerform->lanes) {
+        while (queue.try_dequeue_bulk(tasks, PERFORM_BATCH_SIZE) > 0) {
+            for (auto &task : tasks) {
+                task.reset();
+            }
+        }
+    }
 }
 
-// main loop
-void Scheduler::update(float dt) {
-    _updateHashLocked = true;
+size_t Scheduler::getPendingFunctionCount() const {
+    size_t count = 0;
+    for (const auto &queue : _functionsToPerform->lanes) {
+        count += queue.size_approx();
+    }
+    return count;
+}
 
-    // Iterate over all the custom selectors
-    HashTimerEntry *elt = nullptr;
-    for (auto iter = _hashForTimers.begin(); iter != _hashForTimers.end();) {
-        elt = iter->second;
-        _currentTarget = elt;
-        _currentTargetSalvaged = false;
-
-        if (!_currentTarget->paused) {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < static_cast<int>(elt->timers.size()); ++(elt->timerIndex)) {
-                elt->currentTimer = elt->timers.at(elt->timerIndex);
-                elt->currentTimerSalvaged = false;
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimerSalvaged) {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
+void Scheduler::performFunctions() {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(_performTimeBudget));
+
+    // Functions queued by the performed ones are left to the next frame, so that a function can't starve the frame by re-posting itself.
+    auto &highQueue = _functionsToPerform->lanes[static_cast<size_t>(TaskPriority::HIGH)];
+    size_t remaining = highQueue.size_approx();
+    InlineTask tasks[PERFORM_BATCH_SIZE];
+    while (remaining > 0) {
+        const size_t count = highQueue.try_dequeue_bulk(tasks, std::min(remaining, PERFORM_BATCH_SIZE));
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            tasks[i]();
+            tasks[i].reset();
+        }
+        remaining -= count;
+    }
+
+    // The other lanes are drained within the time budget, one function at a time so that the budget is checked between them.
+    // Each lane performs at least one function per frame, so the LOW lane is never starved completely.
+    for (auto priority : {TaskPriority::NORMAL, TaskPriority::LOW}) {
+        auto &queue = _functionsToPerform->lanes[static_cast<size_t>(priority)];
+        remaining = queue.size_approx();
+        InlineTask &task = tasks[0];
+        for (bool first = true; remaining > 0 && (first || Clock::now() < deadline); first = false, --remaining) {
+            if (!queue.try_dequeue(task)) {
+                break;
             }
+            task();
+            task.reset();
+        }
+    }
+}
+
+// main loop
+void Scheduler::updateFrameTimers(float dt) {
+    // timers added to the list by the callbacks are triggered from the next frame
+    const size_t count = _frameTimers.size();
+    for (size_t i = 0; i < count; ++i) {
+        auto *timer = _frameTimers[i];
+        if (timer->_state != Timer::State::FRAME) {
+            continue;
+        }
+        if (timer->_interval > 0.F) {
+            // the interval has been updated
+            timer->_deadline = _currentTime + timer->_interval;
+            insertTimer(timer);
+            continue;
         }
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty()) {
-            ++iter;
-            removeHashElement(_currentTarget);
-            if (iter != _hashForTimers.end()) {
-                ++iter;
+        timer->_state = Timer::State::DUE;
+        timer->trigger(dt);
+        timer->_timesExecuted += 1;
+        const bool finished = !timer->_runForever && timer->_timesExecuted > timer->_repeat;
+        if (timer->_state != Timer::State::DUE) {
+            if (finished && timer->_state == Timer::State::PAUSED) {
+                timer->cancel();
             }
-        } else {
-            ++iter;
+            continue;
+        }
+        timer->_state = Timer::State::FRAME;
+        if (finished) {
+            timer->cancel();
         }
     }
+}
 
-    _updateHashLocked = false;
-    _currentTarget = nullptr;
+void Scheduler::startPendingTimers() {
+    for (auto *timer : _pendingTimers) {
+        timer->_listed = false;
+        if (timer->_state == Timer::State::PENDING) {
+            startTimer(timer);
+        } else if (timer->_state == Timer::State::CANCELLED) {
+            recycleTimer(timer);
+        }
+    }
+    _pendingTimers.clear();
+}
+
+void Scheduler::update(float dt) {
+    _currentTime += std::max(dt, 0.F);
+
+    updateFrameTimers(dt);
+
+    // Iterate over the expired custom selectors
+    _timerWheel.advance(toTick(_currentTime), [this](TimerWheel::Node *node) {
+        auto *timer = static_cast<TimerTargetCallback *>(static_cast<Timer *>(node));
+        if (timer->_deadline > _currentTime) {
+            // expires later in the current tick
+            _timerWheel.insert(timer, toTick(timer->_deadline));
+            return;
+        }
+        fireTimer(timer);
+    });
+
+    startPendingTimers();
+
+    auto last = std::remove_if(_frameTimers.begin(), _frameTimers.end(), [this](TimerTargetCallback *timer) {
+        if (timer->_state == Timer::State::FRAME) {
+            return false;
+        }
+        timer->_listed = false;
+        if (timer->_state == Timer::State::CANCELLED) {
+            recycleTimer(timer);
+        }
+        return true;
+    });
+    _frameTimers.erase(last, _frameTimers.end());
+
+    for (auto *timer : _cancelledTimers) {
+        recycleTimer(timer);
+    }
+    _cancelledTimers.clear();
 
     //
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
-    // And almost never there will be functions scheduled to be called.
-    if (!_functionsToPerform.empty()) {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if new functions are added in callback, it will cause thread deadlock.
-        auto temp = _functionsToPerform;
-        _functionsToPerform.clear();
-        _performMutex.unlock();
-        for (const auto &function : temp) {
-            function();
-        }
-    }
+    performFunctions();
 }
 
 } // namespace cc
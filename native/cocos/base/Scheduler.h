@@ -29,9 +29,10 @@
 #pragma once
 
 #include <functional>
-#include <mutex>
+#include <memory>
 
-#include "base/RefCounted.h"
+#include "base/TimerWheel.h"
+#include "base/threading/InlineTask.h"
 #include "base/std/container/set.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
@@ -41,13 +42,25 @@ namespace cc {
 
 class Scheduler;
 
+/**
+ * Lanes of Scheduler::performFunctionInCocosThread.
+ */
+enum class TaskPriority : uint8_t {
+    HIGH,
+    NORMAL,
+    LOW,
+    COUNT,
+};
+
 using ccSchedulerFunc = std::function<void(float)>;
 
 /**
  * @cond
  */
-class CC_DLL Timer : public RefCounted {
+class CC_DLL Timer : private TimerWheel::Node {
 public:
+    virtual ~Timer() = default;
+
     /** get interval in seconds */
     inline float getInterval() const { return _interval; };
     /** set interval in seconds */
@@ -58,20 +71,36 @@ public:
     virtual void trigger(float dt) = 0;
     virtual void cancel() = 0;
 
-    /** triggers the timer */
-    void update(float dt);
-
 protected:
     Timer() = default;
 
     Scheduler *_scheduler = nullptr;
-    float _elapsed = 0.F;
     bool _runForever = false;
     bool _useDelay = false;
     unsigned int _timesExecuted = 0;
     unsigned int _repeat = 0; //0 = once, 1 is 2 x executed
     float _delay = 0.F;
     float _interval = 0.F;
+
+private:
+    friend class Scheduler;
+
+    enum class State : uint8_t {
+        IDLE,      // in the pool of the scheduler
+        PENDING,   // waiting to be started in the next update
+        WHEEL,     // linked in the timer wheel
+        FRAME,     // triggered every frame
+        DUE,       // being triggered
+        PAUSED,    // the target is paused
+        CANCELLED, // unscheduled, recycled once it is released by the scheduler
+    };
+
+    // The time the timer expires at, or the time left while paused.
+    double _deadline{0.0};
+    State _state{State::IDLE};
+    bool _started{false};
+    // Referenced by the pending or per-frame timers of the scheduler.
+    bool _listed{false};
 };
 
 class CC_DLL TimerTargetCallback final : public Timer {
@@ -79,18 +108,23 @@ public:
     TimerTargetCallback() = default;
 
     // Initializes a timer with a target, a lambda and an interval in seconds, repeat in number of times to repeat, delay in seconds.
-    bool initWithCallback(Scheduler *scheduler, const ccSchedulerFunc &callback, void *target, const ccstd::string &key, float seconds, unsigned int repeat, float delay);
+    bool initWithCallback(Scheduler *scheduler, const ccSchedulerFunc &callback, void *target, uint32_t key, float seconds, unsigned int repeat, float delay);
 
     inline const ccSchedulerFunc &getCallback() const { return _callback; };
-    inline const ccstd::string &getKey() const { return _key; };
+    inline void *getTarget() const { return _target; }
+    inline uint32_t getKeyId() const { return _key; };
+    const ccstd::string &getKey() const;
 
     void trigger(float dt) override;
     void cancel() override;
 
+    // Releases the callback before the timer goes back to the pool.
+    void reset();
+
 private:
     void *_target = nullptr;
     ccSchedulerFunc _callback = nullptr;
-    ccstd::string _key;
+    uint32_t _key = 0;
 };
 
 /**
@@ -116,6 +150,9 @@ There are 2 different types of callbacks (selectors):
 
 The 'custom selectors' should be avoided when possible. It is faster, and consumes less memory to use the 'update selector'.
 
+Custom selectors with an interval or a delay are kept in a timer wheel, so an update only touches the ones that expire.
+Their timers are pooled, and keys are interned so that they are compared as integers.
+
 */
 class CC_DLL Scheduler final {
 public:
@@ -172,6 +209,29 @@ public:
      */
     void schedule(const ccSchedulerFunc &callback, void *target, float interval, bool paused, const ccstd::string &key);
 
+    /** Same as the schedule functions above, with a key interned by Scheduler::internKey.
+     @since v3.8.5
+     */
+    void schedule(const ccSchedulerFunc &callback, void *target, float interval, unsigned int repeat, float delay, bool paused, uint32_t key);
+    void schedule(const ccSchedulerFunc &callback, void *target, float interval, bool paused, uint32_t key);
+
+    /** Interns a key, the returned id identifies the key in all the schedulers.
+     The same id is returned for the same string. An empty key is interned as 0.
+     Keys interned here are kept for the lifetime of the program, keys only passed as strings to `schedule`
+     are released when their last timer is unscheduled.
+     This function is not thread safe, it should be called from the cocos thread only.
+     @param key The key to be interned.
+     @return The id of the key.
+     @since v3.8.5
+     */
+    static uint32_t internKey(const ccstd::string &key);
+
+    /** Returns the string of a key interned by Scheduler::internKey. */
+    static const ccstd::string &getKeyName(uint32_t key);
+
+    /** Returns the number of keys currently interned, including the empty key. */
+    static size_t getKeyCount();
+
     /////////////////////////////////////
 
     // unschedule
@@ -183,6 +243,7 @@ public:
      @since v3.0
      */
     void unschedule(const ccstd::string &key, void *target);
+    void unschedule(uint32_t key, void *target);
 
     /** Unschedules all selectors for a given target.
      This also includes the "update" selector.
@@ -217,6 +278,7 @@ public:
      @since v3.0.0
      */
     bool isScheduled(const ccstd::string &key, void *target);
+    bool isScheduled(uint32_t key, void *target);
 
     /////////////////////////////////////
 
@@ -253,12 +315,27 @@ public:
     ccstd::set<void *> pauseAllTargetsWithMinPriority(int minPriority);
 
     /** Calls a function on the cocos2d thread. Useful when you need to call a cocos2d function from another thread.
-     This function is thread safe.
+     This function is thread safe and lock free.
+     HIGH priority functions are all performed in the next frame, NORMAL and LOW ones are performed within
+     the per-frame time budget and the rest are deferred to the following frames.
+     Functions posted by the same thread to the same lane are performed in the order they were posted.
+     There is no order between functions posted by different threads, even if one was posted before the other.
      @param function The function to be run in cocos2d thread.
+     @param priority The lane the function is queued in.
      @since v3.0
      @js NA
      */
-    void performFunctionInCocosThread(const std::function<void()> &function);
+    void performFunctionInCocosThread(InlineTask &&function, TaskPriority priority = TaskPriority::NORMAL);
+
+    /** Sets the time in milliseconds that may be spent per frame performing NORMAL and LOW priority functions.
+     At least one function of each lane is performed per frame, whatever the budget.
+     @js NA
+     */
+    inline void setPerformFunctionTimeBudget(float milliseconds) { _performTimeBudget = milliseconds; }
+    inline float getPerformFunctionTimeBudget() const { return _performTimeBudget; }
+
+    /** Returns the approximate number of functions waiting to be performed. */
+    size_t getPendingFunctionCount() const;
 
     /**
      * Remove all pending functions queued to be performed with Scheduler::performFunctionInCocosThread
@@ -269,34 +346,51 @@ public:
      */
     void removeAllFunctionsToBePerformedInCocosThread();
 
-    bool isCurrentTargetSalvaged() const { return _currentTargetSalvaged; };
-
 private:
     // Hash Element used for "selectors with interval"
     struct HashTimerEntry {
-        ccstd::vector<Timer *> timers;
-        void *target;
-        int timerIndex;
-        Timer *currentTimer;
-        bool currentTimerSalvaged;
-        bool paused;
+        ccstd::vector<TimerTargetCallback *> timers;
+        bool paused{false};
     };
 
-    void removeHashElement(struct HashTimerEntry *element);
+    static uint64_t toTick(double time);
+
     void removeUpdateFromHash(struct _listEntry *entry);
 
+    TimerTargetCallback *acquireTimer();
+    void recycleTimer(TimerTargetCallback *timer);
+    void listTimer(ccstd::vector<TimerTargetCallback *> &timers, TimerTargetCallback *timer);
+    void insertTimer(TimerTargetCallback *timer);
+    void startTimer(TimerTargetCallback *timer);
+    void fireTimer(TimerTargetCallback *timer);
+    void pauseTimer(TimerTargetCallback *timer);
+    void resumeTimer(TimerTargetCallback *timer);
+    void cancelTimer(TimerTargetCallback *timer);
+
+    void updateFrameTimers(float dt);
+    void startPendingTimers();
+
     // update specific
 
     // Used for "selectors with interval"
-    ccstd::unordered_map<void *, HashTimerEntry *> _hashForTimers;
-    struct HashTimerEntry *_currentTarget = nullptr;
-    bool _currentTargetSalvaged = false;
-    // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
-    bool _updateHashLocked = false;
-
-    // Used for "perform Function"
-    ccstd::vector<std::function<void()>> _functionsToPerform;
-    std::mutex _performMutex;
+    ccstd::unordered_map<void *, HashTimerEntry> _hashForTimers;
+    TimerWheel _timerWheel;
+    // Timers scheduled since the last update, they start counting in the next update.
+    ccstd::vector<TimerTargetCallback *> _pendingTimers;
+    // Timers with a 0 interval, triggered every frame.
+    ccstd::vector<TimerTargetCallback *> _frameTimers;
+    // Timers unscheduled while being triggered, recycled at the end of the update.
+    ccstd::vector<TimerTargetCallback *> _cancelledTimers;
+    ccstd::vector<TimerTargetCallback *> _freeTimers;
+    ccstd::vector<std::unique_ptr<TimerTargetCallback[]>> _timerBlocks;
+    double _currentTime{0.0};
+
+    void performFunctions();
+
+    // Used for "perform Function", one lock free queue per lane
+    struct FunctionQueues;
+    std::unique_ptr<FunctionQueues> _functionsToPerform;
+    float _performTimeBudget{5.F};
 };
 
 // end of base group
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/TimerWheel.h"
+
+namespace cc {
+
+TimerWheel::TimerWheel() {
+    for (auto &level : _slots) {
+        for (auto &slot : level) {
+            initList(slot);
+        }
+    }
+    initList(_overflow);
+    initList(_immediate);
+}
+
+void TimerWheel::initList(Node &head) {
+    head.prev = &head;
+    head.next = &head;
+}
+
+void TimerWheel::link(Node &head, Node *node) {
+    node->prev = head.prev;
+    node->next = &head;
+    head.prev->next = node;
+    head.prev = node;
+}
+
+void TimerWheel::unlink(Node *node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+void TimerWheel::splice(Node &from, Node &to) {
+    if (from.next == &from) {
+        initList(to);
+        return;
+    }
+    to.next = from.next;
+    to.prev = from.prev;
+    to.next->prev = &to;
+    to.prev->next = &to;
+    initList(from);
+}
+
+void TimerWheel::insert(Node *node, uint64_t tick) {
+    CC_ASSERT(!node->isLinked());
+    node->tick = tick;
+    if (tick <= _currentTick) {
+        link(_immediate, node);
+    } else {
+        place(node);
+    }
+    ++_size;
+}
+
+void TimerWheel::remove(Node *node) {
+    if (node->isLinked()) {
+        unlink(node);
+        --_size;
+    }
+}
+
+void TimerWheel::place(Node *node) {
+    // The tick isn't before the current one. A node of the current tick is only placed
+    // while cascading, it lands in the level 0 slot that is about to expire.
+    const uint64_t delta = node->tick - _currentTick;
+    for (uint32_t level = 0; level < LEVEL_COUNT; ++level) {
+        const uint32_t shift = SLOT_BITS * level;
+        if (delta < (uint64_t{1} << (shift + SLOT_BITS))) {
+            link(_slots[level][(node->tick >> shift) & (SLOT_COUNT - 1)], node);
+            return;
+        }
+    }
+    link(_overflow, node);
+}
+
+void TimerWheel::cascade(Node &head) {
+    Node nodes;
+    splice(head, nodes);
+    while (nodes.next != &nodes) {
+        Node *node = nodes.next;
+        unlink(node);
+        place(node);
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,138 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * A hierarchical timing wheel.
+ * Nodes are linked into the slot of the tick they expire at, so advancing the wheel only touches the expiring nodes
+ * and the slots of the higher levels that are cascaded down once per rotation of the lower level.
+ * The nodes are intrusive and owned by the caller, inserting and removing them never allocates.
+ */
+class CC_DLL TimerWheel final {
+public:
+    struct Node {
+        Node *prev{nullptr};
+        Node *next{nullptr};
+        uint64_t tick{0};
+
+        inline bool isLinked() const { return next != nullptr; }
+    };
+
+    static constexpr uint32_t SLOT_BITS{8};
+    static constexpr uint32_t SLOT_COUNT{1U << SLOT_BITS};
+    static constexpr uint32_t LEVEL_COUNT{4};
+
+    TimerWheel();
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel(TimerWheel &&) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+    TimerWheel &operator=(TimerWheel &&) = delete;
+    ~TimerWheel() = default;
+
+    /**
+     * Links the node to expire at the given tick.
+     * A tick that is not after the current one expires in the next call to advance.
+     */
+    void insert(Node *node, uint64_t tick);
+    void remove(Node *node);
+
+    /**
+     * Moves the wheel to the given tick and calls onExpired with each node that expired in between.
+     * The node is unlinked before the call, onExpired may insert or remove any node.
+     */
+    template <typename F>
+    void advance(uint64_t tick, F &&onExpired);
+
+    inline uint64_t getCurrentTick() const { return _currentTick; }
+    inline size_t size() const { return _size; }
+    inline bool empty() const { return _size == 0; }
+
+private:
+    static void initList(Node &head);
+    static void link(Node &head, Node *node);
+    static void unlink(Node *node);
+    static void splice(Node &from, Node &to);
+
+    void place(Node *node);
+    void cascade(Node &head);
+
+    template <typename F>
+    void expire(Node &head, F &onExpired);
+
+    std::array<std::array<Node, SLOT_COUNT>, LEVEL_COUNT> _slots;
+    // nodes past the range of the highest level
+    Node _overflow;
+    // nodes inserted with a tick that isn't after the current one
+    Node _immediate;
+    uint64_t _currentTick{0};
+    size_t _size{0};
+};
+
+template <typename F>
+void TimerWheel::expire(Node &head, F &onExpired) {
+    Node expired;
+    splice(head, expired);
+    while (expired.next != &expired) {
+        Node *node = expired.next;
+        unlink(node);
+        --_size;
+        onExpired(node);
+    }
+}
+
+template <typename F>
+void TimerWheel::advance(uint64_t tick, F &&onExpired) {
+    expire(_immediate, onExpired);
+    if (_size == 0) {
+        _currentTick = std::max(_currentTick, tick);
+        return;
+    }
+
+    constexpr uint64_t SLOT_MASK{SLOT_COUNT - 1};
+    while (_currentTick < tick) {
+        ++_currentTick;
+        for (uint32_t level = 1; level < LEVEL_COUNT; ++level) {
+            const uint32_t shift = SLOT_BITS * level;
+            if ((_currentTick & ((uint64_t{1} << shift) - 1)) != 0) {
+                break;
+            }
+            cascade(_slots[level][(_currentTick >> shift) & SLOT_MASK]);
+        }
+        if ((_currentTick & ((uint64_t{1} << (SLOT_BITS * LEVEL_COUNT)) - 1)) == 0) {
+            cascade(_overflow);
+        }
+        expire(_slots[0][_currentTick & SLOT_MASK], onExpired);
+    }
+}
+
+} // namespace cc
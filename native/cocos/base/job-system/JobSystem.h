@@ -49,3 +49,26 @@ using JobGraph = DummyJobGraph;
 using JobSystem = DummyJobSystem;
 } // namespace cc
 #endif
+
+namespace cc {
+
+/**
+ * Runs func(0) .. func(count - 1) on the job system and waits for all of them, the calling thread takes index 0.
+ * The indices run in order on the calling thread if there is only one of them or only one worker.
+ */
+template <typename Function>
+void parallelFor(uint32_t count, const Function &func) {
+    if (count > 1 && JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph graph(JobSystem::getInstance());
+        graph.createForEachIndexJob(1U, count, 1U, func);
+        graph.run();
+        func(0U);
+        graph.waitForAll();
+        return;
+    }
+    for (uint32_t i = 0; i != count; ++i) {
+        func(i);
+    }
+}
+
+} // namespace cc
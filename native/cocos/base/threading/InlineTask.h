@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "base/Macros.h"
+
+namespace cc {
+
+// A move-only void() callable for tasks handed over between threads.
+// Callables that fit the inline storage are stored in place, so posting a small lambda doesn't allocate.
+class InlineTask final {
+public:
+    static constexpr size_t INLINE_SIZE = 56;
+
+    InlineTask() noexcept = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, InlineTask>::value && std::is_invocable<std::decay_t<F> &>::value>>
+    InlineTask(F &&function) { // NOLINT(google-explicit-constructor)
+        using T = std::decay_t<F>;
+        if constexpr (sizeof(T) <= INLINE_SIZE && alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<T>::value) {
+            new (_storage) T(std::forward<F>(function));
+            _ops = &InlineOps<T>::OPS;
+        } else {
+            *reinterpret_cast<T **>(_storage) = new T(std::forward<F>(function));
+            _ops = &HeapOps<T>::OPS;
+        }
+    }
+
+    InlineTask(InlineTask &&other) noexcept {
+        moveFrom(other);
+    }
+
+    InlineTask &operator=(InlineTask &&other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InlineTask(const InlineTask &) = delete;
+    InlineTask &operator=(const InlineTask &) = delete;
+
+    ~InlineTask() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept { return _ops != nullptr; }
+
+    inline bool isInline() const noexcept { return _ops != nullptr && _ops->isInline; }
+
+    void operator()() {
+        CC_ASSERT(_ops);
+        _ops->invoke(_storage);
+    }
+
+    void reset() noexcept {
+        if (_ops != nullptr) {
+            _ops->destroy(_storage);
+            _ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void *storage);
+        // move constructs into dst and destroys src
+        void (*relocate)(void *dst, void *src) noexcept;
+        void (*destroy)(void *storage) noexcept;
+        bool isInline;
+    };
+
+    template <typename T>
+    struct InlineOps {
+        static void invoke(void *storage) { (*static_cast<T *>(storage))(); }
+        static void relocate(void *dst, void *src) noexcept {
+            new (dst) T(std::move(*static_cast<T *>(src)));
+            static_cast<T *>(src)->~T();
+        }
+        static void destroy(void *storage) noexcept { static_cast<T *>(storage)->~T(); }
+        static constexpr Ops OPS{invoke, relocate, destroy, true};
+    };
+
+    template <typename T>
+    struct HeapOps {
+        static void invoke(void *storage) { (**static_cast<T **>(storage))(); }
+        static void relocate(void *dst, void *src) noexcept { *static_cast<T **>(dst) = *static_cast<T **>(src); }
+        static void destroy(void *storage) noexcept { delete *static_cast<T **>(storage); }
+        static constexpr Ops OPS{invoke, relocate, destroy, false};
+    };
+
+    void moveFrom(InlineTask &other) noexcept {
+        if (other._ops != nullptr) {
+            other._ops->relocate(_storage, other._storage);
+            _ops = other._ops;
+            other._ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char _storage[INLINE_SIZE];
+    const Ops *_ops{nullptr};
+};
+
+template <typename T>
+constexpr InlineTask::Ops InlineTask::InlineOps<T>::OPS;
+
+template <typename T>
+constexpr InlineTask::Ops InlineTask::HeapOps<T>::OPS;
+
+} // namespace cc
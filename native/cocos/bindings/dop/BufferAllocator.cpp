@@ -34,32 +34,24 @@ BufferAllocator::BufferAllocator(PoolType type)
 
 BufferAllocator::~BufferAllocator() {
     for (auto buffer : _buffers) {
-        buffer.second->decRef();
+        delete buffer.second;
     }
     _buffers.clear();
 }
 
 se::Object *BufferAllocator::alloc(uint32_t index, uint32_t bytes) {
-    if (_buffers.count(index)) {
-        se::Object *oldObj = _buffers[index];
-        oldObj->decRef();
-    }
-    se::Object *obj = se::Object::createArrayBufferObject(nullptr, bytes);
-
-    _buffers[index] = obj;
-
-    uint8_t *ret = nullptr;
-    size_t len;
-    obj->getArrayBufferData(static_cast<uint8_t **>(&ret), &len);
-
-    return obj;
+    free(index);
+    // chunks never grow, reserve exactly what is needed
+    auto *buffer = ccnew ScriptBuffer(bytes, bytes);
+    _buffers[index] = buffer;
+    return buffer->getArrayBuffer();
 }
 
 void BufferAllocator::free(uint32_t index) {
-    if (_buffers.count(index)) {
-        se::Object *oldObj = _buffers[index];
-        oldObj->decRef();
-        _buffers.erase(index);
+    auto iter = _buffers.find(index);
+    if (iter != _buffers.end()) {
+        delete iter->second;
+        _buffers.erase(iter);
     }
 }
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "PoolType.h"
+#include "ScriptBufferArena.h"
 #include "cocos/base/Macros.h"
 #include "cocos/base/std/container/unordered_map.h"
 #include "cocos/bindings/jswrapper/Object.h"
@@ -39,10 +40,15 @@ public:
     se::Object *alloc(uint32_t index, uint32_t bytes);
     void free(uint32_t index);
 
+    inline ScriptBuffer *getBuffer(uint32_t index) const {
+        auto iter = _buffers.find(index);
+        return iter != _buffers.end() ? iter->second : nullptr;
+    }
+
 private:
     static constexpr uint32_t BUFFER_MASK = ~(1 << 30);
 
-    ccstd::unordered_map<uint32_t, se::Object *> _buffers;
+    ccstd::unordered_map<uint32_t, ScriptBuffer *> _buffers;
     PoolType _type = PoolType::UNKNOWN;
 };
 
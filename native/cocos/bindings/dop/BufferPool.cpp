@@ -43,12 +43,11 @@ BufferPool::BufferPool(PoolType type, uint32_t entryBits, uint32_t bytesPerEntry
 BufferPool::~BufferPool() = default;
 
 se::Object *BufferPool::allocateNewChunk() {
-    se::Object *jsObj = _allocator.alloc(static_cast<uint32_t>(_chunks.size()), _bytesPerChunk);
+    const auto index = static_cast<uint32_t>(_chunks.size());
+    se::Object *jsObj = _allocator.alloc(index, _bytesPerChunk);
 
-    uint8_t *realPtr = nullptr;
-    size_t len = 0;
-    jsObj->getArrayBufferData(&realPtr, &len);
-    _chunks.push_back(realPtr);
+    // chunks never grow, the native address of the arena buffer stays valid
+    _chunks.push_back(_allocator.getBuffer(index)->getData());
 
     return jsObj;
 }
@@ -0,0 +1,346 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "ScriptBufferArena.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Log.h"
+#include "base/memory/Memory.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    #include <Windows.h>
+    #define CC_SCRIPT_BUFFER_VIRTUAL_MEMORY 1
+#elif CC_PLATFORM == CC_PLATFORM_EMSCRIPTEN
+    #define CC_SCRIPT_BUFFER_VIRTUAL_MEMORY 0
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #define CC_SCRIPT_BUFFER_VIRTUAL_MEMORY 1
+#endif
+
+namespace se {
+
+namespace {
+
+// reservation of buffers created without a max length
+constexpr uint32_t DEFAULT_RESERVE_SCALE{4};
+
+uint32_t getPageSize() {
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    static const uint32_t pageSize = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        // reservations are aligned to the allocation granularity
+        return static_cast<uint32_t>(std::max(info.dwPageSize, info.dwAllocationGranularity));
+    }();
+#elif CC_SCRIPT_BUFFER_VIRTUAL_MEMORY
+    static const auto pageSize = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+#else
+    static const uint32_t pageSize = 4096;
+#endif
+    return pageSize;
+}
+
+uint32_t alignUp(uint32_t value, uint32_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint8_t *reserveMemory(uint32_t bytes) {
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    return static_cast<uint8_t *>(VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS));
+#elif CC_SCRIPT_BUFFER_VIRTUAL_MEMORY
+    void *ptr = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : static_cast<uint8_t *>(ptr);
+#else
+    CC_UNUSED_PARAM(bytes);
+    return nullptr;
+#endif
+}
+
+bool commitMemory(uint8_t *ptr, uint32_t bytes) {
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    return VirtualAlloc(ptr, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#elif CC_SCRIPT_BUFFER_VIRTUAL_MEMORY
+    return mprotect(ptr, bytes, PROT_READ | PROT_WRITE) == 0;
+#else
+    CC_UNUSED_PARAM(ptr);
+    CC_UNUSED_PARAM(bytes);
+    return false;
+#endif
+}
+
+void releaseMemory(uint8_t *ptr, uint32_t bytes) {
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    CC_UNUSED_PARAM(bytes);
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#elif CC_SCRIPT_BUFFER_VIRTUAL_MEMORY
+    munmap(ptr, bytes);
+#else
+    CC_UNUSED_PARAM(ptr);
+    CC_UNUSED_PARAM(bytes);
+#endif
+}
+
+} // namespace
+
+ScriptBuffer::ScriptBuffer(uint32_t byteLength, uint32_t maxByteLength)
+: _byteLength(byteLength) {
+    if (maxByteLength == 0) {
+        maxByteLength = byteLength * DEFAULT_RESERVE_SCALE;
+    }
+    _block = allocateBlock(byteLength, std::max(byteLength, maxByteLength));
+    ScriptBufferArena::getInstance().add(this);
+}
+
+ScriptBuffer::~ScriptBuffer() {
+    releaseView();
+    ScriptBufferArena::getInstance().remove(this);
+    detachBlock();
+}
+
+ScriptBuffer::Block *ScriptBuffer::allocateBlock(uint32_t byteLength, uint32_t maxByteLength) {
+    auto *block = ccnew Block;
+    const uint32_t pageSize = getPageSize();
+    // small buffers don't deserve pages of their own
+    if (maxByteLength >= pageSize) {
+        const uint32_t reserved = alignUp(maxByteLength, pageSize);
+        block->data = reserveMemory(reserved);
+        if (block->data != nullptr) {
+            block->reserved = reserved;
+            block->isVirtual = true;
+            if (!commitBlock(block, byteLength)) {
+                releaseMemory(block->data, block->reserved);
+                block->data = nullptr;
+                block->isVirtual = false;
+            }
+        }
+    }
+    if (block->data == nullptr) {
+        // zero initialized like freshly committed pages
+        block->reserved = std::max(maxByteLength, 1U);
+        block->committed = block->reserved;
+        block->data = static_cast<uint8_t *>(calloc(block->reserved, 1));
+        CC_ASSERT_NOT_NULL(block->data);
+    }
+
+    auto &stats = ScriptBufferArena::getInstance().getStatistics();
+    stats.reservedBytes += block->reserved;
+    if (!block->isVirtual) {
+        // pages of a reservation are accounted by commitBlock
+        stats.committedBytes += block->committed;
+    }
+    return block;
+}
+
+bool ScriptBuffer::commitBlock(Block *block, uint32_t byteLength) {
+    if (byteLength <= block->committed) {
+        return true;
+    }
+    if (byteLength > block->reserved) {
+        return false;
+    }
+    const uint32_t committed = std::min(alignUp(byteLength, getPageSize()), block->reserved);
+    if (!commitMemory(block->data + block->committed, committed - block->committed)) {
+        return false;
+    }
+    ScriptBufferArena::getInstance().getStatistics().committedBytes += committed - block->committed;
+    block->committed = committed;
+    return true;
+}
+
+void ScriptBuffer::releaseBlock(Block *block) {
+    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    if (block->isVirtual) {
+        releaseMemory(block->data, block->reserved);
+    } else {
+        free(block->data);
+    }
+    delete block;
+}
+
+void ScriptBuffer::detachBlock() {
+    // views may release the block on the GC thread, so memory is accounted until the owner drops it
+    auto &stats = ScriptBufferArena::getInstance().getStatistics();
+    stats.reservedBytes -= _block->reserved;
+    stats.committedBytes -= _block->committed;
+    releaseBlock(_block);
+    _block = nullptr;
+}
+
+/* static */
+void ScriptBuffer::onViewFreed(void * /*contents*/, size_t /*byteLength*/, void *userData) {
+    releaseBlock(static_cast<Block *>(userData));
+}
+
+void ScriptBuffer::resize(uint32_t byteLength) {
+    if (byteLength <= _byteLength) {
+        return;
+    }
+    auto &stats = ScriptBufferArena::getInstance().getStatistics();
+    if (commitBlock(_block, byteLength)) {
+        ++stats.growCount;
+    } else {
+        // beyond the reservation, reserve twice as much for the next growth
+        Block *block = allocateBlock(byteLength, std::max(byteLength, _block->reserved * 2));
+        memcpy(block->data, _block->data, _byteLength);
+        detachBlock();
+        _block = block;
+        ++stats.moveCount;
+    }
+    _byteLength = byteLength;
+    markChanged();
+}
+
+void ScriptBuffer::markChanged() {
+    ++_generation;
+    ScriptBufferArena::getInstance().setGeneration(this);
+}
+
+Object *ScriptBuffer::getArrayBuffer() {
+    return getView(Object::TypedArrayType::NONE);
+}
+
+Object *ScriptBuffer::getTypedArray(Object::TypedArrayType type) {
+    CC_ASSERT(type != Object::TypedArrayType::NONE);
+    return getView(type);
+}
+
+Object *ScriptBuffer::getView(Object::TypedArrayType type) {
+    auto &stats = ScriptBufferArena::getInstance().getStatistics();
+    if (_view != nullptr && _viewType == type && _viewGeneration == _generation) {
+        ++stats.viewsReused;
+        return _view;
+    }
+    releaseView();
+
+    AutoHandleScope hs;
+    // released by the script engine once the view is garbage collected
+    _block->refs.fetch_add(1, std::memory_order_relaxed);
+    Object *arrayBuffer = Object::createExternalArrayBufferObject(_block->data, _byteLength, onViewFreed, _block);
+    if (arrayBuffer == nullptr) {
+        releaseBlock(_block);
+        return nullptr;
+    }
+    if (type == Object::TypedArrayType::NONE) {
+        _view = arrayBuffer;
+    } else {
+        _view = Object::createTypedArrayWithBuffer(type, arrayBuffer);
+        arrayBuffer->decRef();
+    }
+    _view->root();
+    _viewType = type;
+    _viewGeneration = _generation;
+    ++stats.viewsCreated;
+    return _view;
+}
+
+void ScriptBuffer::releaseView() {
+    if (_view == nullptr) {
+        return;
+    }
+    _view->unroot();
+    _view->decRef();
+    _view = nullptr;
+    _viewGeneration = 0;
+}
+
+/* static */
+ScriptBufferArena &ScriptBufferArena::getInstance() {
+    static ScriptBufferArena instance;
+    return instance;
+}
+
+ScriptBufferArena::ScriptBufferArena()
+: _generations(GENERATION_TABLE_SIZE, 0) {
+    _scriptEngineListener.bind([this](cc::ScriptEngineEvent event) {
+        // script objects are invalid after cleanup, views are created again on demand
+        if (event == cc::ScriptEngineEvent::BEFORE_CLEANUP) {
+            releaseViews();
+        }
+    });
+}
+
+ScriptBufferArena::~ScriptBufferArena() = default;
+
+void ScriptBufferArena::add(ScriptBuffer *buffer) {
+    if (!_freeSlots.empty()) {
+        buffer->_slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _buffers[buffer->_slot] = buffer;
+    } else {
+        buffer->_slot = static_cast<uint32_t>(_buffers.size());
+        _buffers.push_back(buffer);
+    }
+    if (buffer->_slot < GENERATION_TABLE_SIZE) {
+        // continue the generation of the previous buffer in the slot, views of it never look current
+        buffer->_generation = _generations[buffer->_slot] + 1;
+    }
+    ++_statistics.bufferCount;
+    setGeneration(buffer);
+}
+
+void ScriptBufferArena::remove(ScriptBuffer *buffer) {
+    CC_ASSERT(buffer->_slot < _buffers.size() && _buffers[buffer->_slot] == buffer);
+    _buffers[buffer->_slot] = nullptr;
+    _freeSlots.push_back(buffer->_slot);
+    buffer->_slot = ScriptBuffer::INVALID_SLOT;
+    --_statistics.bufferCount;
+}
+
+void ScriptBufferArena::setGeneration(const ScriptBuffer *buffer) {
+    // buffers beyond the table are still valid, scripts have to fetch their view from native
+    if (buffer->_slot < GENERATION_TABLE_SIZE) {
+        _generations[buffer->_slot] = buffer->_generation;
+    }
+}
+
+Object *ScriptBufferArena::getGenerationTable() {
+    if (_generationTable == nullptr) {
+        AutoHandleScope hs;
+        // the table lives as long as the process, nothing to free
+        Object *arrayBuffer = Object::createExternalArrayBufferObject(_generations.data(), _generations.size() * sizeof(uint32_t), [](void * /*contents*/, size_t /*byteLength*/, void * /*userData*/) {});
+        _generationTable = Object::createTypedArrayWithBuffer(Object::TypedArrayType::UINT32, arrayBuffer);
+        arrayBuffer->decRef();
+        _generationTable->root();
+    }
+    return _generationTable;
+}
+
+void ScriptBufferArena::releaseViews() {
+    for (auto *buffer : _buffers) {
+        if (buffer != nullptr) {
+            buffer->releaseView();
+        }
+    }
+    if (_generationTable != nullptr) {
+        _generationTable->unroot();
+        _generationTable->decRef();
+        _generationTable = nullptr;
+    }
+}
+
+} // namespace se
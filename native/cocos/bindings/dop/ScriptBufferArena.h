@@ -0,0 +1,164 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include "cocos/base/Macros.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/bindings/jswrapper/Object.h"
+#include "cocos/engine/EngineEvents.h"
+
+namespace se {
+
+/**
+ * Native memory shared with scripts.
+ * The memory is a virtual reservation which is committed on demand, growing a buffer inside its reservation
+ * doesn't move the data, so native pointers stay valid and only the script view has to be created again.
+ * The generation increases every time the script view becomes stale, scripts compare it with the generation
+ * of their view in jsb.scriptBufferGenerations to detect changes without crossing the binding.
+ */
+class CC_DLL ScriptBuffer final {
+public:
+    static constexpr uint32_t INVALID_SLOT{0xFFFFFFFF};
+
+    /**
+     * @param byteLength Initial length in bytes, the memory is zero initialized.
+     * @param maxByteLength Bytes to reserve, the buffer moves only if it grows beyond the reservation.
+     *                      0 reserves a few times of the initial length.
+     */
+    explicit ScriptBuffer(uint32_t byteLength, uint32_t maxByteLength = 0);
+    ~ScriptBuffer();
+    ScriptBuffer(const ScriptBuffer &) = delete;
+    ScriptBuffer &operator=(const ScriptBuffer &) = delete;
+
+    inline uint8_t *getData() const { return _block->data; }
+    inline uint32_t getByteLength() const { return _byteLength; }
+    inline uint32_t getReservedLength() const { return _block->reserved; }
+    inline uint32_t getGeneration() const { return _generation; }
+    inline uint32_t getSlot() const { return _slot; }
+
+    /**
+     * @brief Grows the buffer, the content is preserved.
+     * @note The data pointer changes only if the buffer grows beyond its reservation.
+     */
+    void resize(uint32_t byteLength);
+
+    /**
+     * @brief Gets an ArrayBuffer over the whole buffer, it's created again only after the buffer grows.
+     */
+    Object *getArrayBuffer();
+
+    /**
+     * @brief Gets a typed array over the whole buffer, it's created again only after the buffer grows or the type changes.
+     */
+    Object *getTypedArray(Object::TypedArrayType type);
+
+    /**
+     * @brief Releases the script view, the memory is kept alive until scripts don't reference the view anymore.
+     */
+    void releaseView();
+
+private:
+    struct Block {
+        uint8_t *data{nullptr};
+        uint32_t reserved{0};
+        uint32_t committed{0};
+        bool isVirtual{false};
+        // held by the owner and every script view
+        std::atomic<uint32_t> refs{1};
+    };
+
+    static Block *allocateBlock(uint32_t byteLength, uint32_t maxByteLength);
+    static bool commitBlock(Block *block, uint32_t byteLength);
+    static void releaseBlock(Block *block);
+    static void onViewFreed(void *contents, size_t byteLength, void *userData);
+
+    void detachBlock();
+    Object *getView(Object::TypedArrayType type);
+    void markChanged();
+
+    Block *_block{nullptr};
+    uint32_t _byteLength{0};
+    uint32_t _generation{1};
+    uint32_t _slot{INVALID_SLOT};
+
+    Object *_view{nullptr};
+    Object::TypedArrayType _viewType{Object::TypedArrayType::NONE};
+    uint32_t _viewGeneration{0};
+
+    friend class ScriptBufferArena;
+};
+
+/**
+ * Tracks all ScriptBuffers, owns the generation table shared with scripts and collects statistics.
+ */
+class CC_DLL ScriptBufferArena final {
+public:
+    struct Statistics {
+        uint32_t bufferCount{0};
+        uint64_t reservedBytes{0};
+        uint64_t committedBytes{0};
+        // growths inside the reservation
+        uint32_t growCount{0};
+        // growths beyond the reservation, the data is copied
+        uint32_t moveCount{0};
+        uint32_t viewsCreated{0};
+        uint32_t viewsReused{0};
+    };
+
+    static constexpr uint32_t GENERATION_TABLE_SIZE{4096};
+
+    static ScriptBufferArena &getInstance();
+
+    /**
+     * @brief Gets a Uint32Array whose element at ScriptBuffer::getSlot() is the generation of the buffer.
+     */
+    Object *getGenerationTable();
+
+    inline const Statistics &getStatistics() const { return _statistics; }
+    inline Statistics &getStatistics() { return _statistics; }
+
+private:
+    ScriptBufferArena();
+    ~ScriptBufferArena();
+
+    void add(ScriptBuffer *buffer);
+    void remove(ScriptBuffer *buffer);
+    void setGeneration(const ScriptBuffer *buffer);
+    void releaseViews();
+
+    ccstd::vector<ScriptBuffer *> _buffers;
+    ccstd::vector<uint32_t> _freeSlots;
+    // fixed size, the script view refers to its memory
+    ccstd::vector<uint32_t> _generations;
+    Object *_generationTable{nullptr};
+    Statistics _statistics;
+
+    cc::events::ScriptEngine::Listener _scriptEngineListener;
+
+    friend class ScriptBuffer;
+};
+
+} // namespace se
@@ -26,6 +26,7 @@
 
 #include "BufferAllocator.h"
 #include "BufferPool.h"
+#include "ScriptBufferArena.h"
 #include "cocos/bindings/manual/jsb_classtype.h"
 #include "cocos/bindings/manual/jsb_conversions.h"
 #include "cocos/bindings/manual/jsb_global.h"
@@ -181,5 +182,8 @@ bool register_all_dop_bindings(se::Object *obj) { // NOLINT
 
     js_register_se_BufferAllocator(ns); // NOLINT
     js_register_se_BufferPool(ns);      // NOLINT
+
+    // generations of native buffers shared with scripts, indexed by buffer slot
+    ns->setProperty("scriptBufferGenerations", se::Value(se::ScriptBufferArena::getInstance().getGenerationTable()));
     return true;
 }
@@ -33,10 +33,15 @@
     #include "Object.h"
     #include "Utils.h"
     #include "base/Log.h"
+    #include "base/ThreadPool.h"
     #include "base/std/container/unordered_map.h"
     #include "platform/FileUtils.h"
     #include "plugins/bus/EventBus.h"
 
+    #include <algorithm>
+    #include <condition_variable>
+    #include <cstdio>
+    #include <mutex>
     #include <sstream>
 
     #if SE_ENABLE_INSPECTOR
@@ -268,6 +273,51 @@ public:
 
 ScriptEngineV8Context *gSharedV8 = nullptr;
     #endif // CC_EDITOR
+
+const uint32_t CODE_CACHE_MAGIC = 0x43434a53; // "CCJS"
+const uint32_t CODE_CACHE_VERSION = 2;
+
+struct CodeCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sourceLength;
+    uint32_t dataLength;
+    uint64_t sourceHash;
+};
+
+// 64 bit FNV-1a, the cache is trusted by its hash so a 32 bit ccstd::hash_t is not enough
+uint64_t hashBytes(uint64_t hash, const char *data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t hashScript(const ccstd::string &script) {
+    const char *version = v8::V8::GetVersion();
+    uint64_t hash = hashBytes(0xcbf29ce484222325ULL, version, strlen(version));
+    return hashBytes(hash, script.data(), script.length());
+}
+
+bool endsWith(const ccstd::string &str, const char *suffix) {
+    const size_t length = strlen(suffix);
+    return str.size() >= length && str.compare(str.size() - length, length, suffix) == 0;
+}
+
+// V8 on Windows is a dll with its own heap, `delete` from here would free the CachedData on the wrong heap.
+// The exported destructor still releases the code buffer inside the dll, only the small object itself is left.
+void destroyCachedData(v8::ScriptCompiler::CachedData *cd) {
+    #if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    cd->~CachedData();
+    #else
+    delete cd;
+    #endif
+}
+
+double elapsedMilliseconds(const std::chrono::steady_clock::time_point &begin, const std::chrono::steady_clock::time_point &end) {
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
 } // namespace
 
 ScriptEngine *ScriptEngine::instance = nullptr;
@@ -623,6 +673,9 @@ bool ScriptEngine::init(v8::Isolate *isolate) {
     cleanup();
     SE_LOGD("Initializing V8, version: %s\n", v8::V8::GetVersion());
     ++_vmId;
+    _codeCacheStatistics = {};
+    _startupTime = 0.0;
+    _isStartupFinished = false;
 
     _engineThreadId = std::this_thread::get_id();
 
@@ -703,6 +756,10 @@ void ScriptEngine::cleanup() {
         }
     #endif
 
+        // caches not serialized yet are dropped, files being written are completed
+        _pendingCodeCaches.clear();
+        flushCodeCaches();
+
         _context.Get(_isolate)->Exit();
         _context.Reset();
         _isolate->Exit();
@@ -866,6 +923,8 @@ bool ScriptEngine::evalString(const char *script, uint32_t length /* = 0 */, Val
         length = static_cast<uint32_t>(strlen(script));
     }
 
+    // only scripts loaded from files are cached, snippets evaluated by native code are not worth it
+    const bool useCodeCache = fileName != nullptr && !_codeCacheDir.empty();
     if (fileName == nullptr) {
         fileName = "(no filename)";
     }
@@ -893,7 +952,12 @@ bool ScriptEngine::evalString(const char *script, uint32_t length /* = 0 */, Val
     }
 
     v8::ScriptOrigin origin(_isolate, originStr.ToLocalChecked());
-    v8::MaybeLocal<v8::Script> maybeScript = v8::Script::Compile(_context.Get(_isolate), source.ToLocalChecked(), &origin);
+    CodeCacheEntry cacheEntry;
+    auto compileBegin = std::chrono::steady_clock::now();
+    v8::MaybeLocal<v8::Script> maybeScript = useCodeCache ? compileWithCodeCache(source.ToLocalChecked(), origin, fileName, scriptStr, &cacheEntry)
+                                                          : v8::Script::Compile(_context.Get(_isolate), source.ToLocalChecked(), &origin);
+    auto runBegin = std::chrono::steady_clock::now();
+    _codeCacheStatistics.compileTime += elapsedMilliseconds(compileBegin, runBegin);
 
     bool success = false;
 
@@ -901,7 +965,15 @@ bool ScriptEngine::evalString(const char *script, uint32_t length /* = 0 */, Val
         v8::TryCatch block(_isolate);
 
         v8::Local<v8::Script> v8Script = maybeScript.ToLocalChecked();
+        // serialized by mainLoopUpdate, a script evaluated twice before that is queued once
+        if (!cacheEntry.path.empty() &&
+            std::none_of(_pendingCodeCaches.begin(), _pendingCodeCaches.end(), [&](const PendingCodeCache &pending) {
+                return pending.entry.path == cacheEntry.path;
+            })) {
+            _pendingCodeCaches.push_back({v8::Global<v8::UnboundScript>(_isolate, v8Script->GetUnboundScript()), std::move(cacheEntry)});
+        }
         v8::MaybeLocal<v8::Value> maybeResult = v8Script->Run(_context.Get(_isolate));
+        _codeCacheStatistics.runTime += elapsedMilliseconds(runBegin, std::chrono::steady_clock::now());
 
         if (!maybeResult.IsEmpty()) {
             v8::Local<v8::Value> result = maybeResult.ToLocalChecked();
@@ -1002,12 +1074,7 @@ bool ScriptEngine::saveByteCodeToFile(const ccstd::string &path, const ccstd::st
             SE_LOGE("ScriptEngine::generateByteCode write %s\n", pathBc.c_str());
         }
 
-        // TODO(PatriceJiang): v8 on windows is built with dynamic library (dll),
-        // Invoking `delete` for the memory allocated in v8.dll will cause crash.
-        // Need to modify v8 source code and add v8::ScriptCompiler::DestroyCodeCache(v8::ScriptCompiler::CachedData *cd).
-    #if CC_PLATFORM != CC_PLATFORM_WINDOWS
-        delete cd;
-    #endif
+        destroyCachedData(cd);
     } else {
         success = false;
     }
@@ -1015,6 +1082,158 @@ bool ScriptEngine::saveByteCodeToFile(const ccstd::string &path, const ccstd::st
     return success;
 }
 
+void ScriptEngine::setCodeCacheDirectory(const ccstd::string &dir) {
+    flushCodeCaches();
+    _codeCacheDir = dir;
+    if (_codeCacheDir.empty()) {
+        return;
+    }
+    if (_codeCacheDir.back() != '/') {
+        _codeCacheDir.push_back('/');
+    }
+    auto *fu = cc::FileUtils::getInstance();
+    if (!fu->isDirectoryExist(_codeCacheDir) && !fu->createDirectory(_codeCacheDir)) {
+        SE_LOGE("ScriptEngine::setCodeCacheDirectory failed to create %s, code cache is disabled\n", _codeCacheDir.c_str());
+        _codeCacheDir.clear();
+        return;
+    }
+
+    // caches of older formats and temporary files of interrupted writes are never read again
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".v%u.jscc", CODE_CACHE_VERSION);
+    for (const auto &file : fu->listFiles(_codeCacheDir)) {
+        if (endsWith(file, ".tmp") || (endsWith(file, ".jscc") && !endsWith(file, suffix))) {
+            fu->removeFile(file);
+        }
+    }
+}
+
+void ScriptEngine::markStartupFinished() {
+    if (_isStartupFinished) {
+        return;
+    }
+    _isStartupFinished = true;
+    _startupTime = elapsedMilliseconds(_startTime, std::chrono::steady_clock::now());
+
+    SE_LOGD("ScriptEngine startup finished in %.2f ms, compile: %.2f ms, run: %.2f ms, code cache hits: %u, misses: %u, rejected: %u\n",
+            _startupTime, _codeCacheStatistics.compileTime, _codeCacheStatistics.runTime,
+            _codeCacheStatistics.hits, _codeCacheStatistics.misses, _codeCacheStatistics.rejected);
+}
+
+v8::MaybeLocal<v8::Script> ScriptEngine::compileWithCodeCache(v8::Local<v8::String> source, v8::ScriptOrigin &origin, const char *fileName, const ccstd::string &script, CodeCacheEntry *entry) {
+    // one cache file per script file, the cache of an older version of the script is replaced
+    const uint64_t hash = hashScript(script);
+    char cacheName[40];
+    snprintf(cacheName, sizeof(cacheName), "%016llx.v%u.jscc",
+             static_cast<unsigned long long>(hashBytes(0xcbf29ce484222325ULL, fileName, strlen(fileName))), CODE_CACHE_VERSION);
+    ccstd::string path = _codeCacheDir + cacheName;
+
+    auto *fu = cc::FileUtils::getInstance();
+    cc::Data cacheData;
+    const CodeCacheHeader *header = nullptr;
+    if (fu->isFileExist(path) && fu->getContents(path, &cacheData) == cc::FileUtils::Status::OK && cacheData.getSize() >= sizeof(CodeCacheHeader)) {
+        header = reinterpret_cast<const CodeCacheHeader *>(cacheData.getBytes());
+        if (header->magic != CODE_CACHE_MAGIC || header->version != CODE_CACHE_VERSION ||
+            header->sourceLength != script.length() || header->sourceHash != hash ||
+            header->dataLength != cacheData.getSize() - sizeof(CodeCacheHeader)) {
+            header = nullptr;
+        }
+    }
+
+    entry->sourceHash = hash;
+    entry->sourceLength = static_cast<uint32_t>(script.length());
+
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    if (header == nullptr) {
+        ++_codeCacheStatistics.misses;
+        entry->path = std::move(path);
+        return v8::Script::Compile(context, source, &origin);
+    }
+
+    // the buffer isn't owned by CachedData, cacheData outlives the compilation
+    auto *v8CacheData = ccnew v8::ScriptCompiler::CachedData(cacheData.getBytes() + sizeof(CodeCacheHeader), static_cast<int>(header->dataLength));
+    v8::ScriptCompiler::Source compilerSource(source, origin, v8CacheData);
+    v8::MaybeLocal<v8::Script> maybeScript = v8::ScriptCompiler::Compile(context, &compilerSource, v8::ScriptCompiler::kConsumeCodeCache);
+    if (compilerSource.GetCachedData()->rejected) {
+        // written by another V8 build or with different flags, the script is compiled from source
+        SE_LOGD("ScriptEngine::compileWithCodeCache cache rejected %s\n", path.c_str());
+        ++_codeCacheStatistics.rejected;
+        fu->removeFile(path);
+        entry->path = std::move(path);
+    } else {
+        ++_codeCacheStatistics.hits;
+    }
+    return maybeScript;
+}
+
+struct ScriptEngine::CodeCacheWrites {
+    std::mutex mutex;
+    std::condition_variable idle;
+    uint32_t inFlight{0};
+    uint32_t serial{0};
+};
+
+bool ScriptEngine::writeCodeCache(v8::Local<v8::UnboundScript> script, const CodeCacheEntry &entry) {
+    v8::ScriptCompiler::CachedData *cd = v8::ScriptCompiler::CreateCodeCache(script);
+    if (cd == nullptr) {
+        return false;
+    }
+
+    CodeCacheHeader header{};
+    header.magic = CODE_CACHE_MAGIC;
+    header.version = CODE_CACHE_VERSION;
+    header.sourceLength = entry.sourceLength;
+    header.dataLength = static_cast<uint32_t>(cd->length);
+    header.sourceHash = entry.sourceHash;
+
+    auto writeData = std::make_shared<cc::Data>();
+    writeData->resize(static_cast<uint32_t>(sizeof(CodeCacheHeader)) + header.dataLength);
+    memcpy(writeData->getBytes(), &header, sizeof(CodeCacheHeader));
+    memcpy(writeData->getBytes() + sizeof(CodeCacheHeader), cd->data, cd->length);
+    destroyCachedData(cd);
+
+    ++_codeCacheStatistics.written;
+    _codeCacheStatistics.bytesWritten += writeData->getSize();
+
+    if (!_codeCacheWrites) {
+        _codeCacheWrites = std::make_shared<CodeCacheWrites>();
+    }
+    auto writes = _codeCacheWrites;
+    ccstd::string tmpPath;
+    {
+        std::lock_guard<std::mutex> lock(writes->mutex);
+        ++writes->inFlight;
+        tmpPath = entry.path + "." + std::to_string(writes->serial++) + ".tmp";
+    }
+    // written to a temporary file on a worker thread first, a partially written cache file is never read
+    cc::LegacyThreadPool::getDefaultThreadPool()->pushTask([writes, writeData, path = entry.path, tmpPath](int /*tid*/) {
+        auto *fu = cc::FileUtils::getInstance();
+        if (!fu->writeDataToFile(*writeData, tmpPath) || !fu->renameFile(tmpPath, path)) {
+            SE_LOGE("ScriptEngine::writeCodeCache failed to write %s\n", path.c_str());
+            fu->removeFile(tmpPath);
+        }
+        std::lock_guard<std::mutex> lock(writes->mutex);
+        if (--writes->inFlight == 0) {
+            writes->idle.notify_all();
+        }
+    });
+    return true;
+}
+
+void ScriptEngine::flushCodeCaches() {
+    if (!_pendingCodeCaches.empty()) {
+        v8::HandleScope hs(_isolate);
+        for (const auto &pending : _pendingCodeCaches) {
+            writeCodeCache(pending.script.Get(_isolate), pending.entry);
+        }
+        _pendingCodeCaches.clear();
+    }
+    if (_codeCacheWrites) {
+        std::unique_lock<std::mutex> lock(_codeCacheWrites->mutex);
+        _codeCacheWrites->idle.wait(lock, [this]() { return _codeCacheWrites->inFlight == 0; });
+    }
+}
+
 bool ScriptEngine::runByteCodeFile(const ccstd::string &pathBc, Value *ret /* = nullptr */) {
     auto *fu = cc::FileUtils::getInstance();
 
@@ -1034,12 +1253,7 @@ bool ScriptEngine::runByteCodeFile(const ccstd::string &pathBc, Value *ret /* =
         v8::ScriptCompiler::CachedData *dummyData = v8::ScriptCompiler::CreateCodeCache(dummyFunction);
         memcpy(p + 4, dummyData->data + 12, 4);
 
-        // TODO(PatriceJiang): v8 on windows is built with dynamic library (dll),
-        // Invoking `delete` for the memory allocated in v8.dll will cause crash.
-        // Need to modify v8 source code and add v8::ScriptCompiler::DestroyCodeCache(v8::ScriptCompiler::CachedData *cd).
-    #if CC_PLATFORM != CC_PLATFORM_WINDOWS
-        delete dummyData;
-    #endif
+        destroyCachedData(dummyData);
     }
 
     // setup ScriptOrigin
@@ -1161,7 +1375,15 @@ bool ScriptEngine::isDebuggerEnabled() const {
 }
 
 void ScriptEngine::mainLoopUpdate() {
-    // empty implementation
+    if (!_isStartupFinished) {
+        markStartupFinished();
+    } else if (!_pendingCodeCaches.empty()) {
+        // one cache per frame, serializing a large bundle takes several milliseconds
+        v8::HandleScope hs(_isolate);
+        const auto &pending = _pendingCodeCaches.back();
+        writeCodeCache(pending.script.Get(_isolate), pending.entry);
+        _pendingCodeCaches.pop_back();
+    }
 }
 
 bool ScriptEngine::callFunction(Object *targetObj, const char *funcName, uint32_t argc, Value *args, Value *rval /* = nullptr*/) {
@@ -187,6 +187,62 @@ public:
      */
     bool saveByteCodeToFile(const ccstd::string &path, const ccstd::string &pathBc);
 
+    /**
+     *  Statistics of script compilation and the code cache, used to measure startup time.
+     */
+    struct CodeCacheStatistics {
+        uint32_t hits{0};
+        uint32_t misses{0};
+        uint32_t rejected{0};
+        // caches serialized and queued for writing, the files are written by a worker thread
+        uint32_t written{0};
+        uint64_t bytesWritten{0};
+        // accumulated milliseconds spent compiling and running scripts
+        double compileTime{0.0};
+        double runTime{0.0};
+    };
+
+    /**
+     *  @brief Sets the directory of the code cache for scripts executed with a file name.
+     *  @param[in] dir The directory where cache files are stored, an empty string disables the code cache.
+     *  @note There is one cache file per script file name, it's validated against the hash of the script content and V8 version.
+     *        A cache rejected by V8 is removed and written again after the script is compiled.
+     *        Cache files of older formats and leftovers of interrupted writes in the directory are removed here.
+     */
+    void setCodeCacheDirectory(const ccstd::string &dir);
+
+    /**
+     *  @brief Gets the directory of the code cache, empty if the code cache is disabled.
+     */
+    const ccstd::string &getCodeCacheDirectory() const { return _codeCacheDir; }
+
+    /**
+     *  @brief Marks the end of startup, it's invoked by the first `mainLoopUpdate` if not invoked before.
+     *  @note Caches of compiled scripts are serialized by `mainLoopUpdate` after startup, one per frame,
+     *        and written to files by a worker thread to keep both out of the startup path.
+     */
+    void markStartupFinished();
+
+    /**
+     *  @brief Serializes all pending caches and waits until all cache files are written.
+     */
+    void flushCodeCaches();
+
+    /**
+     *  @brief Tests whether startup is finished.
+     */
+    bool isStartupFinished() const { return _isStartupFinished; }
+
+    /**
+     *  @brief Gets the milliseconds from `start` to `markStartupFinished`, 0 before startup is finished.
+     */
+    double getStartupTime() const { return _startupTime; }
+
+    /**
+     *  @brief Gets the statistics of script compilation and the code cache since `init`.
+     */
+    const CodeCacheStatistics &getCodeCacheStatistics() const { return _codeCacheStatistics; }
+
     /**
      * @brief Grab a snapshot of the current JavaScript execution stack.
      * @return current stack trace string
@@ -379,6 +435,13 @@ private:
      *  @return true if succeed, otherwise false.
      */
     bool runByteCodeFile(const ccstd::string &pathBc, Value *ret /* = nullptr */);
+    struct CodeCacheEntry {
+        ccstd::string path; // empty if the cache file doesn't need to be written
+        uint64_t sourceHash{0};
+        uint32_t sourceLength{0};
+    };
+    v8::MaybeLocal<v8::Script> compileWithCodeCache(v8::Local<v8::String> source, v8::ScriptOrigin &origin, const char *fileName, const ccstd::string &script, CodeCacheEntry *entry);
+    bool writeCodeCache(v8::Local<v8::UnboundScript> script, const CodeCacheEntry &entry);
     void callExceptionCallback(const char *, const char *, const char *);
     bool callRegisteredCallback();
     bool postInit();
@@ -397,6 +460,18 @@ private:
     ccstd::vector<std::tuple<std::unique_ptr<v8::Persistent<v8::Promise>>, ccstd::vector<PromiseExceptionMsg>>> _promiseArray;
 
     std::chrono::steady_clock::time_point _startTime;
+
+    struct PendingCodeCache {
+        v8::Global<v8::UnboundScript> script;
+        CodeCacheEntry entry;
+    };
+    ccstd::string _codeCacheDir;
+    ccstd::vector<PendingCodeCache> _pendingCodeCaches;
+    struct CodeCacheWrites;
+    std::shared_ptr<CodeCacheWrites> _codeCacheWrites;
+    CodeCacheStatistics _codeCacheStatistics;
+    double _startupTime{0.0};
+    bool _isStartupFinished{false};
     ccstd::vector<RegisterCallback> _registerCallbackArray;
     ccstd::vector<RegisterCallback> _permRegisterCallbackArray;
     ccstd::vector<std::function<void()>> _beforeInitHookArray;
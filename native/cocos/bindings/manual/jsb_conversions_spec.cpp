@@ -348,6 +348,20 @@ bool seval_to_DownloaderHints(const se::Value &v, cc::network::DownloaderHints *
     SE_PRECONDITION3(ok && tmp.isString(), false, *ret = ZERO);
     ret->tempFileNameSuffix = tmp.toString();
 
+    // optional, the defaults are kept when absent
+    if (obj->getProperty("cacheDirectory", &tmp) && tmp.isString()) {
+        ret->cacheDirectory = tmp.toString();
+    }
+    if (obj->getProperty("cacheMaxSize", &tmp) && tmp.isNumber()) {
+        ret->cacheMaxSize = static_cast<uint64_t>(tmp.toDouble());
+    }
+    if (obj->getProperty("segmentThreshold", &tmp) && tmp.isNumber()) {
+        ret->segmentThreshold = tmp.toUint32();
+    }
+    if (obj->getProperty("countOfMaxSegmentsPerTask", &tmp) && tmp.isNumber()) {
+        ret->countOfMaxSegmentsPerTask = tmp.toUint32();
+    }
+
     return ok;
 }
 
@@ -1529,56 +1543,57 @@ bool nativevalue_to_se(const cc::NativeDep &from, se::Value &to, se::Object * /*
 
 #if CC_USE_PHYSICS_PHYSX
 
-bool nativevalue_to_se(const ccstd::vector<std::shared_ptr<cc::physics::TriggerEventPair>> &from, se::Value &to, se::Object * /*ctx*/) {
-    se::HandleObject array(se::Object::createArrayObject(from.size() * cc::physics::TriggerEventPair::COUNT));
-    for (size_t i = 0; i < from.size(); i++) {
-        auto t = i * cc::physics::TriggerEventPair::COUNT;
-        array->setArrayElement(static_cast<uint>(t + 0), se::Value(from[i]->shapeA));
-        array->setArrayElement(static_cast<uint>(t + 1), se::Value(from[i]->shapeB));
-        array->setArrayElement(static_cast<uint>(t + 2), se::Value(static_cast<uint8_t>(from[i]->state)));
-    }
+namespace {
+// Event records are handed to scripts as one typed array per category instead of one JS value per field.
+template <typename T, typename Fill>
+bool eventsToTypedArray(size_t count, size_t stride, se::Object::TypedArrayType type, se::Value &to, Fill fill) {
+    static ccstd::vector<T> staging;
+    staging.resize(count * stride);
+    for (size_t i = 0; i < count; i++) {
+        fill(i, staging.data() + i * stride);
+    }
+    se::HandleObject array(se::Object::createTypedArray(type, staging.data(), staging.size() * sizeof(T)));
     to.setObject(array);
     return true;
 }
+} // namespace
 
-bool nativevalue_to_se(const ccstd::vector<cc::physics::ContactPoint> &from, se::Value &to, se::Object * /*ctx*/) {
-    const auto contactCount = from.size();
-    se::HandleObject array(se::Object::createArrayObject(contactCount));
-    for (size_t i = 0; i < contactCount; i++) {
-        auto t = i * cc::physics::ContactPoint::COUNT;
-        uint32_t j = 0;
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].position.x));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].position.y));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].position.z));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].normal.x));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].normal.y));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].normal.z));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].impulse.x));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].impulse.y));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].impulse.z));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].separation));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].internalFaceIndex0));
-        array->setArrayElement(static_cast<uint>(t + j++), se::Value(from[i].internalFaceIndex1));
-    }
-    to.setObject(array);
-    return true;
+bool nativevalue_to_se(const ccstd::vector<cc::physics::TriggerEventPair> &from, se::Value &to, se::Object * /*ctx*/) {
+    return eventsToTypedArray<uint32_t>(from.size(), cc::physics::TriggerEventPair::COUNT, se::Object::TypedArrayType::UINT32, to, [&](size_t i, uint32_t *out) {
+        out[0] = from[i].shapeA;
+        out[1] = from[i].shapeB;
+        out[2] = static_cast<uint32_t>(from[i].state);
+    });
 }
 
-bool nativevalue_to_se(const ccstd::vector<std::shared_ptr<cc::physics::ContactEventPair>> &from, se::Value &to, se::Object *ctx) {
-    se::HandleObject array(se::Object::createArrayObject(from.size() * cc::physics::ContactEventPair::COUNT));
-    for (size_t i = 0; i < from.size(); i++) {
-        auto t = i * cc::physics::ContactEventPair::COUNT;
-        array->setArrayElement(static_cast<uint>(t + 0), se::Value(from[i]->shapeA));
-        array->setArrayElement(static_cast<uint>(t + 1), se::Value(from[i]->shapeB));
-        array->setArrayElement(static_cast<uint>(t + 2), se::Value(static_cast<uint8_t>(from[i]->state)));
-        array->setArrayElement(static_cast<uint>(t + 3), [&]() -> se::Value {
-            auto obj = se::Value();
-            nativevalue_to_se(from[i]->contacts, obj, ctx);
-            return obj;
-        }());
-    }
-    to.setObject(array);
-    return true;
+bool nativevalue_to_se(const ccstd::vector<cc::physics::ContactPoint> &from, se::Value &to, se::Object * /*ctx*/) {
+    // Face indices are stored as floats, exact up to 2^24 triangles.
+    return eventsToTypedArray<float>(from.size(), cc::physics::ContactPoint::COUNT, se::Object::TypedArrayType::FLOAT32, to, [&](size_t i, float *out) {
+        const auto &c = from[i];
+        uint32_t j = 0;
+        out[j++] = c.position.x;
+        out[j++] = c.position.y;
+        out[j++] = c.position.z;
+        out[j++] = c.normal.x;
+        out[j++] = c.normal.y;
+        out[j++] = c.normal.z;
+        out[j++] = c.impulse.x;
+        out[j++] = c.impulse.y;
+        out[j++] = c.impulse.z;
+        out[j++] = c.separation;
+        out[j++] = static_cast<float>(c.internalFaceIndex0);
+        out[j++] = static_cast<float>(c.internalFaceIndex1);
+    });
+}
+
+bool nativevalue_to_se(const ccstd::vector<cc::physics::ContactEventPair> &from, se::Value &to, se::Object * /*ctx*/) {
+    return eventsToTypedArray<uint32_t>(from.size(), cc::physics::ContactEventPair::COUNT, se::Object::TypedArrayType::UINT32, to, [&](size_t i, uint32_t *out) {
+        out[0] = from[i].shapeA;
+        out[1] = from[i].shapeB;
+        out[2] = static_cast<uint32_t>(from[i].state);
+        out[3] = from[i].contactOffset;
+        out[4] = from[i].contactCount;
+    });
 }
 
 bool nativevalue_to_se(const ccstd::vector<cc::physics::CharacterControllerContact> &from, se::Value &to, se::Object * /*ctx*/) {
@@ -1619,16 +1634,12 @@ bool nativevalue_to_se(const ccstd::vector<std::shared_ptr<cc::physics::CCTShape
     return true;
 }
 
-bool nativevalue_to_se(const ccstd::vector<std::shared_ptr<cc::physics::CCTTriggerEventPair>> &from, se::Value &to, se::Object * /*ctx*/) {
-    se::HandleObject array(se::Object::createArrayObject(from.size() * cc::physics::CCTTriggerEventPair::COUNT));
-    for (size_t i = 0; i < from.size(); i++) {
-        auto t = i * cc::physics::CCTTriggerEventPair::COUNT;
-        array->setArrayElement(static_cast<uint>(t + 0), se::Value(from[i]->cct));
-        array->setArrayElement(static_cast<uint>(t + 1), se::Value(from[i]->shape));
-        array->setArrayElement(static_cast<uint>(t + 2), se::Value(static_cast<uint8_t>(from[i]->state)));
-    }
-    to.setObject(array);
-    return true;
+bool nativevalue_to_se(const ccstd::vector<cc::physics::CCTTriggerEventPair> &from, se::Value &to, se::Object * /*ctx*/) {
+    return eventsToTypedArray<uint32_t>(from.size(), cc::physics::CCTTriggerEventPair::COUNT, se::Object::TypedArrayType::UINT32, to, [&](size_t i, uint32_t *out) {
+        out[0] = from[i].cct;
+        out[1] = from[i].shape;
+        out[2] = static_cast<uint32_t>(from[i].state);
+    });
 }
 
 bool nativevalue_to_se(const cc::physics::RaycastResult &from, se::Value &to, se::Object *ctx) {
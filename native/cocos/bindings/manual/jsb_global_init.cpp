@@ -216,6 +216,11 @@ void jsb_init_file_operation_delegate() { //NOLINT
         // Games may be restarted in the same process and run in different threads. Android may restart from recent task list.
         se::ScriptEngine::getInstance()->setFileOperationDelegate(delegate);
     }
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8 && !CC_EDITOR
+    // scripts compiled in this launch are reused by the next one
+    se::ScriptEngine::getInstance()->setCodeCacheDirectory(FileUtils::getInstance()->getWritablePath() + "jscache/");
+#endif
 }
 
 bool jsb_enable_debugger(const ccstd::string &debuggerServerAddr, uint32_t port, bool isWaitForConnect) { //NOLINT
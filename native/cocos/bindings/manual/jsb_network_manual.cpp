@@ -85,20 +85,24 @@ static bool js_network_Downloader_createDownloadTask(se::State &s) { // NOLINT(r
         return true;
     }
     
-    if (argc == 4) {
+    if (argc == 4 || argc == 5) {
         ccstd::string arg0;
         ccstd::string arg1;
         ccstd::unordered_map<ccstd::string, ccstd::string> arg2;
         ccstd::string arg3;
+        ccstd::string checksum;
         
         ok &= sevalue_to_native(args[0], &arg0);
         ok &= sevalue_to_native(args[1], &arg1);
         ok &= sevalue_to_native(args[2], &arg2);
         ok &= sevalue_to_native(args[3], &arg3);
+        if (argc == 5) {
+            ok &= sevalue_to_native(args[4], &checksum);
+        }
         SE_PRECONDITION2(ok, false,
                          "js_network_Downloader_createDownloadTask : Error processing arguments");
         std::shared_ptr<const cc::network::DownloadTask> result = cobj->createDownloadTask(
-            arg0, arg1, arg2, arg3);
+            arg0, arg1, arg2, arg3, checksum);
         ok &= nativevalue_to_se(result, s.rval());
         //ROOT downloader object
         s.thisObject()->root();
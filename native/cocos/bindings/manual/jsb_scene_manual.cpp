@@ -27,6 +27,7 @@
 #include "bindings/auto/jsb_scene_auto.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
+#include "core/scene-graph/NodeTransformBatch.h"
 #include "scene/Model.h"
 
 #ifndef JSB_ALLOC
@@ -620,6 +621,32 @@ static bool js_scene_Node_inverseTransformPoint(void *nativeObject) // NOLINT(re
 }
 SE_BIND_FUNC_FAST(js_scene_Node_inverseTransformPoint)
 
+static bool js_scene_Node_getTransformBatchBuffer(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto &batch = cc::NodeTransformBatch::getInstance();
+    // The memory is owned by the batch, the external array buffer just references it.
+    se::HandleObject buffer(se::Object::createExternalArrayBufferObject(batch.getBuffer(), batch.getByteLength(), [](void * /*contents*/, size_t /*byteLength*/, void * /*userData*/) {}));
+    s.rval().setObject(buffer);
+    return true;
+}
+SE_BIND_FUNC(js_scene_Node_getTransformBatchBuffer)
+
+static bool js_scene_Node_applyTransformBatch(se::State & /*s*/) // NOLINT(readability-identifier-naming)
+{
+    cc::NodeTransformBatch::getInstance().apply();
+    return true;
+}
+SE_BIND_FUNC(js_scene_Node_applyTransformBatch)
+
+static bool js_scene_Node_getTransformBatchSlot(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::Node>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    s.rval().setUint32(cc::NodeTransformBatch::getInstance().getSlot(cobj));
+    return true;
+}
+SE_BIND_FUNC(js_scene_Node_getTransformBatchSlot)
+
 static bool js_scene_Pass_blocks_getter(se::State &s) { // NOLINT(readability-identifier-naming)
     auto *cobj = SE_THIS_OBJECT<cc::scene::Pass>(s);
     SE_PRECONDITION2(cobj, false, "Invalid Native Object");
@@ -866,6 +893,8 @@ bool register_all_scene_manual(se::Object *obj) // NOLINT(readability-identifier
     jsbVal.toObject()->getProperty("Node", &nodeVal);
 
     nodeVal.toObject()->defineFunction("_setTempFloatArray", _SE(js_scene_Node_setTempFloatArray));
+    nodeVal.toObject()->defineFunction("_getTransformBatchBuffer", _SE(js_scene_Node_getTransformBatchBuffer));
+    nodeVal.toObject()->defineFunction("_applyTransformBatch", _SE(js_scene_Node_applyTransformBatch));
 
     __jsb_cc_Node_proto->defineFunction("_setPosition", _SE(js_scene_Node_setPosition));
     __jsb_cc_Node_proto->defineFunction("_setScale", _SE(js_scene_Node_setScale));
@@ -887,6 +916,7 @@ bool register_all_scene_manual(se::Object *obj) // NOLINT(readability-identifier
     __jsb_cc_Node_proto->defineFunction("_getWorldRT", _SE(js_scene_Node_getWorldRT));
 
     __jsb_cc_Node_proto->defineFunction("_setRTS", _SE(js_scene_Node_setRTS));
+    __jsb_cc_Node_proto->defineFunction("_getTransformBatchSlot", _SE(js_scene_Node_getTransformBatchSlot));
     __jsb_cc_Node_proto->defineFunction("_inverseTransformPoint", _SE(js_scene_Node_inverseTransformPoint));
 
     __jsb_cc_scene_Pass_proto->defineProperty("blocks", _SE(js_scene_Pass_blocks_getter), nullptr);
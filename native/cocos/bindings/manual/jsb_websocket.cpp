@@ -132,7 +132,19 @@ void JsbWebSocketDelegate::onMessage(cc::network::WebSocket *ws, const cc::netwo
         args.push_back(se::Value(jsObj));
 
         if (data.isBinary) {
-            se::HandleObject dataObj(se::Object::createArrayBufferObject(data.bytes, data.len));
+            // Hand the received buffer to the script directly when the connection allows it, otherwise copy.
+            se::Object *buffer = nullptr;
+            if (data.detach()) {
+                buffer = se::Object::createExternalArrayBufferObject(data.bytes, data.len, data.freeFunc, data.freeUserData);
+                if (buffer == nullptr) {
+                    // The storage is detached but wasn't taken over, copy it and give it back here.
+                    buffer = se::Object::createArrayBufferObject(data.bytes, data.len);
+                    data.freeFunc(data.bytes, data.len, data.freeUserData);
+                }
+            } else {
+                buffer = se::Object::createArrayBufferObject(data.bytes, data.len);
+            }
+            se::HandleObject dataObj(buffer);
             jsObj->setProperty("data", se::Value(dataObj));
         } else {
             se::Value dataVal;
@@ -335,6 +335,42 @@ static bool WebSocketServer_connections(se::State &s) { // NOLINT(readability-id
 }
 SE_BIND_PROP_GET(WebSocketServer_connections)
 
+static bool WebSocketServer_broadcast(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    int argc = static_cast<int>(args.size());
+
+    if (argc == 1) {
+        auto cobj = sharedPtrObj<cc::network::WebSocketServer>(s);
+        bool ok = false;
+        if (args[0].isString()) {
+            ccstd::string data;
+            ok = sevalue_to_native(args[0], &data);
+            SE_PRECONDITION2(ok, false, "Convert string failed");
+            cobj->broadcastTextAsync(data);
+        } else if (args[0].isObject()) {
+            se::Object *dataObj = args[0].toObject();
+            uint8_t *ptr = nullptr;
+            size_t length = 0;
+            if (dataObj->isArrayBuffer()) {
+                ok = dataObj->getArrayBufferData(&ptr, &length);
+                SE_PRECONDITION2(ok, false, "getArrayBufferData failed!");
+            } else if (dataObj->isTypedArray()) {
+                ok = dataObj->getTypedArrayData(&ptr, &length);
+                SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
+            } else {
+                CC_ABORT();
+            }
+            cobj->broadcastBinaryAsync(ptr, length);
+        } else {
+            CC_ABORT();
+        }
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting 1", argc);
+    return false;
+}
+SE_BIND_FUNC(WebSocketServer_broadcast)
+
 static bool WebSocketServer_Connection_finalize(se::State &s) { // NOLINT(readability-identifier-naming)
     auto *cobj = static_cast<cc::network::WebSocketServerConnection *>(s.nativeThisObject());
     CC_LOG_INFO("jsbindings: finalizing JS object %p (WebSocketServer_Connection)", cobj);
@@ -888,6 +924,7 @@ bool register_all_websocket_server(se::Object *obj) {
 
     cls->defineFunction("close", _SE(WebSocketServer_close));
     cls->defineFunction("listen", _SE(WebSocketServer_listen));
+    cls->defineFunction("broadcast", _SE(WebSocketServer_broadcast));
     cls->defineProperty("onconnection", nullptr, _SE(WebSocketServer_onconnection));
     cls->defineProperty("onclose", nullptr, _SE(WebSocketServer_onclose));
     cls->defineProperty("connections", _SE(WebSocketServer_connections), nullptr);
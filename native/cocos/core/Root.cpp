@@ -26,6 +26,7 @@
 #include "2d/renderer/Batcher2d.h"
 #include "application/ApplicationManager.h"
 #include "bindings/event/EventDispatcher.h"
+#include "core/scene-graph/NodeTransformBatch.h"
 #include "pipeline/custom/RenderingModule.h"
 #include "platform/interfaces/modules/IScreen.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
@@ -47,6 +48,7 @@
 #include "renderer/pipeline/forward/ForwardPipeline.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
+#include "scene/LocalUBOPool.h"
 #include "scene/SpotLight.h"
 #include "scene/Skybox.h"
 
@@ -150,13 +152,9 @@ cc::scene::RenderWindow *Root::createRenderWindowFromSystemWindow(uint32_t windo
 
 void Root::destroy() {
     destroyScenes();
+    scene::LocalUBOPool::destroyAll();
     removeWindowEventListener();
-    if (_pipelineRuntime) {
-        _pipelineRuntime->destroy();
-    }
-    _pipelineRuntime.reset();
-
-    CC_SAFE_DESTROY_NULL(_pipeline);
+    destroyRenderPipeline();
 
     CC_SAFE_DELETE(_batcher);
 
@@ -300,6 +298,16 @@ public:
 
 } // namespace
 
+void Root::destroyRenderPipeline() {
+    if (_pipelineRuntime) {
+        _pipelineRuntime->destroy();
+    }
+    _pipelineRuntime.reset();
+
+    CC_SAFE_DESTROY_NULL(_pipeline);
+    _useDeferredPipeline = false;
+}
+
 bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
     if (rppl) {
         if (dynamic_cast<pipeline::DeferredPipeline *>(rppl) != nullptr) {
@@ -317,7 +325,8 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
         }
         _pipeline->setBloomEnabled(false);
 
-        if (!_pipeline->activate(_mainRenderWindow->getSwapchain())) {
+        // a headless root has no main window, the pipeline is activated without a swapchain
+        if (!_pipeline->activate(_mainRenderWindow ? _mainRenderWindow->getSwapchain() : nullptr)) {
             _pipeline = nullptr;
             return false;
         }
@@ -382,6 +391,8 @@ void Root::frameSync() {
 }
 
 void Root::frameMoveBegin() {
+    NodeTransformBatch::getInstance().apply();
+
     for (const auto &scene : _scenes) {
         scene->removeBatches();
     }
@@ -413,6 +424,7 @@ void Root::frameMoveProcess(bool isNeedUpdateScene, int32_t totalFrames) {
             for (const auto &scene : _scenes) {
                 scene->update(stamp);
             }
+            scene::LocalUBOPool::commitAll();
         }
 
         CC_PROFILER_UPDATE;
@@ -666,11 +678,22 @@ void Root::addWindowEventListener() {
             window->onNativeWindowResume(windowId);
         }
     });
+
+    // the app may be killed without the device being destroyed
+    _enterBackgroundListener.bind([this]() -> void {
+        _device->flushPersistentCache();
+    });
+
+    _lowMemoryListener.bind([this]() -> void {
+        _device->flushPersistentCache();
+    });
 }
 
 void Root::removeWindowEventListener() {
     _windowDestroyListener.reset();
     _windowRecreatedListener.reset();
+    _enterBackgroundListener.reset();
+    _lowMemoryListener.reset();
 }
 
 } // namespace cc
@@ -85,6 +85,11 @@ public:
     void resize(uint32_t width, uint32_t height, uint32_t windowId);
 
     bool setRenderPipeline(pipeline::RenderPipeline *rppl = nullptr);
+    /**
+     * @zh
+     * 销毁当前的渲染管线，之后可以重新设置渲染管线
+     */
+    void destroyRenderPipeline();
     void onGlobalPipelineStateChanged();
 
     /**
@@ -328,6 +333,8 @@ private:
     IXRInterface *_xr{nullptr};
     events::WindowDestroy::Listener _windowDestroyListener;
     events::WindowRecreated::Listener _windowRecreatedListener;
+    events::EnterBackground::Listener _enterBackgroundListener;
+    events::LowMemory::Listener _lowMemoryListener;
 
     // Cache ccstd::vector to avoid allocate every frame in frameMove
     ccstd::vector<scene::Camera *> _cameraList;
@@ -215,6 +215,13 @@ bool EffectAsset::validate() const {
 
 void EffectAsset::precompile() {
     Root *root = Root::getInstance();
+    auto *programLib = render::getProgramLibrary();
+    if (programLib) {
+        // Native Program Lib can not precompile shader variant without phaseID,
+        // it compiles the variants recorded with their phase by earlier runs.
+        programLib->precompileEffect(root->getDevice(), this);
+        return;
+    }
     for (index_t i = 0; i < _shaders.size(); ++i) {
         auto shader = _shaders[i];
         if (i >= _combinations.size()) {
@@ -226,16 +233,11 @@ void EffectAsset::precompile() {
             continue;
         }
 
-        // Native Program Lib can not precompile shader variant without phaseID.
-        // Shaders are compiled only during the compilation of PSO. A new mechanism may be needed for pre-compilation.
-        auto *programLib = render::getProgramLibrary();
-        if (programLib == nullptr) {
-            ccstd::vector<MacroRecord> defines = EffectAsset::doCombine(
-                ccstd::vector<MacroRecord>(), combination, combination.begin());
-            for (auto &define: defines) {
-                ProgramLib::getInstance()->getGFXShader(root->getDevice(), shader.name, define,
-                                                        root->getPipeline());
-            }
+        ccstd::vector<MacroRecord> defines = EffectAsset::doCombine(
+            ccstd::vector<MacroRecord>(), combination, combination.begin());
+        for (auto &define: defines) {
+            ProgramLib::getInstance()->getGFXShader(root->getDevice(), shader.name, define,
+                                                    root->getPipeline());
         }
     }
 }
@@ -23,40 +23,73 @@
 ****************************************************************************/
 #include "EventBus.h"
 #include <algorithm>
-#include "intl/List.h"
+#include <thread>
 
 namespace cc {
 namespace event {
 
 void BusEventListenerContainer::addListener(BusEventListenerBase *listener) {
-    if (_isBroadcasting) {
-        intl::listAppend(&_listenersToAdd, listener->entry);
-        return;
-    }
-    intl::listAppend(&_listenerList, listener->entry);
+    listener->index = static_cast<uint32_t>(_listeners.size());
+    listener->generation = _generation;
+    _listeners.emplace_back(listener);
 }
 
 void BusEventListenerContainer::removeListener(BusEventListenerBase *listener) {
-    if (_isBroadcasting) {
-        _listenersToRemove.emplace_back(listener->entry);
-        listener->entry->listener = nullptr;
+    CC_ASSERT(listener->index < _listeners.size() && _listeners[listener->index] == listener);
+    if (!_isBroadcasting && listener->index + 1 == _listeners.size()) {
+        _listeners.pop_back();
+        while (!_listeners.empty() && _listeners.back() == nullptr) {
+            _listeners.pop_back();
+            --_removedCount;
+        }
         return;
     }
-    intl::detachFromList(&_listenerList, listener->entry);
-    delete listener->entry;
+    // slots can't move while broadcasting, leave a hole and compact later
+    _listeners[listener->index] = nullptr;
+    ++_removedCount;
+    if (!_isBroadcasting && _removedCount * 2 > _listeners.size()) {
+        compact();
+    }
+}
+
+void BusEventListenerContainer::compact() {
+    uint32_t count = 0;
+    for (auto *listener : _listeners) {
+        if (listener != nullptr) {
+            listener->index = count;
+            _listeners[count++] = listener;
+        }
+    }
+    _listeners.resize(count);
+    _removedCount = 0;
+}
+
+namespace {
+ccstd::vector<DeferredBroadcastQueueBase *> &pendingQueues() {
+    static ccstd::vector<DeferredBroadcastQueueBase *> queues;
+    return queues;
+}
+} // namespace
+
+void DeferredBroadcastQueueBase::markPending(DeferredBroadcastQueueBase *queue) {
+    pendingQueues().emplace_back(queue);
+}
+
+void DeferredBroadcastQueueBase::checkThread() {
+#if CC_DEBUG
+    static const std::thread::id engineThread = std::this_thread::get_id();
+    CC_ASSERT(engineThread == std::this_thread::get_id());
+#endif
 }
 
-void BusEventListenerContainer::addOrRemovePendingListeners() {
-    for (auto &entry : _listenersToRemove) {
-        intl::detachFromList(&_listenerList, entry);
-        delete entry;
+void flushDeferredBroadcasts() {
+    DeferredBroadcastQueueBase::checkThread();
+    // events deferred by the listeners are flushed next time
+    ccstd::vector<DeferredBroadcastQueueBase *> queues;
+    queues.swap(pendingQueues());
+    for (auto *queue : queues) {
+        queue->flush();
     }
-    EVENT_LIST_LOOP_REV_BEGIN(curr, _listenersToAdd)
-    intl::detachFromList(&_listenersToAdd, curr);
-    intl::listAppend(&_listenerList, curr);
-    EVENT_LIST_LOOP_REV_END(curr, _listenersToAdd)
-    _listenersToAdd = nullptr;
-    _listenersToRemove.clear();
 }
 } // namespace event
 } // namespace cc
@@ -26,13 +26,15 @@
 #include <cstddef>
 #include <iostream>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 
 #include "base/Log.h"
+#include "base/std/container/unordered_set.h"
 #include "base/std/container/vector.h"
+#include "base/std/hash/hash.h"
 #include "core/memop/Pool.h"
 #include "intl/EventIntl.h"
-#include "intl/List.h"
 
 namespace cc {
 namespace event {
@@ -41,18 +43,13 @@ class BusEventListenerBase;
 template <typename EHandler>
 class BusEventListenerDB;
 
-template <typename EHandler, typename... ARGS>
-class BusEventBroadcaster;
-
 class BusEventListenerContainer;
-struct BusEventListenerEntry {
-    BusEventListenerEntry *next{nullptr};
-    BusEventListenerEntry *prev{nullptr};
-    BusEventListenerBase *listener{nullptr};
-};
 class BusEventListenerBase {
 protected:
-    BusEventListenerEntry *entry{nullptr}; // NOLINT
+    // slot in BusEventListenerContainer::_listeners
+    uint32_t index{0}; // NOLINT
+    // generation of the container when added, the broadcast running at that time skips the listener
+    uint64_t generation{0}; // NOLINT
     friend class BusEventListenerContainer;
 };
 
@@ -67,42 +64,40 @@ protected:
     void addListener(BusEventListenerBase *);
     void removeListener(BusEventListenerBase *);
 
-    bool hasPendingListeners() const {
-        return !_listenersToRemove.empty() || _listenersToAdd;
+    void beginBroadcast() {
+        if (_isBroadcasting++ == 0) {
+            ++_generation;
+        }
     }
-    void addOrRemovePendingListeners();
+    void endBroadcast() {
+        if (--_isBroadcasting == 0 && _removedCount > 0) {
+            compact();
+        }
+    }
+    void compact();
+
+    template <typename EHandler, typename... ARGS>
+    void doBroadcast(ARGS &&...args);
     // fields
-    BusEventListenerEntry *_listenerList{nullptr};
-    BusEventListenerEntry *_listenersToAdd{nullptr};
-    ccstd::vector<BusEventListenerEntry *> _listenersToRemove;
+    // dense in the order listeners were added, a removed listener leaves a nullptr until compact()
+    ccstd::vector<BusEventListenerBase *> _listeners;
+    uint32_t _removedCount{0};
+    uint64_t _generation{0};
     int _isBroadcasting = 0;
 
     template <typename T>
     friend class BusEventListenerDB;
 
-    template <typename EHandler, typename... ARGS>
-    friend class BusEventBroadcaster;
-
     friend class BusEventListenerBase;
     template <typename E>
     friend class Listener;
 };
 
-template <typename EHandler, typename... ARGS>
-class BusEventBroadcaster final : public BusEventListenerContainer {
-public:
-    bool doBroadcast(ARGS &&...args);
-};
-
 template <typename EHandler, typename... ARGS>
 bool BusEventListenerContainer::broadcast(ARGS &&...args) {
-    using BusType = BusEventBroadcaster<EHandler, ARGS...>;
-    _isBroadcasting++;
-    auto ret = static_cast<BusType *>(this)->doBroadcast(std::forward<ARGS>(args)...);
-    _isBroadcasting--;
-    if (!_isBroadcasting && hasPendingListeners()) {
-        addOrRemovePendingListeners();
-    }
+    beginBroadcast();
+    doBroadcast<EHandler>(std::forward<ARGS>(args)...);
+    endBroadcast();
     return false;
 }
 
@@ -179,8 +174,6 @@ private:
 
 template <typename EHandler>
 Listener<EHandler>::Listener() {
-    entry = new BusEventListenerEntry;
-    entry->listener = this;
     BusEventListenerDB<EHandler>::container()->addListener(this);
 }
 
@@ -190,14 +183,17 @@ Listener<EHandler>::~Listener() {
 }
 
 template <typename EHandler, typename... ARGS>
-bool BusEventBroadcaster<EHandler, ARGS...>::doBroadcast(ARGS &&...args) {
+void BusEventListenerContainer::doBroadcast(ARGS &&...args) {
     // broadcast events to all listeners
-    EVENT_LIST_LOOP_BEGIN(curr, _listenerList)
-    if (curr->listener) {
-        static_cast<Listener<EHandler> *>(curr->listener)->invoke(std::forward<ARGS>(args)...);
+    // Listeners may be added or removed by the callbacks, so index the array instead of holding iterators.
+    // Slots are not moved while broadcasting, added listeners are skipped by generation.
+    const uint64_t generation = _generation;
+    for (size_t i = 0; i < _listeners.size(); ++i) {
+        BusEventListenerBase *listener = _listeners[i];
+        if (listener != nullptr && listener->generation != generation) {
+            static_cast<Listener<EHandler> *>(listener)->invoke(std::forward<ARGS>(args)...);
+        }
     }
-    EVENT_LIST_LOOP_END(curr, _listenerList)
-    return true;
 }
 
 template <typename EHandler, typename... ARGS>
@@ -208,6 +204,116 @@ void broadcast(ARGS &&...args) {
     listenerSet->template broadcast<EHandler, ARGS...>(std::forward<ARGS>(args)...);
 }
 
+namespace intl {
+namespace hash_lookup {
+using ccstd::hash_value;
+
+template <typename T, typename = void>
+struct IsHashable : std::false_type {};
+
+template <typename T>
+struct IsHashable<T, std::void_t<decltype(hash_value(std::declval<const T &>())),
+                                 decltype(std::declval<const T &>() == std::declval<const T &>())>> : std::true_type {};
+} // namespace hash_lookup
+
+template <typename Tuple>
+struct IsCoalescable;
+
+template <typename... ARGS>
+struct IsCoalescable<std::tuple<ARGS...>> {
+    constexpr static bool VALUE = (hash_lookup::IsHashable<ARGS>::value && ...);
+};
+} // namespace intl
+
+class DeferredBroadcastQueueBase {
+public:
+    virtual ~DeferredBroadcastQueueBase() = default;
+    virtual void flush() = 0;
+
+protected:
+    // queues with pending events, flushed by flushDeferredBroadcasts
+    static void markPending(DeferredBroadcastQueueBase *queue);
+    // deferred events are not synchronized, they must be queued and flushed on the engine thread
+    static void checkThread();
+
+    friend void flushDeferredBroadcasts();
+};
+
+/**
+ * Events of EHandler queued by broadcastDeferred.
+ * Equal events are queued once when every argument type has ccstd::hash_value and operator==,
+ * otherwise each event is queued.
+ */
+template <typename EHandler>
+class DeferredBroadcastQueue final : public DeferredBroadcastQueueBase {
+public:
+    using Event = typename intl::DecayedTuple<typename EHandler::_argument_tuple_types>::type;
+    constexpr static bool COALESCE = intl::IsCoalescable<Event>::VALUE;
+
+    static DeferredBroadcastQueue *instance() {
+        static auto *queue = new DeferredBroadcastQueue;
+        return queue;
+    }
+
+    template <typename... ARGS>
+    void push(ARGS &&...args) {
+        static_assert(std::is_copy_constructible<Event>::value, "arguments of deferred events are copied");
+        checkThread();
+        Event event{std::forward<ARGS>(args)...};
+        if constexpr (COALESCE) {
+            if (!_queued.insert(event).second) {
+                return;
+            }
+        }
+        if (_events.empty()) {
+            markPending(this);
+        }
+        _events.emplace_back(std::move(event));
+    }
+
+    void flush() override {
+        // events queued by the listeners go to the next flush
+        ccstd::vector<Event> events;
+        events.swap(_events);
+        if constexpr (COALESCE) {
+            _queued.clear();
+        }
+        for (auto &event : events) {
+            std::apply([](auto &...args) { broadcast<EHandler>(args...); }, event);
+        }
+    }
+
+private:
+    struct EventHash {
+        size_t operator()(const Event &event) const {
+            ccstd::hash_t seed = 0;
+            std::apply([&seed](const auto &...args) { (ccstd::hash_combine(seed, args), ...); }, event);
+            return seed;
+        }
+    };
+
+    ccstd::vector<Event> _events;
+    // only used when COALESCE
+    ccstd::unordered_set<Event, EventHash> _queued;
+};
+
+/**
+ * Queues an event to be broadcast by the next flushDeferredBroadcasts(), which the engine calls once per frame.
+ * Arguments are copied, and an event equal to one already queued in this frame is dropped.
+ * Must be called on the engine thread.
+ */
+template <typename EHandler, typename... ARGS>
+void broadcastDeferred(ARGS &&...args) {
+    static_assert(sizeof...(ARGS) == EHandler::ARG_COUNT, "parameter count incorrect");
+    event::intl::validateParameters<0, EHandler, ARGS...>(std::forward<ARGS>(args)...);
+    DeferredBroadcastQueue<EHandler>::instance()->push(std::forward<ARGS>(args)...);
+}
+
+/**
+ * Broadcasts the events queued by broadcastDeferred, in the order they were first queued per event type.
+ */
+void flushDeferredBroadcasts();
+
 } // namespace event
 } // namespace cc
 
@@ -233,6 +339,10 @@ void broadcast(ARGS &&...args) {
         static inline void emit(ARGS &&...args) {                                                            \
             cc::event::emit<BusEventClass>(std::forward<ARGS>(args)...);                                     \
         }                                                                                                    \
+        template <typename... ARGS>                                                                          \
+        static inline void broadcastDeferred(ARGS &&...args) {                                               \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                        \
+        }                                                                                                    \
     };
 
 #include "intl/EventBusMacros.h"
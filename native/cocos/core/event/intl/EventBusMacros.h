@@ -12,6 +12,10 @@
         static inline void broadcast() {                                                        \
             cc::event::broadcast<BusEventClass>();                                              \
         }                                                                                       \
+        template <typename... ARGS>                                                             \
+        static inline void broadcastDeferred(ARGS &&...args) {                                  \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);           \
+        }                                                                                       \
     };
 
 #define DECLARE_BUS_EVENT_ARG1(BusEventClass, EventBusClass, ArgType0)                                    \
@@ -26,6 +30,10 @@
         static inline void broadcast(ArgType0 arg0) {                                                     \
             cc::event::broadcast<BusEventClass>(arg0);                                                    \
         }                                                                                                 \
+        template <typename... ARGS>                                                                       \
+        static inline void broadcastDeferred(ARGS &&...args) {                                            \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                     \
+        }                                                                                                 \
     };
 
 #define DECLARE_BUS_EVENT_ARG2(BusEventClass, EventBusClass, ArgType0, ArgType1)                                    \
@@ -40,6 +48,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1) {                                                \
             cc::event::broadcast<BusEventClass>(arg0, arg1);                                                        \
         }                                                                                                           \
+        template <typename... ARGS>                                                                                 \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                      \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                               \
+        }                                                                                                           \
     };
 
 #define DECLARE_BUS_EVENT_ARG3(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2)                                    \
@@ -54,6 +66,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2) {                                           \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2);                                                            \
         }                                                                                                                     \
+        template <typename... ARGS>                                                                                           \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                         \
+        }                                                                                                                     \
     };
 
 #define DECLARE_BUS_EVENT_ARG4(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3)                                    \
@@ -68,6 +84,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3) {                                      \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3);                                                                \
         }                                                                                                                               \
+        template <typename... ARGS>                                                                                                     \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                          \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                   \
+        }                                                                                                                               \
     };
 
 #define DECLARE_BUS_EVENT_ARG5(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4)                                    \
@@ -82,6 +102,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4) {                                 \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4);                                                                    \
         }                                                                                                                                         \
+        template <typename... ARGS>                                                                                                               \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                    \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                             \
+        }                                                                                                                                         \
     };
 
 #define DECLARE_BUS_EVENT_ARG6(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5)                                    \
@@ -96,6 +120,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5) {                            \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5);                                                                        \
         }                                                                                                                                                   \
+        template <typename... ARGS>                                                                                                                         \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                              \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                       \
+        }                                                                                                                                                   \
     };
 
 #define DECLARE_BUS_EVENT_ARG7(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6)                                    \
@@ -110,6 +138,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6) {                       \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6);                                                                            \
         }                                                                                                                                                             \
+        template <typename... ARGS>                                                                                                                                   \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                        \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                 \
+        }                                                                                                                                                             \
     };
 
 #define DECLARE_BUS_EVENT_ARG8(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7)                                    \
@@ -124,6 +156,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7) {                  \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7);                                                                                \
         }                                                                                                                                                                       \
+        template <typename... ARGS>                                                                                                                                             \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                  \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                           \
+        }                                                                                                                                                                       \
     };
 
 #define DECLARE_BUS_EVENT_ARG9(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8)                                    \
@@ -138,6 +174,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8) {             \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8);                                                                                    \
         }                                                                                                                                                                                 \
+        template <typename... ARGS>                                                                                                                                                       \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                            \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                     \
+        }                                                                                                                                                                                 \
     };
 
 #define DECLARE_BUS_EVENT_ARG10(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9)                                   \
@@ -152,6 +192,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9) {        \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9);                                                                                        \
         }                                                                                                                                                                                           \
+        template <typename... ARGS>                                                                                                                                                                 \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                      \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                               \
+        }                                                                                                                                                                                           \
     };
 
 #define DECLARE_BUS_EVENT_ARG11(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10)                                   \
@@ -166,6 +210,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10) {  \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10);                                                                                            \
         }                                                                                                                                                                                                      \
+        template <typename... ARGS>                                                                                                                                                                            \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                 \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                          \
+        }                                                                                                                                                                                                      \
     };
 
 #define DECLARE_BUS_EVENT_ARG12(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11)                                        \
@@ -180,6 +228,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11);                                                                                                     \
         }                                                                                                                                                                                                                      \
+        template <typename... ARGS>                                                                                                                                                                                            \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                 \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                          \
+        }                                                                                                                                                                                                                      \
     };
 
 #define DECLARE_BUS_EVENT_ARG13(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12)                                              \
@@ -194,6 +246,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12);                                                                                                               \
         }                                                                                                                                                                                                                                       \
+        template <typename... ARGS>                                                                                                                                                                                                             \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                  \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                           \
+        }                                                                                                                                                                                                                                       \
     };
 
 #define DECLARE_BUS_EVENT_ARG14(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12, ArgType13)                                                    \
@@ -208,6 +264,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12, ArgType13 arg13) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13);                                                                                                                         \
         }                                                                                                                                                                                                                                                        \
+        template <typename... ARGS>                                                                                                                                                                                                                              \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                                   \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                                            \
+        }                                                                                                                                                                                                                                                        \
     };
 
 #define DECLARE_BUS_EVENT_ARG15(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12, ArgType13, ArgType14)                                                          \
@@ -222,6 +282,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12, ArgType13 arg13, ArgType14 arg14) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14);                                                                                                                                   \
         }                                                                                                                                                                                                                                                                         \
+        template <typename... ARGS>                                                                                                                                                                                                                                               \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                                                    \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                                                             \
+        }                                                                                                                                                                                                                                                                         \
     };
 
 #define DECLARE_BUS_EVENT_ARG16(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12, ArgType13, ArgType14, ArgType15)                                                                \
@@ -236,6 +300,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12, ArgType13 arg13, ArgType14 arg14, ArgType15 arg15) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15);                                                                                                                                             \
         }                                                                                                                                                                                                                                                                                          \
+        template <typename... ARGS>                                                                                                                                                                                                                                                                \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                                                                     \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                                                                              \
+        }                                                                                                                                                                                                                                                                                          \
     };
 
 #define DECLARE_BUS_EVENT_ARG17(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12, ArgType13, ArgType14, ArgType15, ArgType16)                                                                      \
@@ -250,6 +318,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12, ArgType13 arg13, ArgType14 arg14, ArgType15 arg15, ArgType16 arg16) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16);                                                                                                                                                       \
         }                                                                                                                                                                                                                                                                                                           \
+        template <typename... ARGS>                                                                                                                                                                                                                                                                                 \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                                                                                      \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                                                                                               \
+        }                                                                                                                                                                                                                                                                                                           \
     };
 
 #define DECLARE_BUS_EVENT_ARG18(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12, ArgType13, ArgType14, ArgType15, ArgType16, ArgType17)                                                                            \
@@ -264,6 +336,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12, ArgType13 arg13, ArgType14 arg14, ArgType15 arg15, ArgType16 arg16, ArgType17 arg17) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16, arg17);                                                                                                                                                                 \
         }                                                                                                                                                                                                                                                                                                                            \
+        template <typename... ARGS>                                                                                                                                                                                                                                                                                                  \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                                                                                                       \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                                                                                                                \
+        }                                                                                                                                                                                                                                                                                                                            \
     };
 
 #define DECLARE_BUS_EVENT_ARG19(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12, ArgType13, ArgType14, ArgType15, ArgType16, ArgType17, ArgType18)                                                                                  \
@@ -278,6 +354,10 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12, ArgType13 arg13, ArgType14 arg14, ArgType15 arg15, ArgType16 arg16, ArgType17 arg17, ArgType18 arg18) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16, arg17, arg18);                                                                                                                                                                           \
         }                                                                                                                                                                                                                                                                                                                                             \
+        template <typename... ARGS>                                                                                                                                                                                                                                                                                                                   \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                                                                                                                        \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                                                                                                                                 \
+        }                                                                                                                                                                                                                                                                                                                                             \
     };
 
 #define DECLARE_BUS_EVENT_ARG20(BusEventClass, EventBusClass, ArgType0, ArgType1, ArgType2, ArgType3, ArgType4, ArgType5, ArgType6, ArgType7, ArgType8, ArgType9, ArgType10, ArgType11, ArgType12, ArgType13, ArgType14, ArgType15, ArgType16, ArgType17, ArgType18, ArgType19)                                                                                        \
@@ -292,4 +372,8 @@
         static inline void broadcast(ArgType0 arg0, ArgType1 arg1, ArgType2 arg2, ArgType3 arg3, ArgType4 arg4, ArgType5 arg5, ArgType6 arg6, ArgType7 arg7, ArgType8 arg8, ArgType9 arg9, ArgType10 arg10, ArgType11 arg11, ArgType12 arg12, ArgType13 arg13, ArgType14 arg14, ArgType15 arg15, ArgType16 arg16, ArgType17 arg17, ArgType18 arg18, ArgType19 arg19) { \
             cc::event::broadcast<BusEventClass>(arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16, arg17, arg18, arg19);                                                                                                                                                                                     \
         }                                                                                                                                                                                                                                                                                                                                                              \
+        template <typename... ARGS>                                                                                                                                                                                                                                                                                                                                    \
+        static inline void broadcastDeferred(ARGS &&...args) {                                                                                                                                                                                                                                                                                                         \
+            cc::event::broadcastDeferred<BusEventClass>(std::forward<ARGS>(args)...);                                                                                                                                                                                                                                                                                  \
+        }                                                                                                                                                                                                                                                                                                                                                              \
     };
@@ -101,6 +101,15 @@ struct TupleExtractor<std::tuple<ARGS...>> {
     using std_func_type = std::function<void(ARGS...)>;
 };
 
+// argument values stored by deferred broadcasts
+template <typename T>
+struct DecayedTuple;
+
+template <typename... ARGS>
+struct DecayedTuple<std::tuple<ARGS...>> {
+    using type = std::tuple<std::decay_t<ARGS>...>;
+};
+
 template <typename F>
 struct FunctionTrait : public FunctionTrait<decltype(&F::operator())> {
     constexpr static bool IS_LAMBDA = true;
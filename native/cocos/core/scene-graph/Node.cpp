@@ -65,6 +65,9 @@ Node::Node(const ccstd::string &name) {
 }
 
 Node::~Node() {
+    if (_transformBatchSlot != NodeTransformBatch::INVALID_SLOT) {
+        NodeTransformBatch::getInstance().removeSlot(_transformBatchSlot);
+    }
     if (!_children.empty()) {
         // Reset children's _parent to nullptr to avoid dangerous pointer
         for (const auto &child : _children) {
@@ -395,6 +398,7 @@ Node *Node::getChildByPath(const ccstd::string &path) const {
 
 //
 void Node::setPositionInternal(float x, float y, float z, bool calledFromJS) {
+    applyTransformBatch();
     if (_localPosition.approxEquals({x, y, z})) {
         return;
     }
@@ -412,6 +416,7 @@ void Node::setPositionInternal(float x, float y, float z, bool calledFromJS) {
 }
 
 void Node::setRotationInternal(float x, float y, float z, float w, bool calledFromJS) {
+    applyTransformBatch();
     if (_localRotation.approxEquals({x, y, z, w})) {
         return;
     }
@@ -431,6 +436,7 @@ void Node::setRotationInternal(float x, float y, float z, float w, bool calledFr
 }
 
 void Node::setRotationFromEuler(float x, float y, float z) {
+    applyTransformBatch();
     _euler.set(x, y, z);
     Quaternion::fromEuler(x, y, z, &_localRotation);
     _eulerDirty = false;
@@ -443,6 +449,7 @@ void Node::setRotationFromEuler(float x, float y, float z) {
 }
 
 void Node::setScaleInternal(float x, float y, float z, bool calledFromJS) {
+    applyTransformBatch();
     if (_localScale.approxEquals({x, y, z})) {
         return;
     }
@@ -459,6 +466,7 @@ void Node::setScaleInternal(float x, float y, float z, bool calledFromJS) {
     }
 }
 void Node::updateWorldTransform() { // NOLINT(misc-no-recursion)
+    applyTransformBatch();
     uint32_t dirtyBits = 0;
     updateWorldTransformRecursive(dirtyBits);
 }
@@ -542,6 +550,7 @@ void Node::invalidateChildren(TransformBit dirtyBit) { // NOLINT(misc-no-recursi
 }
 
 void Node::setWorldPosition(float x, float y, float z) {
+    applyTransformBatch();
     bool forceUpdate = _parent != nullptr && (_transformFlags & static_cast<uint32_t>(TransformBit::POSITION)) != static_cast<uint32_t>(TransformBit::NONE);
 
     if (!forceUpdate && _worldPosition.approxEquals({x, y, z})) {
@@ -572,6 +581,7 @@ const Vec3 &Node::getWorldPosition() const {
 }
 
 void Node::setWorldRotation(float x, float y, float z, float w) {
+    applyTransformBatch();
     bool forceUpdate = _parent != nullptr && (_transformFlags & static_cast<uint32_t>(TransformBit::ROTATION)) != static_cast<uint32_t>(TransformBit::NONE);
 
     if (!forceUpdate && _worldRotation.approxEquals({x, y, z, w})) {
@@ -604,6 +614,7 @@ const Quaternion &Node::getWorldRotation() const { // NOLINT(misc-no-recursion)
 }
 
 void Node::setWorldScale(float x, float y, float z) {
+    applyTransformBatch();
     bool forceUpdate = _parent != nullptr && (_transformFlags & static_cast<uint32_t>(TransformBit::SCALE)) != static_cast<uint32_t>(TransformBit::NONE);
 
     if (!forceUpdate && _worldScale.approxEquals({x, y, z})) {
@@ -659,6 +670,7 @@ void Node::setForward(const Vec3 &dir) {
 }
 
 void Node::setAngle(float val) {
+    applyTransformBatch();
     if (_euler.approxEquals({0, 0, val})) {
         return;
     }
@@ -705,6 +717,7 @@ void Node::onSetParent(Node *oldParent, bool keepWorldTransform) {
 }
 
 void Node::rotate(const Quaternion &rot, NodeSpace ns /* = NodeSpace::LOCAL*/, bool calledFromJS /* = false*/) {
+    applyTransformBatch();
     Quaternion qTempA{rot};
     qTempA.normalize();
     if (ns == NodeSpace::LOCAL) {
@@ -753,6 +766,7 @@ void Node::inverseTransformPointRecursive(Vec3 &out) const { // NOLINT(misc-no-r
 }
 
 void Node::setMatrix(const Mat4 &val) {
+    applyTransformBatch();
     val.decompose(&_localScale, &_localRotation, &_localPosition);
     notifyLocalPositionRotationScaleUpdated();
 
@@ -770,6 +784,7 @@ void Node::setWorldRotationFromEuler(float x, float y, float z) {
 }
 
 void Node::setRTSInternal(Quaternion *rot, Vec3 *pos, Vec3 *scale, bool calledFromJS) {
+    applyTransformBatch();
     uint32_t dirtyBit = 0;
     if (rot) {
         dirtyBit |= static_cast<uint32_t>(TransformBit::ROTATION);
@@ -820,6 +835,7 @@ ccstd::string Node::getPathInHierarchy() const {
 }
 
 void Node::translate(const Vec3 &trans, NodeSpace ns) {
+    applyTransformBatch();
     Vec3 v3Temp{trans};
     if (ns == NodeSpace::LOCAL) {
         v3Temp.transformQuat(_localRotation);
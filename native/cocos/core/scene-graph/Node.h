@@ -33,6 +33,7 @@
 #include "core/event/EventTarget.h"
 #include "core/scene-graph/Layers.h"
 #include "core/scene-graph/NodeEnum.h"
+#include "core/scene-graph/NodeTransformBatch.h"
 #include "math/Mat3.h"
 #include "math/Mat4.h"
 #include "math/Quaternion.h"
@@ -247,9 +248,9 @@ public:
      * @param position Target position
      */
     inline void setPosition(const Vec3 &pos) { setPosition(pos.x, pos.y, pos.z); }
-    inline void setPosition(float x, float y) { setPosition(x, y, _localPosition.z); }
+    inline void setPosition(float x, float y) { setPosition(x, y, getPosition().z); }
     inline void setPosition(float x, float y, float z) { setPositionInternal(x, y, z, false); }
-    inline void setPositionInternal(float x, float y, bool calledFromJS) { setPositionInternal(x, y, _localPosition.z, calledFromJS); }
+    inline void setPositionInternal(float x, float y, bool calledFromJS) { setPositionInternal(x, y, getPosition().z, calledFromJS); }
     void setPositionInternal(float x, float y, float z, bool calledFromJS);
     // It is invoked after deserialization. It only sets position value, not triggers other logic.
     inline void setPositionForJS(float x, float y, float z) { _localPosition.set(x, y, z); }
@@ -259,7 +260,10 @@ public:
      * @param out Set the result to out vector
      * @return If `out` given, the return value equals to `out`, otherwise a new vector will be generated and return
      */
-    inline const Vec3 &getPosition() const { return _localPosition; }
+    inline const Vec3 &getPosition() const {
+        applyTransformBatch();
+        return _localPosition;
+    }
 
     /**
      * @en Set rotation in local coordinate system with a quaternion representing the rotation
@@ -273,7 +277,10 @@ public:
 
     inline void setEulerAngles(const Vec3 &val) { setRotationFromEuler(val.x, val.y, val.z); }
     inline void setRotationFromEuler(const Vec3 &val) { setRotationFromEuler(val.x, val.y, val.z); }
-    inline void setRotationFromEuler(float x, float y) { setRotationFromEuler(x, y, _euler.z); }
+    inline void setRotationFromEuler(float x, float y) {
+        applyTransformBatch();
+        setRotationFromEuler(x, y, _euler.z);
+    }
     void setRotationFromEuler(float x, float y, float z);
     inline void setRotationFromEulerForJS(float x, float y, float z) { _euler.set(x, y, z); }
     /**
@@ -282,7 +289,10 @@ public:
      * @param out Set the result to out quaternion
      * @return If `out` given, the return value equals to `out`, otherwise a new quaternion will be generated and return
      */
-    inline const Quaternion &getRotation() const { return _localRotation; }
+    inline const Quaternion &getRotation() const {
+        applyTransformBatch();
+        return _localRotation;
+    }
 
     /**
      * @en Set scale in local coordinate system
@@ -290,9 +300,9 @@ public:
      * @param scale Target scale
      */
     inline void setScale(const Vec3 &scale) { setScale(scale.x, scale.y, scale.z); }
-    inline void setScale(float x, float y) { setScale(x, y, _localScale.z); }
+    inline void setScale(float x, float y) { setScale(x, y, getScale().z); }
     inline void setScale(float x, float y, float z) { setScaleInternal(x, y, z, false); }
-    inline void setScaleInternal(float x, float y, bool calledFromJS) { setScaleInternal(x, y, _localScale.z, calledFromJS); }
+    inline void setScaleInternal(float x, float y, bool calledFromJS) { setScaleInternal(x, y, getScale().z, calledFromJS); }
     void setScaleInternal(float x, float y, float z, bool calledFromJS);
     inline void setScaleForJS(float x, float y, float z) { _localScale.set(x, y, z); }
     /**
@@ -301,7 +311,10 @@ public:
      * @param out Set the result to out vector
      * @return If `out` given, the return value equals to `out`, otherwise a new vector will be generated and return
      */
-    inline const Vec3 &getScale() const { return _localScale; }
+    inline const Vec3 &getScale() const {
+        applyTransformBatch();
+        return _localScale;
+    }
 
     /**
      * @en Inversely transform a point from world coordinate system to local coordinate system.
@@ -413,6 +426,7 @@ public:
     void setAngle(float);
 
     inline const Vec3 &getEulerAngles() const {
+        applyTransformBatch();
         if (_eulerDirty) {
             auto *thiz = const_cast<Node *>(this);
             Quaternion::toEuler(_localRotation, false, &(thiz->_euler));
@@ -614,6 +628,14 @@ private:
     void inverseTransformPointRecursive(Vec3 &out) const;
     void updateWorldTransformRecursive(uint32_t &superDirtyBits);
 
+    // local transforms batched by script must be applied before native reads or writes local or world transforms
+    static inline void applyTransformBatch() {
+        auto &transformBatch = NodeTransformBatch::getInstance();
+        if (!transformBatch.empty()) {
+            transformBatch.apply();
+        }
+    }
+
     inline void notifyLocalPositionUpdated() {
         emit<LocalPositionUpdated>(_localPosition.x, _localPosition.y, _localPosition.z);
     }
@@ -681,7 +703,10 @@ private:
 
     bool _eulerDirty{false};
 
+    uint32_t _transformBatchSlot{NodeTransformBatch::INVALID_SLOT};
+
     friend class NodeActivator;
+    friend class NodeTransformBatch;
     friend class Scene;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Node);
@@ -0,0 +1,210 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/scene-graph/NodeTransformBatch.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Macros.h"
+#include "core/scene-graph/Node.h"
+
+namespace cc {
+
+namespace {
+constexpr uint32_t HEADER_SIZE = 1;
+constexpr uint32_t FLOAT_COUNT = NodeTransformBatch::RECORD_SIZE - 2;
+} // namespace
+
+NodeTransformBatch &NodeTransformBatch::getInstance() {
+    static NodeTransformBatch instance{DEFAULT_CAPACITY};
+    return instance;
+}
+
+NodeTransformBatch::NodeTransformBatch(uint32_t capacity)
+: _buffer(HEADER_SIZE + capacity * RECORD_SIZE, 0),
+  _capacity(capacity) {
+    CC_ASSERT(capacity > 0);
+}
+
+NodeTransformBatch::~NodeTransformBatch() {
+    for (auto *node : _nodes) {
+        if (node) {
+            node->_transformBatchSlot = INVALID_SLOT;
+        }
+    }
+}
+
+uint32_t NodeTransformBatch::getSlot(Node *node) {
+    CC_ASSERT_NOT_NULL(node);
+    if (node->_transformBatchSlot != INVALID_SLOT) {
+        return node->_transformBatchSlot;
+    }
+    uint32_t slot = 0;
+    if (_freeSlots.empty()) {
+        slot = static_cast<uint32_t>(_nodes.size());
+        _nodes.emplace_back(node);
+        _dirtyIndices.emplace_back(INVALID_SLOT);
+    } else {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _nodes[slot] = node;
+    }
+    node->_transformBatchSlot = slot;
+    return slot;
+}
+
+void NodeTransformBatch::removeSlot(uint32_t slot) noexcept {
+    if (slot >= _nodes.size() || !_nodes[slot]) {
+        return;
+    }
+    // drop pending records, the slot may be reused by another node before the batch is applied
+    auto dropRecords = [slot](uint32_t *record, uint32_t count) {
+        for (uint32_t i = 0; i != count; ++i, record += RECORD_SIZE) {
+            if (record[0] == slot) {
+                record[1] = 0;
+            }
+        }
+    };
+    dropRecords(_buffer.data() + HEADER_SIZE, std::min(size(), _capacity));
+    dropRecords(_overflow.data(), static_cast<uint32_t>(_overflow.size() / RECORD_SIZE));
+    _nodes[slot]->_transformBatchSlot = INVALID_SLOT;
+    _nodes[slot] = nullptr;
+    _freeSlots.emplace_back(slot);
+}
+
+void NodeTransformBatch::push(uint32_t slot, TransformBit dirtyBits, const Vec3 &position, const Quaternion &rotation, const Vec3 &scale) {
+    uint32_t *record = nullptr;
+    if (size() < _capacity) {
+        record = _buffer.data() + HEADER_SIZE + size() * RECORD_SIZE;
+        ++_buffer[0];
+    } else if (_applying) {
+        // pushed by a transform listener, the batch can't be applied recursively
+        const auto offset = _overflow.size();
+        _overflow.resize(offset + RECORD_SIZE);
+        record = _overflow.data() + offset;
+    } else {
+        apply();
+        record = _buffer.data() + HEADER_SIZE;
+        _buffer[0] = 1;
+    }
+    const float values[FLOAT_COUNT] = {
+        position.x, position.y, position.z,
+        rotation.x, rotation.y, rotation.z, rotation.w,
+        scale.x, scale.y, scale.z};
+    record[0] = slot;
+    record[1] = static_cast<uint32_t>(dirtyBits);
+    memcpy(record + 2, values, sizeof(values));
+}
+
+uint32_t NodeTransformBatch::apply() {
+    // transform listeners may read world transforms while the batch is applied
+    if (_applying || empty()) {
+        return 0;
+    }
+    _applying = true;
+
+    uint32_t applied = 0;
+    // listeners may push new records, they are applied in another round
+    while (!empty() || !_overflow.empty()) {
+        const uint32_t count = std::min(size(), _capacity);
+        collectRecords(_buffer.data() + HEADER_SIZE, count);
+        // the overflow is newer than the full buffer
+        const auto overflowCount = static_cast<uint32_t>(_overflow.size() / RECORD_SIZE);
+        collectRecords(_overflow.data(), overflowCount);
+        applied += count + overflowCount;
+        // records are consumed, listeners below may start a new batch
+        _buffer[0] = 0;
+        _overflow.clear();
+
+        notifyDirtyNodes();
+    }
+
+    _applying = false;
+    return applied;
+}
+
+void NodeTransformBatch::collectRecords(const uint32_t *records, uint32_t count) {
+    const auto *record = records;
+    for (uint32_t i = 0; i != count; ++i, record += RECORD_SIZE) {
+        const uint32_t slot = record[0];
+        const uint32_t bits = record[1] & static_cast<uint32_t>(TransformBit::TRS);
+        if (slot >= _nodes.size() || !_nodes[slot] || !bits) {
+            continue;
+        }
+        auto *node = _nodes[slot];
+        float values[FLOAT_COUNT];
+        memcpy(values, record + 2, sizeof(values));
+
+        uint32_t changed = 0;
+        if (bits & static_cast<uint32_t>(TransformBit::POSITION)) {
+            const Vec3 position{values[0], values[1], values[2]};
+            if (!node->_localPosition.approxEquals(position)) {
+                node->_localPosition = position;
+                changed |= static_cast<uint32_t>(TransformBit::POSITION);
+            }
+        }
+        if (bits & static_cast<uint32_t>(TransformBit::ROTATION)) {
+            const Quaternion rotation{values[3], values[4], values[5], values[6]};
+            if (!node->_localRotation.approxEquals(rotation)) {
+                node->_localRotation = rotation;
+                node->_eulerDirty = true;
+                changed |= static_cast<uint32_t>(TransformBit::ROTATION);
+            }
+        }
+        if (bits & static_cast<uint32_t>(TransformBit::SCALE)) {
+            const Vec3 scale{values[7], values[8], values[9]};
+            if (!node->_localScale.approxEquals(scale)) {
+                node->_localScale = scale;
+                changed |= static_cast<uint32_t>(TransformBit::SCALE);
+            }
+        }
+        if (!changed) {
+            continue;
+        }
+
+        auto &index = _dirtyIndices[slot];
+        if (index == INVALID_SLOT) {
+            index = static_cast<uint32_t>(_dirtyNodes.size());
+            _dirtyNodes.emplace_back(DirtyNode{node, slot, changed});
+        } else {
+            _dirtyNodes[index].dirtyBits |= changed;
+        }
+    }
+}
+
+void NodeTransformBatch::notifyDirtyNodes() {
+    for (const auto &dirty : _dirtyNodes) {
+        _dirtyIndices[dirty.slot] = INVALID_SLOT;
+    }
+    for (const auto &dirty : _dirtyNodes) {
+        auto *node = dirty.node;
+        const auto dirtyBits = static_cast<TransformBit>(dirty.dirtyBits);
+        node->invalidateChildren(dirtyBits);
+        if (node->_eventMask & Node::TRANSFORM_ON) {
+            node->emit<Node::TransformChanged>(dirtyBits);
+        }
+    }
+    _dirtyNodes.clear();
+}
+
+} // namespace cc
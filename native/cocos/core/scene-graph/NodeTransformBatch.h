@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/TypeDef.h"
+#include "base/std/container/vector.h"
+#include "core/scene-graph/NodeEnum.h"
+
+namespace cc {
+
+class Node;
+class Quaternion;
+class Vec3;
+
+/**
+ * Bulk channel for local transform updates from script.
+ * Script writes (slot, TransformBit, position, rotation, scale) records into a buffer shared with native,
+ * the whole batch is applied with a single dirty propagation pass before native reads any world transform,
+ * and at latest when the frame starts.
+ *
+ * Buffer layout, in 32-bit words:
+ *  0: record count, written by script and reset by native when the batch is applied
+ *  1 + i * RECORD_SIZE: slot (Uint32), dirty bits (Uint32), position (3 x Float32), rotation (4 x Float32), scale (3 x Float32)
+ */
+class CC_DLL NodeTransformBatch final {
+public:
+    static constexpr uint32_t RECORD_SIZE = 12;
+    static constexpr uint32_t DEFAULT_CAPACITY = 4096;
+    static constexpr uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+    static NodeTransformBatch &getInstance();
+
+    ~NodeTransformBatch();
+
+    uint32_t getSlot(Node *node);
+    void removeSlot(uint32_t slot) noexcept;
+
+    // Writes a record from native, only the fields selected by dirtyBits are applied.
+    // The batch is applied first when it is full, records pushed by transform listeners while
+    // the batch is applied are kept aside and applied before apply() returns.
+    void push(uint32_t slot, TransformBit dirtyBits, const Vec3 &position, const Quaternion &rotation, const Vec3 &scale);
+    // Returns the number of records applied.
+    uint32_t apply();
+
+    inline bool empty() const noexcept { return _buffer[0] == 0; }
+    inline uint32_t size() const noexcept { return _buffer[0]; }
+    inline uint32_t getCapacity() const noexcept { return _capacity; }
+    inline uint32_t *getBuffer() noexcept { return _buffer.data(); }
+    inline uint32_t getByteLength() const noexcept { return static_cast<uint32_t>(_buffer.size() * sizeof(uint32_t)); }
+
+private:
+    // nodes remove their slots from the shared instance when destroyed
+    explicit NodeTransformBatch(uint32_t capacity);
+
+    void collectRecords(const uint32_t *records, uint32_t count);
+    void notifyDirtyNodes();
+
+    struct DirtyNode {
+        Node *node{nullptr};
+        uint32_t slot{0};
+        uint32_t dirtyBits{0};
+    };
+
+    ccstd::vector<uint32_t> _buffer;
+    uint32_t _capacity{0};
+    // weak references, nodes remove their slots when destroyed
+    ccstd::vector<Node *> _nodes;
+    ccstd::vector<uint32_t> _freeSlots;
+    ccstd::vector<DirtyNode> _dirtyNodes;
+    // slot -> index in _dirtyNodes while applying, so each node is invalidated once
+    ccstd::vector<uint32_t> _dirtyIndices;
+    // records pushed while the batch is applied and the shared buffer is full, same layout as the buffer
+    ccstd::vector<uint32_t> _overflow;
+    bool _applying{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(NodeTransformBatch);
+};
+
+} // namespace cc
@@ -23,70 +23,30 @@
 ****************************************************************************/
 
 #include "IOTypedArray.h"
-#include "TypedArrayPool.h"
-
-#define USE_TYPEARRAY_POOL 0
+#include "base/memory/Memory.h"
 
 MIDDLEWARE_BEGIN
 
-IOTypedArray::IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, bool usePool) {
+IOTypedArray::IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, std::size_t maxSize) {
     _arrayType = arrayType;
     _bufferSize = defaultSize;
-    _usePool = usePool;
-
-    if (_usePool) {
-        _typeArray = TypedArrayPool::getInstance()->pop(_arrayType, _bufferSize);
-    } else {
-        se::AutoHandleScope hs;
-        _typeArray = se::Object::createTypedArray(_arrayType, nullptr, _bufferSize);
-        _typeArray->root();
-    }
-
-    se::AutoHandleScope hs;
-    _typeArray->getTypedArrayData(&_buffer, &_bufferSize);
+    _scriptBuffer = ccnew se::ScriptBuffer(static_cast<uint32_t>(defaultSize), static_cast<uint32_t>(maxSize));
+    _buffer = _scriptBuffer->getData();
 }
 
 IOTypedArray::~IOTypedArray() {
-    if (_usePool) {
-        TypedArrayPool::getInstance()->push(_arrayType, _bufferSize, _typeArray);
-    } else {
-        _typeArray->unroot();
-        _typeArray->decRef();
-    }
-    _typeArray = nullptr;
+    delete _scriptBuffer;
+    _scriptBuffer = nullptr;
+    // owned by _scriptBuffer
     _buffer = nullptr;
 }
 
-void IOTypedArray::resize(std::size_t newLen, bool needCopy) {
+void IOTypedArray::resize(std::size_t newLen, bool /*needCopy*/) {
     if (_bufferSize >= newLen) return;
 
-    se::Object *newTypeBuffer = nullptr;
-
-    if (_usePool) {
-        newTypeBuffer = TypedArrayPool::getInstance()->pop(_arrayType, newLen);
-    } else {
-        se::AutoHandleScope hs;
-        newTypeBuffer = se::Object::createTypedArray(_arrayType, nullptr, newLen);
-        newTypeBuffer->root();
-    }
-
-    uint8_t *newBuffer = nullptr;
-    se::AutoHandleScope hs;
-    newTypeBuffer->getTypedArrayData(&newBuffer, static_cast<size_t *>(&newLen));
-
-    if (needCopy) {
-        memcpy(newBuffer, _buffer, _bufferSize);
-    }
-
-    if (_usePool) {
-        TypedArrayPool::getInstance()->push(_arrayType, _bufferSize, _typeArray);
-    } else {
-        _typeArray->unroot();
-        _typeArray->decRef();
-    }
-
-    _typeArray = newTypeBuffer;
-    _buffer = newBuffer;
+    // the content is always kept, the data moves only if it grows beyond the reservation
+    _scriptBuffer->resize(static_cast<uint32_t>(newLen));
+    _buffer = _scriptBuffer->getData();
     _bufferSize = newLen;
     _outRange = false;
 }
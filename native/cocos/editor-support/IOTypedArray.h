@@ -28,6 +28,7 @@
 #include "MiddlewareMacro.h"
 #include "SeApi.h"
 #include "base/Macros.h"
+#include "bindings/dop/ScriptBufferArena.h"
 
 MIDDLEWARE_BEGIN
 /**
@@ -39,21 +40,30 @@ public:
      * @brief constructor
      * @param[in] arrayType TypeArray type
      * @param[in] defaultSize TypeArray capacity
-     * @param[in] usePool If true,will get TypeArray from pool,or create TypeArray,default false.
+     * @param[in] maxSize Bytes reserved for growing without moving the data, 0 reserves a few times of defaultSize.
      */
-    IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, bool usePool = false);
+    IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, std::size_t maxSize = 0);
     ~IOTypedArray() override;
 
+    /**
+     * @brief Gets the TypeArray over the buffer, a new one is created only if the buffer has grown since the last call.
+     */
     inline se::Object *getTypeArray() const {
-        return _typeArray;
+        return _scriptBuffer->getTypedArray(_arrayType);
+    }
+
+    /**
+     * @brief Gets the slot of the buffer in the generation table shared with scripts.
+     */
+    inline uint32_t getGenerationSlot() const {
+        return _scriptBuffer->getSlot();
     }
 
     void resize(std::size_t newLen, bool needCopy) override;
 
 private:
     se::Object::TypedArrayType _arrayType = se::Object::TypedArrayType::NONE;
-    se::Object *_typeArray = nullptr;
-    bool _usePool = false;
+    se::ScriptBuffer *_scriptBuffer = nullptr;
 };
 
 MIDDLEWARE_END
@@ -52,6 +52,14 @@ public:
         return _buffer->getTypeArray();
     }
 
+    /**
+     * @brief Gets the slot of the buffer in jsb.scriptBufferGenerations,
+     * the shared buffer needs to be fetched again only if the generation in its slot changes.
+     */
+    uint32_t getGenerationSlot() const {
+        return _buffer->getGenerationSlot();
+    }
+
 private:
     void init();
     void afterCleanupHandle();
@@ -304,6 +304,8 @@ void Engine::tick() {
         se::ScriptEngine::getInstance()->handlePromiseExceptions();
         events::Tick::broadcast(dt);
         se::ScriptEngine::getInstance()->mainLoopUpdate();
+        // before the release pool is cleared, objects passed to deferred events are still alive
+        event::flushDeferredBroadcasts();
 
         cc::DeferredReleasePool::clear();
         if (_xr) _xr->endRenderFrame();
@@ -24,6 +24,9 @@
 ****************************************************************************/
 
 #include "LightProbe.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include "PolynomialSolver.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
@@ -32,9 +35,58 @@
 #include "math/Utils.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+#endif
+
 namespace cc {
 namespace gi {
 
+namespace {
+// Upper bound of grid cells along one axis
+constexpr int32_t MAX_GRID_DIMENSION = 32;
+
+// dst = c0 * w.x + c1 * w.y + c2 * w.z + c3 * w.w over one padded probe block, c3 may be null
+inline void blendCoefficients(const float *c0, const float *c1, const float *c2, const float *c3, const Vec4 &w, float *dst) {
+    constexpr uint32_t stride = LightProbesData::COEFFICIENT_STRIDE;
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    const __m128 w0 = _mm_set1_ps(w.x);
+    const __m128 w1 = _mm_set1_ps(w.y);
+    const __m128 w2 = _mm_set1_ps(w.z);
+    const __m128 w3 = _mm_set1_ps(w.w);
+    for (uint32_t i = 0; i < stride; i += 4) {
+        __m128 r = _mm_mul_ps(_mm_loadu_ps(c0 + i), w0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(c1 + i), w1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(c2 + i), w2));
+        if (c3) {
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(c3 + i), w3));
+        }
+        _mm_storeu_ps(dst + i, r);
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    for (uint32_t i = 0; i < stride; i += 4) {
+        float32x4_t r = vmulq_n_f32(vld1q_f32(c0 + i), w.x);
+        r = vmlaq_n_f32(r, vld1q_f32(c1 + i), w.y);
+        r = vmlaq_n_f32(r, vld1q_f32(c2 + i), w.z);
+        if (c3) {
+            r = vmlaq_n_f32(r, vld1q_f32(c3 + i), w.w);
+        }
+        vst1q_f32(dst + i, r);
+    }
+#else
+    for (uint32_t i = 0; i < stride; ++i) {
+        float r = c0[i] * w.x + c1[i] * w.y + c2[i] * w.z;
+        if (c3) {
+            r += c3[i] * w.w;
+        }
+        dst[i] = r;
+    }
+#endif
+}
+} // namespace
+
 void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
     _probes.clear();
 
@@ -43,11 +95,99 @@ void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
     for (auto i = 0; i < pointCount; i++) {
         _probes.emplace_back(points[i]);
     }
+    _cacheDirty = true;
 }
 
 void LightProbesData::updateTetrahedrons() {
     Delaunay delaunay(_probes);
     _tetrahedrons = delaunay.build();
+    _cacheDirty = true;
+}
+
+void LightProbesData::updateCache() {
+    if (!_cacheDirty) {
+        return;
+    }
+
+    _coefficients.clear();
+    if (hasCoefficients()) {
+        const auto basisCount = SH::getBasisCount();
+        _coefficients.resize(_probes.size() * COEFFICIENT_STRIDE, 0.0F);
+        for (size_t i = 0; i < _probes.size(); i++) {
+            const auto &src = _probes[i].coefficients;
+            float *dst = _coefficients.data() + i * COEFFICIENT_STRIDE;
+            const auto count = std::min(static_cast<uint32_t>(src.size()), basisCount);
+            for (uint32_t j = 0; j < count; j++) {
+                dst[j * 3 + 0] = src[j].x;
+                dst[j * 3 + 1] = src[j].y;
+                dst[j * 3 + 2] = src[j].z;
+            }
+        }
+    }
+
+    buildGrid();
+    _cacheDirty = false;
+}
+
+void LightProbesData::buildGrid() {
+    _gridCells.clear();
+    _gridDims = {0, 0, 0};
+    if (empty()) {
+        return;
+    }
+
+    Vec3 minPos = _probes[0].position;
+    Vec3 maxPos = _probes[0].position;
+    for (const auto &probe : _probes) {
+        minPos.x = std::min(minPos.x, probe.position.x);
+        minPos.y = std::min(minPos.y, probe.position.y);
+        minPos.z = std::min(minPos.z, probe.position.z);
+        maxPos.x = std::max(maxPos.x, probe.position.x);
+        maxPos.y = std::max(maxPos.y, probe.position.y);
+        maxPos.z = std::max(maxPos.z, probe.position.z);
+    }
+
+    // about one cell per tetrahedron
+    const auto dimension = std::max(1, std::min(MAX_GRID_DIMENSION,
+                                                static_cast<int32_t>(std::ceil(std::cbrt(static_cast<float>(_tetrahedrons.size()))))));
+    const Vec3 extent = maxPos - minPos;
+    const float extents[3] = {extent.x, extent.y, extent.z};
+    float invCellSize[3];
+    for (int32_t axis = 0; axis < 3; axis++) {
+        _gridDims[axis] = extents[axis] > mathutils::EPSILON ? dimension : 1;
+        invCellSize[axis] = extents[axis] > mathutils::EPSILON ? static_cast<float>(_gridDims[axis]) / extents[axis] : 0.0F;
+    }
+    _gridMin = minPos;
+    _gridInvCellSize.set(invCellSize[0], invCellSize[1], invCellSize[2]);
+    _gridCells.resize(static_cast<size_t>(_gridDims[0]) * _gridDims[1] * _gridDims[2]);
+
+    // neighbouring cells are visited in turn so each walk starts next to its target
+    Vec4 weights;
+    int32_t tetIndex = 0;
+    for (int32_t z = 0; z < _gridDims[2]; z++) {
+        for (int32_t y = 0; y < _gridDims[1]; y++) {
+            for (int32_t x = 0; x < _gridDims[0]; x++) {
+                const Vec3 center{
+                    minPos.x + (static_cast<float>(x) + 0.5F) * extent.x / static_cast<float>(_gridDims[0]),
+                    minPos.y + (static_cast<float>(y) + 0.5F) * extent.y / static_cast<float>(_gridDims[1]),
+                    minPos.z + (static_cast<float>(z) + 0.5F) * extent.z / static_cast<float>(_gridDims[2])};
+                tetIndex = walkTetrahedrons(center, tetIndex, weights);
+                _gridCells[(z * _gridDims[1] + y) * _gridDims[0] + x] = tetIndex;
+            }
+        }
+    }
+}
+
+int32_t LightProbesData::getGridTetrahedron(const Vec3 &position) const {
+    const auto toCell = [](float value, float min, float invCellSize, int32_t dimension) {
+        const auto cell = static_cast<int32_t>((value - min) * invCellSize);
+        return std::max(0, std::min(dimension - 1, cell));
+    };
+
+    const auto x = toCell(position.x, _gridMin.x, _gridInvCellSize.x, _gridDims[0]);
+    const auto y = toCell(position.y, _gridMin.y, _gridInvCellSize.y, _gridDims[1]);
+    const auto z = toCell(position.z, _gridMin.z, _gridInvCellSize.z, _gridDims[2]);
+    return _gridCells[(z * _gridDims[1] + y) * _gridDims[0] + x];
 }
 
 bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const {
@@ -55,30 +195,84 @@ bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec
         return false;
     }
 
-    const auto length = SH::getBasisCount();
-    coefficients.resize(length);
+    coefficients.resize(SH::getBasisCount());
+    return getInterpolationSHCoefficients(tetIndex, weights, coefficients.data());
+}
 
-    const auto &tetrahedron = _tetrahedrons[tetIndex];
-    const auto &c0 = _probes[tetrahedron.vertex0].coefficients;
-    const auto &c1 = _probes[tetrahedron.vertex1].coefficients;
-    const auto &c2 = _probes[tetrahedron.vertex2].coefficients;
+bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, Vec3 *coefficients) const {
+    return getInterpolationSHCoefficients(&tetIndex, &weights, 1, coefficients);
+}
 
-    if (tetrahedron.vertex3 >= 0) {
-        const auto &c3 = _probes[tetrahedron.vertex3].coefficients;
+bool LightProbesData::getInterpolationSHCoefficients(const int32_t *tetIndices, const Vec4 *weights, uint32_t count, Vec3 *coefficients) const {
+    if (!hasCoefficients()) {
+        return false;
+    }
 
-        for (auto i = 0; i < length; i++) {
-            coefficients[i] = c0[i] * weights.x + c1[i] * weights.y + c2[i] * weights.z + c3[i] * weights.w;
-        }
-    } else {
-        for (auto i = 0; i < length; i++) {
-            coefficients[i] = c0[i] * weights.x + c1[i] * weights.y + c2[i] * weights.z;
+    const auto length = SH::getBasisCount();
+    if (_cacheDirty || _coefficients.empty()) {
+        for (uint32_t n = 0; n < count; n++) {
+            const auto &tetrahedron = _tetrahedrons[tetIndices[n]];
+            const auto &w = weights[n];
+            const auto &c0 = _probes[tetrahedron.vertex0].coefficients;
+            const auto &c1 = _probes[tetrahedron.vertex1].coefficients;
+            const auto &c2 = _probes[tetrahedron.vertex2].coefficients;
+            Vec3 *dst = coefficients + n * length;
+
+            if (tetrahedron.vertex3 >= 0) {
+                const auto &c3 = _probes[tetrahedron.vertex3].coefficients;
+
+                for (auto i = 0; i < length; i++) {
+                    dst[i] = c0[i] * w.x + c1[i] * w.y + c2[i] * w.z + c3[i] * w.w;
+                }
+            } else {
+                for (auto i = 0; i < length; i++) {
+                    dst[i] = c0[i] * w.x + c1[i] * w.y + c2[i] * w.z;
+                }
+            }
         }
+        return true;
+    }
+
+    static_assert(sizeof(Vec3) == sizeof(float) * 3, "Vec3 should be tightly packed");
+    const float *base = _coefficients.data();
+    float blended[COEFFICIENT_STRIDE];
+    for (uint32_t n = 0; n < count; n++) {
+        const auto &tetrahedron = _tetrahedrons[tetIndices[n]];
+        const float *c0 = base + tetrahedron.vertex0 * COEFFICIENT_STRIDE;
+        const float *c1 = base + tetrahedron.vertex1 * COEFFICIENT_STRIDE;
+        const float *c2 = base + tetrahedron.vertex2 * COEFFICIENT_STRIDE;
+        const float *c3 = tetrahedron.vertex3 >= 0 ? base + tetrahedron.vertex3 * COEFFICIENT_STRIDE : nullptr;
+        blendCoefficients(c0, c1, c2, c3, weights[n], blended);
+        memcpy(coefficients + n * length, blended, length * sizeof(Vec3));
     }
 
     return true;
 }
 
 int32_t LightProbesData::getInterpolationWeights(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const {
+    const auto tetrahedronCount = static_cast<int32_t>(_tetrahedrons.size());
+    if (tetIndex >= 0 && tetIndex < tetrahedronCount) {
+        getBarycentricCoord(position, _tetrahedrons[tetIndex], weights);
+        if (weights.x >= 0.0F && weights.y >= 0.0F && weights.z >= 0.0F && weights.w >= 0.0F) {
+            return tetIndex;
+        }
+    }
+
+    // restart from the grid so teleported objects don't walk across the whole mesh
+    if (!_cacheDirty && !_gridCells.empty()) {
+        tetIndex = getGridTetrahedron(position);
+    }
+
+    return walkTetrahedrons(position, tetIndex, weights);
+}
+
+void LightProbesData::getInterpolationWeights(const Vec3 *positions, int32_t *tetIndices, Vec4 *weights, uint32_t count) const {
+    for (uint32_t i = 0; i < count; i++) {
+        tetIndices[i] = getInterpolationWeights(positions[i], tetIndices[i], weights[i]);
+    }
+}
+
+int32_t LightProbesData::walkTetrahedrons(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const {
     const auto tetrahedronCount = _tetrahedrons.size();
     if (tetIndex < 0 || tetIndex >= tetrahedronCount) {
         tetIndex = 0;
@@ -221,10 +415,10 @@ void LightProbeInfo::clearSHCoefficients() {
         return;
     }
 
-    auto &probes = _data->getProbes();
-    for (auto &probe : probes) {
+    for (auto &probe : _data->_probes) {
         probe.coefficients.clear();
     }
+    _data->markDirty();
 
     clearAllSHUBOs();
 }
@@ -30,6 +30,7 @@
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/std/container/array.h"
 #include "base/std/container/vector.h"
 #include "math/Vec3.h"
 #include "math/Vec4.h"
@@ -46,32 +47,71 @@ class LightProbesData : public RefCounted {
 public:
     LightProbesData() = default;
 
-    inline ccstd::vector<Vertex> &getProbes() { return _probes; }
-    inline void setProbes(const ccstd::vector<Vertex> &probes) { _probes = probes; }
-    inline ccstd::vector<Tetrahedron> &getTetrahedrons() { return _tetrahedrons; }
-    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) { _tetrahedrons = tetrahedrons; }
+    inline const ccstd::vector<Vertex> &getProbes() const { return _probes; }
+    inline void setProbes(const ccstd::vector<Vertex> &probes) {
+        _probes = probes;
+        _cacheDirty = true;
+    }
+    inline const ccstd::vector<Tetrahedron> &getTetrahedrons() const { return _tetrahedrons; }
+    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) {
+        _tetrahedrons = tetrahedrons;
+        _cacheDirty = true;
+    }
 
     inline bool empty() const { return _probes.empty() || _tetrahedrons.empty(); }
     inline void reset() {
         _probes.clear();
         _tetrahedrons.clear();
+        _cacheDirty = true;
     }
     void updateProbes(ccstd::vector<Vec3> &points);
     void updateTetrahedrons();
 
+    /**
+     * @en Rebuild the flat coefficient storage and the tetrahedron lookup grid if probes changed.
+     * Call it on the main thread, the interpolation methods fall back to the probe vertices while the cache is dirty.
+     * @zh 探针数据变化后重建系数缓存和四面体查找网格，需要在主线程调用。
+     */
+    void updateCache();
+    inline bool isCacheDirty() const { return _cacheDirty; }
+    // Call it after modifying _probes or _tetrahedrons in place, the cache is rebuilt at the next updateCache.
+    inline void markDirty() { _cacheDirty = true; }
+
     inline bool hasCoefficients() const { return !empty() && !_probes[0].coefficients.empty(); }
     bool getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const;
+    // coefficients should hold SH::getBasisCount() elements
+    bool getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, Vec3 *coefficients) const;
+    // Batched version, coefficients should hold count * SH::getBasisCount() elements
+    bool getInterpolationSHCoefficients(const int32_t *tetIndices, const Vec4 *weights, uint32_t count, Vec3 *coefficients) const;
     int32_t getInterpolationWeights(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const;
+    // Batched version, tetIndices holds the last indices on input and the found indices on output
+    void getInterpolationWeights(const Vec3 *positions, int32_t *tetIndices, Vec4 *weights, uint32_t count) const;
 
 private:
     static Vec3 getTriangleBarycentricCoord(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &position);
     void getBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
     void getTetrahedronBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
     void getOuterCellBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
+    int32_t walkTetrahedrons(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const;
+    int32_t getGridTetrahedron(const Vec3 &position) const;
+    void buildGrid();
 
 public:
     ccstd::vector<Vertex> _probes;
     ccstd::vector<Tetrahedron> _tetrahedrons;
+
+    // 9 rgb coefficients per probe padded to 28 floats, a whole number of 4-wide SIMD lanes
+    static constexpr uint32_t COEFFICIENT_STRIDE = 28;
+
+private:
+    bool _cacheDirty{true};
+    ccstd::vector<float> _coefficients;
+
+    // Uniform grid over the probe bounds, each cell stores the tetrahedron containing its center
+    Vec3 _gridMin;
+    Vec3 _gridInvCellSize;
+    ccstd::array<int32_t, 3> _gridDims{0, 0, 0};
+    ccstd::vector<int32_t> _gridCells;
 };
 
 class LightProbes final {
@@ -65,7 +65,10 @@ public:
     /**
      * update ubo data by coefficients
      */
-    static void updateUBOData(Float32Array& data, int32_t offset, ccstd::vector<Vec3>& coefficients);
+    static void updateUBOData(Float32Array& data, int32_t offset, const Vec3* coefficients);
+    static inline void updateUBOData(Float32Array& data, int32_t offset, ccstd::vector<Vec3>& coefficients) {
+        updateUBOData(data, offset, coefficients.data());
+    }
 
     /**
      * recreate a function from sh coefficients, which is same as SHEvaluate in shader
@@ -105,6 +108,10 @@ public:
     }
 
     static inline void reduceRinging(ccstd::vector<Vec3>& coefficients, float lambda) {
+        reduceRinging(coefficients.data(), lambda);
+    }
+
+    static inline void reduceRinging(Vec3* coefficients, float lambda) {
         if (lambda == 0.0F) {
             return;
         }
@@ -0,0 +1,439 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "network/DownloadCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "base/BinaryArchive.h"
+#include "base/Log.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace network {
+
+namespace {
+
+const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t rotr(uint32_t x, uint32_t n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+const uint32_t MAGIC = 0x43434443; // "CCDC"
+const uint32_t VERSION = 1;
+const char *const INDEX_FILE_NAME = "index.bin";
+const uint32_t DIGEST_LENGTH = 64;
+
+bool isValidDigest(const ccstd::string &digest) {
+    return digest.size() == DIGEST_LENGTH &&
+           std::all_of(digest.begin(), digest.end(), [](char c) {
+               return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+           });
+}
+
+int64_t getFileSize(const ccstd::string &path) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) {
+        return -1;
+    }
+    return static_cast<int64_t>(stream.tellg());
+}
+
+bool copyFile(const ccstd::string &srcPath, const ccstd::string &dstPath) {
+    std::ifstream src(srcPath, std::ios::binary);
+    std::ofstream dst(dstPath, std::ios::binary | std::ios::trunc);
+    if (!src.is_open() || !dst.is_open()) {
+        return false;
+    }
+    dst << src.rdbuf();
+    dst.flush();
+    return dst.good();
+}
+
+// Entries never share their storage with the files of the callers, which may be written in place.
+bool replaceWithCopy(const ccstd::string &srcPath, const ccstd::string &dstPath) {
+    std::remove(dstPath.c_str());
+    // copy to a temporary file so that an interrupted copy never looks complete
+    const ccstd::string tmpPath = dstPath + ".tmp";
+    if (!copyFile(srcPath, tmpPath) || std::rename(tmpPath.c_str(), dstPath.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+//  Implementation Sha256
+
+Sha256::Sha256() {
+    reset();
+}
+
+void Sha256::reset() {
+    static const uint32_t INITIAL_STATE[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memcpy(_state, INITIAL_STATE, sizeof(_state));
+    _length = 0;
+    _blockSize = 0;
+}
+
+void Sha256::update(const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    _length += size;
+    if (_blockSize) {
+        const size_t count = std::min(size, static_cast<size_t>(sizeof(_block) - _blockSize));
+        memcpy(_block + _blockSize, bytes, count);
+        _blockSize += static_cast<uint32_t>(count);
+        bytes += count;
+        size -= count;
+        if (_blockSize < sizeof(_block)) {
+            return;
+        }
+        transform(_block);
+        _blockSize = 0;
+    }
+    for (; size >= sizeof(_block); bytes += sizeof(_block), size -= sizeof(_block)) {
+        transform(bytes);
+    }
+    memcpy(_block, bytes, size);
+    _blockSize = static_cast<uint32_t>(size);
+}
+
+ccstd::string Sha256::finish() {
+    const uint64_t bitLength = _length * 8;
+    const uint8_t padding[64] = {0x80};
+    const uint32_t paddingSize = _blockSize < 56 ? 56 - _blockSize : 120 - _blockSize;
+    update(padding, paddingSize);
+    uint8_t lengthBytes[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        lengthBytes[i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+    }
+    update(lengthBytes, sizeof(lengthBytes));
+
+    static const char HEX[] = "0123456789abcdef";
+    ccstd::string digest(DIGEST_LENGTH, '0');
+    for (uint32_t i = 0; i < 32; ++i) {
+        const auto byte = static_cast<uint8_t>(_state[i / 4] >> (24 - (i % 4) * 8));
+        digest[i * 2] = HEX[byte >> 4];
+        digest[i * 2 + 1] = HEX[byte & 0xf];
+    }
+    return digest;
+}
+
+void Sha256::transform(const uint8_t *block) {
+    uint32_t w[64];
+    for (uint32_t i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+               (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+    }
+    for (uint32_t i = 16; i < 64; ++i) {
+        const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = _state[0];
+    uint32_t b = _state[1];
+    uint32_t c = _state[2];
+    uint32_t d = _state[3];
+    uint32_t e = _state[4];
+    uint32_t f = _state[5];
+    uint32_t g = _state[6];
+    uint32_t h = _state[7];
+    for (uint32_t i = 0; i < 64; ++i) {
+        const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        const uint32_t ch = (e & f) ^ (~e & g);
+        const uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+        const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    _state[0] += a;
+    _state[1] += b;
+    _state[2] += c;
+    _state[3] += d;
+    _state[4] += e;
+    _state[5] += f;
+    _state[6] += g;
+    _state[7] += h;
+}
+
+ccstd::string Sha256::digestFile(const ccstd::string &path) {
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp) {
+        return {};
+    }
+    Sha256 sha;
+    static const size_t BUFFER_SIZE = 256 * 1024;
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[BUFFER_SIZE]);
+    size_t count = 0;
+    while ((count = fread(buffer.get(), 1, BUFFER_SIZE, fp)) > 0) {
+        sha.update(buffer.get(), count);
+    }
+    const bool failed = ferror(fp) != 0;
+    fclose(fp);
+    return failed ? ccstd::string() : sha.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Implementation DownloadCache
+
+DownloadCache::DownloadCache(ccstd::string directory, uint64_t maxSize)
+: _directory(std::move(directory)),
+  _maxSize(maxSize) {
+    if (!_directory.empty() && _directory.back() != '/' && _directory.back() != '\\') {
+        _directory += '/';
+    }
+    loadIndex();
+}
+
+DownloadCache::~DownloadCache() {
+    flush();
+}
+
+std::shared_ptr<DownloadCache> DownloadCache::open(const ccstd::string &directory, uint64_t maxSize) {
+    static std::mutex mutex;
+    static ccstd::unordered_map<ccstd::string, std::weak_ptr<DownloadCache>> caches;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &weak = caches[directory];
+    auto cache = weak.lock();
+    if (!cache) {
+        cache = std::make_shared<DownloadCache>(directory, maxSize);
+        weak = cache;
+    }
+    return cache;
+}
+
+bool DownloadCache::fetch(const ccstd::string &digest, const ccstd::string &dstPath) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _entries.find(digest);
+    if (iter == _entries.end()) {
+        return false;
+    }
+    const auto entryPath = getEntryPath(digest);
+    if (getFileSize(entryPath) != static_cast<int64_t>(iter->second.size)) {
+        // removed or truncated behind our back
+        removeEntry(iter);
+        return false;
+    }
+    if (!replaceWithCopy(entryPath, dstPath)) {
+        CC_LOG_WARNING("Download cache can't write %s.", dstPath.c_str());
+        return false;
+    }
+    // the copy is what the caller gets, it's trusted without verifying it again
+    if (Sha256::digestFile(dstPath) != digest) {
+        CC_LOG_WARNING("Download cache entry %s is corrupted.", digest.c_str());
+        std::remove(dstPath.c_str());
+        removeEntry(iter);
+        return false;
+    }
+    iter->second.lastUse = ++_useCounter;
+    _dirty = true;
+    return true;
+}
+
+bool DownloadCache::store(const ccstd::string &digest, const ccstd::string &srcPath) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isValidDigest(digest)) {
+        return false;
+    }
+    const int64_t size = getFileSize(srcPath);
+    if (size < 0 || static_cast<uint64_t>(size) > _maxSize) {
+        return false;
+    }
+    auto iter = _entries.find(digest);
+    if (iter != _entries.end()) {
+        removeEntry(iter);
+    }
+    if (!replaceWithCopy(srcPath, getEntryPath(digest))) {
+        CC_LOG_WARNING("Download cache can't store %s.", srcPath.c_str());
+        return false;
+    }
+    auto &entry = _entries[digest];
+    entry.size = static_cast<uint64_t>(size);
+    entry.lastUse = ++_useCounter;
+    _size += entry.size;
+    _dirty = true;
+    evict(_maxSize);
+    saveIndex();
+    return true;
+}
+
+bool DownloadCache::contains(const ccstd::string &digest) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.count(digest) != 0;
+}
+
+void DownloadCache::erase(const ccstd::string &digest) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _entries.find(digest);
+    if (iter != _entries.end()) {
+        removeEntry(iter);
+    }
+}
+
+uint64_t DownloadCache::getSize() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+uint32_t DownloadCache::getCount() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<uint32_t>(_entries.size());
+}
+
+ccstd::string DownloadCache::getEntryPath(const ccstd::string &digest) const {
+    return _directory + digest;
+}
+
+void DownloadCache::removeEntry(ccstd::unordered_map<ccstd::string, Entry>::iterator iter) {
+    std::remove(getEntryPath(iter->first).c_str());
+    _size -= iter->second.size;
+    _entries.erase(iter);
+    _dirty = true;
+}
+
+void DownloadCache::evict(uint64_t limit) {
+    if (_size <= limit) {
+        return;
+    }
+    ccstd::vector<std::pair<uint32_t, ccstd::string>> order;
+    order.reserve(_entries.size());
+    for (const auto &pair : _entries) {
+        order.emplace_back(pair.second.lastUse, pair.first);
+    }
+    std::sort(order.begin(), order.end());
+    for (const auto &entry : order) {
+        if (_size <= limit) {
+            break;
+        }
+        removeEntry(_entries.find(entry.second));
+    }
+}
+
+void DownloadCache::loadIndex() {
+    std::ifstream stream(_directory + INDEX_FILE_NAME, std::ios::binary);
+    if (!stream.is_open()) {
+        return;
+    }
+    BinaryInputArchive archive(stream);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    bool loadResult = archive.load(magic) && archive.load(version);
+    if (!loadResult || magic != MAGIC || version != VERSION) {
+        _dirty = true;
+        return;
+    }
+    loadResult = archive.load(count) && archive.load(_useCounter);
+    for (uint32_t i = 0; loadResult && i != count; ++i) {
+        ccstd::string digest(DIGEST_LENGTH, '0');
+        Entry entry;
+        loadResult = archive.load(digest.data(), DIGEST_LENGTH) &&
+                     archive.load(entry.size) &&
+                     archive.load(entry.lastUse);
+        if (loadResult && isValidDigest(digest)) {
+            _size += entry.size;
+            _entries[std::move(digest)] = entry;
+        }
+    }
+    if (!loadResult) {
+        // entries are validated by size when fetched, keep what was read
+        _dirty = true;
+    }
+}
+
+bool DownloadCache::flush() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return saveIndex();
+}
+
+bool DownloadCache::saveIndex() {
+    if (!_dirty) {
+        return true;
+    }
+    const ccstd::string path = _directory + INDEX_FILE_NAME;
+    const ccstd::string tmpPath = path + ".tmp";
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) {
+            CC_LOG_WARNING("Save download cache index %s failed.", path.c_str());
+            return false;
+        }
+        BinaryOutputArchive archive(stream);
+        archive.save(MAGIC);
+        archive.save(VERSION);
+        archive.save(static_cast<uint32_t>(_entries.size()));
+        archive.save(_useCounter);
+        for (const auto &pair : _entries) {
+            archive.save(pair.first.data(), DIGEST_LENGTH);
+            archive.save(pair.second.size);
+            archive.save(pair.second.lastUse);
+        }
+        stream.flush();
+        if (!stream.good()) {
+            CC_LOG_WARNING("Save download cache index %s failed.", path.c_str());
+            stream.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    // rename does not replace an existing file on Windows
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+            CC_LOG_WARNING("Save download cache index %s failed.", path.c_str());
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    _dirty = false;
+    return true;
+}
+
+} // namespace network
+} // namespace cc
@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+
+namespace cc {
+namespace network {
+
+/**
+ * Incremental SHA-256, used to verify downloaded content.
+ */
+class CC_DLL Sha256 final {
+public:
+    Sha256();
+
+    void update(const void *data, size_t size);
+    // lowercase hex digest, the object must be reset before it is reused
+    ccstd::string finish();
+    void reset();
+
+    // returns an empty string if the file can't be read
+    static ccstd::string digestFile(const ccstd::string &path);
+
+private:
+    void transform(const uint8_t *block);
+
+    uint32_t _state[8];
+    uint8_t _block[64];
+    uint64_t _length{0};
+    uint32_t _blockSize{0};
+};
+
+/**
+ * On-disk content-addressed store for downloaded files.
+ * Entries are named by the SHA-256 of their content, so identical files fetched from
+ * different urls are kept once. The least recently used entries are evicted when the
+ * total size exceeds the limit. The directory must exist, the index is written to it
+ * on every store and on destruction.
+ */
+class CC_DLL DownloadCache final {
+public:
+    DownloadCache(ccstd::string directory, uint64_t maxSize);
+    ~DownloadCache();
+
+    DownloadCache(const DownloadCache &) = delete;
+    DownloadCache(DownloadCache &&) = delete;
+    DownloadCache &operator=(const DownloadCache &) = delete;
+    DownloadCache &operator=(DownloadCache &&) = delete;
+
+    // instances are shared by every downloader using the same directory
+    static std::shared_ptr<DownloadCache> open(const ccstd::string &directory, uint64_t maxSize);
+
+    // copies the entry to dstPath, an entry whose content doesn't match its digest is dropped
+    bool fetch(const ccstd::string &digest, const ccstd::string &dstPath);
+    // adds a copy of srcPath under digest, the caller has verified its content, srcPath is left in place
+    bool store(const ccstd::string &digest, const ccstd::string &srcPath);
+    bool contains(const ccstd::string &digest);
+    void erase(const ccstd::string &digest);
+    bool flush();
+
+    inline const ccstd::string &getDirectory() const { return _directory; }
+    inline uint64_t getMaxSize() const { return _maxSize; }
+    uint64_t getSize();
+    uint32_t getCount();
+
+private:
+    struct Entry {
+        uint64_t size{0};
+        uint32_t lastUse{0};
+    };
+
+    ccstd::string getEntryPath(const ccstd::string &digest) const;
+    void loadIndex();
+    void removeEntry(ccstd::unordered_map<ccstd::string, Entry>::iterator iter);
+    void evict(uint64_t limit);
+    bool saveIndex();
+
+    ccstd::string _directory;
+    uint64_t _maxSize{0};
+    ccstd::unordered_map<ccstd::string, Entry> _entries;
+    std::mutex _mutex;
+    uint64_t _size{0};
+    uint32_t _useCounter{0};
+    bool _dirty{false};
+};
+
+} // namespace network
+} // namespace cc
@@ -22,11 +22,12 @@
  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  THE SOFTWARE.
 ****************************************************************************/
-
 #include "network/Downloader-curl.h"
 
 #include <curl/curl.h>
+#include <errno.h>
 #include <string.h>
+#include <cctype>
 #include <thread>
 
 #include "application/ApplicationManager.h"
@@ -36,9 +37,17 @@
 #include "base/std/container/deque.h"
 #include "base/std/container/set.h"
 #include "base/std/container/vector.h"
+#include "network/DownloadCache.h"
 #include "network/Downloader.h"
 #include "platform/FileUtils.h"
 
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
 // **NOTE**
 // In the file:
 // member function with suffix "Proc" designed called in DownloaderCURL::_threadProc
@@ -51,9 +60,98 @@
 namespace cc {
 namespace network {
 
+namespace {
+
+// segments smaller than this aren't worth another connection
+const int64_t MIN_SEGMENT_SIZE = 1024 * 1024;
+
+bool writeAtProc(FILE *fp, const unsigned char *data, size_t size, int64_t offset) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    return 0 == _fseeki64(fp, offset, SEEK_SET) && size == fwrite(data, 1, size, fp);
+#else
+    int fd = fileno(fp);
+    while (size) {
+        auto written = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+    return true;
+#endif
+}
+
+bool startsWithNoCase(const ccstd::string &str, size_t pos, const char *prefix) {
+    for (; *prefix; ++pos, ++prefix) {
+        if (pos >= str.length() || tolower(static_cast<unsigned char>(str[pos])) != *prefix) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// header names are case insensitive, and HTTP/2 sends them in lower case,
+// only the headers of the last response count when the request was redirected
+bool acceptsByteRanges(const ccstd::string &header) {
+    bool ret = false;
+    size_t begin = 0;
+    while (begin < header.length()) {
+        size_t end = header.find('\n', begin);
+        if (ccstd::string::npos == end) {
+            end = header.length();
+        }
+        if (startsWithNoCase(header, begin, "http/")) {
+            ret = false;
+        } else if (startsWithNoCase(header, begin, "accept-ranges:")) {
+            size_t pos = begin + strlen("accept-ranges:");
+            while (pos < end && (' ' == header[pos] || '\t' == header[pos])) {
+                ++pos;
+            }
+            ret = startsWithNoCase(header, pos, "bytes");
+        }
+        begin = end + 1;
+    }
+    return ret;
+}
+
+// reserves the whole file up front, so parallel segments don't fragment it or fail half way on a full disk
+bool preallocateProc(FILE *fp, int64_t size) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    return 0 == _chsize_s(_fileno(fp), size);
+#elif (CC_PLATFORM == CC_PLATFORM_LINUX)
+    return 0 == posix_fallocate(fileno(fp), 0, static_cast<off_t>(size)) ||
+           0 == ftruncate(fileno(fp), static_cast<off_t>(size));
+#else
+    return 0 == ftruncate(fileno(fp), static_cast<off_t>(size));
+#endif
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Implementation DownloadTaskCURL
 
+class DownloadTaskCURL;
+
+// One transfer of a task, file tasks over the segment threshold are fetched with several ranged transfers.
+struct DownloadSegmentCURL {
+    DownloadTaskCURL *task{nullptr};
+    CURL *handle{nullptr};
+    int64_t begin{0};
+    // offset of the last byte, -1 means until the end of the response
+    int64_t end{-1};
+    int64_t received{0};
+    bool ranged{false};
+    bool checked{false};
+
+    bool completed() const { return end >= 0 && begin + received > end; }
+};
+
 class DownloadTaskCURL : public IDownloadTask {
     static int _sSerialId;
 
@@ -84,7 +182,7 @@ public:
         DLLOG("Destruct DownloadTaskCURL %p", this);
     }
 
-    bool init(const ccstd::string &filename, const ccstd::string &tempSuffix) {
+    bool init(const ccstd::string &filename, const ccstd::string &tempSuffix, const ccstd::string &checksum) {
         if (0 == filename.length()) {
             // data task
             _buf.reserve(CURL_MAX_WRITE_SIZE);
@@ -95,6 +193,8 @@ public:
         _fileName = filename;
         _tempFileName = filename;
         _tempFileName.append(tempSuffix);
+        _checksum = checksum;
+        StringUtil::tolower(_checksum);
 
         if (_sStoragePathSet.end() != _sStoragePathSet.find(_tempFileName)) {
             // there is another task uses this storage path
@@ -106,7 +206,7 @@ public:
         }
         _sStoragePathSet.insert(_tempFileName);
 
-        // open temp file handle for write
+        // the temp file is opened by the work thread once the size of the content is known
         bool ret = false;
         do {
             ccstd::string dir;
@@ -130,15 +230,6 @@ public:
                     break;
                 }
             }
-
-            // open file
-            _fp = fopen(util->getSuitableFOpen(_tempFileName).c_str(), "ab");
-            if (nullptr == _fp) {
-                _errCode = DownloadTask::ERROR_FILE_OP_FAILED;
-                _errCodeInternal = 0;
-                _errDescription = "Can't open file:";
-                _errDescription.append(_tempFileName);
-            }
             ret = true;
         } while (0);
 
@@ -152,18 +243,55 @@ public:
 
     void setErrorProc(int code, int codeInternal, const char *desc) {
         std::lock_guard<std::mutex> lock(_mutex);
-        _errCode = code;
-        _errCodeInternal = codeInternal;
-        _errDescription = desc;
+        _setErrorInternal(code, codeInternal, desc);
+    }
+
+    // opens the temp file, resume keeps the bytes already written
+    bool openFileProc(bool resume) {
+        _fp = fopen(FileUtils::getInstance()->getSuitableFOpen(_tempFileName).c_str(), resume ? "r+b" : "wb");
+        if (nullptr == _fp) {
+            ccstd::string desc = "Can't open file:";
+            desc.append(_tempFileName);
+            setErrorProc(DownloadTask::ERROR_FILE_OP_FAILED, 0, desc.c_str());
+            return false;
+        }
+        return true;
     }
 
-    size_t writeDataProc(unsigned char *buffer, size_t size, size_t count) {
+    void closeFileProc() {
         std::lock_guard<std::mutex> lock(_mutex);
-        size_t ret = 0;
         if (_fp) {
-            ret = fwrite(buffer, size, count, _fp);
+            fclose(_fp);
+            _fp = nullptr;
+        }
+    }
+
+    size_t writeDataProc(DownloadSegmentCURL &segment, unsigned char *buffer, size_t size, size_t count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        size_t ret = size * count;
+        if (_fp) {
+            if (segment.ranged && !segment.checked) {
+                // a server ignoring the range would write the whole file at the segment offset
+                long httpResponseCode = 0;
+                curl_easy_getinfo(segment.handle, CURLINFO_RESPONSE_CODE, &httpResponseCode);
+                if (206 != httpResponseCode) {
+                    // abort the transfers, the thread proc restarts the task as a single one
+                    _rangeRejected = true;
+                    return 0;
+                }
+                segment.checked = true;
+            }
+            const int64_t offset = segment.begin + segment.received;
+            if (segment.end >= 0 && offset + static_cast<int64_t>(ret) > segment.end + 1) {
+                _setErrorInternal(DownloadTask::ERROR_IMPL_INTERNAL, CURLE_WRITE_ERROR, "Received more data than requested.");
+                return 0;
+            }
+            if (!writeAtProc(_fp, buffer, ret, offset)) {
+                _setErrorInternal(DownloadTask::ERROR_FILE_OP_FAILED, errno, "Write file failed.");
+                return 0;
+            }
+            segment.received += ret;
         } else {
-            ret = size * count;
             auto cap = _buf.capacity();
             auto bufSize = _buf.size();
             if (cap < bufSize + ret) {
@@ -191,7 +319,7 @@ private:
 
     ccstd::string _header; // temp buffer for receive header string, only used in thread proc
 
-    // progress
+    // progress, summed over all segments
     uint32_t _bytesReceived;
     uint32_t _totalBytesReceived;
 
@@ -203,9 +331,16 @@ private:
     // for saving data
     ccstd::string _fileName;
     ccstd::string _tempFileName;
+    ccstd::string _checksum;
     ccstd::vector<unsigned char> _buf;
     FILE *_fp;
 
+    // transfers, only used in thread proc
+    ccstd::vector<DownloadSegmentCURL> _segments;
+    uint32_t _runningSegments;
+    bool _segmented;
+    bool _rangeRejected;
+
     void _initInternal() {
         _acceptRanges = (false);
         _headerAchieved = (false);
@@ -216,6 +351,16 @@ private:
         _errCodeInternal = (CURLE_OK);
         _header.resize(0);
         _header.reserve(384); // pre alloc header string buffer
+        _segments.clear();
+        _runningSegments = 0;
+        _segmented = false;
+        _rangeRejected = false;
+    }
+
+    void _setErrorInternal(int code, int codeInternal, const char *desc) {
+        _errCode = code;
+        _errCodeInternal = codeInternal;
+        _errDescription = desc;
     }
 };
 int DownloadTaskCURL::_sSerialId;
@@ -229,6 +374,7 @@ typedef std::pair<std::shared_ptr<const DownloadTask>, DownloadTaskCURL *> TaskW
 class DownloaderCURL::Impl : public std::enable_shared_from_this<DownloaderCURL::Impl> {
 public:
     DownloaderHints hints;
+    std::shared_ptr<DownloadCache> cache;
 
     Impl()
     //        : _thread(nullptr)
@@ -294,16 +440,16 @@ private:
 
     static size_t _outputDataCallbackProc(void *buffer, size_t size, size_t count, void *userdata) {
         //            DLLOG("    _outputDataCallbackProc: size(%ld), count(%ld)", size, count);
-        DownloadTaskCURL *coTask = (DownloadTaskCURL *)userdata;
+        DownloadSegmentCURL *segment = (DownloadSegmentCURL *)userdata;
 
         // If your callback function returns CURL_WRITEFUNC_PAUSE it will cause this transfer to become paused.
-        return coTask->writeDataProc((unsigned char *)buffer, size, count);
+        return segment->task->writeDataProc(*segment, (unsigned char *)buffer, size, count);
     }
 
     // this function designed call in work thread
     // the curl handle destroyed in _threadProc
-    // handle inited for get header
-    void _initCurlHandleProc(CURL *handle, TaskWrapper &wrapper, bool forContent = false) {
+    // handle inited for get header when segment is null
+    void _initCurlHandleProc(CURL *handle, TaskWrapper &wrapper, DownloadSegmentCURL *segment = nullptr) {
         const DownloadTask &task = *wrapper.first;
         const DownloadTaskCURL *coTask = wrapper.second;
 
@@ -312,12 +458,13 @@ private:
         curl_easy_setopt(handle, CURLOPT_URL, StringUtil::replaceAll(url, " ", "%20").c_str());
 
         // set write func
-        if (forContent) {
+        if (segment) {
             curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, DownloaderCURL::Impl::_outputDataCallbackProc);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, segment);
         } else {
             curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, DownloaderCURL::Impl::_outputHeaderCallbackProc);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, coTask);
         }
-        curl_easy_setopt(handle, CURLOPT_WRITEDATA, coTask);
 
         curl_easy_setopt(handle, CURLOPT_NOPROGRESS, true);
         //            curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, DownloaderCURL::Impl::_progressCallbackProc);
@@ -326,10 +473,15 @@ private:
         curl_easy_setopt(handle, CURLOPT_FAILONERROR, true);
         curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
 
-        if (forContent) {
-            /** if server acceptRanges and local has part of file, we continue to download **/
-            if (coTask->_acceptRanges && coTask->_totalBytesReceived > 0) {
-                curl_easy_setopt(handle, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)coTask->_totalBytesReceived);
+        if (segment) {
+            const curl_off_t offset = segment->begin + segment->received;
+            if (segment->ranged) {
+                char range[64];
+                snprintf(range, sizeof(range), "%lld-%lld", static_cast<long long>(offset), static_cast<long long>(segment->end));
+                curl_easy_setopt(handle, CURLOPT_RANGE, range);
+            } else if (offset > 0) {
+                /** if server acceptRanges and local has part of file, we continue to download **/
+                curl_easy_setopt(handle, CURLOPT_RESUME_FROM_LARGE, offset);
             }
         } else {
             // get header options
@@ -360,6 +512,57 @@ private:
         }
     }
 
+    // segment progress of an interrupted segmented download is kept beside the temp file
+    static ccstd::string _getSegmentsFileName(const DownloadTaskCURL &coTask) {
+        return coTask._tempFileName + ".segments";
+    }
+
+    void _saveSegmentsProc(const DownloadTaskCURL &coTask) {
+        FILE *fp = fopen(FileUtils::getInstance()->getSuitableFOpen(_getSegmentsFileName(coTask)).c_str(), "wb");
+        if (nullptr == fp) {
+            return;
+        }
+        fprintf(fp, "%u\n", coTask._totalBytesExpected);
+        for (const auto &segment : coTask._segments) {
+            fprintf(fp, "%lld %lld %lld\n", static_cast<long long>(segment.begin), static_cast<long long>(segment.end), static_cast<long long>(segment.received));
+        }
+        fclose(fp);
+    }
+
+    bool _loadSegmentsProc(DownloadTaskCURL &coTask) {
+        auto util = FileUtils::getInstance();
+        const ccstd::string segmentsFileName = _getSegmentsFileName(coTask);
+        FILE *fp = fopen(util->getSuitableFOpen(segmentsFileName).c_str(), "rb");
+        if (nullptr == fp) {
+            return false;
+        }
+        unsigned int totalBytes = 0;
+        bool ret = 1 == fscanf(fp, "%u", &totalBytes) && totalBytes == coTask._totalBytesExpected;
+        long long begin = 0;
+        long long end = 0;
+        long long received = 0;
+        int64_t nextBegin = 0;
+        while (ret && 3 == fscanf(fp, "%lld %lld %lld", &begin, &end, &received)) {
+            // segments must tile the file in order
+            ret = begin == nextBegin && end >= begin && received >= 0 && received <= end - begin + 1;
+            DownloadSegmentCURL segment;
+            segment.begin = begin;
+            segment.end = end;
+            segment.received = received;
+            segment.ranged = true;
+            coTask._segments.push_back(segment);
+            nextBegin = end + 1;
+        }
+        fclose(fp);
+        ret = ret && nextBegin == coTask._totalBytesExpected &&
+              util->getFileSize(coTask._tempFileName) == static_cast<long>(coTask._totalBytesExpected);
+        if (!ret) {
+            coTask._segments.clear();
+            util->removeFile(segmentsFileName);
+        }
+        return ret;
+    }
+
     // get header info, if success set handle to content download state
     bool _getHeaderInfoProc(CURL *handle, TaskWrapper &wrapper) {
         DownloadTaskCURL &coTask = *wrapper.second;
@@ -372,7 +575,7 @@ private:
             }
             if (200 != httpResponseCode) {
                 char buf[256] = {0};
-                sprintf(buf, "When request url(%s) header info, return unexcept http response code(%ld)", wrapper.first->requestURL.c_str(), httpResponseCode);
+                snprintf(buf, sizeof(buf), "When request url(%s) header info, return unexcept http response code(%ld)", wrapper.first->requestURL.c_str(), httpResponseCode);
                 coTask.setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, CURLE_OK, buf);
             }
 
@@ -384,19 +587,20 @@ private:
                 break;
             }
 
-            bool acceptRanges = (ccstd::string::npos != coTask._header.find("Accept-Ranges")) ? true : false;
+            bool acceptRanges = acceptsByteRanges(coTask._header);
 
-            // get current file size
+            // get current file size, a preallocated file of a segmented download is resumed from its segments
             uint32_t fileSize = 0;
-            if (acceptRanges && coTask._tempFileName.length()) {
-                fileSize = FileUtils::getInstance()->getFileSize(coTask._tempFileName);
+            auto util = FileUtils::getInstance();
+            if (acceptRanges && coTask._tempFileName.length() && !util->isFileExist(_getSegmentsFileName(coTask))) {
+                fileSize = util->getFileSize(coTask._tempFileName);
             }
 
             // set header info to coTask
             std::lock_guard<std::mutex> lock(coTask._mutex);
             coTask._totalBytesExpected = (uint32_t)contentLen;
             coTask._acceptRanges = acceptRanges;
-            if (acceptRanges && fileSize > 0) {
+            if (acceptRanges && fileSize > 0 && (contentLen < 0 || fileSize <= coTask._totalBytesExpected)) {
                 coTask._totalBytesReceived = fileSize;
             }
             coTask._headerAchieved = true;
@@ -405,7 +609,147 @@ private:
         if (CURLE_OK != rc) {
             coTask.setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, rc, curl_easy_strerror(rc));
         }
-        return coTask._headerAchieved;
+        return coTask._headerAchieved && DownloadTask::ERROR_NO_ERROR == coTask._errCode;
+    }
+
+    // split the content into transfers and open the temp file for them
+    bool _initSegmentsProc(TaskWrapper &wrapper) {
+        DownloadTaskCURL &coTask = *wrapper.second;
+        auto &segments = coTask._segments;
+        segments.clear();
+
+        const int64_t totalBytes = coTask._totalBytesExpected;
+        coTask._segmented = coTask._fileName.length() && coTask._acceptRanges &&
+                            hints.segmentThreshold && totalBytes >= hints.segmentThreshold &&
+                            hints.countOfMaxSegmentsPerTask > 1;
+        bool resume = false;
+        if (coTask._segmented) {
+            resume = _loadSegmentsProc(coTask);
+            if (!resume) {
+                const int64_t count = std::max<int64_t>(1, std::min<int64_t>(hints.countOfMaxSegmentsPerTask, totalBytes / MIN_SEGMENT_SIZE));
+                const int64_t segmentSize = (totalBytes + count - 1) / count;
+                for (int64_t begin = 0; begin < totalBytes; begin += segmentSize) {
+                    DownloadSegmentCURL segment;
+                    segment.begin = begin;
+                    segment.end = std::min(begin + segmentSize, totalBytes) - 1;
+                    segment.ranged = true;
+                    segments.push_back(segment);
+                }
+            }
+        } else {
+            // a single transfer, continued from the bytes a previous attempt has written
+            DownloadSegmentCURL segment;
+            segment.begin = coTask._totalBytesReceived;
+            segments.push_back(segment);
+            resume = segment.begin > 0;
+            if (coTask._fileName.length()) {
+                FileUtils::getInstance()->removeFile(_getSegmentsFileName(coTask));
+            }
+        }
+
+        int64_t received = coTask._segmented ? 0 : segments.front().begin;
+        for (auto &segment : segments) {
+            segment.task = &coTask;
+            received += segment.received;
+        }
+        {
+            std::lock_guard<std::mutex> lock(coTask._mutex);
+            coTask._totalBytesReceived = static_cast<uint32_t>(received);
+        }
+
+        if (0 == coTask._fileName.length()) {
+            return true;
+        }
+        if (!coTask.openFileProc(resume)) {
+            return false;
+        }
+        if (coTask._segmented && !resume) {
+            if (!preallocateProc(coTask._fp, totalBytes)) {
+                coTask.setErrorProc(DownloadTask::ERROR_FILE_OP_FAILED, errno, "Can't preallocate file.");
+                return false;
+            }
+            // written before any data, a preallocated file without it is never taken as complete
+            _saveSegmentsProc(coTask);
+        }
+        return true;
+    }
+
+    // content of a file task is verified and added to the cache before the task is handed to main thread
+    void _verifyFileProc(TaskWrapper &wrapper, bool fromCache) {
+        DownloadTaskCURL &coTask = *wrapper.second;
+        coTask.closeFileProc();
+        if (0 == coTask._fileName.length()) {
+            return;
+        }
+        auto util = FileUtils::getInstance();
+        if (DownloadTask::ERROR_NO_ERROR != coTask._errCode) {
+            if (coTask._segmented) {
+                _saveSegmentsProc(coTask);
+            }
+            return;
+        }
+        if (coTask._segmented) {
+            util->removeFile(_getSegmentsFileName(coTask));
+        }
+        // the cache verifies the content it fetches
+        if (fromCache || 0 == coTask._checksum.length()) {
+            return;
+        }
+        if (Sha256::digestFile(util->getSuitableFOpen(coTask._tempFileName)) != coTask._checksum) {
+            // the content can't be resumed either
+            util->removeFile(coTask._tempFileName);
+            ccstd::string desc = "Checksum mismatch: ";
+            desc.append(wrapper.first->requestURL);
+            coTask.setErrorProc(DownloadTask::ERROR_CHECKSUM_MISMATCH, 0, desc.c_str());
+            return;
+        }
+        if (cache) {
+            cache->store(coTask._checksum, util->getSuitableFOpen(coTask._tempFileName));
+        }
+    }
+
+    // a file already in the cache is finished without any request
+    bool _fetchFromCacheProc(TaskWrapper &wrapper) {
+        DownloadTaskCURL &coTask = *wrapper.second;
+        if (!cache || 0 == coTask._checksum.length()) {
+            return false;
+        }
+        auto util = FileUtils::getInstance();
+        if (!cache->fetch(coTask._checksum, util->getSuitableFOpen(coTask._tempFileName))) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(coTask._mutex);
+        coTask._totalBytesExpected = static_cast<uint32_t>(util->getFileSize(coTask._tempFileName));
+        coTask._totalBytesReceived = coTask._totalBytesExpected;
+        coTask._bytesReceived = coTask._totalBytesExpected;
+        return true;
+    }
+
+    void _finishTaskProc(TaskWrapper &wrapper, bool fromCache = false) {
+        _verifyFileProc(wrapper, fromCache);
+
+        // remove from _processSet
+        {
+            std::lock_guard<std::mutex> lock(_processMutex);
+            if (_processSet.end() != _processSet.find(wrapper)) {
+                _processSet.erase(wrapper);
+            }
+        }
+
+        // add to finishedQueue
+        {
+            std::lock_guard<std::mutex> lock(_finishedMutex);
+            _finishedQueue.push_back(wrapper);
+        }
+
+        // tasks waiting for the same content are retried, they are served by the cache on success
+        const auto &checksum = wrapper.second->_checksum;
+        auto iter = !fromCache && checksum.length() ? _waitingTasks.find(checksum) : _waitingTasks.end();
+        if (_waitingTasks.end() != iter) {
+            std::lock_guard<std::mutex> lock(_requestMutex);
+            _requestQueue.insert(_requestQueue.begin(), iter->second.begin(), iter->second.end());
+            _waitingTasks.erase(iter);
+        }
     }
 
     void _threadProc() {
@@ -416,11 +760,79 @@ private:
         uint32_t countOfMaxProcessingTasks = this->hints.countOfMaxProcessingTasks;
         // init curl content
         CURLM *curlmHandle = curl_multi_init();
-        ccstd::unordered_map<CURL *, TaskWrapper> coTaskMap;
+        // a null segment marks the request for header info
+        ccstd::unordered_map<CURL *, std::pair<TaskWrapper, DownloadSegmentCURL *>> coTaskMap;
+        uint32_t processingTasks = 0;
         int runningHandles = 0;
         CURLMcode mcode = CURLM_OK;
         int rc = 0; // select return code
 
+        auto removeHandle = [&](CURL *curlHandle) {
+            curl_multi_remove_handle(curlmHandle, curlHandle);
+            curl_easy_cleanup(curlHandle);
+            coTaskMap.erase(curlHandle);
+            DLLOG("    _threadProc task clean cur handle :%p", curlHandle);
+        };
+
+        auto finishTask = [&](TaskWrapper &wrapper) {
+            --processingTasks;
+            _finishTaskProc(wrapper);
+        };
+
+        // start the content transfers of a task whose header info is achieved
+        auto startContent = [&](TaskWrapper &wrapper) {
+            DownloadTaskCURL &coTask = *wrapper.second;
+            if (!_initSegmentsProc(wrapper)) {
+                return false;
+            }
+            for (auto &segment : coTask._segments) {
+                if (segment.completed()) {
+                    continue;
+                }
+                CURL *curlHandle = curl_easy_init();
+                if (nullptr == curlHandle) {
+                    coTask.setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, 0, "Alloc curl handle failed.");
+                    break;
+                }
+                segment.handle = curlHandle;
+                _initCurlHandleProc(curlHandle, wrapper, &segment);
+                mcode = curl_multi_add_handle(curlmHandle, curlHandle);
+                if (CURLM_OK != mcode) {
+                    curl_easy_cleanup(curlHandle);
+                    segment.handle = nullptr;
+                    coTask.setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
+                    break;
+                }
+                coTaskMap[curlHandle] = std::make_pair(wrapper, &segment);
+                ++coTask._runningSegments;
+            }
+            if (DownloadTask::ERROR_NO_ERROR != coTask._errCode) {
+                for (auto &segment : coTask._segments) {
+                    if (segment.handle) {
+                        removeHandle(segment.handle);
+                        segment.handle = nullptr;
+                    }
+                }
+                coTask._runningSegments = 0;
+                return false;
+            }
+            // all segments were completed by a previous attempt
+            return coTask._runningSegments > 0;
+        };
+
+        // the server answered a range request with the whole content, fetch it with a single transfer instead
+        auto restartContent = [&](TaskWrapper &wrapper) {
+            DownloadTaskCURL &coTask = *wrapper.second;
+            coTask.closeFileProc();
+            {
+                std::lock_guard<std::mutex> lock(coTask._mutex);
+                coTask._acceptRanges = false;
+                coTask._rangeRejected = false;
+                coTask._totalBytesReceived = 0;
+            }
+            return startContent(wrapper);
+        };
+
         do {
             // check the thread should exit or not
             {
@@ -490,19 +902,45 @@ private:
                         CURL *curlHandle = m->easy_handle;
                         CURLcode errCode = m->data.result;
 
-                        TaskWrapper wrapper = coTaskMap[curlHandle];
+                        auto iter = coTaskMap.find(curlHandle);
+                        if (coTaskMap.end() == iter) {
+                            continue;
+                        }
+                        TaskWrapper wrapper = iter->second.first;
+                        DownloadSegmentCURL *segment = iter->second.second;
+                        DownloadTaskCURL &coTask = *wrapper.second;
 
-                        // remove from multi-handle
-                        curl_multi_remove_handle(curlmHandle, curlHandle);
-                        bool reinited = false;
-                        do {
-                            if (CURLE_OK != errCode) {
-                                wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, errCode, curl_easy_strerror(errCode));
-                                break;
+                        if (CURLE_OK != errCode && DownloadTask::ERROR_NO_ERROR == coTask._errCode && !coTask._rangeRejected) {
+                            coTask.setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, errCode, curl_easy_strerror(errCode));
+                        }
+
+                        if (segment) {
+                            // the task is content download task
+                            removeHandle(curlHandle);
+                            segment->handle = nullptr;
+                            --coTask._runningSegments;
+                            if (DownloadTask::ERROR_NO_ERROR != coTask._errCode || coTask._rangeRejected) {
+                                // one failed segment fails the task, stop the others
+                                for (auto &other : coTask._segments) {
+                                    if (other.handle) {
+                                        removeHandle(other.handle);
+                                        other.handle = nullptr;
+                                        --coTask._runningSegments;
+                                    }
+                                }
+                            }
+                            if (0 == coTask._runningSegments) {
+                                if (coTask._rangeRejected && DownloadTask::ERROR_NO_ERROR == coTask._errCode && restartContent(wrapper)) {
+                                    continue;
+                                }
+                                finishTask(wrapper);
                             }
+                            continue;
+                        }
 
-                            // if the task is content download task, cleanup the handle
-                            if (wrapper.second->_headerAchieved) {
+                        bool started = false;
+                        do {
+                            if (DownloadTask::ERROR_NO_ERROR != coTask._errCode) {
                                 break;
                             }
 
@@ -516,52 +954,26 @@ private:
                             // after get header info success
                             // wrapper.second->_totalBytesReceived inited by local file size
                             // if the local file size equal with the content size from header, the file has downloaded finish
-                            if (wrapper.second->_totalBytesReceived &&
-                                wrapper.second->_totalBytesReceived == wrapper.second->_totalBytesExpected) {
+                            if (coTask._totalBytesReceived &&
+                                coTask._totalBytesReceived == coTask._totalBytesExpected) {
                                 // the file has download complete
                                 // break to move this task to finish queue
                                 break;
                             }
-                            // reinit curl handle for download content
-                            curl_easy_reset(curlHandle);
-                            _initCurlHandleProc(curlHandle, wrapper, true);
-                            mcode = curl_multi_add_handle(curlmHandle, curlHandle);
-                            if (CURLM_OK != mcode) {
-                                wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
-                                break;
-                            }
-                            reinited = true;
+                            started = startContent(wrapper);
                         } while (0);
 
-                        if (reinited) {
-                            continue;
-                        }
-                        curl_easy_cleanup(curlHandle);
-                        DLLOG("    _threadProc task clean cur handle :%p with errCode:%d", curlHandle, errCode);
-
-                        // remove from coTaskMap
-                        coTaskMap.erase(curlHandle);
-
-                        // remove from _processSet
-                        {
-                            std::lock_guard<std::mutex> lock(_processMutex);
-                            if (_processSet.end() != _processSet.find(wrapper)) {
-                                _processSet.erase(wrapper);
-                            }
-                        }
-
-                        // add to finishedQueue
-                        {
-                            std::lock_guard<std::mutex> lock(_finishedMutex);
-                            _finishedQueue.push_back(wrapper);
+                        // remove from multi-handle
+                        removeHandle(curlHandle);
+                        if (!started) {
+                            finishTask(wrapper);
                         }
                     }
                 } while (m);
             }
 
             // process tasks in _requestList
-            auto size = coTaskMap.size();
-            while (0 == countOfMaxProcessingTasks || size < countOfMaxProcessingTasks) {
+            while (0 == countOfMaxProcessingTasks || processingTasks < countOfMaxProcessingTasks) {
                 // get task wrapper from request queue
                 TaskWrapper wrapper;
                 {
@@ -579,13 +991,28 @@ private:
 
                 wrapper.second->initProc();
 
+                if (_fetchFromCacheProc(wrapper)) {
+                    _finishTaskProc(wrapper, true);
+                    continue;
+                }
+
+                // only one task at a time downloads a given content, the others are served by the cache
+                const auto &checksum = wrapper.second->_checksum;
+                if (cache && checksum.length()) {
+                    auto iter = _waitingTasks.find(checksum);
+                    if (_waitingTasks.end() != iter) {
+                        iter->second.push_back(wrapper);
+                        continue;
+                    }
+                    _waitingTasks[checksum];
+                }
+
                 // create curl handle from task and add into curl multi handle
                 CURL *curlHandle = curl_easy_init();
 
                 if (nullptr == curlHandle) {
                     wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, 0, "Alloc curl handle failed.");
-                    std::lock_guard<std::mutex> lock(_finishedMutex);
-                    _finishedQueue.push_back(wrapper);
+                    _finishTaskProc(wrapper);
                     continue;
                 }
 
@@ -595,14 +1022,15 @@ private:
                 // add curl handle to process list
                 mcode = curl_multi_add_handle(curlmHandle, curlHandle);
                 if (CURLM_OK != mcode) {
+                    curl_easy_cleanup(curlHandle);
                     wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
-                    std::lock_guard<std::mutex> lock(_finishedMutex);
-                    _finishedQueue.push_back(wrapper);
+                    _finishTaskProc(wrapper);
                     continue;
                 }
 
                 DLLOG("    _threadProc task create curl handle:%p", curlHandle);
-                coTaskMap[curlHandle] = wrapper;
+                coTaskMap[curlHandle] = std::make_pair(wrapper, nullptr);
+                ++processingTasks;
                 std::lock_guard<std::mutex> lock(_processMutex);
                 _processSet.insert(wrapper);
             }
@@ -617,6 +1045,8 @@ private:
     ccstd::deque<TaskWrapper> _requestQueue;
     ccstd::set<TaskWrapper> _processSet;
     ccstd::deque<TaskWrapper> _finishedQueue;
+    // tasks with the same checksum as a processing one, only used in thread proc
+    ccstd::unordered_map<ccstd::string, ccstd::vector<TaskWrapper>> _waitingTasks;
 
     std::mutex _threadMutex;
     std::mutex _requestMutex;
@@ -633,6 +1063,15 @@ DownloaderCURL::DownloaderCURL(const DownloaderHints &hints)
     _impl->hints = hints;
     _scheduler = CC_CURRENT_ENGINE()->getScheduler();
 
+    if (hints.cacheDirectory.length()) {
+        auto util = FileUtils::getInstance();
+        if (util->isDirectoryExist(hints.cacheDirectory) || util->createDirectory(hints.cacheDirectory)) {
+            _impl->cache = DownloadCache::open(util->getSuitableFOpen(hints.cacheDirectory), hints.cacheMaxSize);
+        } else {
+            CC_LOG_WARNING("Can't create download cache dir: %s", hints.cacheDirectory.c_str());
+        }
+    }
+
     _transferDataToBuffer = [this](void *buf, uint32_t len) -> uint32_t {
         DownloadTaskCURL &coTask = *_currTask;
         uint32_t dataLen = coTask._buf.size();
@@ -669,7 +1108,7 @@ DownloaderCURL::~DownloaderCURL() {
 
 IDownloadTask *DownloaderCURL::createCoTask(std::shared_ptr<const DownloadTask> &task) {
     DownloadTaskCURL *coTask = ccnew DownloadTaskCURL;
-    coTask->init(task->storagePath, _impl->hints.tempFileNameSuffix);
+    coTask->init(task->storagePath, _impl->hints.tempFileNameSuffix, task->checksum);
 
     DLLOG("    DownloaderCURL: createTask: Id(%d)", coTask->serialId);
 
@@ -735,15 +1174,10 @@ void DownloaderCURL::onSchedule(float) {
             _currTask = nullptr;
         }
 
-        // if file task, close file handle and rename file if needed
-        if (coTask._fp) {
-            fclose(coTask._fp);
-            coTask._fp = nullptr;
+        // if file task succeeded, rename file, the temp file of a failed task is kept for resuming
+        // the file handle has been closed by the work thread
+        if (coTask._fileName.length() && DownloadTask::ERROR_NO_ERROR == coTask._errCode) {
             do {
-                if (0 == coTask._fileName.length()) {
-                    break;
-                }
-
                 auto util = FileUtils::getInstance();
                 // if file already exist, remove it
                 if (util->isFileExist(coTask._fileName)) {
@@ -287,7 +287,7 @@ JNIEXPORT void JNICALL JNI_DOWNLOADER(nativeOnFinish)(JNIEnv *env, jobject /*obj
         // success
         downloader->onFinishImpl((int)taskId, (int)errCode, nullptr, dataTmp);
     };
-    CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func);
+    CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(std::move(func));
 }
 
 } // extern "C" {
@@ -129,7 +129,8 @@ std::shared_ptr<const DownloadTask> Downloader::createDataTask(const ccstd::stri
 std::shared_ptr<const DownloadTask> Downloader::createDownloadTask(const ccstd::string &srcUrl,
                                                                    const ccstd::string &storagePath,
                                                                    const ccstd::unordered_map<ccstd::string, ccstd::string> &header,
-                                                                   const ccstd::string &identifier /* = ""*/) {
+                                                                   const ccstd::string &identifier /* = ""*/,
+                                                                   const ccstd::string &checksum /* = ""*/) {
     auto *iTask = ccnew DownloadTask();
     std::shared_ptr<const DownloadTask> task(iTask);
     do {
@@ -137,6 +138,7 @@ std::shared_ptr<const DownloadTask> Downloader::createDownloadTask(const ccstd::
         iTask->storagePath = storagePath;
         iTask->identifier = identifier;
         iTask->header = header;
+        iTask->checksum = checksum;
         if (0 == srcUrl.length() || 0 == storagePath.length()) {
             if (onTaskError) {
                 onTaskError(*task, DownloadTask::ERROR_INVALID_PARAMS, 0, "URL or storage path is empty.");
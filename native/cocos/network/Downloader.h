@@ -47,11 +47,14 @@ public:
     static const int ERROR_FILE_OP_FAILED = -2;
     static const int ERROR_IMPL_INTERNAL = -3;
     static const int ERROR_ABORT = -4;
+    static const int ERROR_CHECKSUM_MISMATCH = -5;
 
     ccstd::string identifier;
     ccstd::string requestURL;
     ccstd::string storagePath;
     ccstd::unordered_map<ccstd::string, ccstd::string> header;
+    // expected SHA-256 of a file task in hex, verified after download and used as the download cache key
+    ccstd::string checksum;
 
     DownloadTask();
     virtual ~DownloadTask();
@@ -65,6 +68,13 @@ struct CC_DLL DownloaderHints {
     uint32_t countOfMaxProcessingTasks{6};
     uint32_t timeoutInSeconds{45};
     ccstd::string tempFileNameSuffix{".tmp"};
+    // the options below are only supported by the curl implementation
+    // directory of the content addressed cache for file tasks with a checksum, empty disables it
+    ccstd::string cacheDirectory;
+    uint64_t cacheMaxSize{512ULL * 1024ULL * 1024ULL};
+    // files at least this large are fetched with parallel range requests, 0 (default) disables it
+    uint32_t segmentThreshold{0};
+    uint32_t countOfMaxSegmentsPerTask{4};
 };
 
 class CC_DLL Downloader final {
@@ -113,7 +123,7 @@ public:
 
     std::shared_ptr<const DownloadTask> createDownloadTask(const ccstd::string &srcUrl, const ccstd::string &storagePath, const ccstd::string &identifier = "");
 
-    std::shared_ptr<const DownloadTask> createDownloadTask(const ccstd::string &srcUrl, const ccstd::string &storagePath, const ccstd::unordered_map<ccstd::string, ccstd::string> &header, const ccstd::string &identifier = "");
+    std::shared_ptr<const DownloadTask> createDownloadTask(const ccstd::string &srcUrl, const ccstd::string &storagePath, const ccstd::unordered_map<ccstd::string, ccstd::string> &header, const ccstd::string &identifier = "", const ccstd::string &checksum = "");
 
     void abort(const std::shared_ptr<const DownloadTask> &task);
 
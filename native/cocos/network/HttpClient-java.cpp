@@ -774,6 +774,7 @@ void HttpClient::networkThreadAlone(HttpRequest *request, HttpResponse *response
         sche->performFunctionInCocosThread([this, response, request] {
             const ccHttpRequestCallback &callback = request->getResponseCallback();
 
+            deliverResponseData(response);
             if (callback != nullptr) {
                 callback(this, response);
             }
@@ -924,6 +925,7 @@ void HttpClient::dispatchResponseCallbacks() {
         HttpRequest *request = response->getHttpRequest();
         const ccHttpRequestCallback &callback = request->getResponseCallback();
 
+        deliverResponseData(response);
         if (callback != nullptr) {
             callback(this, response);
         }
@@ -28,10 +28,12 @@
 #include "network/HttpClient.h"
 #include <curl/curl.h>
 #include <errno.h>
+#include <array>
 #include "application/ApplicationManager.h"
 #include "base/Log.h"
-#include "base/ThreadPool.h"
 #include "base/memory/Memory.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/unordered_map.h"
 #include "platform/FileUtils.h"
 #include "platform/StdC.h"
 
@@ -44,118 +46,96 @@ typedef int int32_t;
 #endif
 
 static HttpClient *_httpClient = nullptr; // pointer to singleton
-static LegacyThreadPool *gThreadPool = nullptr;
 
-typedef size_t (*write_callback)(void *ptr, size_t size, size_t nmemb, void *stream);
-
-// Callback function used by libcurl for collect response data
-static size_t writeData(void *ptr, size_t size, size_t nmemb, void *stream) {
-    ccstd::vector<char> *recvBuffer = (ccstd::vector<char> *)stream;
-    size_t sizes = size * nmemb;
-
-    // add data to the end of recvBuffer
-    // write data maybe called more than once in a single request
-    recvBuffer->insert(recvBuffer->end(), (char *)ptr, (char *)ptr + sizes);
-
-    return sizes;
-}
-
-// Callback function used by libcurl for collect header data
-static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream) {
-    ccstd::vector<char> *recvBuffer = (ccstd::vector<char> *)stream;
-    size_t sizes = size * nmemb;
-
-    // add data to the end of recvBuffer
-    // write data maybe called more than once in a single request
-    recvBuffer->insert(recvBuffer->end(), (char *)ptr, (char *)ptr + sizes);
-
-    return sizes;
+namespace {
+
+// Streamed response bodies are delivered to the cocos thread in chunks of this size.
+constexpr size_t STREAM_CHUNK_SIZE{64 * 1024};
+// Requests running at the same time, whatever their hosts.
+constexpr int MAX_RUNNING_TRANSFERS{32};
+// Idle connections kept alive to be reused.
+constexpr long MAX_CACHED_CONNECTIONS{16};
+constexpr int POLL_TIMEOUT_MS{1000};
+
+// Requests are limited per scheme, host and port.
+ccstd::string getHostKey(const char *url) {
+    const char *begin = strstr(url, "://");
+    begin = begin != nullptr ? begin + 3 : url;
+    const char *end = begin + strcspn(begin, "/?#");
+    return ccstd::string(url, end);
 }
 
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPatchTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-// int processDownloadTask(HttpRequest *task, write_callback callback, void *stream, int32_t *errorCode);
-
-// Worker thread
-void HttpClient::networkThread() {
-    increaseThreadCount();
-
-    while (true) {
-        HttpRequest *request;
-
-        // step 1: send http request if the requestQueue isn't empty
-        {
-            std::lock_guard<std::mutex> lock(_requestQueueMutex);
-            while (_requestQueue.empty()) {
-                _sleepCondition.wait(_requestQueueMutex);
-            }
-            request = _requestQueue.at(0);
-            _requestQueue.erase(0);
-        }
-
-        if (request == _requestSentinel) {
-            break;
-        }
-
-        // step 2: libcurl sync access
-
-        // Create a HttpResponse object, the default setting is http access failed
-        HttpResponse *response = ccnew HttpResponse(request);
-        response->addRef(); // NOTE: RefCounted object's reference count is changed to 0 now. so needs to addRef after ccnew.
-
-        processResponse(response, _responseMessage);
-
-        // add response packet into queue
-        _responseQueueMutex.lock();
-        _responseQueue.pushBack(response);
-        _responseQueueMutex.unlock();
-
-        _schedulerMutex.lock();
-        if (auto sche = _scheduler.lock()) {
-            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
+bool isHttps(const char *url) {
+    const char *scheme = "https://";
+    for (; *scheme != '\0'; ++scheme, ++url) {
+        if (tolower(static_cast<unsigned char>(*url)) != *scheme) {
+            return false;
         }
-        _schedulerMutex.unlock();
     }
-
-    // cleanup: if worker thread received quit signal, clean up un-completed request queue
-    _requestQueueMutex.lock();
-    _requestQueue.clear();
-    _requestQueueMutex.unlock();
-
-    _responseQueueMutex.lock();
-    _responseQueue.clear();
-    _responseQueueMutex.unlock();
-
-    decreaseThreadCountAndMayDeleteThis();
+    return true;
 }
 
-// Worker thread
-void HttpClient::networkThreadAlone(HttpRequest *request, HttpResponse *response) {
-    increaseThreadCount();
-
-    char responseMessage[RESPONSE_BUFFER_SIZE] = {0};
-    processResponse(response, responseMessage);
-
-    _schedulerMutex.lock();
-    if (auto sche = _scheduler.lock()) {
-        sche->performFunctionInCocosThread([this, response, request] {
-            const ccHttpRequestCallback &callback = request->getResponseCallback();
-
-            if (callback != nullptr) {
-                callback(this, response);
-            }
-            response->release();
-            // do not release in other thread
-            request->release();
-        });
-    }
-    _schedulerMutex.unlock();
-
-    decreaseThreadCountAndMayDeleteThis();
-}
+} // namespace
+
+struct HttpClient::CurlContext {
+    struct Transfer {
+        CurlContext *context{nullptr};
+        HttpRequest *request{nullptr};
+        HttpResponse *response{nullptr};
+        CURL *handle{nullptr};
+        curl_slist *headers{nullptr};
+        ccstd::string host;
+        // streamed body not delivered yet
+        ccstd::vector<char> chunk;
+        bool streaming{false};
+        char errorBuffer[CURL_ERROR_SIZE]{};
+    };
+
+    struct QueuedRequest {
+        HttpRequest *request;
+        HttpRequest::Priority priority;
+        bool immediate;
+    };
+
+    explicit CurlContext(HttpClient *client);
+    ~CurlContext();
+
+    static size_t writeData(void *ptr, size_t size, size_t nmemb, void *stream);
+    static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream);
+
+    void enqueue(HttpRequest *request, HttpRequest::Priority priority, bool immediate);
+    void stop();
+
+    void run();
+    void takeQueuedRequests();
+    bool startTransfers();
+    bool startTransfer(HttpRequest *request, const ccstd::string &host);
+    void finishTransfer(Transfer *transfer, CURLcode result);
+    void recycleTransfer(Transfer *transfer);
+    void deliverChunk(Transfer *transfer);
+    void performInCocosThread(InlineTask &&task);
+    void cleanup();
+
+    HttpClient *client{nullptr};
+    CURLM *multi{nullptr};
+    // one cookie engine for all the easy handles, they are only used by the network thread
+    CURLSH *share{nullptr};
+
+    // Filled by HttpClient::send, the network thread is woken up with curl_multi_wakeup.
+    ccstd::vector<QueuedRequest> queue;
+    std::mutex queueMutex;
+    std::atomic<bool> quit{false};
+
+    // The state below is only accessed by the network thread.
+    std::array<ccstd::deque<HttpRequest *>, 3> pending;
+    // sent by sendImmediate, they are started whatever the limits
+    ccstd::deque<HttpRequest *> immediate;
+    ccstd::unordered_map<ccstd::string, int> runningPerHost;
+    int runningCount{0};
+    ccstd::vector<Transfer *> transfers;
+    // easy handles are reused, they keep their DNS cache and TLS session ids
+    ccstd::vector<Transfer *> freeTransfers;
+};
 
 //Configure curl's timeout property
 static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle, char *errorBuffer) {
@@ -169,12 +149,13 @@ static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle
         return false;
     }
     // In the openharmony platform, the long type must be used, otherwise there will be an exception.
-    long timeout = static_cast<long>(request->getTimeout());
-    code = curl_easy_setopt(handle, CURLOPT_TIMEOUT, timeout);
+    // Milliseconds, so that timeouts below one second don't turn into 0, which means no timeout.
+    long timeout = static_cast<long>(request->getTimeout() * 1000.0F);
+    code = curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, timeout);
     if (code != CURLE_OK) {
         return false;
     }
-    code = curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, timeout);
+    code = curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT_MS, timeout);
     if (code != CURLE_OK) {
         return false;
     }
@@ -195,124 +176,354 @@ static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle
 
     curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
 
+    // Prefer HTTP/2 over TLS, and wait for a connection that can be multiplexed rather than opening a new one.
+    // Plain http stays on HTTP/1.1, waiting would serialize the requests to a host that closes its connections.
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+    if (isHttps(request->getUrl())) {
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+    }
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+
     return true;
 }
 
-class CURLRaii {
-    /// Instance of CURL
-    CURL *_curl;
-    /// Keeps custom header data
-    curl_slist *_headers;
+static bool configureRequestType(HttpRequest *request, CURL *handle) {
+    auto setOption = [handle](CURLoption option, auto data) {
+        return CURLE_OK == curl_easy_setopt(handle, option, data);
+    };
+    auto setRequestData = [&]() {
+        return setOption(CURLOPT_POSTFIELDSIZE, static_cast<long>(request->getRequestDataSize())) && setOption(CURLOPT_POSTFIELDS, request->getRequestData());
+    };
+
+    switch (request->getRequestType()) {
+        case HttpRequest::Type::GET: // HTTP GET
+            return setOption(CURLOPT_FOLLOWLOCATION, 1L);
+        case HttpRequest::Type::POST: // HTTP POST
+            return setOption(CURLOPT_POST, 1L) && setRequestData();
+        case HttpRequest::Type::PUT:
+            return setOption(CURLOPT_CUSTOMREQUEST, "PUT") && setRequestData();
+        case HttpRequest::Type::HEAD:
+            return setOption(CURLOPT_NOBODY, 1L) && setRequestData();
+        case HttpRequest::Type::DELETE:
+            return setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && setOption(CURLOPT_FOLLOWLOCATION, 1L);
+        case HttpRequest::Type::PATCH:
+            return setOption(CURLOPT_CUSTOMREQUEST, "PATCH") && setRequestData();
+        default:
+            CC_ABORT();
+            return false;
+    }
+}
+
+HttpClient::CurlContext::CurlContext(HttpClient *client)
+: client(client),
+  multi(curl_multi_init()),
+  share(curl_share_init()) {
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, MAX_CACHED_CONNECTIONS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
+}
 
-public:
-    CURLRaii()
-    : _curl(curl_easy_init()),
-      _headers(nullptr) {
+HttpClient::CurlContext::~CurlContext() {
+    for (auto *transfer : transfers) {
+        curl_easy_cleanup(transfer->handle);
+        delete transfer;
     }
+    curl_multi_cleanup(multi);
+    curl_share_cleanup(share);
+}
+
+// Callback function used by libcurl for collect response data
+size_t HttpClient::CurlContext::writeData(void *ptr, size_t size, size_t nmemb, void *stream) {
+    auto *transfer = static_cast<Transfer *>(stream);
+    const auto *data = static_cast<const char *>(ptr);
+    size_t sizes = size * nmemb;
 
-    ~CURLRaii() {
-        if (_curl)
-            curl_easy_cleanup(_curl);
-        /* free the linked list for header data */
-        if (_headers)
-            curl_slist_free_all(_headers);
+    if (transfer->streaming) {
+        if (transfer->chunk.empty()) {
+            transfer->chunk.reserve(STREAM_CHUNK_SIZE);
+        }
+        transfer->chunk.insert(transfer->chunk.end(), data, data + sizes);
+        if (transfer->chunk.size() >= STREAM_CHUNK_SIZE) {
+            transfer->context->deliverChunk(transfer);
+        }
+        return sizes;
     }
 
-    template <class T>
-    bool setOption(CURLoption option, T data) {
-        return CURLE_OK == curl_easy_setopt(_curl, option, data);
+    ccstd::vector<char> *recvBuffer = transfer->response->getResponseData();
+    if (recvBuffer->empty()) {
+        // the length is a hint only, the body may be decoded
+        curl_off_t length = -1;
+        if (curl_easy_getinfo(transfer->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) == CURLE_OK && length > 0) {
+            recvBuffer->reserve(static_cast<size_t>(length));
+        }
     }
 
-    /**
-     * @brief Inits CURL instance for common usage
-     * @param request Null not allowed
-     * @param callback Response write callback
-     * @param stream Response write stream
-     */
-    bool init(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-        if (!_curl)
-            return false;
-        if (!configureCURL(client, request, _curl, errorBuffer))
-            return false;
+    // add data to the end of recvBuffer
+    // write data maybe called more than once in a single request
+    recvBuffer->insert(recvBuffer->end(), data, data + sizes);
 
-        /* get custom header data (if set) */
-        ccstd::vector<ccstd::string> headers = request->getHeaders();
-        if (!headers.empty()) {
-            /* append custom headers one by one */
-            for (auto &header : headers)
-                _headers = curl_slist_append(_headers, header.c_str());
-            /* set custom headers for curl */
-            if (!setOption(CURLOPT_HTTPHEADER, _headers))
-                return false;
+    return sizes;
+}
+
+// Callback function used by libcurl for collect header data
+size_t HttpClient::CurlContext::writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream) {
+    ccstd::vector<char> *recvBuffer = static_cast<ccstd::vector<char> *>(stream);
+    size_t sizes = size * nmemb;
+
+    // add data to the end of recvBuffer
+    // write data maybe called more than once in a single request
+    recvBuffer->insert(recvBuffer->end(), static_cast<char *>(ptr), static_cast<char *>(ptr) + sizes);
+
+    return sizes;
+}
+
+void HttpClient::CurlContext::enqueue(HttpRequest *request, HttpRequest::Priority priority, bool immediate) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back({request, priority, immediate});
+    }
+    curl_multi_wakeup(multi);
+}
+
+void HttpClient::CurlContext::stop() {
+    quit = true;
+    curl_multi_wakeup(multi);
+}
+
+void HttpClient::CurlContext::performInCocosThread(InlineTask &&task) {
+    std::lock_guard<std::mutex> lock(client->_schedulerMutex);
+    if (auto sche = client->_scheduler.lock()) {
+        sche->performFunctionInCocosThread(std::move(task));
+    }
+}
+
+void HttpClient::CurlContext::takeQueuedRequests() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    for (const auto &queued : queue) {
+        if (queued.immediate) {
+            immediate.push_back(queued.request);
+        } else {
+            pending[static_cast<size_t>(queued.priority)].push_back(queued.request);
         }
-        ccstd::string cookieFilename = client->getCookieFilename();
-        if (!cookieFilename.empty()) {
-            if (!setOption(CURLOPT_COOKIEFILE, cookieFilename.c_str())) {
-                return false;
-            }
-            if (!setOption(CURLOPT_COOKIEJAR, cookieFilename.c_str())) {
-                return false;
+    }
+    queue.clear();
+}
+
+bool HttpClient::CurlContext::startTransfers() {
+    bool started = false;
+    // they still count as running, so the other requests wait for them
+    for (auto *request : immediate) {
+        started |= startTransfer(request, getHostKey(request->getUrl()));
+    }
+    immediate.clear();
+
+    const int maxPerHost = std::max(client->_maxConnectionsPerHost.load(), 1);
+    for (auto &requests : pending) {
+        // requests to busy hosts don't block the requests to other hosts
+        for (auto iter = requests.begin(); iter != requests.end() && runningCount < MAX_RUNNING_TRANSFERS;) {
+            auto host = getHostKey((*iter)->getUrl());
+            if (runningPerHost[host] >= maxPerHost) {
+                ++iter;
+                continue;
             }
+            started |= startTransfer(*iter, host);
+            iter = requests.erase(iter);
         }
+    }
+    return started;
+}
+
+bool HttpClient::CurlContext::startTransfer(HttpRequest *request, const ccstd::string &host) {
+    // Create a HttpResponse object, the default setting is http access failed
+    HttpResponse *response = ccnew HttpResponse(request);
+    response->addRef(); // NOTE: RefCounted object's reference count is changed to 0 now. so needs to addRef after ccnew.
 
-        return setOption(CURLOPT_URL, request->getUrl()) && setOption(CURLOPT_WRITEFUNCTION, callback) && setOption(CURLOPT_WRITEDATA, stream) && setOption(CURLOPT_HEADERFUNCTION, headerCallback) && setOption(CURLOPT_HEADERDATA, headerStream);
+    Transfer *transfer = nullptr;
+    if (freeTransfers.empty()) {
+        transfer = ccnew Transfer();
+        transfer->context = this;
+        transfer->handle = curl_easy_init();
+        transfers.push_back(transfer);
+    } else {
+        transfer = freeTransfers.back();
+        freeTransfers.pop_back();
+    }
+    transfer->request = request;
+    transfer->response = response;
+    transfer->host = host;
+    transfer->streaming = request->getResponseDataCallback() != nullptr;
+    transfer->errorBuffer[0] = '\0';
+
+    CURL *handle = transfer->handle;
+    bool ok = configureCURL(client, request, handle, transfer->errorBuffer);
+    if (ok) {
+        /* get custom header data (if set) */
+        for (const auto &header : request->getHeaders()) {
+            transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+        }
+        if (transfer->headers) {
+            ok = CURLE_OK == curl_easy_setopt(handle, CURLOPT_HTTPHEADER, transfer->headers);
+        }
     }
+    ccstd::string cookieFilename = client->getCookieFilename();
+    if (ok && !cookieFilename.empty()) {
+        // the pooled handles would otherwise keep their own cookies until they are cleaned up
+        ok = CURLE_OK == curl_easy_setopt(handle, CURLOPT_SHARE, share) &&
+             CURLE_OK == curl_easy_setopt(handle, CURLOPT_COOKIEFILE, cookieFilename.c_str()) &&
+             CURLE_OK == curl_easy_setopt(handle, CURLOPT_COOKIEJAR, cookieFilename.c_str());
+    }
+    ok = ok &&
+         CURLE_OK == curl_easy_setopt(handle, CURLOPT_URL, request->getUrl()) &&
+         CURLE_OK == curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, writeData) &&
+         CURLE_OK == curl_easy_setopt(handle, CURLOPT_WRITEDATA, transfer) &&
+         CURLE_OK == curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, writeHeaderData) &&
+         CURLE_OK == curl_easy_setopt(handle, CURLOPT_HEADERDATA, response->getResponseHeader()) &&
+         CURLE_OK == curl_easy_setopt(handle, CURLOPT_PRIVATE, transfer) &&
+         configureRequestType(request, handle);
+
+    ++runningPerHost[host];
+    ++runningCount;
+    if (!ok || curl_multi_add_handle(multi, handle) != CURLM_OK) {
+        finishTransfer(transfer, CURLE_FAILED_INIT);
+        return false;
+    }
+    return true;
+}
 
-    /// @param responseCode Null not allowed
-    bool perform(long *responseCode) {
-        if (CURLE_OK != curl_easy_perform(_curl))
-            return false;
-        CURLcode code = curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, responseCode);
-        if (code != CURLE_OK || !(*responseCode >= 200 && *responseCode < 300)) {
+void HttpClient::CurlContext::finishTransfer(Transfer *transfer, CURLcode result) {
+    HttpResponse *response = transfer->response;
+    long responseCode = -1;
+    bool succeed = result == CURLE_OK;
+    if (succeed) {
+        CURLcode code = curl_easy_getinfo(transfer->handle, CURLINFO_RESPONSE_CODE, &responseCode);
+        if (code != CURLE_OK || !(responseCode >= 200 && responseCode < 300)) {
             CC_LOG_ERROR("Curl curl_easy_getinfo failed: %s", curl_easy_strerror(code));
-            return false;
+            succeed = false;
         }
-        // Get some mor data.
+    }
 
-        return true;
+    // write data to HttpResponse
+    response->setResponseCode(responseCode);
+    response->setSucceed(succeed);
+    if (!succeed) {
+        response->setErrorBuffer(transfer->errorBuffer);
+    }
+
+    if (transfer->streaming) {
+        deliverChunk(transfer);
+    }
+
+    // the handle is reused, so the jar is written now rather than when it's cleaned up
+    if (!client->getCookieFilename().empty()) {
+        curl_easy_setopt(transfer->handle, CURLOPT_COOKIELIST, "FLUSH");
     }
-};
 
-//Process Get Request
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+    // the chunks are delivered in the same lane, so they are all delivered before the response
+    performInCocosThread([this, response]() {
+        HttpRequest *request = response->getHttpRequest();
+        const ccHttpRequestCallback &callback = request->getResponseCallback();
+        if (callback != nullptr) {
+            callback(client, response);
+        }
+
+        response->release();
+        // do not release in other thread
+        request->release();
+    });
+
+    recycleTransfer(transfer);
 }
 
-//Process POST Request
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_POST, 1) && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+void HttpClient::CurlContext::recycleTransfer(Transfer *transfer) {
+    curl_multi_remove_handle(multi, transfer->handle);
+    if (--runningPerHost[transfer->host] == 0) {
+        runningPerHost.erase(transfer->host);
+    }
+    --runningCount;
+
+    if (transfer->headers) {
+        curl_slist_free_all(transfer->headers);
+        transfer->headers = nullptr;
+    }
+    // keeps the live connections, the DNS cache and the TLS session ids
+    curl_easy_reset(transfer->handle);
+    transfer->request = nullptr;
+    transfer->response = nullptr;
+    transfer->chunk.clear();
+    freeTransfers.push_back(transfer);
 }
 
-//Process PUT Request
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+void HttpClient::CurlContext::deliverChunk(Transfer *transfer) {
+    if (transfer->chunk.empty()) {
+        return;
+    }
+    HttpResponse *response = transfer->response;
+    response->addRef();
+    performInCocosThread([this, response, chunk = std::move(transfer->chunk)]() {
+        const ccHttpDataCallback &callback = response->getHttpRequest()->getResponseDataCallback();
+        if (callback != nullptr) {
+            callback(client, response, chunk.data(), chunk.size());
+        }
+        response->release();
+    });
+    transfer->chunk = ccstd::vector<char>();
 }
 
-//Process HEAD Request
-static int processHeadTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_NOBODY, "HEAD") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+void HttpClient::CurlContext::run() {
+    while (!quit) {
+        takeQueuedRequests();
+        startTransfers();
+
+        int runningHandles = 0;
+        curl_multi_perform(multi, &runningHandles);
+
+        bool finished = false;
+        int messageCount = 0;
+        while (CURLMsg *message = curl_multi_info_read(multi, &messageCount)) {
+            if (message->msg == CURLMSG_DONE) {
+                Transfer *transfer = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+                finishTransfer(transfer, message->data.result);
+                finished = true;
+            }
+        }
+
+        // start the requests that were waiting for the finished ones without waiting
+        if (!finished) {
+            curl_multi_poll(multi, nullptr, 0, POLL_TIMEOUT_MS, nullptr);
+        }
+    }
+
+    cleanup();
 }
 
-//Process DELETE Request
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+void HttpClient::CurlContext::cleanup() {
+    // if worker thread received quit signal, clean up un-completed requests without invoking their callbacks
+    takeQueuedRequests();
+    for (auto *request : immediate) {
+        request->release();
+    }
+    immediate.clear();
+    for (auto &requests : pending) {
+        for (auto *request : requests) {
+            request->release();
+        }
+        requests.clear();
+    }
+
+    for (auto *transfer : transfers) {
+        if (transfer->request != nullptr) {
+            transfer->response->release();
+            transfer->request->release();
+            recycleTransfer(transfer);
+        }
+    }
 }
 
-//Process PATCH Request
-static int processPatchTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "PATCH") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// Worker thread
+void HttpClient::networkThread() {
+    _curlContext->run();
+    decreaseThreadCountAndMayDeleteThis();
 }
 
 // HttpClient implementation
@@ -342,11 +553,7 @@ void HttpClient::destroyInstance() {
     thiz->_scheduler.reset();
     thiz->_schedulerMutex.unlock();
 
-    thiz->_requestQueueMutex.lock();
-    thiz->_requestQueue.pushBack(thiz->_requestSentinel);
-    thiz->_requestQueueMutex.unlock();
-
-    thiz->_sleepCondition.notify_one();
+    thiz->_curlContext->stop();
     thiz->decreaseThreadCountAndMayDeleteThis();
 
     CC_LOG_DEBUG("HttpClient::destroyInstance() finished!");
@@ -372,18 +579,16 @@ HttpClient::HttpClient()
   _timeoutForRead(60),
   _threadCount(0),
   _cookie(nullptr),
-  _requestSentinel(ccnew HttpRequest()) {
+  _requestSentinel(nullptr) {
     CC_LOG_DEBUG("In the constructor of HttpClient!");
-    _requestSentinel->addRef();
-    if (gThreadPool == nullptr) {
-        gThreadPool = LegacyThreadPool::newFixedThreadPool(4);
-    }
     memset(_responseMessage, 0, RESPONSE_BUFFER_SIZE * sizeof(char));
+    _curlContext = ccnew CurlContext(this);
     _scheduler = CC_CURRENT_ENGINE()->getScheduler();
     increaseThreadCount();
 }
 
 HttpClient::~HttpClient() {
+    delete _curlContext;
     CC_SAFE_RELEASE(_requestSentinel);
     CC_LOG_DEBUG("HttpClient destructor");
 }
@@ -393,6 +598,8 @@ bool HttpClient::lazyInitThreadSemaphore() {
     if (_isInited) {
         return true;
     } else {
+        // counted before the thread starts, so that destroyInstance can't delete the client under it
+        increaseThreadCount();
         auto t = std::thread(CC_CALLBACK_0(HttpClient::networkThread, this));
         t.detach();
         _isInited = true;
@@ -412,136 +619,21 @@ void HttpClient::send(HttpRequest *request) {
     }
 
     request->addRef();
-
-    _requestQueueMutex.lock();
-    _requestQueue.pushBack(request);
-    _requestQueueMutex.unlock();
-
-    // Notify thread start to work
-    _sleepCondition.notify_one();
+    _curlContext->enqueue(request, request->getPriority(), false);
 }
 
 void HttpClient::sendImmediate(HttpRequest *request) {
-    if (!request) {
+    if (false == lazyInitThreadSemaphore()) {
         return;
     }
 
-    request->addRef();
-    // Create a HttpResponse object, the default setting is http access failed
-    HttpResponse *response = ccnew HttpResponse(request);
-    response->addRef(); // NOTE: RefCounted object's reference count is changed to 0 now. so needs to addRef after ccnew.
-
-    gThreadPool->pushTask([this, request, response](int /*tid*/) { HttpClient::networkThreadAlone(request, response); });
-}
-
-// Poll and notify main thread if responses exists in queue
-void HttpClient::dispatchResponseCallbacks() {
-    // log("CCHttpClient::dispatchResponseCallbacks is running");
-    //occurs when cocos thread fires but the network thread has already quited
-    HttpResponse *response = nullptr;
-
-    _responseQueueMutex.lock();
-    if (!_responseQueue.empty()) {
-        response = _responseQueue.at(0);
-        _responseQueue.erase(0);
-    }
-    _responseQueueMutex.unlock();
-
-    if (response) {
-        HttpRequest *request = response->getHttpRequest();
-        const ccHttpRequestCallback &callback = request->getResponseCallback();
-
-        if (callback != nullptr) {
-            callback(this, response);
-        }
-
-        response->release();
-        // do not release in other thread
-        request->release();
-    }
-}
-
-// Process Response
-void HttpClient::processResponse(HttpResponse *response, char *responseMessage) {
-    auto request = response->getHttpRequest();
-    long responseCode = -1;
-    int retValue = 0;
-
-    // Process the request -> get response packet
-    switch (request->getRequestType()) {
-        case HttpRequest::Type::GET: // HTTP GET
-            retValue = processGetTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::POST: // HTTP POST
-            retValue = processPostTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::PUT:
-            retValue = processPutTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::HEAD:
-            retValue = processHeadTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::DELETE:
-            retValue = processDeleteTask(this, request,
-                                         writeData,
-                                         response->getResponseData(),
-                                         &responseCode,
-                                         writeHeaderData,
-                                         response->getResponseHeader(),
-                                         responseMessage);
-            break;
-
-        case HttpRequest::Type::PATCH:
-            retValue = processPatchTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        default:
-            CC_ABORT();
-            break;
+    if (!request) {
+        return;
     }
 
-    // write data to HttpResponse
-    response->setResponseCode(responseCode);
-    if (retValue != 0) {
-        response->setSucceed(false);
-        response->setErrorBuffer(responseMessage);
-    } else {
-        response->setSucceed(true);
-    }
+    // runs on the same event loop, ahead of the queued requests and regardless of the limits
+    request->addRef();
+    _curlContext->enqueue(request, HttpRequest::Priority::HIGH, true);
 }
 
 void HttpClient::increaseThreadCount() {
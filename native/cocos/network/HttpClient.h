@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <thread>
 #include "base/RefVector.h"
@@ -47,6 +48,10 @@ namespace network {
  *
  * Once the request completed, a callback will issued in main thread when it provided during make request.
  *
+ * The curl backend runs all the requests on a single curl_multi event loop. Connections are kept alive and reused,
+ * HTTP/2 requests to the same host are multiplexed on one connection, and queued requests are started by priority
+ * while the number of running requests per host is below getMaxConnectionsPerHost().
+ *
  * @lua NA
  */
 class CC_DLL HttpClient {
@@ -105,13 +110,22 @@ public:
     void send(HttpRequest *request);
 
     /**
-     * Immediate send a request
+     * Immediate send a request, it starts at once without waiting for the per host limit or the other queued requests.
      *
      * @param request a HttpRequest object, which includes url, response callback etc.
                       please make sure request->_requestData is clear before calling "sendImmediate" here.
      */
     void sendImmediate(HttpRequest *request);
 
+    /**
+     * Set the maximum number of requests that run at the same time to a host, the other ones wait in the queue.
+     * Requests sent with sendImmediate() are not limited but are counted. Used by the curl backend only.
+     *
+     * @param count the maximum number of running requests per host, 6 by default.
+     */
+    void setMaxConnectionsPerHost(int count) { _maxConnectionsPerHost = count; }
+    int getMaxConnectionsPerHost() const { return _maxConnectionsPerHost; }
+
     HttpCookie *getCookie() const { return _cookie; }
 
     std::mutex &getCookieFileMutex() { return _cookieFileMutex; }
@@ -134,6 +148,15 @@ private:
     void dispatchResponseCallbacks();
 
     void processResponse(HttpResponse *response, char *responseMessage);
+
+    // Delivers the whole response data to the data callback of the request, for the backends that don't stream it.
+    void deliverResponseData(HttpResponse *response) {
+        const ccHttpDataCallback &callback = response->getHttpRequest()->getResponseDataCallback();
+        auto *data = response->getResponseData();
+        if (callback != nullptr && !data->empty()) {
+            callback(this, response, data->data(), data->size());
+        }
+    }
     void increaseThreadCount();
     void decreaseThreadCountAndMayDeleteThis();
 
@@ -171,6 +194,12 @@ private: // NOLINT(readability-redundant-access-specifiers)
     char _responseMessage[RESPONSE_BUFFER_SIZE];
 
     HttpRequest *_requestSentinel;
+
+    std::atomic<int> _maxConnectionsPerHost{6};
+
+    // State of the curl_multi event loop, used by the curl backend only.
+    struct CurlContext;
+    CurlContext *_curlContext{nullptr};
 };
 
 } // namespace network
@@ -46,6 +46,7 @@ class HttpClient;
 class HttpResponse;
 
 using ccHttpRequestCallback = std::function<void(HttpClient *, HttpResponse *)>;
+using ccHttpDataCallback = std::function<void(HttpClient *, HttpResponse *, const char *, size_t)>;
 
 /**
  * Defines the object which users must packed for HttpClient::send(HttpRequest*) method.
@@ -76,6 +77,15 @@ public:
         UNKNOWN,
     };
 
+    /**
+     * The order in which queued requests are started by HttpClient.
+     */
+    enum class Priority {
+        HIGH,
+        NORMAL,
+        LOW,
+    };
+
     /**
      *  Constructor.
      *   Because HttpRequest object will be used between UI thread and network thread,
@@ -220,6 +230,39 @@ public:
         return _callback;
     }
 
+    /**
+     * Set the callback that receives the response body in chunks, on the cocos thread, as it is downloaded.
+     * The chunks are not kept in the response data, which stays empty.
+     * All the chunks are delivered before the response callback is invoked.
+     *
+     * @param callback the ccHttpDataCallback function.
+     */
+    inline void setResponseDataCallback(const ccHttpDataCallback &callback) {
+        _dataCallback = callback;
+    }
+
+    /**
+     * Get ccHttpDataCallback callback function.
+     *
+     * @return const ccHttpDataCallback& ccHttpDataCallback callback function.
+     */
+    inline const ccHttpDataCallback &getResponseDataCallback() const {
+        return _dataCallback;
+    }
+
+    /**
+     * Set the priority of the request, higher priority requests are started first when requests are queued.
+     *
+     * @param priority the priority of the request.
+     */
+    inline void setPriority(Priority priority) {
+        _priority = priority;
+    }
+
+    inline Priority getPriority() const {
+        return _priority;
+    }
+
     /**
      * Set custom-defined headers.
      *
@@ -253,9 +296,11 @@ protected:
     ccstd::vector<char> _requestData;      /// used for POST
     ccstd::string _tag;                    /// user defined tag, to identify different requests in response callback
     ccHttpRequestCallback _callback;       /// C++11 style callbacks
+    ccHttpDataCallback _dataCallback;      /// receives the response body in chunks
     void *_userData{nullptr};              /// You can add your customed data here
     ccstd::vector<ccstd::string> _headers; /// custom http headers
     float _timeoutInSeconds{10.F};
+    Priority _priority{Priority::NORMAL};
 };
 
 } // namespace network
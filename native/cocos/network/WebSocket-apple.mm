@@ -293,6 +293,12 @@ size_t WebSocket::getBufferedAmount() const {
     return 0;
 }
 
+WebSocket::Stats WebSocket::getStats() const {
+    Stats stats;
+    stats.bufferedAmount = getBufferedAmount();
+    return stats;
+}
+
 WebSocket::State WebSocket::getReadyState() const {
     return [_impl getReadyState];
 }
@@ -51,9 +51,9 @@
 #include <thread>
 #include "application/ApplicationManager.h"
 #include "base/Scheduler.h"
-#include "base/std/container/list.h"
-#include "base/std/container/queue.h"
+#include "base/std/container/deque.h"
 #include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 #include "network/Uri.h"
 #include "network/WebSocket.h"
 
@@ -69,6 +69,10 @@
 
 #define WS_RX_BUFFER_SIZE              (65536)
 #define WS_RESERVE_RECEIVE_BUFFER_SIZE (4096)
+// bytes written in one writable callback before other connections get their turn
+#define WS_WRITE_BUDGET (4 * WS_RX_BUFFER_SIZE)
+// the loop is woken up for new connections and messages, the timeout only bounds the latency if a wake up is missed
+#define WS_SERVICE_TIMEOUT_MS (100)
 
 #if CC_PLATFORM == CC_PLATFORM_ANDROID
     #define WS_ENABLE_LIBUV 1
@@ -222,9 +226,14 @@ public:
     cc::network::WebSocket::Delegate *getDelegate() const;
 
     size_t getBufferedAmount() const;
+    cc::network::WebSocket::Stats getStats() const;
     ccstd::string getExtensions() const;
 
 private:
+    void queueMessage(const char *bytes, uint32_t len, bool isBinary);
+    // asks the websocket thread for a writable callback
+    void requestWritable();
+
     // The following callback functions are invoked in websocket thread
     void onClientOpenConnectionRequest();
     int onSocketCallback(struct lws *wsi, enum lws_callback_reasons reason, void *in, ssize_t len);
@@ -241,7 +250,27 @@ private:
     cc::network::WebSocket::State _readyState;
     std::mutex _readyStateMutex;
     ccstd::string _url;
-    ccstd::vector<char> _receivedData;
+    // pooled buffer the fragments of the incoming message are gathered in
+    ccstd::vector<char> *_receivedData{nullptr};
+
+    // messages queued by send(), written in order by the websocket thread
+    struct OutgoingMessage {
+        // LWS_PRE bytes of headroom followed by the payload
+        ccstd::vector<char> *buffer{nullptr};
+        uint32_t len{0};
+        uint32_t issued{0};
+        bool isBinary{false};
+    };
+    ccstd::deque<OutgoingMessage> _outgoingMessages;
+    mutable std::mutex _outgoingMutex;
+    std::atomic<bool> _writableRequested{false};
+    std::atomic<size_t> _bufferedAmount{0};
+    std::atomic<size_t> _peakBufferedAmount{0};
+    std::atomic<uint64_t> _messagesSent{0};
+    std::atomic<uint64_t> _bytesSent{0};
+    std::atomic<uint64_t> _messagesReceived{0};
+    std::atomic<uint64_t> _bytesReceived{0};
+    std::atomic<uint64_t> _chokedWrites{0};
 
     struct lws *_wsInstance;
     struct lws_protocols *_lwsProtocols;
@@ -270,17 +299,11 @@ private:
     friend class WebSocketCallbackWrapper;
 };
 
-enum WsMsg {
-    WS_MSG_TO_SUBTRHEAD_SENDING_STRING = 0,
-    WS_MSG_TO_SUBTRHEAD_SENDING_BINARY,
-    WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION
-};
-
 class WsThreadHelper;
 
 static ccstd::vector<WebSocketImpl *> *websocketInstances{nullptr};
 static std::recursive_mutex instanceMutex;
-static struct lws_context *wsContext{nullptr};
+static std::atomic<struct lws_context *> wsContext{nullptr};
 static WsThreadHelper *wsHelper{nullptr};
 static std::atomic_bool wsPolling{false};
 
@@ -335,22 +358,61 @@ static lws_context_creation_info convertToContextCreationInfo(const struct lws_p
     return info;
 }
 
-class WsMessage {
+/**
+ *  @brief Recycles message buffers between Cocos thread and websocket thread.
+ *  Buffers handed to scripts as external ArrayBuffers come back when they are collected, maybe on another thread.
+ */
+class WsBufferPool {
 public:
-    WsMessage() : id(++idCount) {}
-    unsigned int id;
-    unsigned int what{0}; // message type
-    cc::network::WebSocket::Data *data{nullptr};
-    void *user{nullptr};
+    // never destroyed, buffers may be released by the script engine at exit
+    static WsBufferPool &getInstance() {
+        static auto *instance = ccnew WsBufferPool();
+        return *instance;
+    }
+
+    ccstd::vector<char> *acquire(size_t capacity) {
+        ccstd::vector<char> *buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            if (!_buffers.empty()) {
+                buffer = _buffers.back();
+                _buffers.pop_back();
+            }
+        }
+        if (buffer == nullptr) {
+            buffer = ccnew ccstd::vector<char>();
+        }
+        buffer->reserve(capacity);
+        return buffer;
+    }
+
+    void release(ccstd::vector<char> *buffer) {
+        if (buffer->capacity() <= MAX_POOLED_CAPACITY) {
+            buffer->clear();
+            std::lock_guard<std::mutex> lk(_mutex);
+            if (_buffers.size() < MAX_POOLED_BUFFERS) {
+                _buffers.push_back(buffer);
+                return;
+            }
+        }
+        delete buffer;
+    }
+
+    static void freeExternal(void * /*bytes*/, size_t /*len*/, void *userData) {
+        getInstance().release(static_cast<ccstd::vector<char> *>(userData));
+    }
 
 private:
-    static unsigned int idCount;
-};
+    static constexpr size_t MAX_POOLED_BUFFERS = 32;
+    static constexpr size_t MAX_POOLED_CAPACITY = 4 * WS_RX_BUFFER_SIZE;
 
-unsigned int WsMessage::idCount = 0;
+    std::mutex _mutex;
+    ccstd::vector<ccstd::vector<char> *> _buffers;
+};
 
 /**
  *  @brief Websocket thread helper, it's used for sending message between UI thread and websocket thread.
+ *  All connections are served by one websocket thread running the lws event loop.
  */
 class WsThreadHelper {
 public:
@@ -363,12 +425,13 @@ public:
     void quitWebSocketThread();
 
     // Sends message to Cocos thread. It's needed to be invoked in Websocket thread.
-    static void sendMessageToCocosThread(const std::function<void()> &cb);
+    static void sendMessageToCocosThread(cc::InlineTask &&cb);
 
-    // Sends message to Websocket thread. It's needs to be invoked in Cocos thread.
-    void sendMessageToWebSocketThread(WsMessage *msg);
+    // Asks websocket thread to open the connection. It's needs to be invoked in Cocos thread.
+    void requestConnection(WebSocketImpl *ws);
 
-    size_t countBufferedBytes(const WebSocketImpl *ws);
+    // Interrupts lws_service so that queued requests are handled immediately.
+    static void wakeUp();
 
     // Waits the sub-thread (websocket thread) to exit,
     void joinWebSocketThread() const;
@@ -381,12 +444,12 @@ protected:
     void wsThreadEntryFunc() const;
 
 public:
-    ccstd::list<WsMessage *> *_subThreadWsMessageQueue;
-    std::mutex _subThreadWsMessageQueueMutex;
+    ccstd::vector<WebSocketImpl *> _pendingConnections;
+    std::mutex _pendingConnectionsMutex;
     std::thread *_subThreadInstance{nullptr};
 
 private:
-    bool _needQuit{false};
+    std::atomic<bool> _needQuit{false};
 };
 
 // Wrapper for converting websocket callback from static function to member function of WebSocket class.
@@ -415,16 +478,11 @@ public:
 };
 
 // Implementation of WsThreadHelper
-WsThreadHelper::WsThreadHelper()
-
-{
-    _subThreadWsMessageQueue = ccnew ccstd::list<WsMessage *>();
-}
+WsThreadHelper::WsThreadHelper() = default;
 
 WsThreadHelper::~WsThreadHelper() {
     joinWebSocketThread();
     CC_SAFE_DELETE(_subThreadInstance);
-    delete _subThreadWsMessageQueue;
 }
 
 bool WsThreadHelper::createWebSocketThread() {
@@ -435,34 +493,33 @@ bool WsThreadHelper::createWebSocketThread() {
 
 void WsThreadHelper::quitWebSocketThread() {
     _needQuit = true;
+    wakeUp();
 }
 
 void WsThreadHelper::onSubThreadLoop() {
     if (wsContext) {
-        //        _readyStateMutex.unlock();
-        wsHelper->_subThreadWsMessageQueueMutex.lock();
-        bool isEmpty = wsHelper->_subThreadWsMessageQueue->empty();
-
-        if (!isEmpty) {
-            auto iter = wsHelper->_subThreadWsMessageQueue->begin();
-            for (; iter != wsHelper->_subThreadWsMessageQueue->end();) {
-                auto *msg = (*iter);
-                auto *ws = static_cast<WebSocketImpl *>(msg->user);
+        ccstd::vector<WebSocketImpl *> connections;
+        {
+            std::lock_guard<std::mutex> lk(wsHelper->_pendingConnectionsMutex);
+            connections.swap(wsHelper->_pendingConnections);
+        }
+        {
+            std::lock_guard<std::recursive_mutex> lk(instanceMutex);
+            for (auto *ws : connections) {
                 // REFINE: ws may be a invalid pointer
-                if (msg->what == WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION) {
-                    ws->onClientOpenConnectionRequest();
-                    delete *iter;
-                    iter = wsHelper->_subThreadWsMessageQueue->erase(iter);
-                } else {
-                    ++iter;
+                ws->onClientOpenConnectionRequest();
+            }
+            if (websocketInstances != nullptr) {
+                for (auto *ws : *websocketInstances) {
+                    if (ws->_wsInstance != nullptr && ws->_writableRequested.exchange(false)) {
+                        lws_callback_on_writable(ws->_wsInstance);
+                    }
                 }
             }
         }
-        wsHelper->_subThreadWsMessageQueueMutex.unlock();
-        // Windows: Cause delay 40ms for event WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION
         // Android: Let libuv lws to decide when to stop
         wsPolling = true;
-        lws_service(wsContext, WS_ENABLE_LIBUV ? 40 : 4);
+        lws_service(wsContext, WS_ENABLE_LIBUV ? 40 : WS_SERVICE_TIMEOUT_MS);
         wsPolling = false;
     }
 }
@@ -488,10 +545,11 @@ void WsThreadHelper::onSubThreadStarted() {
 }
 
 void WsThreadHelper::onSubThreadEnded() {
-    if (wsContext != nullptr) {
-        lws_context_destroy(wsContext);
+    struct lws_context *context = wsContext.exchange(nullptr);
+    if (context != nullptr) {
+        lws_context_destroy(context);
 #if WS_ENABLE_LIBUV
-        lws_context_destroy2(wsContext);
+        lws_context_destroy2(context);
 #endif
     }
 }
@@ -509,26 +567,25 @@ void WsThreadHelper::wsThreadEntryFunc() const {
     LOGD("WebSocket thread exit, helper instance: %p\n", this);
 }
 
-void WsThreadHelper::sendMessageToCocosThread(const std::function<void()> &cb) {
+void WsThreadHelper::sendMessageToCocosThread(cc::InlineTask &&cb) {
     if (CC_CURRENT_APPLICATION() != nullptr) {
-        CC_CURRENT_APPLICATION()->getEngine()->getScheduler()->performFunctionInCocosThread(cb);
+        CC_CURRENT_APPLICATION()->getEngine()->getScheduler()->performFunctionInCocosThread(std::move(cb));
     }
 }
 
-void WsThreadHelper::sendMessageToWebSocketThread(WsMessage *msg) {
-    std::lock_guard<std::mutex> lk(_subThreadWsMessageQueueMutex);
-    _subThreadWsMessageQueue->push_back(msg);
+void WsThreadHelper::requestConnection(WebSocketImpl *ws) {
+    {
+        std::lock_guard<std::mutex> lk(_pendingConnectionsMutex);
+        _pendingConnections.push_back(ws);
+    }
+    wakeUp();
 }
 
-size_t WsThreadHelper::countBufferedBytes(const WebSocketImpl *ws) {
-    std::lock_guard<std::mutex> lk(_subThreadWsMessageQueueMutex);
-    size_t total = 0;
-    for (auto *msg : *_subThreadWsMessageQueue) {
-        if (msg->user == ws && msg->data && (msg->what == WS_MSG_TO_SUBTRHEAD_SENDING_STRING || msg->what == WS_MSG_TO_SUBTRHEAD_SENDING_BINARY)) {
-            total += msg->data->getRemain();
-        }
+void WsThreadHelper::wakeUp() {
+    struct lws_context *context = wsContext;
+    if (context != nullptr) {
+        lws_cancel_service(context);
     }
-    return total;
 }
 
 void WsThreadHelper::joinWebSocketThread() const {
@@ -537,47 +594,6 @@ void WsThreadHelper::joinWebSocketThread() const {
     }
 }
 
-// Define a WebSocket frame
-class WebSocketFrame {
-public:
-    bool init(unsigned char *buf, ssize_t len) {
-        if (buf == nullptr && len > 0) {
-            return false;
-        }
-
-        if (!_data.empty()) {
-            LOGD("WebSocketFrame was initialized, should not init it again!\n");
-            return false;
-        }
-
-        _data.resize(LWS_PRE + len);
-        if (len > 0) {
-            std::copy(buf, buf + len, _data.begin() + LWS_PRE);
-        }
-
-        _payload = _data.data() + LWS_PRE;
-        _payloadLength = len;
-        _frameLength = len;
-        return true;
-    }
-
-    void update(ssize_t issued) {
-        _payloadLength -= issued;
-        _payload += issued;
-    }
-
-    unsigned char *getPayload() const { return _payload; }
-    ssize_t getPayloadLength() const { return _payloadLength; }
-    ssize_t getFrameLength() const { return _frameLength; }
-
-private:
-    unsigned char *_payload{nullptr};
-    ssize_t _payloadLength{0};
-
-    ssize_t _frameLength{0};
-    ccstd::vector<unsigned char> _data;
-};
-
 //
 
 void WebSocketImpl::closeAllConnections() {
@@ -603,9 +619,6 @@ WebSocketImpl::WebSocketImpl(cc::network::WebSocket *ws)
   _isDestroyed(std::make_shared<std::atomic<bool>>(false)),
   _delegate(nullptr),
   _closeState(CloseState::NONE) {
-    // reserve data buffer to avoid allocate memory frequently
-    _receivedData.reserve(WS_RESERVE_RECEIVE_BUFFER_SIZE);
-
     {
         std::lock_guard<std::recursive_mutex> lk(instanceMutex);
         if (websocketInstances == nullptr) {
@@ -651,6 +664,16 @@ WebSocketImpl::~WebSocketImpl() {
         CC_SAFE_DELETE(wsHelper);
     }
 
+    // websocket thread doesn't touch this instance any more, give back buffers which were not sent.
+    for (auto &message : _outgoingMessages) {
+        WsBufferPool::getInstance().release(message.buffer);
+    }
+    _outgoingMessages.clear();
+    if (_receivedData != nullptr) {
+        WsBufferPool::getInstance().release(_receivedData);
+        _receivedData = nullptr;
+    }
+
     // NOTE: Refer to the comment in constructor!!!
     //    cc::Director::getInstance()->getEventDispatcher()->removeEventListener(_resetDirectorListener);
 
@@ -701,13 +724,10 @@ bool WebSocketImpl::init(const cc::network::WebSocket::Delegate &delegate,
         isWebSocketThreadCreated = false;
     }
 
-    auto *msg = ccnew WsMessage();
-    msg->what = WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION;
-    msg->user = this;
-    wsHelper->sendMessageToWebSocketThread(msg);
+    wsHelper->requestConnection(this);
 
     // fixed https://github.com/cocos2d/cocos2d-x/issues/17433
-    // createWebSocketThread has to be after message WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION was sent.
+    // createWebSocketThread has to be after the connection request was queued.
     // And websocket thread should only be created once.
     if (!isWebSocketThreadCreated) {
         wsHelper->createWebSocketThread();
@@ -726,7 +746,23 @@ bool WebSocketImpl::init(const cc::network::WebSocket::Delegate &delegate,
 }
 
 size_t WebSocketImpl::getBufferedAmount() const {
-    return wsHelper->countBufferedBytes(this);
+    return _bufferedAmount;
+}
+
+cc::network::WebSocket::Stats WebSocketImpl::getStats() const {
+    cc::network::WebSocket::Stats stats;
+    stats.messagesSent = _messagesSent;
+    stats.bytesSent = _bytesSent;
+    stats.messagesReceived = _messagesReceived;
+    stats.bytesReceived = _bytesReceived;
+    stats.bufferedAmount = _bufferedAmount;
+    stats.peakBufferedAmount = _peakBufferedAmount;
+    stats.chokedWrites = _chokedWrites;
+    {
+        std::lock_guard<std::mutex> lk(_outgoingMutex);
+        stats.pendingMessages = _outgoingMessages.size();
+    }
+    return stats;
 }
 
 ccstd::string WebSocketImpl::getExtensions() const {
@@ -741,18 +777,7 @@ ccstd::string WebSocketImpl::getExtensions() const {
 void WebSocketImpl::send(const ccstd::string &message) {
     if (_readyState == cc::network::WebSocket::State::OPEN) {
         // In main thread
-        auto *data = ccnew cc::network::WebSocket::Data();
-        data->bytes = static_cast<char *>(malloc(message.length() + 1));
-        // Make sure the last byte is '\0'
-        data->bytes[message.length()] = '\0';
-        strcpy(data->bytes, message.c_str());
-        data->len = static_cast<ssize_t>(message.length());
-
-        auto *msg = ccnew WsMessage();
-        msg->what = WS_MSG_TO_SUBTRHEAD_SENDING_STRING;
-        msg->data = data;
-        msg->user = this;
-        wsHelper->sendMessageToWebSocketThread(msg);
+        queueMessage(message.c_str(), static_cast<uint32_t>(message.length()), false);
     } else {
         LOGD("Couldn't send message since websocket wasn't opened!\n");
     }
@@ -761,27 +786,40 @@ void WebSocketImpl::send(const ccstd::string &message) {
 void WebSocketImpl::send(const unsigned char *binaryMsg, unsigned int len) {
     if (_readyState == cc::network::WebSocket::State::OPEN) {
         // In main thread
-        auto *data = ccnew cc::network::WebSocket::Data();
-        if (len == 0) {
-            // If data length is zero, allocate 1 byte for safe.
-            data->bytes = static_cast<char *>(malloc(1));
-            data->bytes[0] = '\0';
-        } else {
-            data->bytes = static_cast<char *>(malloc(len));
-            memcpy(data->bytes, binaryMsg, len);
-        }
-        data->len = len;
-
-        auto *msg = ccnew WsMessage();
-        msg->what = WS_MSG_TO_SUBTRHEAD_SENDING_BINARY;
-        msg->data = data;
-        msg->user = this;
-        wsHelper->sendMessageToWebSocketThread(msg);
+        queueMessage(reinterpret_cast<const char *>(binaryMsg), len, true);
     } else {
         LOGD("Couldn't send message since websocket wasn't opened!\n");
     }
 }
 
+void WebSocketImpl::queueMessage(const char *bytes, uint32_t len, bool isBinary) {
+    // Copy once into a buffer with LWS_PRE bytes of headroom, the websocket thread writes it in place.
+    auto *buffer = WsBufferPool::getInstance().acquire(LWS_PRE + len);
+    buffer->resize(LWS_PRE + len);
+    if (len > 0) {
+        memcpy(buffer->data() + LWS_PRE, bytes, len);
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(_outgoingMutex);
+        _outgoingMessages.push_back({buffer, len, 0, isBinary});
+    }
+
+    size_t buffered = _bufferedAmount.fetch_add(len) + len;
+    size_t peak = _peakBufferedAmount;
+    while (buffered > peak && !_peakBufferedAmount.compare_exchange_weak(peak, buffered)) {
+    }
+
+    requestWritable();
+}
+
+void WebSocketImpl::requestWritable() {
+    // Several sends between two loop iterations only arm the writable callback once.
+    if (!_writableRequested.exchange(true)) {
+        WsThreadHelper::wakeUp();
+    }
+}
+
 void WebSocketImpl::close() {
     if (_closeState != CloseState::NONE) {
         LOGD("close was invoked, don't invoke it again!\n");
@@ -805,6 +843,9 @@ void WebSocketImpl::close() {
         _readyStateMutex.unlock();
     }
 
+    // onClientWritable closes the connection
+    requestWritable();
+
     {
         std::unique_lock<std::mutex> lkClose(_closeMutex);
         _closeCondition.wait(lkClose);
@@ -839,6 +880,8 @@ void WebSocketImpl::closeAsync() {
     }
 
     _readyState = cc::network::WebSocket::State::CLOSING;
+    // onClientWritable closes the connection
+    requestWritable();
 }
 
 cc::network::WebSocket::State WebSocketImpl::getReadyState() const {
@@ -1005,130 +1048,78 @@ int WebSocketImpl::onClientWritable() {
         }
     }
 
-    do {
-        std::lock_guard<std::mutex> lk(wsHelper->_subThreadWsMessageQueueMutex);
-
-        if (wsHelper->_subThreadWsMessageQueue->empty()) {
-            break;
-        }
-
-        auto iter = wsHelper->_subThreadWsMessageQueue->begin();
-
-        while (iter != wsHelper->_subThreadWsMessageQueue->end()) {
-            WsMessage *msg = *iter;
-            if (msg->user == this) {
+    // Write queued fragments until the budget is spent or the socket can't take more,
+    // so that one connection doesn't starve the others served by this thread.
+    size_t budget = WS_WRITE_BUDGET;
+    bool hasMore = false;
+    while (budget > 0) {
+        OutgoingMessage *message = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(_outgoingMutex);
+            if (_outgoingMessages.empty()) {
                 break;
             }
-            ++iter;
+            // Only this thread pops, and push_back doesn't invalidate references of a deque.
+            message = &_outgoingMessages.front();
         }
 
-        ssize_t bytesWrite = 0;
-        if (iter != wsHelper->_subThreadWsMessageQueue->end()) {
-            WsMessage *subThreadMsg = *iter;
-
-            auto *data = subThreadMsg->data;
-
-            const ssize_t cBufferSize = WS_RX_BUFFER_SIZE;
-
-            const ssize_t remaining = data->len - data->issued;
-            const ssize_t n = std::min(remaining, cBufferSize);
+        const uint32_t remaining = message->len - message->issued;
+        const uint32_t n = std::min(remaining, static_cast<uint32_t>(WS_RX_BUFFER_SIZE));
 
-            WebSocketFrame *frame = nullptr;
-
-            if (data->ext) {
-                frame = static_cast<WebSocketFrame *>(data->ext);
-            } else {
-                frame = ccnew WebSocketFrame();
-                bool success = frame && frame->init(reinterpret_cast<unsigned char *>(data->bytes + data->issued), n);
-                if (success) {
-                    data->ext = frame;
-                } else { // If frame initialization failed, delete the frame and drop the sending data
-                         // These codes should never be called.
-                    LOGD("WebSocketFrame initialization failed, drop the sending data, msg(%d)\n", (int)subThreadMsg->id);
-                    delete frame;
-                    CC_SAFE_FREE(data->bytes);
-                    CC_SAFE_DELETE(data);
-                    wsHelper->_subThreadWsMessageQueue->erase(iter);
-                    CC_SAFE_DELETE(subThreadMsg);
-                    break;
-                }
+        int writeProtocol;
+        if (message->issued == 0) {
+            writeProtocol = message->isBinary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT;
+            // If we have more than 1 fragment
+            if (remaining > n) {
+                writeProtocol |= LWS_WRITE_NO_FIN;
             }
-
-            int writeProtocol;
-
-            if (data->issued == 0) {
-                if (WS_MSG_TO_SUBTRHEAD_SENDING_STRING == subThreadMsg->what) {
-                    writeProtocol = LWS_WRITE_TEXT;
-                } else {
-                    writeProtocol = LWS_WRITE_BINARY;
-                }
-
-                // If we have more than 1 fragment
-                if (data->len > cBufferSize) {
-                    writeProtocol |= LWS_WRITE_NO_FIN;
-                }
-            } else {
-                // we are in the middle of fragments
-                writeProtocol = LWS_WRITE_CONTINUATION;
-                // and if not in the last fragment
-                if (remaining != n) {
-                    writeProtocol |= LWS_WRITE_NO_FIN;
-                }
-            }
-
-            bytesWrite = lws_write(_wsInstance, frame->getPayload(), frame->getPayloadLength(), static_cast<lws_write_protocol>(writeProtocol));
-
-            // Handle the result of lws_write
-            // Buffer overrun?
-            if (bytesWrite < 0) {
-                LOGD("ERROR: msg(%u), lws_write return: %d, but it should be %d, drop this message.\n", subThreadMsg->id, (int)bytesWrite, (int)n);
-                // socket error, we need to close the socket connection
-                CC_SAFE_FREE(data->bytes);
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
-                CC_SAFE_DELETE(data);
-                wsHelper->_subThreadWsMessageQueue->erase(iter);
-                CC_SAFE_DELETE(subThreadMsg);
-
-                closeAsync();
-            } else if (bytesWrite < frame->getPayloadLength()) {
-                frame->update(bytesWrite);
-                LOGD("frame wasn't sent completely, bytesWrite: %d, remain: %d\n", (int)bytesWrite, (int)frame->getPayloadLength());
-            }
-            // Do we have another fragments to send?
-            else if (remaining > frame->getFrameLength() && bytesWrite == frame->getPayloadLength()) {
-                // A frame was totally sent, plus data->issued to send next frame
-                LOGD("msg(%u) append: %d + %d = %d\n", subThreadMsg->id, (int)data->issued, (int)frame->getFrameLength(), (int)(data->issued + frame->getFrameLength()));
-                data->issued += frame->getFrameLength();
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
+        } else {
+            // we are in the middle of fragments
+            writeProtocol = LWS_WRITE_CONTINUATION;
+            // and if not in the last fragment
+            if (remaining != n) {
+                writeProtocol |= LWS_WRITE_NO_FIN;
             }
-            // Safely done!
-            else {
-                LOGD("Safely done, msg(%d)!\n", subThreadMsg->id);
-                if (remaining == frame->getFrameLength()) {
-                    LOGD("msg(%u) append: %d + %d = %d\n", subThreadMsg->id, (int)data->issued, (int)frame->getFrameLength(), (int)(data->issued + frame->getFrameLength()));
-                    LOGD("msg(%u) was totally sent!\n", subThreadMsg->id);
-                } else {
-                    LOGD("ERROR: msg(%u), remaining(%d) < bytesWrite(%d)\n", subThreadMsg->id, (int)remaining, (int)frame->getFrameLength());
-                    LOGD("Drop the msg(%u)\n", subThreadMsg->id);
-                    closeAsync();
-                }
+        }
 
-                CC_SAFE_FREE(data->bytes);
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
-                CC_SAFE_DELETE(data);
-                wsHelper->_subThreadWsMessageQueue->erase(iter);
-                CC_SAFE_DELETE(subThreadMsg);
+        // lws writes the frame header in the LWS_PRE bytes before the payload, which are either
+        // the headroom of the buffer or bytes of the previous fragment that were already sent.
+        auto *payload = reinterpret_cast<unsigned char *>(message->buffer->data() + LWS_PRE + message->issued);
+        int bytesWrite = lws_write(_wsInstance, payload, n, static_cast<lws_write_protocol>(writeProtocol));
+        if (bytesWrite < 0) {
+            LOGD("ERROR: lws_write return: %d, but it should be %d, close the connection.\n", bytesWrite, (int)n);
+            // socket error, we need to close the socket connection
+            closeAsync();
+            return -1;
+        }
 
-                LOGD("-----------------------------------------------------------\n");
+        // A partial write is kept by lws and flushed before the next writable callback.
+        message->issued += n;
+        budget -= std::min(budget, static_cast<size_t>(n));
+        _bytesSent += n;
+        _bufferedAmount -= n;
+
+        if (message->issued == message->len) {
+            ccstd::vector<char> *buffer = message->buffer;
+            {
+                std::lock_guard<std::mutex> lk(_outgoingMutex);
+                _outgoingMessages.pop_front();
+                hasMore = !_outgoingMessages.empty();
             }
+            WsBufferPool::getInstance().release(buffer);
+            ++_messagesSent;
+        } else {
+            hasMore = true;
         }
 
-    } while (false);
+        if (lws_send_pipe_choked(_wsInstance)) {
+            ++_chokedWrites;
+            break;
+        }
+    }
 
-    if (_wsInstance != nullptr) {
+    // Only ask for another callback when there is something left to write.
+    if (hasMore && _wsInstance != nullptr) {
         lws_callback_on_writable(_wsInstance);
     }
 
@@ -1142,8 +1133,11 @@ int WebSocketImpl::onClientReceivedData(void *in, ssize_t len) {
     if (in != nullptr && len > 0) {
         LOGD("Receiving data:index:%d, len=%d\n", packageIndex, (int)len);
 
+        if (_receivedData == nullptr) {
+            _receivedData = WsBufferPool::getInstance().acquire(WS_RESERVE_RECEIVE_BUFFER_SIZE);
+        }
         auto *inData = static_cast<unsigned char *>(in);
-        _receivedData.insert(_receivedData.end(), inData, inData + len);
+        _receivedData->insert(_receivedData->end(), inData, inData + len);
     } else {
         LOGD("Empty message received, index=%d!\n", packageIndex);
     }
@@ -1154,10 +1148,11 @@ int WebSocketImpl::onClientReceivedData(void *in, ssize_t len) {
     //    LOGD("remainingSize: %d, isFinalFragment: %d\n", (int)remainingSize, isFinalFragment);
 
     if (remainingSize == 0 && isFinalFragment) {
-        auto *frameData = ccnew ccstd::vector<char>(std::move(_receivedData));
-
-        // reset capacity of received data buffer
-        _receivedData.reserve(WS_RESERVE_RECEIVE_BUFFER_SIZE);
+        ccstd::vector<char> *frameData = _receivedData;
+        _receivedData = nullptr;
+        if (frameData == nullptr) {
+            frameData = WsBufferPool::getInstance().acquire(1);
+        }
 
         ssize_t frameSize = frameData->size();
 
@@ -1167,6 +1162,9 @@ int WebSocketImpl::onClientReceivedData(void *in, ssize_t len) {
             frameData->push_back('\0');
         }
 
+        ++_messagesReceived;
+        _bytesReceived += frameSize;
+
         std::shared_ptr<std::atomic<bool>> isDestroyed = _isDestroyed;
         wsHelper->sendMessageToCocosThread([this, frameData, frameSize, isBinary, isDestroyed]() {
             // In UI thread
@@ -1176,6 +1174,9 @@ int WebSocketImpl::onClientReceivedData(void *in, ssize_t len) {
             data.isBinary = isBinary;
             data.bytes = static_cast<char *>(frameData->data());
             data.len = frameSize;
+            // The delegate may take over the buffer instead of copying it, see Data::detach.
+            data.freeFunc = WsBufferPool::freeExternal;
+            data.freeUserData = frameData;
 
             if (*isDestroyed) {
                 LOGD("WebSocket instance was destroyed!\n");
@@ -1183,7 +1184,9 @@ int WebSocketImpl::onClientReceivedData(void *in, ssize_t len) {
                 _delegate->onMessage(_ws, data);
             }
 
-            delete frameData;
+            if (!data.detached) {
+                WsBufferPool::getInstance().release(frameData);
+            }
         });
     }
 
@@ -1391,6 +1394,10 @@ size_t WebSocket::getBufferedAmount() const {
     return _impl->getBufferedAmount();
 }
 
+WebSocket::Stats WebSocket::getStats() const {
+    return _impl->getStats();
+}
+
 const ccstd::string &WebSocket::getUrl() const {
     return _impl->getUrl();
 }
@@ -325,6 +325,12 @@ size_t WebSocket::getBufferedAmount() const {
     return _impl->getBufferedAmount();
 }
 
+WebSocket::Stats WebSocket::getStats() const {
+    Stats stats;
+    stats.bufferedAmount = getBufferedAmount();
+    return stats;
+}
+
 const std::string &WebSocket::getUrl() const {
     return _impl->getUrl();
 }
@@ -90,7 +90,39 @@ public:
         uint32_t len{0}, issued{0};
         bool isBinary{false};
         void *ext{nullptr};
+        // set for received messages whose storage the delegate may keep, see detach()
+        void (*freeFunc)(void *bytes, size_t len, void *userData){nullptr};
+        void *freeUserData{nullptr};
+        mutable bool detached{false};
         uint32_t getRemain() const { return std::max(static_cast<uint32_t>(0), len - issued); }
+        /**
+         * Takes over bytes instead of copying them, e.g. as an external ArrayBuffer.
+         * They have to be released with freeFunc(bytes, len, freeUserData).
+         * @return false if the storage can't be taken over.
+         */
+        bool detach() const {
+            if (freeFunc == nullptr || detached) {
+                return false;
+            }
+            detached = true;
+            return true;
+        }
+    };
+
+    /**
+     * Transfer counters of a connection, used to watch for backpressure.
+     */
+    struct Stats {
+        uint64_t messagesSent{0};
+        uint64_t bytesSent{0};
+        uint64_t messagesReceived{0};
+        uint64_t bytesReceived{0};
+        // bytes queued by send() but not written yet, and the highest amount seen
+        size_t bufferedAmount{0};
+        size_t peakBufferedAmount{0};
+        uint32_t pendingMessages{0};
+        // times writing was deferred because the socket couldn't take more data
+        uint64_t chokedWrites{0};
     };
 
     /**
@@ -227,6 +259,11 @@ public:
     */
     size_t getBufferedAmount() const;
 
+    /**
+    * @brief Returns the transfer counters of the connection, only bufferedAmount is filled by the platform implementations.
+    */
+    Stats getStats() const;
+
     /**
     * @brief Returns the extensions selected by the server.
     */
@@ -22,18 +22,39 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
+#include <thread>
 #include <utility>
 
 #include "application/ApplicationManager.h"
 #include "base/Log.h"
 #include "base/Scheduler.h"
 #include "base/memory/Memory.h"
+#include "base/threading/InlineTask.h"
 #include "cocos/network/WebSocketServer.h"
+#include "concurrentqueue/concurrentqueue.h"
 
 #define MAX_MSG_PAYLOAD 2048
-#define SEND_BUFF       1024
+#define SEND_BUFF       65536
+// bytes one connection may write in a writable callback before the others get their turn
+#define WRITE_BUDGET (4 * SEND_BUFF)
+
+namespace cc {
+namespace network {
+
+struct ServerTaskQueue {
+    // multi-producer lock free, keeps the order of tasks posted by one thread
+    moodycamel::ConcurrentQueue<cc::InlineTask> tasks;
+    // null once the server loop has stopped, connections held by the game may still post tasks
+    std::atomic<uv_async_t *> async{nullptr};
+    // producers between reading async and signaling it, the handle is closed once there are none
+    std::atomic<uint32_t> posting{0};
+};
+
+} // namespace network
+} // namespace cc
 
 namespace {
 
@@ -55,37 +76,57 @@ const struct lws_extension EXTS[] = {
      "deflate-frame"},
     {nullptr, nullptr, nullptr}};
 
-struct AsyncTaskData {
-    std::mutex mtx;
-    ccstd::list<std::function<void()>> tasks;
-};
+constexpr size_t TASK_BATCH_SIZE = 64;
 
 // run in server thread loop
 void flushTasksInServerLoopCb(uv_async_t *async) {
-    auto *data = static_cast<AsyncTaskData *>(async->data);
-    std::lock_guard<std::mutex> guard(data->mtx);
-    while (!data->tasks.empty()) {
-        // fetch task, run task
-        data->tasks.front()();
-        // drop task
-        data->tasks.pop_front();
+    auto *data = static_cast<cc::network::ServerTaskQueue *>(async->data);
+    // uv_async_send coalesces wakeups, run what was queued so far in one pass.
+    // Tasks queued meanwhile sent another wakeup and run in the next loop iteration.
+    cc::InlineTask tasks[TASK_BATCH_SIZE];
+    size_t remaining = data->tasks.size_approx();
+    while (remaining > 0) {
+        const size_t count = data->tasks.try_dequeue_bulk(tasks, std::min(remaining, TASK_BATCH_SIZE));
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            tasks[i]();
+            tasks[i].reset();
+        }
+        remaining -= count;
     }
 }
-void initLibuvAsyncHandle(uv_loop_t *loop, uv_async_t *async) {
+void initLibuvAsyncHandle(uv_loop_t *loop, uv_async_t *async, cc::network::ServerTaskQueue *queue) {
     memset(async, 0, sizeof(uv_async_t));
     uv_async_init(loop, async, flushTasksInServerLoopCb);
-    async->data = ccnew AsyncTaskData();
+    async->data = queue;
+    queue->async.store(async);
+}
+
+// run in server thread after the loop has stopped, tasks posted later are dropped
+void closeLibuvAsyncHandle(uv_async_t *async, cc::network::ServerTaskQueue *queue) {
+    // producers either see the null handle or are waited for, so none of them signals a closed handle
+    queue->async.store(nullptr);
+    while (queue->posting.load() != 0) {
+        std::this_thread::yield();
+    }
+    cc::InlineTask task;
+    while (queue->tasks.try_dequeue(task)) {
+        task.reset();
+    }
+    uv_close(reinterpret_cast<uv_handle_t *>(async), nullptr);
 }
 
 // run in game thread, dispatch runnable object into server loop
-void schedule_task_into_server_thread_task_queue(uv_async_t *async, std::function<void()> func) {
-    auto *data = static_cast<AsyncTaskData *>(async->data);
-    if (data) {
-        std::lock_guard<std::mutex> guard(data->mtx);
-        data->tasks.emplace_back(func);
+void schedule_task_into_server_thread_task_queue(const std::shared_ptr<cc::network::ServerTaskQueue> &queue, cc::InlineTask &&task) {
+    queue->posting.fetch_add(1);
+    if (uv_async_t *async = queue->async.load()) {
+        queue->tasks.enqueue(std::move(task));
+        //notify server thread to invoke `flushTasksInServerLoopCb()`
+        uv_async_send(async);
     }
-    //notify server thread to invoke `flushTasksInServerLoopCb()`
-    uv_async_send(async);
+    queue->posting.fetch_sub(1);
 }
 
 } // namespace
@@ -110,11 +151,11 @@ namespace network {
         });                                                      \
     } while (0)
 
-#define RUN_IN_SERVERTHREAD(task)                                    \
-    do {                                                             \
-        schedule_task_into_server_thread_task_queue(&_async, [=]() { \
-            task;                                                    \
-        });                                                          \
+#define RUN_IN_SERVERTHREAD(queue, task)                            \
+    do {                                                            \
+        schedule_task_into_server_thread_task_queue(queue, [=]() { \
+            task;                                                   \
+        });                                                         \
     } while (0)
 
 //#define LOGE() CCLOG("WSS: %s", __FUNCTION__)
@@ -155,7 +196,7 @@ ccstd::string DataFrame::toString() {
     return ccstd::string(reinterpret_cast<char *>(getData()), size());
 }
 
-WebSocketServer::WebSocketServer() {
+WebSocketServer::WebSocketServer() : _taskQueue(std::make_shared<ServerTaskQueue>()) {
     aliveServer.fetch_add(1);
 }
 
@@ -180,7 +221,7 @@ void WebSocketServer::closeAsync(const std::function<void(const ccstd::string &e
     if (_serverState.load() != ServerThreadState::RUNNING) {
         return;
     }
-    RUN_IN_SERVERTHREAD(this->close(callback));
+    RUN_IN_SERVERTHREAD(_taskQueue, this->close(callback));
 }
 
 void WebSocketServer::listen(const std::shared_ptr<WebSocketServer> &server, int port, const ccstd::string &host, const std::function<void(const ccstd::string &errorMsg)> &callback) {
@@ -245,14 +286,17 @@ void WebSocketServer::listen(const std::shared_ptr<WebSocketServer> &server, int
         return;
     }
 
+    // the port assigned by the system when listening on port 0
+    server->_port = lws_get_vhost_listen_port(lws_get_vhost_by_name(server->_ctx, "default"));
     loop = lws_uv_getloop(server->_ctx, 0);
-    initLibuvAsyncHandle(loop, &server->_async);
+    initLibuvAsyncHandle(loop, &server->_async, server->_taskQueue.get());
     RUN_IN_GAMETHREAD(if (server->_onlistening) server->_onlistening(""));
     RUN_IN_GAMETHREAD(if (server->_onbegin) server->_onbegin());
     RUN_IN_GAMETHREAD(if (callback) callback(""));
 
     lws_libuv_run(server->_ctx, 0);
-    uv_close(reinterpret_cast<uv_handle_t *>(&server->_async), nullptr);
+    closeLibuvAsyncHandle(&server->_async, server->_taskQueue.get());
+    server->_port = 0;
 
     RUN_IN_GAMETHREAD(if (server->_onclose) server->_onclose(""));
     RUN_IN_GAMETHREAD(if (server->_onclose_cb) server->_onclose_cb(""));
@@ -277,9 +321,48 @@ ccstd::vector<std::shared_ptr<WebSocketServerConnection>> WebSocketServer::getCo
     return ret;
 }
 
+void WebSocketServer::broadcastTextAsync(const ccstd::string &text, const std::function<void(const ccstd::string &)> &callback) {
+    LOGE();
+    if (_serverState.load() != ServerThreadState::RUNNING) {
+        return;
+    }
+    std::shared_ptr<DataFrame> data = std::make_shared<DataFrame>(text);
+    if (callback) {
+        DISPATCH_CALLBACK_IN_GAMETHREAD();
+    }
+    RUN_IN_SERVERTHREAD(_taskQueue, this->broadcast(data));
+}
+
+void WebSocketServer::broadcastBinaryAsync(const void *in, size_t len, const std::function<void(const ccstd::string &)> &callback) {
+    LOGE();
+    if (_serverState.load() != ServerThreadState::RUNNING) {
+        return;
+    }
+    std::shared_ptr<DataFrame> data = std::make_shared<DataFrame>(in, static_cast<int>(len));
+    if (callback) {
+        DISPATCH_CALLBACK_IN_GAMETHREAD();
+    }
+    RUN_IN_SERVERTHREAD(_taskQueue, this->broadcast(data));
+}
+
+void WebSocketServer::broadcast(const std::shared_ptr<DataFrame> &data) {
+    // hold one pending send until the frame is queued everywhere, so that a failed send doesn't finish it early
+    data->addPendingSend();
+    {
+        std::lock_guard<std::mutex> guard(_connsMtx);
+        for (auto &itr : _conns) {
+            if (itr.second->getReadyState() == WebSocketServerConnection::OPEN) {
+                itr.second->send(data);
+            }
+        }
+    }
+    data->onFinish("");
+}
+
 void WebSocketServer::onCreateClient(struct lws *wsi) {
     LOGE();
     std::shared_ptr<WebSocketServerConnection> conn = std::make_shared<WebSocketServerConnection>(wsi);
+    conn->_taskQueue = _taskQueue;
     //char ip[221] = { 0 };
     //char addr[221] = { 0 };
     //lws_get_peer_addresses(wsi, lws_get_socket_fd(wsi), ip, 220, addr, 220);
@@ -366,30 +449,22 @@ void WebSocketServer::destroyContext() {
         lws_context_destroy2(_ctx);
         _ctx = nullptr;
     }
-    if (_async.data) {
-        delete static_cast<AsyncTaskData *>(_async.data);
-        _async.data = nullptr;
-    }
 }
 
 WebSocketServerConnection::WebSocketServerConnection(struct lws *wsi) : _wsi(wsi) {
-    uv_loop_t *loop = lws_uv_getloop(lws_get_context(wsi), 0);
-    initLibuvAsyncHandle(loop, &_async);
 }
 
 WebSocketServerConnection::~WebSocketServerConnection() {
-    if (_async.data) {
-        delete static_cast<AsyncTaskData *>(_async.data);
-        _async.data = nullptr;
-    }
     CC_LOG_INFO("~destroy ws connection");
 }
 
 bool WebSocketServerConnection::send(std::shared_ptr<DataFrame> data) {
-    _sendQueue.emplace_back(data);
-    if (!_wsi || _closed || _readyState == ReadyState::CLOSING) {
+    data->addPendingSend();
+    if (!_wsi || _closed || _readyState == ReadyState::CLOSING || _readyState == ReadyState::CLOSED) {
+        data->onFinish("Connection Closed");
         return false;
     }
+    _sendQueue.push_back({std::move(data), 0});
     lws_callback_on_writable(_wsi);
     return true;
 }
@@ -400,7 +475,7 @@ void WebSocketServerConnection::sendTextAsync(const ccstd::string &text, const s
     if (callback) {
         DISPATCH_CALLBACK_IN_GAMETHREAD();
     }
-    RUN_IN_SERVERTHREAD(this->send(data));
+    RUN_IN_SERVERTHREAD(_taskQueue, this->send(data));
 }
 
 void WebSocketServerConnection::sendBinaryAsync(const void *in, size_t len, const std::function<void(const ccstd::string &)> &callback) {
@@ -409,7 +484,7 @@ void WebSocketServerConnection::sendBinaryAsync(const void *in, size_t len, cons
     if (callback) {
         DISPATCH_CALLBACK_IN_GAMETHREAD();
     }
-    RUN_IN_SERVERTHREAD(this->send(data));
+    RUN_IN_SERVERTHREAD(_taskQueue, this->send(data));
 }
 
 bool WebSocketServerConnection::close(int code, const ccstd::string &reason) {
@@ -424,7 +499,7 @@ bool WebSocketServerConnection::close(int code, const ccstd::string &reason) {
 }
 
 void WebSocketServerConnection::closeAsync(int code, const ccstd::string &reason) {
-    RUN_IN_SERVERTHREAD(this->close(code, reason));
+    RUN_IN_SERVERTHREAD(_taskQueue, this->close(code, reason));
 }
 
 void WebSocketServerConnection::onConnected() {
@@ -465,53 +540,65 @@ int WebSocketServerConnection::onDrainMessage() {
         return -1;
     }
     if (_readyState != ReadyState::OPEN) return 0;
-    unsigned char *p = nullptr;
-    int sendLength = 0;
-    int finishLength = 0;
-    int flags = 0;
-
-    ccstd::vector<char> buff(SEND_BUFF + LWS_PRE);
-
-    if (!_sendQueue.empty()) {
-        std::shared_ptr<DataFrame> frag = _sendQueue.front();
 
-        sendLength = frag->slice(&p, SEND_BUFF);
-
-        if (frag->isFront()) {
-            if (frag->isBinary()) {
-                flags |= LWS_WRITE_BINARY;
-            }
-            if (frag->isString()) {
-                flags |= LWS_WRITE_TEXT;
-            }
+    // Write queued fragments until the budget is spent or the socket can't take more,
+    // so that one busy connection doesn't hold up the others.
+    int budget = WRITE_BUDGET;
+    while (!_sendQueue.empty() && budget > 0) {
+        PendingFrame &pending = _sendQueue.front();
+        DataFrame *frag = pending.frame.get();
+
+        const bool isFront = pending.consumed == 0;
+        const int remain = frag->size() - pending.consumed;
+        const int sendLength = std::min(remain, SEND_BUFF);
+        int flags = 0;
+
+        if (isFront) {
+            flags |= frag->isBinary() ? LWS_WRITE_BINARY : LWS_WRITE_TEXT;
+        } else {
+            flags |= LWS_WRITE_CONTINUATION;
         }
 
-        if (frag->remain() != sendLength) {
+        if (remain != sendLength) {
             // remain bytes > 0
             // not FIN
             flags |= LWS_WRITE_NO_FIN;
         }
 
-        if (!frag->isFront()) {
-            flags |= LWS_WRITE_CONTINUATION;
+        unsigned char *p = nullptr;
+        if (isFront) {
+            // lws puts the header into the LWS_PRE bytes reserved in front of the data, the payload is untouched
+            p = frag->getData();
+        } else {
+            // the bytes in front of a later fragment are payload another connection may still have to send
+            _fragmentBuffer.resize(LWS_PRE + SEND_BUFF);
+            p = _fragmentBuffer.data() + LWS_PRE;
+            memcpy(p, frag->getData() + pending.consumed, sendLength);
         }
 
-        finishLength = lws_write(_wsi, p, sendLength, static_cast<lws_write_protocol>(flags));
+        int finishLength = lws_write(_wsi, p, sendLength, static_cast<lws_write_protocol>(flags));
 
-        if (finishLength == 0) {
-            frag->onFinish("Connection Closed");
-            return -1;
-        }
-        if (finishLength < 0) {
-            frag->onFinish("Send Error!");
+        if (finishLength < 0 || (finishLength == 0 && sendLength > 0)) {
+            std::shared_ptr<DataFrame> frame = std::move(pending.frame);
+            _sendQueue.pop_front();
+            frame->onFinish(finishLength == 0 ? "Connection Closed" : "Send Error!");
             return -1;
         }
-        frag->consume(finishLength);
+        pending.consumed += finishLength;
+        budget -= std::max(sendLength, 1);
 
-        if (frag->remain() == 0) {
-            frag->onFinish("");
+        if (pending.consumed >= frag->size()) {
+            std::shared_ptr<DataFrame> frame = std::move(pending.frame);
             _sendQueue.pop_front();
+            frame->onFinish("");
         }
+
+        if (lws_send_pipe_choked(_wsi)) {
+            break;
+        }
+    }
+
+    if (!_sendQueue.empty()) {
         lws_callback_on_writable(_wsi);
     }
 
@@ -562,11 +649,16 @@ void WebSocketServerConnection::onClientCloseInit() {
 
 void WebSocketServerConnection::onDestroyClient() {
     _readyState = ReadyState::CLOSED;
+    // frames shared with other connections wait for every receiver to finish
+    while (!_sendQueue.empty()) {
+        std::shared_ptr<DataFrame> frame = std::move(_sendQueue.front().frame);
+        _sendQueue.pop_front();
+        frame->onFinish("Connection Closed");
+    }
     //on wsi destroyed
     if (_wsi) {
         RUN_IN_GAMETHREAD(if (_onclose) _onclose(_closeCode, _closeReason));
         RUN_IN_GAMETHREAD(if (_onend) _onend());
-        uv_close(reinterpret_cast<uv_handle_t *>(&_async), nullptr);
     }
 }
 
@@ -33,7 +33,7 @@
 #include <mutex>
 #include <thread>
 #include "base/Macros.h"
-#include "base/std/container/list.h"
+#include "base/std/container/deque.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
 
@@ -51,6 +51,7 @@ namespace network {
 
 class WebSocketServer;
 class WebSocketServerConnection;
+struct ServerTaskQueue;
 
 /**
         * receive/send data buffer with reserved bytes
@@ -79,9 +80,18 @@ public:
         _callback = callback;
     }
 
+    // The frame may be queued on several connections, the callback runs once all of them finished.
+    inline void addPendingSend() { ++_pendingSends; }
+
     void onFinish(const ccstd::string &message) {
+        if (!message.empty()) {
+            _error = message;
+        }
+        if (_pendingSends > 0 && --_pendingSends > 0) {
+            return;
+        }
         if (_callback) {
-            _callback(message);
+            _callback(_error);
         }
     }
 
@@ -95,6 +105,8 @@ private:
     ccstd::vector<unsigned char> _underlyingData;
     int _consumed = 0;
     bool _isBinary = false;
+    int _pendingSends = 0;
+    ccstd::string _error;
     std::function<void(const ccstd::string &)> _callback;
 };
 
@@ -186,9 +198,17 @@ private:
 
     void onDestroyClient();
 
+    // A frame may be shared by several connections, so each one keeps its own progress.
+    struct PendingFrame {
+        std::shared_ptr<DataFrame> frame;
+        int consumed{0};
+    };
+
     struct lws *_wsi = nullptr;
     ccstd::unordered_map<ccstd::string, ccstd::string> _headers;
-    ccstd::list<std::shared_ptr<DataFrame>> _sendQueue;
+    ccstd::deque<PendingFrame> _sendQueue;
+    // holds fragments after the first one, whose header would overwrite bytes of a shared frame
+    ccstd::vector<unsigned char> _fragmentBuffer;
     std::shared_ptr<DataFrame> _prevPkg;
     bool _closed = false;
     ccstd::string _closeReason = "close connection";
@@ -203,7 +223,9 @@ private:
     std::function<void(std::shared_ptr<DataFrame>)> _onmessage;
     std::function<void()> _onconnect;
     std::function<void()> _onend;
-    uv_async_t _async = {};
+    // task queue of the server loop, shared by all connections to keep the order of sends and broadcasts.
+    // Set before the connection is handed to the game, it outlives the loop and drops tasks once the loop has stopped.
+    std::shared_ptr<ServerTaskQueue> _taskQueue;
     void *_data = nullptr;
 
     friend class WebSocketServer;
@@ -219,6 +241,20 @@ public:
 
     ccstd::vector<std::shared_ptr<WebSocketServerConnection>> getConnections() const;
 
+    /**
+     * The port the server is listening on, it's the one assigned by the system when listening on port 0.
+     * 0 if the server isn't listening.
+     */
+    inline int getPort() const { return _port.load(); }
+
+    /**
+     * Sends the same message to every open connection. The frame is built once and queued on each connection by reference.
+     * The callback runs after the frame was written to all of them, with the last error if any.
+     */
+    void broadcastTextAsync(const ccstd::string &text, const std::function<void(const ccstd::string &)> &callback = nullptr);
+
+    void broadcastBinaryAsync(const void *data, size_t len, const std::function<void(const ccstd::string &)> &callback = nullptr);
+
     void setOnListening(const std::function<void(const ccstd::string &)> &cb) {
         _onlistening = cb;
     }
@@ -260,11 +296,14 @@ protected:
 
 private:
     std::shared_ptr<WebSocketServerConnection> findConnection(struct lws *wsi);
+    void broadcast(const std::shared_ptr<DataFrame> &data);
     void destroyContext();
 
     ccstd::string _host;
     lws_context *_ctx = nullptr;
     uv_async_t _async = {};
+    std::shared_ptr<ServerTaskQueue> _taskQueue;
+    std::atomic<int> _port{0};
 
     mutable std::mutex _connsMtx;
     ccstd::unordered_map<struct lws *, std::shared_ptr<WebSocketServerConnection>> _conns;
@@ -23,7 +23,6 @@
 ****************************************************************************/
 
 #include "physics/physx/PhysXEventManager.h"
-#include <algorithm>
 #include "physics/physx/PhysXInc.h"
 #include "physics/physx/PhysXUtils.h"
 #include "physics/physx/PhysXWorld.h"
@@ -39,155 +38,123 @@ void PhysXEventManager::SimulationEventCallback::onTrigger(physx::PxTriggerPair
             continue;
         }
 
-        bool processed = false;
+        const auto &shapeMap = getPxShapeMap();
+        const auto &cctMap = getPxCCTMap();
+        const auto &triggerShapeIter = shapeMap.find(reinterpret_cast<uintptr_t>(triggerPair.triggerShape));
+        const auto &otherShapeIter = shapeMap.find(reinterpret_cast<uintptr_t>(triggerPair.otherShape));
 
         //collider trigger event
-        if (!processed) {
-            const auto &selfIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(triggerPair.triggerShape));
-            const auto &otherIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(triggerPair.otherShape));
-            if (selfIter != getPxShapeMap().end() && otherIter != getPxShapeMap().end()) {
-                processed = true;
-                const auto &self = selfIter->second;
-                const auto &other = otherIter->second;
-                auto &pairs = mManager->getTriggerPairs();
-                const auto &iter = std::find_if(pairs.begin(), pairs.end(), [self, other](std::shared_ptr<TriggerEventPair> &pair) {
-                    return (pair->shapeA == self || pair->shapeA == other) && (pair->shapeB == self || pair->shapeB == other);
-                });
-                if (triggerPair.status & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) {
-                    if (iter == pairs.end()) pairs.push_back(std::shared_ptr<TriggerEventPair>(ccnew TriggerEventPair{self, other}));
-                } else if (triggerPair.status & physx::PxPairFlag::eNOTIFY_TOUCH_LOST) {
-                    if (iter != pairs.end()) iter->get()->state = ETouchState::EXIT;
-                }
-            }
+        if (triggerShapeIter != shapeMap.end() && otherShapeIter != shapeMap.end()) {
+            mManager->onTriggerTouch(triggerShapeIter->second, otherShapeIter->second, triggerPair.status);
+            continue;
         }
 
         //cct trigger event
-        if (!processed) {
-            const auto &shapeIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(triggerPair.triggerShape));
-            const auto &cctIter = getPxCCTMap().find(reinterpret_cast<uintptr_t>(triggerPair.otherShape));
-            if (shapeIter != getPxShapeMap().end() && cctIter != getPxCCTMap().end()) {
-                processed = true;
-                const auto &shape = shapeIter->second;
-                const auto &cct = cctIter->second;
-                auto &pairs = mManager->getCCTTriggerPairs();
-                const auto &iter = std::find_if(pairs.begin(), pairs.end(), [shape, cct](std::shared_ptr<CCTTriggerEventPair> &pair) {
-                    return (pair->shape == shape && pair->cct == cct);
-                });
-                if (triggerPair.status & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) {
-                    if (iter == pairs.end()) pairs.push_back(std::shared_ptr<CCTTriggerEventPair>(ccnew CCTTriggerEventPair{cct, shape}));
-                } else if (triggerPair.status & physx::PxPairFlag::eNOTIFY_TOUCH_LOST) {
-                    if (iter != pairs.end()) iter->get()->state = ETouchState::EXIT;
-                }
+        if (triggerShapeIter != shapeMap.end()) {
+            const auto &cctIter = cctMap.find(reinterpret_cast<uintptr_t>(triggerPair.otherShape));
+            if (cctIter != cctMap.end()) {
+                mManager->onCCTTriggerTouch(cctIter->second, triggerShapeIter->second, triggerPair.status);
+                continue;
             }
         }
 
         //cct trigger event
-        if (!processed) {
-            const auto &cctIter = getPxCCTMap().find(reinterpret_cast<uintptr_t>(triggerPair.triggerShape));
-            const auto &shapeIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(triggerPair.otherShape));
-            if (shapeIter != getPxShapeMap().end() && cctIter != getPxCCTMap().end()) {
-                processed = true;
-                const auto &shape = shapeIter->second;
-                const auto &cct = cctIter->second;
-                auto &pairs = mManager->getCCTTriggerPairs();
-                const auto &iter = std::find_if(pairs.begin(), pairs.end(), [shape, cct](std::shared_ptr<CCTTriggerEventPair> &pair) {
-                    return (pair->shape == shape && pair->cct == cct);
-                });
-                if (triggerPair.status & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) {
-                    if (iter == pairs.end()) pairs.push_back(std::shared_ptr<CCTTriggerEventPair>(ccnew CCTTriggerEventPair{cct, shape}));
-                } else if (triggerPair.status & physx::PxPairFlag::eNOTIFY_TOUCH_LOST) {
-                    if (iter != pairs.end()) iter->get()->state = ETouchState::EXIT;
-                }
+        if (otherShapeIter != shapeMap.end()) {
+            const auto &cctIter = cctMap.find(reinterpret_cast<uintptr_t>(triggerPair.triggerShape));
+            if (cctIter != cctMap.end()) {
+                mManager->onCCTTriggerTouch(cctIter->second, otherShapeIter->second, triggerPair.status);
             }
         }
     }
 }
 
 void PhysXEventManager::SimulationEventCallback::onContact(const physx::PxContactPairHeader & /*header*/, const physx::PxContactPair *pairs, physx::PxU32 count) {
+    const auto &shapeMap = getPxShapeMap();
     for (physx::PxU32 i = 0; i < count; i++) {
         const physx::PxContactPair &cp = pairs[i];
         if (cp.flags & (physx::PxContactPairFlag::eREMOVED_SHAPE_0 | physx::PxContactPairFlag::eREMOVED_SHAPE_1)) {
             continue;
         }
 
-        const auto &selfIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(cp.shapes[0]));
-        const auto &otherIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(cp.shapes[1]));
-        if (selfIter == getPxShapeMap().end() || otherIter == getPxShapeMap().end()) {
+        const auto &selfIter = shapeMap.find(reinterpret_cast<uintptr_t>(cp.shapes[0]));
+        const auto &otherIter = shapeMap.find(reinterpret_cast<uintptr_t>(cp.shapes[1]));
+        if (selfIter == shapeMap.end() || otherIter == shapeMap.end()) {
             continue;
         }
+        mManager->onContactPair(selfIter->second, otherIter->second, cp);
+    }
+}
 
-        const auto &self = selfIter->second;
-        const auto &other = otherIter->second;
-        auto &pairs = mManager->getConatctPairs();
-        auto iter = std::find_if(pairs.begin(), pairs.end(), [self, other](std::shared_ptr<ContactEventPair> &pair) {
-            return (pair->shapeA == self || pair->shapeA == other) && (pair->shapeB == self || pair->shapeB == other);
-        });
-
-        if (iter == pairs.end()) {
-            pairs.push_back(std::shared_ptr<ContactEventPair>(ccnew ContactEventPair{self, other}));
-            iter = pairs.end() - 1;
-        }
-
-        if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_PERSISTS) {
-            iter->get()->state = ETouchState::STAY;
-        } else if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) {
-            iter->get()->state = ETouchState::ENTER;
-        } else if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_LOST) {
-            iter->get()->state = ETouchState::EXIT;
-        }
+void PhysXEventManager::onTriggerTouch(uint32_t self, uint32_t other, physx::PxPairFlag::Enum status) {
+    const auto key = PhysXEventPairTable<TriggerEventPair>::makeKey(self, other);
+    if (status & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) {
+        _mTriggerPairs.emplace(key, self, other);
+    } else if (status & physx::PxPairFlag::eNOTIFY_TOUCH_LOST) {
+        if (auto *pair = _mTriggerPairs.find(key)) pair->state = ETouchState::EXIT;
+    }
+}
 
-        const physx::PxU8 &contactCount = cp.contactCount;
-        iter->get()->contacts.resize(contactCount);
-        if (contactCount > 0) {
-            cp.extractContacts(reinterpret_cast<physx::PxContactPairPoint *>(&iter->get()->contacts[0]), contactCount);
-        }
+void PhysXEventManager::onCCTTriggerTouch(uint32_t cct, uint32_t shape, physx::PxPairFlag::Enum status) {
+    const auto key = PhysXEventPairTable<CCTTriggerEventPair>::makeKey(cct, shape);
+    if (status & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) {
+        _mCCTTriggerPairs.emplace(key, cct, shape);
+    } else if (status & physx::PxPairFlag::eNOTIFY_TOUCH_LOST) {
+        if (auto *pair = _mCCTTriggerPairs.find(key)) pair->state = ETouchState::EXIT;
     }
 }
 
-void PhysXEventManager::refreshPairs() {
-    for (auto iter = getTriggerPairs().begin(); iter != getTriggerPairs().end();) {
-        uintptr_t wrapperPtrShapeA = PhysXWorld::getInstance().getWrapperPtrWithObjectID(iter->get()->shapeA);
-        uintptr_t wrapperPtrShapeB = PhysXWorld::getInstance().getWrapperPtrWithObjectID(iter->get()->shapeB);
-        if (wrapperPtrShapeA == 0 || wrapperPtrShapeB == 0) {
-            iter = getTriggerPairs().erase(iter);
-            continue;
-        }
+void PhysXEventManager::onContactPair(uint32_t self, uint32_t other, const physx::PxContactPair &cp) {
+    auto *pair = _mConatctPairs.emplace(PhysXEventPairTable<ContactEventPair>::makeKey(self, other), self, other).first;
 
-        const auto &selfIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(&(reinterpret_cast<PhysXShape *>(wrapperPtrShapeA)->getShape())));
-        const auto &otherIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(&(reinterpret_cast<PhysXShape *>(wrapperPtrShapeB)->getShape())));
-        if (selfIter == getPxShapeMap().end() || otherIter == getPxShapeMap().end()) {
-            iter = getTriggerPairs().erase(iter);
-        } else if (iter->get()->state == ETouchState::EXIT) {
-            iter = getTriggerPairs().erase(iter);
-        } else {
-            iter->get()->state = ETouchState::STAY;
-            iter++;
-        }
+    if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_PERSISTS) {
+        pair->state = ETouchState::STAY;
+    } else if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) {
+        pair->state = ETouchState::ENTER;
+    } else if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_LOST) {
+        pair->state = ETouchState::EXIT;
     }
 
-    for (auto iter = getCCTTriggerPairs().begin(); iter != getCCTTriggerPairs().end();) {
-        uintptr_t wrapperPtrCCT = PhysXWorld::getInstance().getWrapperPtrWithObjectID(iter->get()->cct);
-        uintptr_t wrapperPtrShape = PhysXWorld::getInstance().getWrapperPtrWithObjectID(iter->get()->shape);
-        if (wrapperPtrCCT == 0 || wrapperPtrShape == 0) {
-            iter = getCCTTriggerPairs().erase(iter);
-            continue;
-        }
+    // A pair reported twice in one step (e.g. by CCD) keeps only its latest contacts.
+    const physx::PxU8 contactCount = cp.contactCount;
+    pair->contactOffset = static_cast<uint32_t>(_mContactPoints.size());
+    pair->contactCount = contactCount;
+    if (contactCount > 0) {
+        _mContactPoints.resize(_mContactPoints.size() + contactCount);
+        cp.extractContacts(reinterpret_cast<physx::PxContactPairPoint *>(&_mContactPoints[pair->contactOffset]), contactCount);
+    }
+}
 
-        const auto& cctIter = getPxCCTMap().find(reinterpret_cast<uintptr_t>(&(reinterpret_cast<PhysXCharacterController*>(wrapperPtrCCT)->getCCT())));
-        const auto& shapeIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(&(reinterpret_cast<PhysXShape*>(wrapperPtrShape)->getShape())));
-        if (cctIter == getPxCCTMap().end() || shapeIter == getPxShapeMap().end()) {
-            iter = getCCTTriggerPairs().erase(iter);
-        }
-        else if (iter->get()->state == ETouchState::EXIT) {
-            iter = getCCTTriggerPairs().erase(iter);
+void PhysXEventManager::refreshPairs() {
+    auto &world = PhysXWorld::getInstance();
+    const auto &shapeMap = getPxShapeMap();
+    const auto &cctMap = getPxCCTMap();
+    auto isShapeAlive = [&](uint32_t shape) {
+        const uintptr_t wrapperPtr = world.getWrapperPtrWithObjectID(shape);
+        return wrapperPtr != 0 && shapeMap.find(reinterpret_cast<uintptr_t>(&(reinterpret_cast<PhysXShape *>(wrapperPtr)->getShape()))) != shapeMap.end();
+    };
+    auto isCCTAlive = [&](uint32_t cct) {
+        const uintptr_t wrapperPtr = world.getWrapperPtrWithObjectID(cct);
+        return wrapperPtr != 0 && cctMap.find(reinterpret_cast<uintptr_t>(&(reinterpret_cast<PhysXCharacterController *>(wrapperPtr)->getCCT()))) != cctMap.end();
+    };
+
+    _mTriggerPairs.eraseIf([&](TriggerEventPair &pair) {
+        if (pair.state == ETouchState::EXIT || !isShapeAlive(pair.shapeA) || !isShapeAlive(pair.shapeB)) {
+            return true;
         }
-        else {
-            iter->get()->state = ETouchState::STAY;
-            iter++;
+        pair.state = ETouchState::STAY;
+        return false;
+    });
+
+    _mCCTTriggerPairs.eraseIf([&](CCTTriggerEventPair &pair) {
+        if (pair.state == ETouchState::EXIT || !isCCTAlive(pair.cct) || !isShapeAlive(pair.shape)) {
+            return true;
         }
-    }
+        pair.state = ETouchState::STAY;
+        return false;
+    });
 
-    getConatctPairs().clear();
+    _mConatctPairs.clear();
+    _mContactPoints.clear();
     getCCTShapePairs().clear();
 }
 
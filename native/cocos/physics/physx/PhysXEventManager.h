@@ -28,6 +28,7 @@
 #include "base/Macros.h"
 #include "base/memory/Memory.h"
 #include "base/std/container/vector.h"
+#include "physics/physx/PhysXEventPairTable.h"
 #include "physics/physx/PhysXInc.h"
 #include "physics/spec/IWorld.h"
 
@@ -58,17 +59,25 @@ public:
     };
 
     inline SimulationEventCallback &getEventCallback() { return *_mCallback; }
-    inline ccstd::vector<std::shared_ptr<TriggerEventPair>> &getTriggerPairs() { return _mTriggerPairs; }
-    inline ccstd::vector<std::shared_ptr<ContactEventPair>>& getConatctPairs() { return _mConatctPairs; }
+    // The returned vectors are views of the pair tables, they must not be resized by callers.
+    inline ccstd::vector<TriggerEventPair> &getTriggerPairs() { return _mTriggerPairs.records(); }
+    inline ccstd::vector<ContactEventPair> &getConatctPairs() { return _mConatctPairs.records(); }
+    inline ccstd::vector<ContactPoint> &getContactPoints() { return _mContactPoints; }
     inline ccstd::vector<std::shared_ptr<CCTShapeEventPair>>& getCCTShapePairs() { return _mCCTShapePairs; }
-    inline ccstd::vector<std::shared_ptr<CCTTriggerEventPair>> &getCCTTriggerPairs() { return _mCCTTriggerPairs; }
+    inline ccstd::vector<CCTTriggerEventPair> &getCCTTriggerPairs() { return _mCCTTriggerPairs.records(); }
     void refreshPairs();
 
 private:
-    ccstd::vector<std::shared_ptr<TriggerEventPair>> _mTriggerPairs;
-    ccstd::vector<std::shared_ptr<ContactEventPair>> _mConatctPairs;
+    void onTriggerTouch(uint32_t self, uint32_t other, physx::PxPairFlag::Enum status);
+    void onCCTTriggerTouch(uint32_t cct, uint32_t shape, physx::PxPairFlag::Enum status);
+    void onContactPair(uint32_t self, uint32_t other, const physx::PxContactPair &cp);
+
+    PhysXEventPairTable<TriggerEventPair> _mTriggerPairs;
+    PhysXEventPairTable<ContactEventPair> _mConatctPairs;
+    // Contact points of every contact pair reported in the current step, addressed by ContactEventPair::contactOffset.
+    ccstd::vector<ContactPoint> _mContactPoints;
     ccstd::vector<std::shared_ptr<CCTShapeEventPair>> _mCCTShapePairs;
-    ccstd::vector<std::shared_ptr<CCTTriggerEventPair>> _mCCTTriggerPairs;
+    PhysXEventPairTable<CCTTriggerEventPair> _mCCTTriggerPairs;
     SimulationEventCallback *_mCallback;
 };
 
@@ -0,0 +1,196 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace physics {
+
+/**
+ * @brief Dense event records indexed by an open addressing hash of their object pair.
+ *
+ * Records live contiguously so they can be handed to scripts in one block, lookups are O(1)
+ * and erasing swaps the last record into the hole. Slots are invalidated by bumping a stamp,
+ * so clearing per step is O(1) and, once warmed up, no step allocates.
+ */
+template <typename T>
+class PhysXEventPairTable final {
+public:
+    /**
+     * @brief Builds a key that does not depend on the order of the two wrapper object ids.
+     */
+    static inline uint64_t makeKey(uint32_t a, uint32_t b) {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    PhysXEventPairTable() { rehash(INITIAL_CAPACITY); }
+
+    inline ccstd::vector<T> &records() { return _records; }
+    inline const ccstd::vector<T> &records() const { return _records; }
+    inline size_t size() const { return _records.size(); }
+    inline size_t capacity() const { return _slots.size(); }
+
+    T *find(uint64_t key) {
+        const uint32_t slot = findSlot(key);
+        return slot == INVALID_SLOT ? nullptr : &_records[_slots[slot].index];
+    }
+
+    /**
+     * @brief Returns the record of |key|, constructing it from |args| if it does not exist yet.
+     * @return The record and whether it was inserted.
+     */
+    template <typename... Args>
+    std::pair<T *, bool> emplace(uint64_t key, Args &&...args) {
+        const uint32_t existing = findSlot(key);
+        if (existing != INVALID_SLOT) {
+            return {&_records[_slots[existing].index], false};
+        }
+        if ((_records.size() + 1) * 2 > _slots.size()) {
+            rehash(static_cast<uint32_t>(_slots.size() * 2));
+        }
+        const auto index = static_cast<uint32_t>(_records.size());
+        _records.emplace_back(std::forward<Args>(args)...);
+        _keys.push_back(key);
+        insertSlot(key, index);
+        return {&_records.back(), true};
+    }
+
+    bool erase(uint64_t key) {
+        const uint32_t slot = findSlot(key);
+        if (slot == INVALID_SLOT) {
+            return false;
+        }
+        const uint32_t index = _slots[slot].index;
+        removeSlot(slot);
+
+        const auto last = static_cast<uint32_t>(_records.size() - 1);
+        if (index != last) {
+            _records[index] = std::move(_records[last]);
+            _keys[index] = _keys[last];
+            _slots[findSlot(_keys[index])].index = index;
+        }
+        _records.pop_back();
+        _keys.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Erases every record for which |pred| returns true, other records may be visited in any order.
+     */
+    template <typename Pred>
+    void eraseIf(Pred pred) {
+        // Walking backwards means the record swapped into a hole has already been visited.
+        for (auto i = static_cast<int64_t>(_records.size()) - 1; i >= 0; --i) {
+            if (pred(_records[i])) {
+                erase(_keys[i]);
+            }
+        }
+    }
+
+    void clear() {
+        _records.clear();
+        _keys.clear();
+        if (++_stamp == 0) {
+            for (auto &slot : _slots) {
+                slot.stamp = 0;
+            }
+            _stamp = 1;
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t key{0};
+        uint32_t index{0};
+        // The slot is occupied only if its stamp equals the table's.
+        uint32_t stamp{0};
+    };
+
+    static constexpr uint32_t INITIAL_CAPACITY = 64;
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    static inline uint32_t hash(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return static_cast<uint32_t>(key);
+    }
+
+    inline bool occupied(uint32_t slot) const { return _slots[slot].stamp == _stamp; }
+
+    uint32_t findSlot(uint64_t key) const {
+        const auto mask = static_cast<uint32_t>(_slots.size() - 1);
+        for (uint32_t slot = hash(key) & mask; occupied(slot); slot = (slot + 1) & mask) {
+            if (_slots[slot].key == key) {
+                return slot;
+            }
+        }
+        return INVALID_SLOT;
+    }
+
+    void insertSlot(uint64_t key, uint32_t index) {
+        const auto mask = static_cast<uint32_t>(_slots.size() - 1);
+        uint32_t slot = hash(key) & mask;
+        while (occupied(slot)) {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = {key, index, _stamp};
+    }
+
+    // Backward shift deletion keeps probe sequences intact without tombstones.
+    void removeSlot(uint32_t hole) {
+        const auto mask = static_cast<uint32_t>(_slots.size() - 1);
+        for (uint32_t next = (hole + 1) & mask; occupied(next); next = (next + 1) & mask) {
+            const uint32_t home = hash(_slots[next].key) & mask;
+            const bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+            if (movable) {
+                _slots[hole] = _slots[next];
+                hole = next;
+            }
+        }
+        _slots[hole].stamp = 0;
+    }
+
+    void rehash(uint32_t capacity) {
+        _slots.assign(capacity, Slot{});
+        _stamp = 1;
+        for (uint32_t i = 0; i < _keys.size(); ++i) {
+            insertSlot(_keys[i], i);
+        }
+    }
+
+    ccstd::vector<T> _records;
+    ccstd::vector<uint64_t> _keys;
+    ccstd::vector<Slot> _slots;
+    uint32_t _stamp{1};
+};
+
+} // namespace physics
+} // namespace cc
@@ -23,6 +23,10 @@
 ****************************************************************************/
 
 #include "physics/physx/PhysXWorld.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "base/job-system/JobSystem.h"
 #include "base/memory/Memory.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
@@ -38,6 +42,11 @@
 namespace cc {
 namespace physics {
 
+namespace {
+// PhysX solver islands rarely scale past a handful of threads, more workers only add wake-up latency.
+constexpr uint32_t MAX_PHYSX_WORKER_THREADS = 4;
+} // namespace
+
 PhysXWorld *PhysXWorld::instance = nullptr;
 uint32_t PhysXWorld::_msWrapperObjectID = 1; // starts from 1 because 0 means null
 uint32_t PhysXWorld::_msPXObjectID = 0;
@@ -78,7 +87,7 @@ PhysXWorld::PhysXWorld() {
 #endif
     _mPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *_mFoundation, scale, true, pvd);
     PxInitExtensions(*_mPhysics, pvd);
-    _mDispatcher = physx::PxDefaultCpuDispatcherCreate(0);
+    _mDispatcher = physx::PxDefaultCpuDispatcherCreate(getWorkerThreadCount());
 
     _mEventMgr = ccnew PhysXEventManager();
 
@@ -101,6 +110,7 @@ PhysXWorld::PhysXWorld() {
 }
 
 PhysXWorld::~PhysXWorld() {
+    endStep();
     auto &materialMap = getPxMaterialMap();
     // clear material cache
     materialMap.clear();
@@ -121,9 +131,32 @@ PhysXWorld::~PhysXWorld() {
     PX_RELEASE(_mFoundation);
 }
 
+uint32_t PhysXWorld::getWorkerThreadCount() {
+    const uint32_t cores = std::thread::hardware_concurrency();
+    // Main thread, render thread and the job system workers are already competing for the cores.
+    const uint32_t reserved = 2 + JobSystem::getInstance()->threadCount();
+    if (cores <= reserved) {
+        return 1;
+    }
+    return std::min(cores - reserved, MAX_PHYSX_WORKER_THREADS);
+}
+
 void PhysXWorld::step(float fixedTimeStep) {
+    beginStep(fixedTimeStep);
+    endStep();
+}
+
+void PhysXWorld::beginStep(float fixedTimeStep) {
+    // Only one step can be in flight, finish the previous one first.
+    endStep();
     _mScene->simulate(fixedTimeStep);
+    _isStepping = true;
+}
+
+void PhysXWorld::endStep() {
+    if (!_isStepping) return;
     _mScene->fetchResults(true);
+    _isStepping = false;
     syncPhysicsToScene();
 #if CC_USE_GEOMETRY_RENDERER
     debugDraw();
@@ -232,6 +265,7 @@ void PhysXWorld::setGravity(float x, float y, float z) {
 }
 
 void PhysXWorld::destroy() {
+    endStep();
 }
 
 void PhysXWorld::setCollisionMatrix(uint32_t index, uint32_t mask) {
@@ -325,10 +359,14 @@ uintptr_t PhysXWorld::getPXMaterialPtrWithMaterialID(uint32_t materialID) {
 }
 
 void PhysXWorld::emitEvents() {
+    // Contact and trigger callbacks are only fired from fetchResults.
+    endStep();
     _mEventMgr->refreshPairs();
 }
 
 void PhysXWorld::syncSceneToPhysics() {
+    // Poses written while simulating would be overwritten by the pending results.
+    endStep();
     for (auto const &sb : _mSharedBodies) {
         sb->syncSceneToPhysics();
     }
@@ -349,6 +387,7 @@ void PhysXWorld::syncPhysicsToScene() {
 }
 
 void PhysXWorld::syncSceneWithCheck() {
+    endStep();
     for (auto const &sb : _mSharedBodies) {
         sb->syncSceneWithCheck();
     }
@@ -396,6 +435,8 @@ void PhysXWorld::removeCCT(const PhysXCharacterController&cct) {
 }
 
 bool PhysXWorld::raycast(RaycastOptions &opt) {
+    // The scene can't be queried while it is simulating.
+    endStep();
     physx::PxQueryCache *cache = nullptr;
     const auto o = opt.origin;
     const auto ud = opt.unitDir;
@@ -432,6 +473,11 @@ ccstd::vector<RaycastResult> &PhysXWorld::raycastResult() {
 }
 
 bool PhysXWorld::raycastClosest(RaycastOptions &opt) {
+    endStep();
+    return raycastClosestImpl(opt, raycastClosestResult());
+}
+
+bool PhysXWorld::raycastClosestImpl(const RaycastOptions &opt, RaycastResult &out) const {
     physx::PxRaycastHit hit;
     physx::PxQueryCache *cache = nullptr;
     const auto o = opt.origin;
@@ -448,13 +494,12 @@ bool PhysXWorld::raycastClosest(RaycastOptions &opt) {
         getScene(), origin, unitDir, opt.distance, flags,
         hit, filterData, &getQueryFilterShader(), cache);
     if (result) {
-        auto &r = raycastClosestResult();
         const auto &shapeIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(hit.shape));
         if (shapeIter == getPxShapeMap().end()) return false;
-        r.shape = shapeIter->second;
-        r.distance = hit.distance;
-        pxSetVec3Ext(r.hitPoint, hit.position);
-        pxSetVec3Ext(r.hitNormal, hit.normal);
+        out.shape = shapeIter->second;
+        out.distance = hit.distance;
+        pxSetVec3Ext(out.hitPoint, hit.position);
+        pxSetVec3Ext(out.hitNormal, hit.normal);
     }
     return result;
 }
@@ -501,6 +546,7 @@ bool PhysXWorld::sweepCapsuleClosest(RaycastOptions &opt, float radius, float he
 }
 
 bool PhysXWorld::sweep(RaycastOptions &opt, const physx::PxGeometry &geometry, const physx::PxQuat &orientation) {
+    endStep();
     physx::PxQueryCache *cache = nullptr;
     const auto o = opt.origin;
     const auto ud = opt.unitDir;
@@ -538,6 +584,11 @@ ccstd::vector<RaycastResult> &PhysXWorld::sweepResult() {
 }
 
 bool PhysXWorld::sweepClosest(RaycastOptions &opt, const physx::PxGeometry &geometry, const physx::PxQuat &orientation) {
+    endStep();
+    return sweepClosestImpl(opt, geometry, orientation, sweepClosestResult());
+}
+
+bool PhysXWorld::sweepClosestImpl(const RaycastOptions &opt, const physx::PxGeometry &geometry, const physx::PxQuat &orientation, RaycastResult &out) const {
     physx::PxSweepHit hit;
     physx::PxQueryCache *cache = nullptr;
     const auto o = opt.origin;
@@ -555,13 +606,12 @@ bool PhysXWorld::sweepClosest(RaycastOptions &opt, const physx::PxGeometry &geom
         getScene(), geometry, pose, unitDir, opt.distance, flags,
         hit, filterData, &getQueryFilterShader(), cache, 0);
     if (result) {
-        auto &r = sweepClosestResult();
         const auto &shapeIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(hit.shape));
         if (shapeIter == getPxShapeMap().end()) return false;
-        r.shape = shapeIter->second;
-        r.distance = hit.distance;
-        pxSetVec3Ext(r.hitPoint, hit.position);
-        pxSetVec3Ext(r.hitNormal, hit.normal);
+        out.shape = shapeIter->second;
+        out.distance = hit.distance;
+        pxSetVec3Ext(out.hitPoint, hit.position);
+        pxSetVec3Ext(out.hitNormal, hit.normal);
     }
     return result;
 }
@@ -571,6 +621,69 @@ RaycastResult &PhysXWorld::sweepClosestResult() {
     return hit;
 }
 
+namespace {
+// Queries per job, small enough to balance the workers and large enough to amortize the dispatch.
+constexpr uint32_t BATCH_QUERIES_PER_JOB = 64;
+
+template <typename Query>
+uint32_t runClosestBatch(const RaycastOptions *opts, uint32_t count, RaycastResult *results, const Query &query) {
+    if (!opts || !results || count == 0) return 0;
+
+    std::atomic<uint32_t> hitCount{0};
+    auto runJob = [&](uint32_t job) {
+        const uint32_t begin = job * BATCH_QUERIES_PER_JOB;
+        const uint32_t end = std::min(begin + BATCH_QUERIES_PER_JOB, count);
+        uint32_t hits = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            RaycastResult hit;
+            if (query(opts[i], hit)) {
+                results[i] = hit;
+                ++hits;
+            } else {
+                results[i] = RaycastResult{};
+            }
+        }
+        hitCount.fetch_add(hits, std::memory_order_relaxed);
+    };
+
+    parallelFor((count - 1) / BATCH_QUERIES_PER_JOB + 1, runJob);
+    return hitCount.load(std::memory_order_relaxed);
+}
+} // namespace
+
+uint32_t PhysXWorld::raycastClosestBatch(const RaycastOptions *opts, uint32_t count, RaycastResult *results) {
+    endStep();
+    return runClosestBatch(opts, count, results, [this](const RaycastOptions &opt, RaycastResult &hit) {
+        return raycastClosestImpl(opt, hit);
+    });
+}
+
+uint32_t PhysXWorld::sweepClosestBatch(const RaycastOptions *opts, uint32_t count, const physx::PxGeometry &geometry,
+                                       const physx::PxQuat &orientation, RaycastResult *results) {
+    endStep();
+    return runClosestBatch(opts, count, results, [&](const RaycastOptions &opt, RaycastResult &hit) {
+        return sweepClosestImpl(opt, geometry, orientation, hit);
+    });
+}
+
+uint32_t PhysXWorld::sweepBoxClosestBatch(const RaycastOptions *opts, uint32_t count, float halfExtentX, float halfExtentY, float halfExtentZ,
+                                          float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) {
+    return sweepClosestBatch(opts, count, physx::PxBoxGeometry{halfExtentX, halfExtentY, halfExtentZ},
+                             physx::PxQuat(orientationX, orientationY, orientationZ, orientationW), results);
+}
+
+uint32_t PhysXWorld::sweepSphereClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, RaycastResult *results) {
+    return sweepClosestBatch(opts, count, physx::PxSphereGeometry{radius}, physx::PxQuat(0, 0, 0, 1), results);
+}
+
+uint32_t PhysXWorld::sweepCapsuleClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, float height,
+                                              float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) {
+    //add an extra 90 degree rotation to PxCapsuleGeometry whose axis is originally along the X axis
+    physx::PxQuat finalOrientation = physx::PxQuat(physx::PxPiDivTwo, physx::PxVec3{0.F, 0.F, 1.F});
+    finalOrientation = physx::PxQuat(orientationX, orientationY, orientationZ, orientationW) * finalOrientation;
+    return sweepClosestBatch(opts, count, physx::PxCapsuleGeometry{radius, height / 2.F}, finalOrientation, results);
+}
+
 uint32_t PhysXWorld::addPXObject(uintptr_t PXObjectPtr) {
     uint32_t pxObjectID = _msPXObjectID;
     _msPXObjectID++;
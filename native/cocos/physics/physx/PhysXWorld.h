@@ -51,6 +51,9 @@ public:
     PhysXWorld();
     ~PhysXWorld() override;
     void step(float fixedTimeStep) override;
+    void beginStep(float fixedTimeStep) override;
+    void endStep() override;
+    inline bool isStepping() const override { return _isStepping; }
     void setGravity(float x, float y, float z) override;
     void setAllowSleep(bool v) override;
     void emitEvents() override;
@@ -75,21 +78,33 @@ public:
     ccstd::vector<RaycastResult> &sweepResult() override;
     RaycastResult &sweepClosestResult() override;
 
+    uint32_t raycastClosestBatch(const RaycastOptions *opts, uint32_t count, RaycastResult *results) override;
+    uint32_t sweepClosestBatch(const RaycastOptions *opts, uint32_t count, const physx::PxGeometry &geometry,
+                               const physx::PxQuat &orientation, RaycastResult *results);
+    uint32_t sweepBoxClosestBatch(const RaycastOptions *opts, uint32_t count, float halfExtentX, float halfExtentY, float halfExtentZ,
+                                  float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) override;
+    uint32_t sweepSphereClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, RaycastResult *results) override;
+    uint32_t sweepCapsuleClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, float height,
+                                      float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) override;
+
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
     uint32_t createHeightField(HeightFieldDesc &desc) override;
     bool createMaterial(uint16_t id, float f, float df, float r,
                         uint8_t m0, uint8_t m1) override;
-    inline ccstd::vector<std::shared_ptr<TriggerEventPair>> &getTriggerEventPairs() override {
+    inline ccstd::vector<TriggerEventPair> &getTriggerEventPairs() override {
         return _mEventMgr->getTriggerPairs();
     }
-    inline ccstd::vector<std::shared_ptr<ContactEventPair>> &getContactEventPairs() override {
+    inline ccstd::vector<ContactEventPair> &getContactEventPairs() override {
         return _mEventMgr->getConatctPairs();
     }
+    inline ccstd::vector<ContactPoint> &getContactPoints() override {
+        return _mEventMgr->getContactPoints();
+    }
     inline ccstd::vector<std::shared_ptr<CCTShapeEventPair>> &getCCTShapeEventPairs() override {
         return _mEventMgr->getCCTShapePairs();
     }
-    inline ccstd::vector<std::shared_ptr<CCTTriggerEventPair>> &getCCTTriggerEventPairs() override {
+    inline ccstd::vector<CCTTriggerEventPair> &getCCTTriggerEventPairs() override {
         return _mEventMgr->getCCTTriggerPairs();
     }
     void syncSceneToPhysics() override;
@@ -122,6 +137,11 @@ public:
 
     uintptr_t getPXMaterialPtrWithMaterialID(uint32_t materialID);
 
+    /**
+     * @brief Number of PhysX worker threads, derived from the cores left over by the main, render and job system threads.
+     */
+    static uint32_t getWorkerThreadCount();
+
     float getFixedTimeStep() const override { return _fixedTimeStep; }
     void setFixedTimeStep(float fixedTimeStep) override { _fixedTimeStep = fixedTimeStep; }
 
@@ -144,6 +164,10 @@ private:
     float getDebugDrawConstraintSize() override { return 0.0; };
 #endif
 private:
+    // Single closest hit queries shared by the one-shot and batched paths, safe to call from worker threads.
+    bool raycastClosestImpl(const RaycastOptions &opt, RaycastResult &out) const;
+    bool sweepClosestImpl(const RaycastOptions &opt, const physx::PxGeometry &geometry, const physx::PxQuat &orientation, RaycastResult &out) const;
+
     static PhysXWorld *instance;
     physx::PxFoundation *_mFoundation;
     physx::PxCooking *_mCooking;
@@ -166,6 +190,7 @@ private:
     ccstd::unordered_map<uint32_t, uintptr_t> _mWrapperObjects;
 
     float _fixedTimeStep{1 / 60.0F};
+    bool _isStepping{false};
 
     uint32_t _debugLineCount = 0;
     uint32_t _MAX_DEBUG_LINE_COUNT = 16384;
@@ -45,6 +45,18 @@ void World::step(float fixedTimeStep) {
     _impl->step(fixedTimeStep);
 }
 
+void World::beginStep(float fixedTimeStep) {
+    _impl->beginStep(fixedTimeStep);
+}
+
+void World::endStep() {
+    _impl->endStep();
+}
+
+bool World::isStepping() const {
+    return _impl->isStepping();
+}
+
 void World::setAllowSleep(bool v) {
     _impl->setAllowSleep(v);
 }
@@ -70,19 +82,23 @@ void World::destroy() {
     _impl->destroy();
 }
 
-ccstd::vector<std::shared_ptr<TriggerEventPair>> &World::getTriggerEventPairs() {
+ccstd::vector<TriggerEventPair> &World::getTriggerEventPairs() {
     return _impl->getTriggerEventPairs();
 }
 
-ccstd::vector<std::shared_ptr<ContactEventPair>> &World::getContactEventPairs() {
+ccstd::vector<ContactEventPair> &World::getContactEventPairs() {
     return _impl->getContactEventPairs();
 }
 
+ccstd::vector<ContactPoint> &World::getContactPoints() {
+    return _impl->getContactPoints();
+}
+
 ccstd::vector<std::shared_ptr<CCTShapeEventPair>>& World::getCCTShapeEventPairs() {
     return _impl->getCCTShapeEventPairs();
 }
 
-ccstd::vector<std::shared_ptr<CCTTriggerEventPair>> &World::getCCTTriggerEventPairs() {
+ccstd::vector<CCTTriggerEventPair> &World::getCCTTriggerEventPairs() {
     return _impl->getCCTTriggerEventPairs();
 }
 
@@ -178,5 +194,25 @@ ccstd::vector<RaycastResult> &World::sweepResult() {
     return _impl->sweepResult();
 }
 
+uint32_t World::raycastClosestBatch(const RaycastOptions *opts, uint32_t count, RaycastResult *results) {
+    return _impl->raycastClosestBatch(opts, count, results);
+}
+
+uint32_t World::sweepBoxClosestBatch(const RaycastOptions *opts, uint32_t count, float halfExtentX, float halfExtentY, float halfExtentZ,
+    float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) {
+    return _impl->sweepBoxClosestBatch(opts, count, halfExtentX, halfExtentY, halfExtentZ,
+        orientationW, orientationX, orientationY, orientationZ, results);
+}
+
+uint32_t World::sweepSphereClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, RaycastResult *results) {
+    return _impl->sweepSphereClosestBatch(opts, count, radius, results);
+}
+
+uint32_t World::sweepCapsuleClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, float height,
+    float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) {
+    return _impl->sweepCapsuleClosestBatch(opts, count, radius, height,
+        orientationW, orientationX, orientationY, orientationZ, results);
+}
+
 } // namespace physics
 } // namespace cc
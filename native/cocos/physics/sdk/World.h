@@ -37,6 +37,9 @@ public:
     void setGravity(float x, float y, float z) override;
     void setAllowSleep(bool v) override;
     void step(float fixedTimeStep) override;
+    void beginStep(float fixedTimeStep) override;
+    void endStep() override;
+    bool isStepping() const override;
     void emitEvents() override;
     void syncSceneToPhysics() override;
     void syncSceneWithCheck() override;
@@ -45,10 +48,11 @@ public:
     void setDebugDrawConstraintSize(float size) override;
     float getDebugDrawConstraintSize() override;
     void setCollisionMatrix(uint32_t i, uint32_t m) override;
-    ccstd::vector<std::shared_ptr<TriggerEventPair>> &getTriggerEventPairs() override;
-    ccstd::vector<std::shared_ptr<ContactEventPair>>& getContactEventPairs() override;
+    ccstd::vector<TriggerEventPair> &getTriggerEventPairs() override;
+    ccstd::vector<ContactEventPair> &getContactEventPairs() override;
+    ccstd::vector<ContactPoint> &getContactPoints() override;
     ccstd::vector<std::shared_ptr<CCTShapeEventPair>>& getCCTShapeEventPairs() override;
-    ccstd::vector<std::shared_ptr<CCTTriggerEventPair>>& getCCTTriggerEventPairs() override;
+    ccstd::vector<CCTTriggerEventPair> &getCCTTriggerEventPairs() override;
     bool raycast(RaycastOptions &opt) override;
     bool raycastClosest(RaycastOptions &opt) override;
     ccstd::vector<RaycastResult> &raycastResult() override;
@@ -65,6 +69,15 @@ public:
         float orientationW, float orientationX, float orientationY, float orientationZ) override;
     RaycastResult &sweepClosestResult() override;
     ccstd::vector<RaycastResult> &sweepResult() override;
+#ifndef SWIGCOCOS
+    // Batched queries take raw caller-owned buffers, they are native only
+    uint32_t raycastClosestBatch(const RaycastOptions *opts, uint32_t count, RaycastResult *results) override;
+    uint32_t sweepBoxClosestBatch(const RaycastOptions *opts, uint32_t count, float halfExtentX, float halfExtentY, float halfExtentZ,
+        float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) override;
+    uint32_t sweepSphereClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, RaycastResult *results) override;
+    uint32_t sweepCapsuleClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, float height,
+        float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) override;
+#endif
 
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
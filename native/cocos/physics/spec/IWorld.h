@@ -71,12 +71,16 @@ struct ContactEventPair {
     uint32_t shapeA; //wrapper object ID
     uint32_t shapeB; //wrapper object ID
     ETouchState state;
-    ccstd::vector<ContactPoint> contacts;
-    static constexpr uint8_t COUNT = 4;
+    // Range of this pair in the contact point buffer shared by all pairs of the step.
+    uint32_t contactOffset;
+    uint32_t contactCount;
+    static constexpr uint8_t COUNT = 5;
     ContactEventPair(const uint32_t a, const uint32_t b)
     : shapeA(a),
       shapeB(b),
-      state(ETouchState::ENTER) {}
+      state(ETouchState::ENTER),
+      contactOffset(0),
+      contactCount(0) {}
 };
 
 struct CharacterControllerContact {
@@ -148,6 +152,16 @@ public:
     virtual void setGravity(float x, float y, float z) = 0;
     virtual void setAllowSleep(bool v) = 0;
     virtual void step(float s) = 0;
+    /**
+     * @brief Kicks off a simulation step on the physics worker threads and returns immediately.
+     * Results are not visible until endStep() is called, step() is beginStep() followed by endStep().
+     */
+    virtual void beginStep(float s) = 0;
+    /**
+     * @brief Waits for the step started by beginStep() and syncs its results to the scene, no-op if none is running.
+     */
+    virtual void endStep() = 0;
+    virtual bool isStepping() const = 0;
     virtual void emitEvents() = 0;
     virtual void syncSceneToPhysics() = 0;
     virtual void syncSceneWithCheck() = 0;
@@ -157,10 +171,11 @@ public:
     virtual void setDebugDrawConstraintSize(float s) = 0;
     virtual float getDebugDrawConstraintSize() = 0;
     virtual void setCollisionMatrix(uint32_t i, uint32_t m) = 0;
-    virtual ccstd::vector<std::shared_ptr<TriggerEventPair>> &getTriggerEventPairs() = 0;
-    virtual ccstd::vector<std::shared_ptr<ContactEventPair>>& getContactEventPairs() = 0;
+    virtual ccstd::vector<TriggerEventPair> &getTriggerEventPairs() = 0;
+    virtual ccstd::vector<ContactEventPair> &getContactEventPairs() = 0;
+    virtual ccstd::vector<ContactPoint> &getContactPoints() = 0;
     virtual ccstd::vector<std::shared_ptr<CCTShapeEventPair>>& getCCTShapeEventPairs() = 0;
-    virtual ccstd::vector<std::shared_ptr<CCTTriggerEventPair>> &getCCTTriggerEventPairs() = 0;
+    virtual ccstd::vector<CCTTriggerEventPair> &getCCTTriggerEventPairs() = 0;
     virtual bool raycast(RaycastOptions &opt) = 0;
     virtual bool raycastClosest(RaycastOptions &opt) = 0;
     virtual ccstd::vector<RaycastResult> &raycastResult() = 0;
@@ -177,6 +192,17 @@ public:
         float orientationW, float orientationX, float orientationY, float orientationZ) = 0;
     virtual RaycastResult &sweepClosestResult() = 0;
     virtual ccstd::vector<RaycastResult> &sweepResult() = 0;
+    /**
+     * @brief Batched closest hit queries, spread over the job system workers.
+     * results[i] receives the hit of opts[i], a result whose shape is 0 did not hit anything.
+     * @return The number of queries that hit.
+     */
+    virtual uint32_t raycastClosestBatch(const RaycastOptions *opts, uint32_t count, RaycastResult *results) = 0;
+    virtual uint32_t sweepBoxClosestBatch(const RaycastOptions *opts, uint32_t count, float halfExtentX, float halfExtentY, float halfExtentZ,
+        float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) = 0;
+    virtual uint32_t sweepSphereClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, RaycastResult *results) = 0;
+    virtual uint32_t sweepCapsuleClosestBatch(const RaycastOptions *opts, uint32_t count, float radius, float height,
+        float orientationW, float orientationX, float orientationY, float orientationZ, RaycastResult *results) = 0;
     virtual uint32_t createConvex(ConvexDesc &desc) = 0;
     virtual uint32_t createTrimesh(TrimeshDesc &desc) = 0;
     virtual uint32_t createHeightField(HeightFieldDesc &desc) = 0;
@@ -92,7 +92,7 @@ JNIEXPORT void JNICALL Java_com_cocos_lib_CocosSurfaceView_onSizeChangedNative(J
     auto func = [width, height, windowId]() -> void {
         cc::events::Resize::broadcast(width, height, windowId);
     };
-    CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func);
+    CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func, cc::TaskPriority::HIGH);
 }
 
 JNIEXPORT void JNICALL Java_com_cocos_lib_CocosSurfaceView_onSurfaceRedrawNeededNative(JNIEnv * /*env*/, jobject /*thiz*/, jlong handle) { // NOLINT JNI function name
@@ -115,7 +115,7 @@ JNIEXPORT void JNICALL Java_com_cocos_lib_CocosSurfaceView_onSurfaceCreatedNativ
         auto func = [sysWindow]() -> void {
             cc::events::WindowRecreated::broadcast(sysWindow->getWindowId());
         };
-        CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func);
+        CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func, cc::TaskPriority::HIGH);
     }
 }
 
@@ -149,7 +149,7 @@ JNIEXPORT void JNICALL Java_com_cocos_lib_CocosSurfaceView_onSurfaceChangedNativ
             auto func = [sysWindow]() -> void {
                 cc::events::WindowRecreated::broadcast(sysWindow->getWindowId());
             };
-            CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func);
+            CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func, cc::TaskPriority::HIGH);
         }
         // Release the window we acquired earlier.
         if (oldNativeWindow != nullptr) {
@@ -170,7 +170,7 @@ JNIEXPORT void JNICALL Java_com_cocos_lib_CocosSurfaceView_onSurfaceDestroyedNat
 
         cc::events::WindowDestroy::broadcast(window->getWindowId());
     };
-    CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func);
+    CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread(func, cc::TaskPriority::HIGH);
 }
 
 // NOLINTNEXTLINE
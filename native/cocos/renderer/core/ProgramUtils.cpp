@@ -22,6 +22,9 @@
  THE SOFTWARE.
 ****************************************************************************/
 #include "ProgramUtils.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 namespace cc {
 
@@ -146,9 +149,18 @@ ccstd::string getVariantKey(const IProgramInfo &tmpl, const MacroRecord &defines
         ccstd::string ret{key.str() + std::to_string(tmpl.hash)};
         return ret;
     }
+    // formatted without streams, the key is requested for every pass hash
+    char buffer[24];
+    const auto length = std::snprintf(
+        buffer, sizeof(buffer), "%x|%u",
+        getVariantBits(tmpl, defines), static_cast<uint32_t>(tmpl.hash));
+    return ccstd::string(buffer, static_cast<size_t>(length));
+}
+
+uint32_t getVariantBits(const IProgramInfo &tmpl, const MacroRecord &defines) {
+    CC_ASSERT(!tmpl.uber);
     uint32_t key = 0;
-    std::stringstream ss;
-    for (const auto &tmplDef : tmplDefs) {
+    for (const auto &tmplDef : tmpl.defines) {
         auto itDef = defines.find(tmplDef.name);
         if (itDef == defines.end() || !tmplDef.map) {
             continue;
@@ -158,9 +170,7 @@ ccstd::string getVariantKey(const IProgramInfo &tmpl, const MacroRecord &defines
         auto offset = tmplDef.offset;
         key |= (mapped << offset);
     }
-    ss << std::hex << key << "|" << std::to_string(tmpl.hash);
-    ccstd::string ret{ss.str()};
-    return ret;
+    return key;
 }
 
 namespace {
@@ -248,6 +258,134 @@ ccstd::string getShaderInstanceName(const ccstd::string &name, const ccstd::vect
     return ret.str();
 }
 
+namespace {
+
+void appendEscaped(ccstd::string &out, const ccstd::string &text) {
+    for (const char c : text) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            default: out += c; break;
+        }
+    }
+}
+
+bool unescape(const char *begin, const char *end, ccstd::string &out) {
+    out.clear();
+    for (const char *p = begin; p != end; ++p) {
+        if (*p != '\\') {
+            out += *p;
+            continue;
+        }
+        if (++p == end) {
+            return false;
+        }
+        switch (*p) {
+            case '\\': out += '\\'; break;
+            case 't': out += '\t'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            default: return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ccstd::string formatVariantManifestLine(
+    uint32_t phaseID, const ccstd::string &phaseName, const ccstd::string &programName,
+    const IProgramInfo &tmpl, const MacroRecord &defines) {
+    ccstd::string line = std::to_string(phaseID);
+    line += '\t';
+    appendEscaped(line, phaseName);
+    line += '\t';
+    appendEscaped(line, programName);
+    for (const auto &def : tmpl.defines) {
+        const auto iter = defines.find(def.name);
+        if (iter == defines.end()) {
+            continue;
+        }
+        const auto &value = iter->second;
+        if (const auto *pBool = ccstd::get_if<bool>(&value)) {
+            line += '\t';
+            line += def.name;
+            line += *pBool ? "=b1" : "=b0";
+        } else if (const auto *pInt = ccstd::get_if<int32_t>(&value)) {
+            line += '\t';
+            line += def.name;
+            line += "=i";
+            line += std::to_string(*pInt);
+        } else if (const auto *pString = ccstd::get_if<ccstd::string>(&value)) {
+            line += '\t';
+            line += def.name;
+            line += "=s";
+            appendEscaped(line, *pString);
+        }
+    }
+    line += '\n';
+    return line;
+}
+
+bool parseVariantManifestLine(
+    const ccstd::string &line, uint32_t &phaseID, ccstd::string &phaseName,
+    ccstd::string &programName, MacroRecord &defines) {
+    const char *const end = line.c_str() + line.size() - (!line.empty() && line.back() == '\n' ? 1 : 0);
+    const char *field = line.c_str();
+    const auto nextField = [&]() {
+        const auto *p = std::find(field, end, '\t');
+        auto range = std::make_pair(field, p);
+        field = p == end ? end : p + 1;
+        return range;
+    };
+
+    auto [idBegin, idEnd] = nextField();
+    char *idParsed = nullptr;
+    phaseID = static_cast<uint32_t>(std::strtoul(idBegin, &idParsed, 10));
+    if (idParsed != idEnd || idBegin == idEnd) {
+        return false;
+    }
+    auto [phaseBegin, phaseEnd] = nextField();
+    auto [programBegin, programEnd] = nextField();
+    if (programBegin == programEnd ||
+        !unescape(phaseBegin, phaseEnd, phaseName) ||
+        !unescape(programBegin, programEnd, programName)) {
+        return false;
+    }
+
+    defines.clear();
+    ccstd::string text;
+    while (field != end) {
+        auto [begin, fieldEnd] = nextField();
+        const auto *eq = std::find(begin, fieldEnd, '=');
+        if (eq == begin || eq == fieldEnd || eq + 1 == fieldEnd) {
+            return false;
+        }
+        ccstd::string macroName(begin, eq);
+        const char *value = eq + 2;
+        switch (eq[1]) {
+            case 'b':
+                defines[macroName] = value != fieldEnd && *value == '1';
+                break;
+            case 'i':
+                text.assign(value, fieldEnd);
+                defines[macroName] = static_cast<int32_t>(std::strtol(text.c_str(), nullptr, 10));
+                break;
+            case 's':
+                if (!unescape(value, fieldEnd, text)) {
+                    return false;
+                }
+                defines[macroName] = text;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
 void addEffectDefaultProperties(EffectAsset &effect) {
     for (auto &tech : effect._techniques) {
         for (auto &pass : tech.passes) {
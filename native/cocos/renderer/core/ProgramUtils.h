@@ -34,6 +34,8 @@ void populateMacros(IProgramInfo& tmpl);
 ccstd::unordered_map<ccstd::string, uint32_t> genHandles(const IProgramInfo& tmpl);
 ccstd::unordered_map<ccstd::string, uint32_t> genHandles(const gfx::ShaderInfo& tmpl);
 ccstd::string getVariantKey(const IProgramInfo& tmpl, const MacroRecord& defines);
+// packed macro bits of a non-uber program, the numeric part of getVariantKey
+uint32_t getVariantBits(const IProgramInfo& tmpl, const MacroRecord& defines);
 ccstd::vector<IMacroInfo> prepareDefines(
     const MacroRecord& records, const ccstd::vector<IDefineRecord>& defList);
 
@@ -48,6 +50,17 @@ ccstd::vector<gfx::Attribute> getActiveAttributes(
 ccstd::string getShaderInstanceName(
     const ccstd::string& name, const ccstd::vector<IMacroInfo>& macros);
 
+// One line of the shader variant manifest, the trailing newline included:
+// phaseID \t phaseName \t programName [\t MACRO=<b|i|s>value]...
+// Only the macros declared by the program are written, tabs, newlines and
+// backslashes in text fields are escaped.
+ccstd::string formatVariantManifestLine(
+    uint32_t phaseID, const ccstd::string& phaseName, const ccstd::string& programName,
+    const IProgramInfo& tmpl, const MacroRecord& defines);
+bool parseVariantManifestLine(
+    const ccstd::string& line, uint32_t& phaseID, ccstd::string& phaseName,
+    ccstd::string& programName, MacroRecord& defines);
+
 void addEffectDefaultProperties(EffectAsset& effect);
 
 } // namespace render
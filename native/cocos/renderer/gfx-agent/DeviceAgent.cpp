@@ -76,6 +76,7 @@ bool DeviceAgent::doInit(const DeviceInfo &info) {
     _cmdBuff = ccnew CommandBufferAgent(_actor->getCommandBuffer());
     _renderer = _actor->getRenderer();
     _vendor = _actor->getVendor();
+    _version = _actor->getVersion();
     _caps = _actor->_caps;
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
     memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
@@ -435,6 +436,16 @@ void DeviceAgent::enableAutoBarrier(bool en) {
         });
 }
 
+void DeviceAgent::flushPersistentCache() {
+    // backends may write their pending data back first, which must happen on the device thread
+    ENQUEUE_MESSAGE_1(
+        _mainMessageQueue, DeviceFlushPersistentCache,
+        actor, getActor(),
+        {
+            actor->flushPersistentCache();
+        });
+}
+
 void DeviceAgent::presentSignal() {
     _frameBoundarySemaphore.signal();
 }
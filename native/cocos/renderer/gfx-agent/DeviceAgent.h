@@ -96,6 +96,7 @@ public:
     uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
+    PersistentCache *getPersistentCache() override { return _actor->getPersistentCache(); }
 
     uint32_t getCurrentIndex() const { return _currentIndex; }
     void setMultithreaded(bool multithreaded);
@@ -106,6 +107,7 @@ public:
     void presentSignal();
 
     void enableAutoBarrier(bool en) override;
+    void flushPersistentCache() override;
     SampleCount getMaxSampleCount(Format format, TextureUsage usage, TextureFlags flags) const override;
 protected:
     static DeviceAgent *instance;
@@ -24,6 +24,8 @@
 
 #include "GFXDevice.h"
 #include "GFXObject.h"
+#include "GFXPersistentCache.h"
+#include "GFXUtil.h"
 #include "base/memory/Memory.h"
 #include "platform/BasePlatform.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
@@ -94,9 +96,31 @@ void Device::destroy() {
 
     doDestroy();
 
+    // backends write their caches back in doDestroy
+    if (_persistentCache) {
+        _persistentCache->flush();
+        _persistentCache.reset();
+    }
+
     CC_SAFE_DELETE(_onAcquire);
 }
 
+PersistentCache *Device::getPersistentCache() {
+    if (!_persistentCache) {
+        PersistentCacheInfo info;
+        info.path = getPipelineCacheFolder() + "/persistent_cache.bin";
+        info.identity = PersistentCache::makeIdentity(*this);
+        _persistentCache = std::make_unique<PersistentCache>(std::move(info));
+    }
+    return _persistentCache.get();
+}
+
+void Device::flushPersistentCache() {
+    if (_persistentCache) {
+        _persistentCache->flush();
+    }
+}
+
 Sampler *Device::getSampler(const SamplerInfo &info) {
     if (!_samplers.count(info)) {
         _samplers[info] = createSampler(info);
@@ -39,6 +39,7 @@
 #include "GFXShader.h"
 #include "GFXSwapchain.h"
 #include "GFXTexture.h"
+#include <memory>
 #include "base/RefCounted.h"
 #include "base/std/container/array.h"
 #include "states/GFXBufferBarrier.h"
@@ -49,6 +50,8 @@
 namespace cc {
 namespace gfx {
 
+class PersistentCache;
+
 class CC_DLL Device : public RefCounted {
 public:
     static Device *getInstance();
@@ -111,6 +114,7 @@ public:
     inline const ccstd::string &getDeviceName() const { return _deviceName; }
     inline const ccstd::string &getRenderer() const { return _renderer; }
     inline const ccstd::string &getVendor() const { return _vendor; }
+    inline const ccstd::string &getVersion() const { return _version; }
     inline bool hasFeature(Feature feature) const { return _features[toNumber(feature)]; }
     inline FormatFeature getFormatFeatures(Format format) const { return _formatFeatures[toNumber(format)]; }
 
@@ -121,6 +125,12 @@ public:
     template <typename ExecuteMethod>
     void registerOnAcquireCallback(ExecuteMethod &&execute);
 
+    // on-disk cache shared by backends for shader binaries and pipeline data,
+    // keyed by device, driver and engine version. Flushed when the device is destroyed.
+    virtual PersistentCache *getPersistentCache();
+    // writes the cache back before the app may be killed, e.g. in background or on low memory
+    virtual void flushPersistentCache();
+
     virtual void enableAutoBarrier(bool en) { _options.enableBarrierDeduce = en; }
     virtual SampleCount getMaxSampleCount(Format format, TextureUsage usage, TextureFlags flags) const {
         std::ignore = format;
@@ -194,6 +204,8 @@ protected:
     ccstd::unordered_map<TextureBarrierInfo, TextureBarrier *, Hasher<TextureBarrierInfo>> _textureBarriers;
     ccstd::unordered_map<BufferBarrierInfo, BufferBarrier *, Hasher<BufferBarrierInfo>> _bufferBarriers;
 
+    std::unique_ptr<PersistentCache> _persistentCache;
+
 private:
     ccstd::vector<Swapchain *> _swapchains; // weak reference
 };
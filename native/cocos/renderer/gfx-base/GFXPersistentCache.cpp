@@ -0,0 +1,295 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "GFXPersistentCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "GFXDevice.h"
+#include "base/BinaryArchive.h"
+#include "base/Log.h"
+#include "cocos-version.h"
+
+namespace cc::gfx {
+
+namespace {
+const uint32_t MAGIC = 0x43435043; // "CCPC"
+const uint32_t VERSION = 1;
+
+// lengths are checked against the bytes left in the file before anything is allocated for them
+bool loadString(BinaryInputArchive &archive, ccstd::string &str, uint64_t remaining) {
+    uint32_t length = 0;
+    if (!archive.load(length) || length > remaining) {
+        return false;
+    }
+    str.resize(length);
+    return archive.load(str.data(), length);
+}
+
+void saveString(BinaryOutputArchive &archive, const ccstd::string &str) {
+    archive.save(static_cast<uint32_t>(str.size()));
+    archive.save(str.data(), static_cast<uint32_t>(str.size()));
+}
+
+} // namespace
+
+PersistentCache::PersistentCache(PersistentCacheInfo info)
+: _info(std::move(info)) {
+}
+
+PersistentCache::~PersistentCache() {
+    flush();
+}
+
+ccstd::string PersistentCache::makeIdentity(const Device &device) {
+    ccstd::string identity;
+    identity += std::to_string(static_cast<uint32_t>(device.getGfxAPI()));
+    identity += '|';
+    identity += device.getDeviceName();
+    identity += '|';
+    identity += device.getRenderer();
+    identity += '|';
+    identity += device.getVendor();
+    identity += '|';
+    identity += device.getVersion();
+    identity += '|';
+    identity += COCOS_VERSION_STRING;
+    return identity;
+}
+
+bool PersistentCache::load(const ccstd::string &key, ccstd::hash_t hash, ccstd::vector<char> &data) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+    auto iter = _items.find(key);
+    if (iter == _items.end()) {
+        return false;
+    }
+    auto &item = iter->second;
+    if (item.hash != hash) {
+        // source changed, the stale item is replaced by the next store
+        _size -= static_cast<uint32_t>(item.data.size());
+        _items.erase(iter);
+        _dirty = true;
+        return false;
+    }
+    item.lastUse = ++_useCounter;
+    data = item.data;
+    return true;
+}
+
+void PersistentCache::store(const ccstd::string &key, ccstd::hash_t hash, const char *data, uint32_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+    if (size > _info.maxSize) {
+        return;
+    }
+    auto &item = _items[key];
+    _size -= static_cast<uint32_t>(item.data.size());
+    item.hash = hash;
+    item.lastUse = ++_useCounter;
+    item.data.assign(data, data + size);
+    _size += size;
+    _dirty = true;
+    evict(_info.maxSize);
+}
+
+void PersistentCache::erase(const ccstd::string &key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+    auto iter = _items.find(key);
+    if (iter != _items.end()) {
+        _size -= static_cast<uint32_t>(iter->second.data.size());
+        _items.erase(iter);
+        _dirty = true;
+    }
+}
+
+void PersistentCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // the file is not read anymore, it is replaced by the next flush
+    _loaded = true;
+    _items.clear();
+    _size = 0;
+    _useCounter = 0;
+    _dirty = true;
+}
+
+uint32_t PersistentCache::getSize() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+    return _size;
+}
+
+uint32_t PersistentCache::getCount() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+    return static_cast<uint32_t>(_items.size());
+}
+
+void PersistentCache::ensureLoaded() {
+    if (_loaded) {
+        return;
+    }
+    _loaded = true;
+    if (!loadFile()) {
+        // missing, corrupted or written by another device, driver or engine version
+        _items.clear();
+        _size = 0;
+        _useCounter = 0;
+    }
+}
+
+bool PersistentCache::loadFile() {
+    std::ifstream stream(_info.path, std::ios::binary);
+    if (!stream.is_open()) {
+        return false;
+    }
+    stream.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(stream.tellg());
+    stream.seekg(0, std::ios::beg);
+    auto remaining = [&]() {
+        const auto pos = stream.tellg();
+        return pos < 0 ? 0 : fileSize - static_cast<uint64_t>(pos);
+    };
+
+    BinaryInputArchive archive(stream);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    ccstd::string identity;
+    bool loadResult = archive.load(magic);
+    loadResult = loadResult && archive.load(version);
+    if (!loadResult || magic != MAGIC || version != VERSION) {
+        _dirty = true;
+        return false;
+    }
+    if (!loadString(archive, identity, remaining()) || identity != _info.identity) {
+        CC_LOG_INFO("Persistent cache %s invalidated.", _info.path.c_str());
+        _dirty = true;
+        return false;
+    }
+    uint32_t count = 0;
+    loadResult = archive.load(count) && archive.load(_useCounter);
+    for (uint32_t i = 0; loadResult && i != count; ++i) {
+        ccstd::string key;
+        Item item;
+        uint32_t size = 0;
+        loadResult = loadString(archive, key, remaining()) &&
+                     archive.load(item.hash) &&
+                     archive.load(item.lastUse) &&
+                     archive.load(size) &&
+                     size <= _info.maxSize && size <= remaining();
+        if (!loadResult) {
+            break;
+        }
+        item.data.resize(size);
+        loadResult = archive.load(item.data.data(), size);
+        if (loadResult) {
+            _size += size;
+            _items[std::move(key)] = std::move(item);
+        }
+    }
+    if (!loadResult) {
+        // truncated file, files are replaced atomically so this is not expected
+        _dirty = true;
+        return false;
+    }
+    // the size limit may have been lowered since the file was written
+    if (_size > _info.maxSize) {
+        evict(_info.maxSize);
+        _dirty = true;
+    }
+    CC_LOG_INFO("Persistent cache %s loaded, %u items.", _info.path.c_str(), count);
+    return true;
+}
+
+void PersistentCache::evict(uint32_t limit) {
+    if (_size <= limit) {
+        return;
+    }
+    ccstd::vector<std::pair<uint32_t, const ccstd::string *>> order;
+    order.reserve(_items.size());
+    for (const auto &pair : _items) {
+        order.emplace_back(pair.second.lastUse, &pair.first);
+    }
+    std::sort(order.begin(), order.end());
+    for (const auto &entry : order) {
+        if (_size <= limit) {
+            break;
+        }
+        auto iter = _items.find(*entry.second);
+        _size -= static_cast<uint32_t>(iter->second.data.size());
+        _items.erase(iter);
+    }
+}
+
+bool PersistentCache::flush() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_dirty || _info.path.empty()) {
+        return true;
+    }
+    const ccstd::string tmpPath = _info.path + ".tmp";
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) {
+            CC_LOG_INFO("Save persistent cache %s failed.", _info.path.c_str());
+            return false;
+        }
+        BinaryOutputArchive archive(stream);
+        archive.save(MAGIC);
+        archive.save(VERSION);
+        saveString(archive, _info.identity);
+        archive.save(static_cast<uint32_t>(_items.size()));
+        archive.save(_useCounter);
+        for (const auto &pair : _items) {
+            const auto &item = pair.second;
+            saveString(archive, pair.first);
+            archive.save(item.hash);
+            archive.save(item.lastUse);
+            archive.save(static_cast<uint32_t>(item.data.size()));
+            archive.save(item.data.data(), static_cast<uint32_t>(item.data.size()));
+        }
+        stream.flush();
+        if (!stream.good()) {
+            CC_LOG_INFO("Save persistent cache %s failed.", _info.path.c_str());
+            stream.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    // rename does not replace an existing file on Windows
+    if (std::rename(tmpPath.c_str(), _info.path.c_str()) != 0) {
+        std::remove(_info.path.c_str());
+        if (std::rename(tmpPath.c_str(), _info.path.c_str()) != 0) {
+            CC_LOG_INFO("Save persistent cache %s failed.", _info.path.c_str());
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    _dirty = false;
+    return true;
+}
+
+} // namespace cc::gfx
@@ -0,0 +1,98 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "base/std/hash/hash.h"
+
+namespace cc::gfx {
+
+class Device;
+
+struct PersistentCacheInfo {
+    // file the cache is stored in
+    ccstd::string path;
+    // device, driver and engine version, a mismatch discards the stored content
+    ccstd::string identity;
+    // total bytes of cached data kept on disk, least recently used items are evicted first
+    uint32_t maxSize{32U * 1024U * 1024U};
+};
+
+/**
+ * Backend agnostic on-disk cache for shader binaries and pipeline data.
+ * The file is loaded lazily on first access and written atomically by flush().
+ * Items are keyed by name and validated by a content hash.
+ */
+class CC_DLL PersistentCache final {
+public:
+    explicit PersistentCache(PersistentCacheInfo info);
+    ~PersistentCache();
+
+    PersistentCache(const PersistentCache &) = delete;
+    PersistentCache(PersistentCache &&) = delete;
+    PersistentCache &operator=(const PersistentCache &) = delete;
+    PersistentCache &operator=(PersistentCache &&) = delete;
+
+    static ccstd::string makeIdentity(const Device &device);
+
+    // returns false if the item is missing or was stored with a different hash
+    bool load(const ccstd::string &key, ccstd::hash_t hash, ccstd::vector<char> &data);
+    void store(const ccstd::string &key, ccstd::hash_t hash, const char *data, uint32_t size);
+    void erase(const ccstd::string &key);
+    void clear();
+
+    // writes the cache to a temporary file and renames it over the previous one
+    bool flush();
+
+    inline const ccstd::string &getPath() const { return _info.path; }
+    inline const ccstd::string &getIdentity() const { return _info.identity; }
+    uint32_t getSize();
+    uint32_t getCount();
+
+private:
+    struct Item {
+        ccstd::hash_t hash{0};
+        uint32_t lastUse{0};
+        ccstd::vector<char> data;
+    };
+
+    void ensureLoaded();
+    bool loadFile();
+    void evict(uint32_t limit);
+
+    PersistentCacheInfo _info;
+    ccstd::unordered_map<ccstd::string, Item> _items;
+    std::mutex _mutex;
+    uint32_t _size{0};
+    uint32_t _useCounter{0};
+    bool _loaded{false};
+    bool _dirty{false};
+};
+
+} // namespace cc::gfx
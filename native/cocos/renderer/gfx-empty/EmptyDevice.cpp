@@ -73,6 +73,13 @@ bool EmptyDevice::doInit(const DeviceInfo & /*info*/) {
     _formatFeatures.fill(static_cast<FormatFeature>(-1)); // allow all usages for all formats
     _formatFeatures[toNumber(Format::UNKNOWN)] = FormatFeature::NONE;
 
+    // limits of a common desktop device, so resources pass the validator when running headless
+    _caps.maxColorRenderTargets = 8;
+    _caps.maxTextureSize = 16384;
+    _caps.maxCubeMapTextureSize = 16384;
+    _caps.maxArrayTextureLayers = 2048;
+    _caps.max3DTextureSize = 2048;
+
     CC_LOG_INFO("Empty device initialized.");
 
     return true;
@@ -238,7 +238,7 @@ bool GLES3Device::doInit(const DeviceInfo & /*info*/) {
     _gpuStateCache->initialize(_caps.maxTextureUnits, _caps.maxImageUnits, _caps.maxUniformBufferBindings, _caps.maxShaderStorageBufferBindings, _caps.maxVertexAttributes);
 
 #if CC_USE_PIPELINE_CACHE
-    _pipelineCache = std::make_unique<GLES3PipelineCache>();
+    _pipelineCache = std::make_unique<GLES3PipelineCache>(getPersistentCache());
     _pipelineCache->init();
 #endif
 
@@ -31,16 +31,13 @@
 #include "base/std/container/unordered_map.h"
 #include "base/std/container/vector.h"
 
-namespace cc {
-class BinaryOutputArchive;
-}
-
 namespace cc::gfx {
 class GLES3GPUShader;
+class PersistentCache;
 
 class GLES3PipelineCache : public RefCounted {
 public:
-    GLES3PipelineCache();
+    explicit GLES3PipelineCache(PersistentCache *persistentCache);
     ~GLES3PipelineCache() override;
 
     void init();
@@ -50,14 +47,9 @@ public:
     bool checkProgramFormat(GLuint format) const;
 
 private:
-    bool loadCache();
-    void saveCacheFull();
-    void saveCacheIncremental(GLES3GPUProgramBinary *binary);
-
     ccstd::vector<GLint> _programBinaryFormats;
     ccstd::unordered_map<ccstd::string, IntrusivePtr<GLES3GPUProgramBinary>> _programCaches;
-    ccstd::string _savePath;
-    bool _dirty = false;
+    PersistentCache *_persistentCache{nullptr};
 };
 
 } // namespace cc::gfx
@@ -83,6 +83,7 @@ bool DeviceValidator::doInit(const DeviceInfo &info) {
     _cmdBuff = ccnew CommandBufferValidator(_actor->getCommandBuffer());
     _renderer = _actor->getRenderer();
     _vendor = _actor->getVendor();
+    _version = _actor->getVersion();
     _caps = _actor->_caps;
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
     memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
@@ -89,6 +89,8 @@ public:
     uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
+    PersistentCache *getPersistentCache() override { return _actor->getPersistentCache(); }
+    void flushPersistentCache() override { _actor->flushPersistentCache(); }
 
     inline void enableRecording(bool recording) { _recording = recording; }
     inline bool isRecording() const { return _recording; }
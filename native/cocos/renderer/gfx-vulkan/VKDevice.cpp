@@ -461,9 +461,6 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     getAccessTypes(AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE, _gpuDevice->defaultDepthStencilBarrier.nextAccesses);
     cmdFuncCCVKCreateGeneralBarrier(this, &_gpuDevice->defaultDepthStencilBarrier);
 
-    _pipelineCache = std::make_unique<CCVKPipelineCache>();
-    _pipelineCache->init(_gpuDevice->vkDevice);
-
     ///////////////////// Print Debug Info /////////////////////
 
     ccstd::string instanceLayers;
@@ -489,6 +486,10 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     _version = StringUtil::format("%d.%d.%d", VK_VERSION_MAJOR(apiVersion),
                                   VK_VERSION_MINOR(apiVersion), VK_VERSION_PATCH(apiVersion));
 
+    // the cache identity names the device and driver, so it is created once they are known
+    _pipelineCache = std::make_unique<CCVKPipelineCache>(getPersistentCache());
+    _pipelineCache->init(_gpuDevice->vkDevice);
+
     CC_LOG_INFO("Vulkan device initialized.");
     CC_LOG_INFO("RENDERER: %s", _renderer.c_str());
     CC_LOG_INFO("VENDOR: %s", _vendor.c_str());
@@ -507,6 +508,15 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     return true;
 }
 
+void CCVKDevice::flushPersistentCache() {
+#if CC_USE_PIPELINE_CACHE
+    if (_pipelineCache) {
+        _pipelineCache->saveCache();
+    }
+#endif
+    Device::flushPersistentCache();
+}
+
 void CCVKDevice::doDestroy() {
     waitAllFences();
 
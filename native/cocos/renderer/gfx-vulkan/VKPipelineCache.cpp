@@ -24,47 +24,18 @@
 
 #include "VKPipelineCache.h"
 
-#include <fstream>
-
-#include "base/BinaryArchive.h"
-
-#include "gfx-base/GFXUtil.h"
+#include "gfx-base/GFXPersistentCache.h"
 
 namespace {
-const char *fileName = "/pipeline_cache_vk.bin";
-const uint32_t MAGIC = 0x4343564B; // "CCVK"
-const uint32_t VERSION = 1;
-
-void loadData(const ccstd::string &path, ccstd::vector<char> &data) {
-    std::ifstream stream(path, std::ios::binary);
-    if (!stream.is_open()) {
-        CC_LOG_INFO("Load program cache, no cached files.");
-        return;
-    }
-
-    uint32_t magic = 0;
-    uint32_t version = 0;
-
-    cc::BinaryInputArchive archive(stream);
-    auto loadResult = archive.load(magic);
-    loadResult &= archive.load(version);
-
-    uint32_t size = 0;
-    if (loadResult && magic == MAGIC && version >= VERSION) {
-        loadResult &= archive.load(size);
-        data.resize(size);
-        loadResult &= archive.load(data.data(), size);
-    }
-    if (loadResult) {
-        CC_LOG_INFO("Load pipeline cache success.");
-    }
-}
+// the driver validates the blob header (vendor, device and pipeline cache UUID) itself
+const char *cacheKey = "vulkan/pipeline_cache";
+const ccstd::hash_t CACHE_HASH = 1;
 } // namespace
 
 namespace cc::gfx {
 
-CCVKPipelineCache::CCVKPipelineCache() {
-    _savePath = getPipelineCacheFolder() + fileName;
+CCVKPipelineCache::CCVKPipelineCache(PersistentCache *persistentCache)
+: _persistentCache(persistentCache) {
 }
 
 CCVKPipelineCache::~CCVKPipelineCache() {
@@ -84,7 +55,9 @@ void CCVKPipelineCache::init(VkDevice dev) {
 void CCVKPipelineCache::loadCache() {
     ccstd::vector<char> data;
 #if CC_USE_PIPELINE_CACHE
-    loadData(_savePath, data);
+    if (_persistentCache->load(cacheKey, CACHE_HASH, data)) {
+        CC_LOG_INFO("Load pipeline cache success.");
+    }
 #endif
 
     VkPipelineCacheCreateInfo cacheInfo = {};
@@ -99,22 +72,12 @@ void CCVKPipelineCache::saveCache() {
     if (!_dirty) {
         return;
     }
-    std::ofstream stream(_savePath, std::ios::binary);
-    if (!stream.is_open()) {
-        CC_LOG_INFO("Save program cache failed.");
-        return;
-    }
-    BinaryOutputArchive archive(stream);
-    archive.save(MAGIC);
-    archive.save(VERSION);
-
     size_t size = 0;
     vkGetPipelineCacheData(_device, _pipelineCache, &size, nullptr);
     ccstd::vector<char> data(size);
     vkGetPipelineCacheData(_device, _pipelineCache, &size, data.data());
 
-    archive.save(static_cast<uint32_t>(size));
-    archive.save(data.data(), static_cast<uint32_t>(size));
+    _persistentCache->store(cacheKey, CACHE_HASH, data.data(), static_cast<uint32_t>(size));
     _dirty = false;
 }
 
@@ -32,10 +32,11 @@
 #include "base/std/container/vector.h"
 
 namespace cc::gfx {
+class PersistentCache;
 
 class CCVKPipelineCache : public RefCounted {
 public:
-    CCVKPipelineCache();
+    explicit CCVKPipelineCache(PersistentCache *persistentCache);
     ~CCVKPipelineCache() override;
 
     void init(VkDevice dev);
@@ -48,7 +49,7 @@ public:
 private:
     VkDevice _device = VK_NULL_HANDLE;
     VkPipelineCache _pipelineCache = VK_NULL_HANDLE;
-    ccstd::string _savePath;
+    PersistentCache *_persistentCache = nullptr;
     bool _dirty = false;
 };
 
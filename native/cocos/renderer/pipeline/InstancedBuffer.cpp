@@ -46,9 +46,10 @@ void InstancedBuffer::destroy() {
     for (auto &instance : _instances) {
         CC_SAFE_DESTROY_AND_DELETE(instance.vb);
         CC_SAFE_DESTROY_AND_DELETE(instance.ia);
-        CC_FREE(instance.data);
     }
     _instances.clear();
+    _staging.clear();
+    _staging.shrink_to_fit();
 }
 
 void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx) {
@@ -73,6 +74,7 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         shader = subModel->getShader(passIdx);
     }
 
+    const auto *source = attrs.buffer.buffer()->getData();
     for (auto &instance : _instances) {
         if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.drawInfo.instanceCount >= MAX_CAPACITY) {
             continue;
@@ -99,24 +101,21 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         if (instance.stride != stride) {
             continue;
         }
-        if (instance.drawInfo.instanceCount >= instance.capacity) { // resize buffers
-            instance.capacity <<= 1;
-            const auto newSize = instance.stride * instance.capacity;
-            instance.data = static_cast<uint8_t *>(CC_REALLOC(instance.data, newSize));
-            instance.vb->resize(newSize);
-        }
-        if (instance.shader != shader) {
-            instance.shader = shader;
+        // instances of different shader variants cannot share one draw
+        if (instance.drawInfo.instanceCount && instance.shader != shader) {
+            continue;
         }
+        instance.shader = shader;
         if (instance.descriptorSet != descriptorSet) {
             instance.descriptorSet = descriptorSet;
         }
-        memcpy(instance.data + instance.stride * instance.drawInfo.instanceCount++, attrs.buffer.buffer()->getData(), stride);
+        instance.sources.emplace_back(source);
+        ++instance.drawInfo.instanceCount;
         _hasPendingModels = true;
         return;
     }
 
-    // Create a new instance
+    // Create a new instance, its vertex buffer is kept and reused in later frames
     const auto newSize = stride * INITIAL_CAPACITY;
     auto *vb = _device->createBuffer({
         gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
@@ -139,31 +138,64 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
             attribute.location});
     }
 
-    auto *data = static_cast<uint8_t *>(CC_MALLOC(newSize));
-    memcpy(data, attrs.buffer.buffer()->getData(), stride);
     vertexBuffers.emplace_back(vb);
     const gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, indexBuffer};
     auto *ia = _device->createInputAssembler(iaInfo);
-    InstancedItem item = {INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet,
+    InstancedItem item = {INITIAL_CAPACITY, vb, ia, stride, shader, descriptorSet,
                           lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType, reflectionProbeBlendCubemap,
                           ia->getDrawInfo()};
     item.drawInfo.instanceCount = 1;
-    _instances.emplace_back(item);
+    item.sources.emplace_back(source);
+    _instances.emplace_back(std::move(item));
     _hasPendingModels = true;
 }
 
-void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) const {
+void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff, InstancingStatistics *statistics) {
+    uint32_t totalSize = 0;
     for (const auto &instance : _instances) {
-        if (!instance.drawInfo.instanceCount) continue;
+        totalSize += instance.stride * instance.drawInfo.instanceCount;
+    }
+    // the arena only grows, steady frames do not allocate
+    if (_staging.size() < totalSize) {
+        _staging.resize(totalSize);
+    }
 
-        cmdBuff->updateBuffer(instance.vb, instance.data, instance.vb->getSize());
-        instance.ia->setInstanceCount(instance.drawInfo.instanceCount);
+    uint32_t offset = 0;
+    for (auto &instance : _instances) {
+        const auto count = instance.drawInfo.instanceCount;
+        if (!count) continue;
+
+        CC_ASSERT(instance.sources.size() == count);
+        auto *data = _staging.data() + offset;
+        for (uint32_t i = 0; i != count; ++i) {
+            memcpy(data + instance.stride * i, instance.sources[i], instance.stride);
+        }
+        const auto size = instance.stride * count;
+        if (count > instance.capacity) { // resize once to the largest batch seen so far
+            while (instance.capacity < count) {
+                instance.capacity <<= 1;
+            }
+            instance.vb->resize(instance.stride * instance.capacity);
+            if (statistics) {
+                ++statistics->numBufferResizes;
+            }
+        }
+        cmdBuff->updateBuffer(instance.vb, data, size);
+        instance.ia->setInstanceCount(count);
+        offset += size;
+
+        if (statistics) {
+            statistics->numInstances += count;
+            ++statistics->numDrawCalls;
+            statistics->uploadedBytes += size;
+        }
     }
 }
 
 void InstancedBuffer::clear() {
     for (auto &instance : _instances) {
         instance.drawInfo.instanceCount = 0;
+        instance.sources.clear();
     }
     _hasPendingModels = false;
 }
@@ -27,6 +27,7 @@
 #include "Define.h"
 #include "base/RefCounted.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 #include "scene/Model.h"
 #include "scene/Pass.h"
 
@@ -40,7 +41,6 @@ struct PSOInfo;
 struct CC_DLL InstancedItem {
     uint32_t capacity = 0;
     gfx::Buffer *vb = nullptr;
-    uint8_t *data = nullptr;
     gfx::InputAssembler *ia = nullptr;
     uint32_t stride = 0;
     gfx::Shader *shader = nullptr;
@@ -51,10 +51,23 @@ struct CC_DLL InstancedItem {
     uint32_t reflectionProbeType = 0;
     gfx::Texture *reflectionProbeBlendCubemap = nullptr;
     gfx::DrawInfo drawInfo;
+#ifndef SWIGCOCOS
+    // per-instance attributes of the merged sub-models, copied to the staging arena on upload
+    ccstd::vector<const uint8_t *> sources;
+#endif
 };
 using InstancedItemList = ccstd::vector<InstancedItem>;
 using DynamicOffsetList = ccstd::vector<uint32_t>;
 
+struct CC_DLL InstancingStatistics {
+    uint32_t getDrawCallsSaved() const { return numInstances - numDrawCalls; }
+
+    uint32_t numInstances{0};
+    uint32_t numDrawCalls{0};
+    uint32_t numBufferResizes{0};
+    uint32_t uploadedBytes{0};
+};
+
 class InstancedBuffer : public RefCounted {
 public:
     static constexpr uint32_t INITIAL_CAPACITY = 32;
@@ -66,7 +79,7 @@ public:
     void destroy();
     void merge(scene::SubModel *, uint32_t);
     void merge(scene::SubModel *, uint32_t, gfx::Shader *);
-    void uploadBuffers(gfx::CommandBuffer *cmdBuff) const;
+    void uploadBuffers(gfx::CommandBuffer *cmdBuff, InstancingStatistics *statistics = nullptr);
     void clear();
     void setDynamicOffset(uint32_t idx, uint32_t value);
 
@@ -82,6 +95,8 @@ private:
     const scene::Pass *_pass{nullptr};
     bool _hasPendingModels{false};
     DynamicOffsetList _dynamicOffsets;
+    // instance data of all items is packed here before upload, reused across frames
+    ccstd::vector<uint8_t> _staging;
     // weak reference
     gfx::Device *_device{nullptr};
 };
@@ -46,25 +46,26 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::
         hash = hash << subpass;
     }
 
-    auto *pso = psoHashMap[static_cast<ccstd::hash_t>(hash)].get();
-    if (!pso) {
-        auto *pipelineLayout = pass->getPipelineLayout();
-
-        pso = gfx::Device::getInstance()->createPipelineState({shader,
-                                                               pipelineLayout,
-                                                               renderPass,
-                                                               {inputAssembler->getAttributes()},
-                                                               *(pass->getRasterizerState()),
-                                                               *(pass->getDepthStencilState()),
-                                                               *(pass->getBlendState()),
-                                                               pass->getPrimitive(),
-                                                               pass->getDynamicStates(),
-                                                               gfx::PipelineBindPoint::GRAPHICS,
-                                                               subpass});
-
-        psoHashMap[static_cast<ccstd::hash_t>(hash)] = pso;
+    // lookups of cached states never insert, so they may run concurrently once all states exist
+    auto iter = psoHashMap.find(static_cast<ccstd::hash_t>(hash));
+    if (iter != psoHashMap.end() && iter->second) {
+        return iter->second.get();
     }
 
+    auto *pipelineLayout = pass->getPipelineLayout();
+    auto *pso = gfx::Device::getInstance()->createPipelineState({shader,
+                                                                 pipelineLayout,
+                                                                 renderPass,
+                                                                 {inputAssembler->getAttributes()},
+                                                                 *(pass->getRasterizerState()),
+                                                                 *(pass->getDepthStencilState()),
+                                                                 *(pass->getBlendState()),
+                                                                 pass->getPrimitive(),
+                                                                 pass->getDynamicStates(),
+                                                                 gfx::PipelineBindPoint::GRAPHICS,
+                                                                 subpass});
+    psoHashMap[static_cast<ccstd::hash_t>(hash)] = pso;
+
     return pso;
 }
 
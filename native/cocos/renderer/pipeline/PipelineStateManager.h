@@ -35,6 +35,8 @@ namespace pipeline {
 
 class CC_DLL PipelineStateManager {
 public:
+    // Lookups of existing states are safe from several threads as long as none of them creates a state.
+    // Creation goes through the device and must stay on the thread that owns it.
     static gfx::PipelineState *getOrCreatePipelineState(const scene::Pass *pass,
                                                         gfx::Shader *shader,
                                                         gfx::InputAssembler *inputAssembler,
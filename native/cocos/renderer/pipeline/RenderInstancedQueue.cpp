@@ -25,6 +25,7 @@
 #include "RenderInstancedQueue.h"
 #include "InstancedBuffer.h"
 #include "PipelineStateManager.h"
+#include "RenderPipeline.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
 #include "gfx-base/GFXDevice.h"
@@ -50,9 +51,11 @@ void RenderInstancedQueue::sort() {
 }
 
 void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
+    auto *pipeline = RenderPipeline::getInstance();
+    auto *statistics = pipeline ? &pipeline->getInstancingStatistics() : nullptr;
     for (auto *instanceBuffer : _queues) {
         if (instanceBuffer->hasPendingModels()) {
-            instanceBuffer->uploadBuffers(cmdBuffer);
+            instanceBuffer->uploadBuffers(cmdBuffer, statistics);
         }
     }
 }
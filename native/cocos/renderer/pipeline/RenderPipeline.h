@@ -25,6 +25,7 @@
 #pragma once
 
 #include "Define.h"
+#include "InstancedBuffer.h"
 #include "RenderFlow.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
@@ -140,6 +141,10 @@ public:
 #endif
     }
 
+    // instanced batches uploaded by the legacy render queues, reset when a frame starts
+    inline const InstancingStatistics &getInstancingStatistics() const { return _instancingStatistics; }
+    inline InstancingStatistics &getInstancingStatistics() { return _instancingStatistics; }
+
     inline void resetRenderQueue(bool reset) { _resetRenderQueue = reset; }
     inline bool isRenderQueueReset() const { return _resetRenderQueue; }
 
@@ -203,6 +208,8 @@ protected:
 
     bool _resetRenderQueue{true};
 
+    InstancingStatistics _instancingStatistics;
+
     render::PipelineRuntime *_pipelineRuntime{nullptr};
 };
 
@@ -464,6 +464,10 @@ struct FrameGraphDispatcher {
 
     void run();
 
+    // hash of every render graph, resource graph and layout graph input that run() reads,
+    // an unchanged hash means the compiled barriers, render pass infos and aliasing plan can be reused
+    ccstd::hash_t computeStructuralHash() const;
+
     const BarrierNode& getBarrier(RenderGraph::vertex_descriptor u) const;
 
     const ResourceAccessNode& getAccessNode(RenderGraph::vertex_descriptor u) const;
@@ -497,6 +501,7 @@ struct FrameGraphDispatcher {
     bool _enableMemoryAliasing{false};
     bool _accessGraphBuilt{false};
     float _paralellExecWeight{0.0F};
+    ccstd::hash_t structuralHash{0};
 };
 
 } // namespace render
@@ -123,6 +123,132 @@ ResourceGraph::vertex_descriptor FrameGraphDispatcher::realResourceID(const ccst
     return resourceAccessGraph.resourceIndex.at(name);
 }
 
+namespace {
+
+template <typename Pair>
+void hashCopyTarget(ccstd::hash_t &seed, const Pair &pair) {
+    ccstd::hash_combine(seed, pair.target);
+    ccstd::hash_combine(seed, pair.mipLevels);
+    ccstd::hash_combine(seed, pair.numSlices);
+    ccstd::hash_combine(seed, pair.targetMostDetailedMip);
+    ccstd::hash_combine(seed, pair.targetFirstSlice);
+    ccstd::hash_combine(seed, pair.targetPlaneSlice);
+}
+
+void hashPass(ccstd::hash_t &seed, RenderGraph::vertex_descriptor v, const RenderGraph &rg) {
+    visitObject(
+        v, rg,
+        [&](const RasterPass &pass) {
+            ccstd::hash_combine(seed, pass);
+        },
+        [&](const RasterSubpass &subpass) {
+            ccstd::hash_combine(seed, subpass.rasterViews);
+            ccstd::hash_combine(seed, subpass.computeViews);
+            ccstd::hash_combine(seed, subpass.resolvePairs);
+            ccstd::hash_combine(seed, subpass.subpassID);
+            ccstd::hash_combine(seed, subpass.count);
+            ccstd::hash_combine(seed, subpass.quality);
+        },
+        [&](const ComputeSubpass &subpass) {
+            ccstd::hash_combine(seed, subpass.rasterViews);
+            ccstd::hash_combine(seed, subpass.computeViews);
+            ccstd::hash_combine(seed, subpass.subpassID);
+        },
+        [&](const ComputePass &pass) {
+            ccstd::hash_combine(seed, pass.computeViews);
+            ccstd::hash_combine(seed, pass.textures);
+        },
+        [&](const ResolvePass &pass) {
+            ccstd::hash_combine(seed, pass.resolvePairs);
+        },
+        [&](const CopyPass &pass) {
+            for (const auto &pair : pass.copyPairs) {
+                ccstd::hash_combine(seed, pair.source);
+                ccstd::hash_combine(seed, pair.sourceMostDetailedMip);
+                ccstd::hash_combine(seed, pair.sourceFirstSlice);
+                ccstd::hash_combine(seed, pair.sourcePlaneSlice);
+                hashCopyTarget(seed, pair);
+            }
+            for (const auto &pair : pass.uploadPairs) {
+                hashCopyTarget(seed, pair);
+            }
+        },
+        [&](const MovePass &pass) {
+            for (const auto &pair : pass.movePairs) {
+                ccstd::hash_combine(seed, pair.source);
+                hashCopyTarget(seed, pair);
+            }
+        },
+        [&](const RaytracePass &pass) {
+            ccstd::hash_combine(seed, pass.computeViews);
+        },
+        [&](const RenderQueue &queue) {
+            ccstd::hash_combine(seed, queue.hint);
+            ccstd::hash_combine(seed, queue.phaseID);
+        },
+        [&](const auto & /*others*/) {
+            // scene, blit, dispatch, clear and viewport nodes do not change resource access
+        });
+}
+
+} // namespace
+
+ccstd::hash_t FrameGraphDispatcher::computeStructuralHash() const {
+    ccstd::hash_t seed = 0;
+    ccstd::hash_combine(seed, &layoutGraph);
+    ccstd::hash_combine(seed, _enablePassReorder);
+    ccstd::hash_combine(seed, _enableMemoryAliasing);
+    ccstd::hash_combine(seed, _paralellExecWeight);
+
+    // render graph: node types, names, layouts, hierarchy, dependencies and pass views
+    ccstd::hash_combine(seed, num_vertices(renderGraph));
+    for (const auto v : makeRange(vertices(renderGraph))) {
+        ccstd::hash_combine(seed, renderGraph._vertices[v].handle.index());
+        ccstd::hash_combine(seed, get(RenderGraph::NameTag{}, renderGraph, v));
+        ccstd::hash_combine(seed, get(RenderGraph::LayoutTag{}, renderGraph, v));
+        ccstd::hash_combine(seed, parent(v, renderGraph));
+        for (const auto e : makeRange(out_edges(v, renderGraph))) {
+            ccstd::hash_combine(seed, target(e, renderGraph));
+        }
+        hashPass(seed, v, renderGraph);
+    }
+    ccstd::hash_combine(seed, renderGraph.sortedVertices);
+
+    // resource graph: descriptors, residency, view hierarchy and the access state the frame starts with
+    ccstd::hash_combine(seed, num_vertices(resourceGraph));
+    for (const auto v : makeRange(vertices(resourceGraph))) {
+        const auto &desc = get(ResourceGraph::DescTag{}, resourceGraph, v);
+        ccstd::hash_combine(seed, resourceGraph._vertices[v].handle.index());
+        ccstd::hash_combine(seed, get(ResourceGraph::NameTag{}, resourceGraph, v));
+        ccstd::hash_combine(seed, desc.dimension);
+        ccstd::hash_combine(seed, desc.width);
+        ccstd::hash_combine(seed, desc.height);
+        ccstd::hash_combine(seed, desc.depthOrArraySize);
+        ccstd::hash_combine(seed, desc.mipLevels);
+        ccstd::hash_combine(seed, desc.format);
+        ccstd::hash_combine(seed, desc.sampleCount);
+        ccstd::hash_combine(seed, desc.textureFlags);
+        ccstd::hash_combine(seed, desc.flags);
+        ccstd::hash_combine(seed, desc.viewType);
+        ccstd::hash_combine(seed, get(ResourceGraph::TraitsTag{}, resourceGraph, v).residency);
+        ccstd::hash_combine(seed, get(ResourceGraph::StatesTag{}, resourceGraph, v).states);
+        ccstd::hash_combine(seed, parent(v, resourceGraph));
+        if (holds<SubresourceViewTag>(v, resourceGraph)) {
+            const auto &view = get(SubresourceViewTag{}, v, resourceGraph);
+            ccstd::hash_combine(seed, view.format);
+            ccstd::hash_combine(seed, view.indexOrFirstMipLevel);
+            ccstd::hash_combine(seed, view.numMipLevels);
+            ccstd::hash_combine(seed, view.firstArraySlice);
+            ccstd::hash_combine(seed, view.numArraySlices);
+            ccstd::hash_combine(seed, view.firstPlane);
+            ccstd::hash_combine(seed, view.numPlanes);
+        } else if (holds<FormatViewTag>(v, resourceGraph)) {
+            ccstd::hash_combine(seed, get(FormatViewTag{}, v, resourceGraph).format);
+        }
+    }
+    return seed;
+}
+
 [[nodiscard]] ccstd::pmr::string concatResName(
     std::string_view name0,
     std::string_view name1,
@@ -22,6 +22,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <chrono>
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/filtered_graph.hpp>
 #include "FGDispatcherGraphs.h"
@@ -32,6 +33,7 @@
 #include "PrivateTypes.h"
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
+#include "cocos/base/job-system/JobSystem.h"
 #include "cocos/renderer/gfx-base/GFXDef-common.h"
 #include "cocos/renderer/gfx-base/GFXDevice.h"
 #include "cocos/renderer/pipeline/Define.h"
@@ -147,6 +149,23 @@ PersistentRenderPassAndFramebuffer createPersistentRenderPassAndFramebuffer(
     return data;
 }
 
+// Pooled textures of a resource may change between frames, the framebuffer must attach the mounted ones.
+bool isFramebufferCurrent(RenderGraphVisitorContext& ctx, const gfx::Framebuffer& framebuffer) {
+    const auto& rag = ctx.fgd.resourceAccessGraph;
+    const auto ragVertID = rag.passIndex.at(ctx.currentInFlightPassID);
+    const auto& info = get(ResourceAccessGraph::RenderPassInfoTag{}, rag, ragVertID);
+    const auto& colors = framebuffer.getColorTextures();
+    for (const auto& viewName : info.orderedViews) {
+        const auto* texture = ctx.resourceGraph.getTexture(rag.resourceIndex.at(viewName));
+        if (std::find(colors.begin(), colors.end(), texture) == colors.end() &&
+            texture != framebuffer.getDepthStencilTexture() &&
+            texture != framebuffer.getDepthStencilResolveTexture()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 PersistentRenderPassAndFramebuffer& fetchOrCreateFramebuffer(
     RenderGraphVisitorContext& ctx, const RasterPass& pass,
     boost::container::pmr::memory_resource* scratch) {
@@ -156,6 +175,8 @@ PersistentRenderPassAndFramebuffer& fetchOrCreateFramebuffer(
         std::tie(iter, added) = ctx.resourceGraph.renderPasses.emplace(
             pass, createPersistentRenderPassAndFramebuffer(ctx, pass, scratch));
         CC_ENSURES(added);
+    } else if (!isFramebufferCurrent(ctx, *iter->second.framebuffer)) {
+        iter->second = createPersistentRenderPassAndFramebuffer(ctx, pass, scratch);
     }
     return iter->second;
 }
@@ -359,7 +380,31 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
             bufferBarriers.data(), buffers.data(), static_cast<uint32_t>(bufferBarriers.size()),
             textureBarriers.data(), textures.data(), static_cast<uint32_t>(textureBarriers.size()));
     }
+    // Pooled memory released by earlier passes was reacquired, their accesses must finish before it is rewritten.
+    void aliasBarrier() const {
+        constexpr auto prevAccesses =
+            gfx::AccessFlagBit::VERTEX_SHADER_READ_TEXTURE |
+            gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE |
+            gfx::AccessFlagBit::FRAGMENT_SHADER_READ_COLOR_INPUT_ATTACHMENT |
+            gfx::AccessFlagBit::FRAGMENT_SHADER_READ_DEPTH_STENCIL_INPUT_ATTACHMENT |
+            gfx::AccessFlagBit::COLOR_ATTACHMENT_WRITE |
+            gfx::AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE |
+            gfx::AccessFlagBit::COMPUTE_SHADER_READ_TEXTURE |
+            gfx::AccessFlagBit::COMPUTE_SHADER_READ_OTHER |
+            gfx::AccessFlagBit::COMPUTE_SHADER_WRITE |
+            gfx::AccessFlagBit::TRANSFER_READ |
+            gfx::AccessFlagBit::TRANSFER_WRITE;
+        constexpr auto nextAccesses =
+            gfx::AccessFlagBit::COLOR_ATTACHMENT_WRITE |
+            gfx::AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE |
+            gfx::AccessFlagBit::COMPUTE_SHADER_WRITE |
+            gfx::AccessFlagBit::TRANSFER_WRITE;
+        ctx.cmdBuff->pipelineBarrier(ctx.device->getGeneralBarrier({prevAccesses, nextAccesses}));
+    }
     void frontBarriers(RenderGraph::vertex_descriptor vertID) const {
+        if (ctx.resourceGraph.transientPool.takeAliasBarrier()) {
+            aliasBarrier();
+        }
         const auto& barrier = ctx.fgd.getBarrier(vertID);
         if (!barrier.frontBarriers.empty()) {
             submitBarriers(barrier.frontBarriers);
@@ -1054,6 +1099,173 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
     RenderGraphVisitorContext& ctx;
 };
 
+// Raster pass whose queues are recorded into secondary command buffers
+struct ParallelRasterPass {
+    RenderGraph::vertex_descriptor passID{RenderGraph::null_vertex()};
+    LayoutGraphData::vertex_descriptor layoutID{LayoutGraphData::null_vertex()};
+    // mounting later passes may recreate the cached framebuffer, so keep references instead of the cache entry
+    SecondaryRenderPass target;
+    uint32_t firstTask{0};
+    uint32_t numTasks{0};
+};
+
+struct ParallelQueueTask {
+    uint32_t passIndex{0};
+    RenderGraph::vertex_descriptor queueID{RenderGraph::null_vertex()};
+};
+
+// Records runs of consecutive raster passes in parallel, one secondary command buffer per queue.
+// Everything touching shared state (resource mounting, descriptor uploads, framebuffers,
+// pipeline states and barriers) stays on the calling thread and in graph order,
+// workers only translate already prepared queues into commands.
+class ParallelPassRecorder {
+public:
+    ParallelPassRecorder(RenderGraphVisitor& visitorIn, ccstd::vector<gfx::CommandBuffer*>& recordedIn)
+    : visitor(visitorIn), ctx(visitorIn.ctx), recorded(recordedIn) {}
+    ParallelPassRecorder(const ParallelPassRecorder&) = delete;
+    ParallelPassRecorder& operator=(const ParallelPassRecorder&) = delete;
+    ~ParallelPassRecorder() noexcept = default;
+
+    void add(RenderGraph::vertex_descriptor passID) {
+        const auto& pass = get(RasterPassTag{}, passID, ctx.g);
+        visitor.mountResources(pass);
+
+        auto& parallelPass = passes.emplace_back();
+        parallelPass.passID = passID;
+        {
+            const auto& layoutName = get(RenderGraph::LayoutTag{}, ctx.g, passID);
+            parallelPass.layoutID = locate(LayoutGraphData::null_vertex(), layoutName, ctx.lg);
+            ctx.currentPassLayoutID = parallelPass.layoutID;
+        }
+        NativePipeline::prepareDescriptors(ctx, passID);
+
+        ctx.currentInFlightPassID = passID;
+        {
+            const auto& data = fetchOrCreateFramebuffer(ctx, pass, ctx.scratch);
+            auto& target = parallelPass.target;
+            target.renderPass = data.renderPass;
+            target.framebuffer = data.framebuffer;
+            target.clearColors.assign(data.clearColors.begin(), data.clearColors.end());
+            target.clearDepth = data.clearDepth;
+            target.clearStencil = data.clearStencil;
+        }
+        auto* renderPass = parallelPass.target.renderPass.get();
+
+        auto vp = pass.viewport;
+        if (vp.width == 0 && vp.height == 0) {
+            vp.width = pass.width;
+            vp.height = pass.height;
+        }
+        parallelPass.target.scissor = gfx::Rect{0, 0, vp.width, vp.height};
+
+        // pipeline states are created here, workers only look them up
+        parallelPass.firstTask = static_cast<uint32_t>(tasks.size());
+        for (const auto e : makeRange(children(passID, ctx.g))) {
+            const auto queueID = target(e, ctx.g);
+            if (!ctx.validPasses[queueID]) {
+                continue;
+            }
+            for (const auto e2 : makeRange(children(queueID, ctx.g))) {
+                const auto sceneID = target(e2, ctx.g);
+                if (ctx.validPasses[sceneID]) {
+                    getRenderQueue(sceneID).preparePipelineStates(renderPass, 0);
+                }
+            }
+            tasks.emplace_back(ParallelQueueTask{static_cast<uint32_t>(passes.size() - 1), queueID});
+        }
+        parallelPass.numTasks = static_cast<uint32_t>(tasks.size()) - parallelPass.firstTask;
+        ctx.currentPass = nullptr;
+        ctx.currentPassLayoutID = LayoutGraphData::null_vertex();
+    }
+
+    void flush() {
+        if (passes.empty()) {
+            return;
+        }
+        auto& pool = ctx.ppl->secondaryCommandBuffers;
+        const auto first = recorded.size();
+        while (pool.size() < first + tasks.size()) {
+            pool.emplace_back(ctx.device->createCommandBuffer(
+                gfx::CommandBufferInfo{ctx.device->getQueue(), gfx::CommandBufferType::SECONDARY}));
+        }
+        for (size_t i = 0; i != tasks.size(); ++i) {
+            recorded.emplace_back(pool[first + i].get());
+        }
+        auto* const* cmdBuffs = recorded.data() + first;
+
+        recordSecondaryCommandBuffers(static_cast<uint32_t>(tasks.size()), [this, cmdBuffs](uint32_t taskID) {
+            recordQueue(tasks[taskID], cmdBuffs[taskID]);
+        });
+
+        // merge in graph order
+        for (const auto& pass : passes) {
+#if CC_DEBUG
+            ctx.cmdBuff->beginMarker(makeMarkerInfo(get(RenderGraph::NameTag{}, ctx.g, pass.passID).c_str(), RASTER_COLOR));
+#endif
+            visitor.frontBarriers(pass.passID);
+            executeSecondaryCommandBuffers(ctx.cmdBuff, pass.target, cmdBuffs + pass.firstTask, pass.numTasks);
+            visitor.rearBarriers(pass.passID);
+#if CC_DEBUG
+            ctx.cmdBuff->endMarker();
+#endif
+        }
+        passes.clear();
+        tasks.clear();
+    }
+
+private:
+    const NativeRenderQueue& getRenderQueue(RenderGraph::vertex_descriptor sceneID) const {
+        const auto& sceneCulling = ctx.context.sceneCulling;
+        const auto& queueDesc = sceneCulling.renderQueueIndex.at(sceneID);
+        return sceneCulling.renderQueues[queueDesc.renderQueueTarget.value];
+    }
+
+    // runs on a worker, must not allocate from ctx.scratch or create device objects
+    void recordQueue(const ParallelQueueTask& task, gfx::CommandBuffer* cmdBuff) const {
+        const auto& pass = passes[task.passIndex];
+        RenderGraphVisitorContext taskCtx{
+            ctx.context,
+            ctx.lg, ctx.g, ctx.resourceGraph,
+            ctx.fgd,
+            ctx.validPasses,
+            ctx.device, cmdBuff,
+            ctx.ppl,
+            ctx.renderGraphDescriptorSet,
+            ctx.profilerPerPassDescriptorSets,
+            ctx.perInstanceDescriptorSets,
+            ctx.programLib,
+            ctx.customContext,
+            boost::container::pmr::get_default_resource()};
+        taskCtx.currentPass = pass.target.renderPass.get();
+        taskCtx.currentPassLayoutID = pass.layoutID;
+        taskCtx.currentInFlightPassID = pass.passID;
+        RenderGraphVisitor taskVisitor{{}, taskCtx};
+
+        beginSecondaryCommandBuffer(cmdBuff, pass.target);
+        taskVisitor.tryBindPerPassDescriptorSet(pass.passID);
+
+        const auto& queue = get(QueueTag{}, task.queueID, ctx.g);
+        taskVisitor.begin(queue, task.queueID);
+        for (const auto e : makeRange(children(task.queueID, ctx.g))) {
+            const auto sceneID = target(e, ctx.g);
+            if (!ctx.validPasses[sceneID]) {
+                continue;
+            }
+            const auto& sceneData = get(SceneTag{}, sceneID, ctx.g);
+            taskVisitor.begin(sceneData, sceneID);
+            taskVisitor.end(sceneData, sceneID);
+        }
+        taskVisitor.end(queue, task.queueID);
+        cmdBuff->end();
+    }
+
+    RenderGraphVisitor& visitor;
+    RenderGraphVisitorContext& ctx;
+    ccstd::vector<gfx::CommandBuffer*>& recorded;
+    ccstd::vector<ParallelRasterPass> passes;
+    ccstd::vector<ParallelQueueTask> tasks;
+};
+
 struct RenderGraphCullVisitor : boost::dfs_visitor<> {
     void discover_vertex(
         // NOLINTNEXTLINE(misc-unused-parameters)
@@ -1106,12 +1318,17 @@ struct CommandSubmitter {
     CommandSubmitter& operator=(const CommandSubmitter&) = delete;
     ~CommandSubmitter() noexcept {
         primaryCommandBuffer->end();
+        // secondary command buffers must be translated before the primary buffer executes them
+        if (!secondaryCommandBuffers.empty()) {
+            device->flushCommands(secondaryCommandBuffers);
+        }
         device->flushCommands(cmdBuffers);
         device->getQueue()->submit(cmdBuffers);
     }
     gfx::Device* device = nullptr;
     const std::vector<gfx::CommandBuffer*>& cmdBuffers;
     gfx::CommandBuffer* primaryCommandBuffer = nullptr;
+    ccstd::vector<gfx::CommandBuffer*> secondaryCommandBuffers;
 };
 
 void extendResourceLifetime(const NativeRenderQueue& queue, ResourceGroup& group) {
@@ -1160,10 +1377,180 @@ void collectStatistics(const NativePipeline& ppl, PipelineStatistics& stats) {
             stats.numInstancingUniformBlocks += static_cast<uint32_t>(buffer->getInstances().size());
         }
     }
+    // transient resources
+    const auto& transient = ppl.resourceGraph.transientPool.getStatistics();
+    stats.numTransientTextures = transient.numTextures;
+    stats.numTransientBuffers = transient.numBuffers;
+    stats.numTransientAcquires = transient.numAcquires;
+    stats.numTransientReuses = transient.numReuses;
+    stats.numTransientEvictions = transient.numEvictions;
+    stats.peakTransientMemoryKB = static_cast<uint32_t>(transient.peakMemory >> 10);
+    stats.totalTransientMemoryKB = static_cast<uint32_t>(transient.totalMemory >> 10);
+}
+
+// Groups managed resources by the last top level pass accessing them,
+// they are returned to the transient pool once that pass is recorded.
+void collectTransientReleases(
+    const RenderGraph& rg, const FrameGraphDispatcher& fgd, const ResourceGraph& resg,
+    ccstd::pmr::unordered_map<RenderGraph::vertex_descriptor, ccstd::pmr::vector<ResourceGraph::vertex_descriptor>>& releases) {
+    auto* scratch = releases.get_allocator().resource();
+    ccstd::pmr::unordered_map<ResourceGraph::vertex_descriptor, RenderGraph::vertex_descriptor> lastUses(scratch);
+    const auto& resourceIndex = fgd.resourceAccessGraph.resourceIndex;
+    RenderGraph::vertex_descriptor passID = RenderGraph::null_vertex();
+    const auto use = [&](const ccstd::pmr::string& name) {
+        auto iter = resourceIndex.find(name);
+        if (iter == resourceIndex.end()) {
+            return;
+        }
+        // views keep their parent texture alive
+        for (auto resID = iter->second; resID != ResourceGraph::null_vertex(); resID = parent(resID, resg)) {
+            lastUses[resID] = passID;
+        }
+    };
+    const auto useSubpass = [&](const Subpass& subpass) {
+        for (const auto& [name, view] : subpass.rasterViews) {
+            use(name);
+        }
+        for (const auto& [name, views] : subpass.computeViews) {
+            use(name);
+        }
+        for (const auto& resolve : subpass.resolvePairs) {
+            use(resolve.target);
+        }
+    };
+    for (const auto vertID : rg.sortedVertices) {
+        passID = vertID;
+        if (holds<RasterPassTag>(vertID, rg)) {
+            const auto& pass = get(RasterPassTag{}, vertID, rg);
+            for (const auto& [name, view] : pass.rasterViews) {
+                use(name);
+            }
+            for (const auto& [name, views] : pass.computeViews) {
+                use(name);
+            }
+            for (const auto& subpass : pass.subpassGraph.subpasses) {
+                useSubpass(subpass);
+            }
+        } else if (holds<ComputeTag>(vertID, rg)) {
+            for (const auto& [name, views] : get(ComputeTag{}, vertID, rg).computeViews) {
+                use(name);
+            }
+        } else if (holds<CopyTag>(vertID, rg)) {
+            const auto& pass = get(CopyTag{}, vertID, rg);
+            for (const auto& pair : pass.copyPairs) {
+                use(pair.source);
+                use(pair.target);
+            }
+            for (const auto& pair : pass.uploadPairs) {
+                use(pair.target);
+            }
+        }
+    }
+    for (const auto& [resID, lastPassID] : lastUses) {
+        releases[lastPassID].emplace_back(resID);
+    }
 }
 
 } // namespace
 
+// Compilation may feed back into the resource graph, so a new graph usually compiles twice before it is cached.
+const FrameGraphDispatcher& compileRenderGraph(
+    std::unique_ptr<FrameGraphDispatcher>& cached,
+    ResourceGraph& resourceGraph, const RenderGraph& rg, const LayoutGraphData& lg,
+    boost::container::pmr::memory_resource* scratch, PipelineStatistics& statistics) {
+    ccstd::hash_t hash = 0;
+    bool hashed = false;
+    if (cached && &cached->renderGraph == &rg && &cached->layoutGraph == &lg && &cached->resourceGraph == &resourceGraph) {
+        hash = cached->computeStructuralHash();
+        hashed = true;
+        if (hash == cached->structuralHash) {
+            ++statistics.numRenderGraphCacheHits;
+            return *cached;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    cached.reset();
+    cached = std::make_unique<FrameGraphDispatcher>(
+        resourceGraph, rg,
+        lg, scratch, scratch);
+    cached->enableMemoryAliasing(false);
+    cached->enablePassReorder(false);
+    cached->setParalellWeight(0);
+    cached->structuralHash = hashed ? hash : cached->computeStructuralHash();
+    cached->run();
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    ++statistics.numRenderGraphCompiles;
+    statistics.renderGraphCompileMicroseconds = static_cast<uint32_t>(elapsed.count());
+    return *cached;
+}
+
+bool supportsParallelRecording(
+    const RenderGraph& g, const ccstd::pmr::vector<bool>& validPasses,
+    RenderGraph::vertex_descriptor passID) {
+    if (!holds<RasterPassTag>(passID, g)) {
+        return false;
+    }
+    const auto& pass = get(RasterPassTag{}, passID, g);
+    if (pass.showStatistics || !pass.subpassGraph.subpasses.empty()) {
+        return false;
+    }
+    if (!get(RenderGraph::DataTag{}, g, passID).custom.empty()) {
+        return false;
+    }
+    for (const auto e : makeRange(children(passID, g))) {
+        const auto queueID = target(e, g);
+        if (!validPasses[queueID]) {
+            continue;
+        }
+        if (!holds<QueueTag>(queueID, g) || !get(RenderGraph::DataTag{}, g, queueID).custom.empty()) {
+            return false;
+        }
+        for (const auto e2 : makeRange(children(queueID, g))) {
+            const auto sceneID = target(e2, g);
+            if (!validPasses[sceneID]) {
+                continue;
+            }
+            if (!holds<SceneTag>(sceneID, g)) {
+                return false;
+            }
+            const auto& sceneData = get(SceneTag{}, sceneID, g);
+            if (any(sceneData.flags & (SceneFlags::UI | SceneFlags::REFLECTION_PROBE))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void beginSecondaryCommandBuffer(gfx::CommandBuffer* cmdBuff, const SecondaryRenderPass& pass) {
+    cmdBuff->begin(pass.renderPass.get(), 0, pass.framebuffer.get());
+    gfx::Viewport viewport{};
+    viewport.width = pass.scissor.width;
+    viewport.height = pass.scissor.height;
+    cmdBuff->setViewport(viewport);
+    cmdBuff->setScissor(pass.scissor);
+}
+
+
+void recordSecondaryCommandBuffers(uint32_t count, const std::function<void(uint32_t)>& record) {
+    parallelFor(count, record);
+}
+
+void executeSecondaryCommandBuffers(
+    gfx::CommandBuffer* primary, const SecondaryRenderPass& pass,
+    gfx::CommandBuffer* const* cmdBuffs, uint32_t count) {
+    primary->beginRenderPass(
+        pass.renderPass.get(),
+        pass.framebuffer.get(),
+        pass.scissor, pass.clearColors.data(),
+        pass.clearDepth, pass.clearStencil,
+        cmdBuffs, count);
+    primary->execute(cmdBuffs, count);
+    primary->endRenderPass();
+}
+
 void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     auto& ppl = *this;
     auto* scratch = &ppl.unsyncPool;
@@ -1174,13 +1561,7 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     ResourceCleaner cleaner(ppl.resourceGraph);
 
     auto& lg = ppl.programLibrary->layoutGraph;
-    FrameGraphDispatcher fgd(
-        ppl.resourceGraph, rg,
-        lg, &ppl.unsyncPool, scratch);
-    fgd.enableMemoryAliasing(false);
-    fgd.enablePassReorder(false);
-    fgd.setParalellWeight(0);
-    fgd.run();
+    const auto& fgd = compileRenderGraph(ppl.compiledRenderGraph, ppl.resourceGraph, rg, lg, scratch, ppl.statistics);
 
     AddressableView<RenderGraph> graphView(rg);
     ccstd::pmr::vector<bool> validPasses(num_vertices(rg), true, scratch);
@@ -1250,13 +1631,18 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
 #endif
             // scene
             const auto& sceneCulling = ppl.nativeContext.sceneCulling;
+            pipeline::InstancingStatistics instancing;
             for (uint32_t queueID = 0; queueID != sceneCulling.numRenderQueues; ++queueID) {
                 // notice: we cannot use ranged-for of sceneCulling.renderQueues
                 CC_EXPECTS(sceneCulling.numRenderQueues <= sceneCulling.renderQueues.size());
                 const auto& queue = sceneCulling.renderQueues[queueID];
-                queue.opaqueInstancingQueue.uploadBuffers(submit.primaryCommandBuffer);
-                queue.transparentInstancingQueue.uploadBuffers(submit.primaryCommandBuffer);
+                queue.opaqueInstancingQueue.uploadBuffers(submit.primaryCommandBuffer, &instancing);
+                queue.transparentInstancingQueue.uploadBuffers(submit.primaryCommandBuffer, &instancing);
             }
+            ppl.statistics.numInstances = instancing.numInstances;
+            ppl.statistics.numInstancedDrawCalls = instancing.numDrawCalls;
+            ppl.statistics.numInstancingBufferResizes = instancing.numBufferResizes;
+            ppl.statistics.instancingUploadedBytes = instancing.uploadedBytes;
 
             // lights
             ctx.lightResources.buildLightBuffer(submit.primaryCommandBuffer);
@@ -1301,11 +1687,56 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
             },
             scratch};
 
+        // transient resources are returned to the pool after their last pass is recorded, later passes may alias them,
+        // RenderGraphVisitor::frontBarriers orders the aliasing writes after the previous accesses
+        ccstd::pmr::unordered_map<
+            RenderGraph::vertex_descriptor,
+            ccstd::pmr::vector<ResourceGraph::vertex_descriptor>>
+            transientReleases(scratch);
+        if (resourceGraph.transientPool.enableAliasing) {
+            collectTransientReleases(rg, fgd, resourceGraph, transientReleases);
+        }
+        const auto releaseTransientResources = [&](RenderGraph::vertex_descriptor vertID) {
+            auto iter = transientReleases.find(vertID);
+            if (iter != transientReleases.end()) {
+                for (const auto resID : iter->second) {
+                    resourceGraph.releaseTransient(resID);
+                }
+            }
+        };
+
         RenderGraphVisitor visitor{{}, ctx};
         auto colors = rg.colors(scratch);
-        for (const auto vertID : ctx.g.sortedVertices) {
-            if (holds<RasterPassTag>(vertID, ctx.g) || holds<ComputeTag>(vertID, ctx.g) || holds<CopyTag>(vertID, ctx.g)) {
-                boost::depth_first_visit(fg, vertID, visitor, get(colors, ctx.g));
+        if (enableMultithreadedRecording && JobSystem::getInstance()->threadCount() > 1) {
+            // consecutive eligible raster passes are recorded together, other passes flush them in order
+            ParallelPassRecorder recorder(visitor, submit.secondaryCommandBuffers);
+            // passes added to the recorder are recorded by flush, their resources are released after it
+            ccstd::pmr::vector<RenderGraph::vertex_descriptor> recordingPasses(scratch);
+            const auto flushRecorder = [&]() {
+                recorder.flush();
+                for (const auto passID : recordingPasses) {
+                    releaseTransientResources(passID);
+                }
+                recordingPasses.clear();
+            };
+            for (const auto vertID : ctx.g.sortedVertices) {
+                if (holds<RasterPassTag>(vertID, ctx.g) && validPasses[vertID] &&
+                    supportsParallelRecording(ctx.g, validPasses, vertID)) {
+                    recorder.add(vertID);
+                    recordingPasses.emplace_back(vertID);
+                } else if (holds<RasterPassTag>(vertID, ctx.g) || holds<ComputeTag>(vertID, ctx.g) || holds<CopyTag>(vertID, ctx.g)) {
+                    flushRecorder();
+                    boost::depth_first_visit(fg, vertID, visitor, get(colors, ctx.g));
+                    releaseTransientResources(vertID);
+                }
+            }
+            flushRecorder();
+        } else {
+            for (const auto vertID : ctx.g.sortedVertices) {
+                if (holds<RasterPassTag>(vertID, ctx.g) || holds<ComputeTag>(vertID, ctx.g) || holds<CopyTag>(vertID, ctx.g)) {
+                    boost::depth_first_visit(fg, vertID, visitor, get(colors, ctx.g));
+                    releaseTransientResources(vertID);
+                }
             }
         }
     }
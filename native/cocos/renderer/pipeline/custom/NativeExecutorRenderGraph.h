@@ -23,6 +23,8 @@
 ****************************************************************************/
 
 #pragma once
+#include <functional>
+#include <memory>
 #include "FGDispatcherTypes.h"
 #include "LayoutGraphTypes.h"
 #include "NativePipelineTypes.h"
@@ -76,6 +78,41 @@ struct RenderGraphVisitorContext {
     Mat4 currentProjMatrix;
 };
 
+// Reuses the dispatcher in cached while the render graph is structurally unchanged, otherwise compiles it again.
+// Cache hits, compiles and the time of the last compile are counted in statistics.
+const FrameGraphDispatcher& compileRenderGraph(
+    std::unique_ptr<FrameGraphDispatcher>& cached,
+    ResourceGraph& resourceGraph, const RenderGraph& rg, const LayoutGraphData& lg,
+    boost::container::pmr::memory_resource* scratch, PipelineStatistics& statistics);
+
+// Whether a raster pass can have its queues recorded into secondary command buffers on worker threads.
+// Passes with custom callbacks, subpasses, statistics, UI or reflection probe scenes are recorded inline.
+bool supportsParallelRecording(
+    const RenderGraph& g, const ccstd::pmr::vector<bool>& validPasses,
+    RenderGraph::vertex_descriptor passID);
+
+// Render pass continued by secondary command buffers.
+// Holds references, so the cached framebuffer may be replaced before the pass is executed.
+struct SecondaryRenderPass {
+    IntrusivePtr<gfx::RenderPass> renderPass;
+    IntrusivePtr<gfx::Framebuffer> framebuffer;
+    ccstd::vector<gfx::Color> clearColors;
+    float clearDepth{0};
+    uint8_t clearStencil{0};
+    gfx::Rect scissor;
+};
+
+// Begins a secondary command buffer inside the render pass, secondaries inherit no dynamic states.
+void beginSecondaryCommandBuffer(gfx::CommandBuffer* cmdBuff, const SecondaryRenderPass& pass);
+
+// Calls record(index) for each index in [0, count) with cc::parallelFor.
+void recordSecondaryCommandBuffers(uint32_t count, const std::function<void(uint32_t)>& record);
+
+// Begins the render pass on the primary command buffer and executes the recorded secondaries.
+void executeSecondaryCommandBuffers(
+    gfx::CommandBuffer* primary, const SecondaryRenderPass& pass,
+    gfx::CommandBuffer* const* cmdBuffs, uint32_t count);
+
 } // namespace render
 
 } // namespace cc
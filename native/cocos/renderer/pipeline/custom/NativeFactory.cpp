@@ -31,6 +31,7 @@
 #include "RenderingModule.h"
 #include "details/GslUtils.h"
 #include "pipeline/custom/details/Pmr.h"
+#include "platform/FileUtils.h"
 
 namespace cc {
 
@@ -54,6 +55,10 @@ RenderingModule* Factory::init(gfx::Device* deviceIn, const ccstd::vector<unsign
         load(ar, ptr->layoutGraph);
     }
     ptr->init(deviceIn);
+#if !CC_EDITOR
+    // variants used by earlier runs are precompiled when their effects load
+    ptr->setVariantManifestPath(FileUtils::getInstance()->getWritablePath() + "shader-variants.txt");
+#endif
 
     sRenderingModule = ccnew NativeRenderingModule(std::move(ptr));
     return sRenderingModule;
@@ -39,6 +39,7 @@ namespace render {
 
 struct ProgramInfo;
 struct ProgramGroup;
+struct ProgramVariantRequest;
 
 } // namespace render
 
@@ -1411,6 +1411,9 @@ bool NativePipeline::destroy() noexcept {
         pipelineSceneData->destroy();
         pipelineSceneData = {};
     }
+    compiledRenderGraph.reset();
+    secondaryCommandBuffers.clear();
+    resourceGraph.transientPool.clear();
     pipeline::PipelineStateManager::destroyAll();
     return true;
 }
@@ -1421,6 +1424,9 @@ void NativePipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     auto *commandBuffer = device->getCommandBuffer();
 
     executeRenderGraph(renderGraph);
+
+    // variants compiled this frame are appended to the manifest off-thread
+    programLibrary->flushVariantManifest();
 }
 
 const MacroRecord &NativePipeline::getMacros() const {
@@ -72,6 +72,7 @@ class NativeComputeQueueBuilder;
 class NativeComputePassBuilder;
 struct RenderInstancingQueue;
 struct DrawInstance;
+struct InstancingDraw;
 struct ProbeHelperQueue;
 struct RenderDrawQueue;
 struct NativeRenderQueue;
@@ -205,6 +205,7 @@ SceneCulling::SceneCulling(SceneCulling&& rhs, const allocator_type& alloc)
   lightBoundsCullingResults(std::move(rhs.lightBoundsCullingResults), alloc),
   renderQueues(std::move(rhs.renderQueues), alloc),
   renderQueueIndex(std::move(rhs.renderQueueIndex), alloc),
+  pendingInstancingDraws(std::move(rhs.pendingInstancingDraws)),
   numFrustumCulling(rhs.numFrustumCulling),
   numLightBoundsCulling(rhs.numLightBoundsCulling),
   numRenderQueues(rhs.numRenderQueues),
@@ -38,6 +38,7 @@
 #include "cocos/renderer/gfx-base/GFXRenderPass.h"
 #include "cocos/renderer/pipeline/GlobalDescriptorSetManager.h"
 #include "cocos/renderer/pipeline/InstancedBuffer.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherTypes.h"
 #include "cocos/renderer/pipeline/custom/NativePipelineFwd.h"
 #include "cocos/renderer/pipeline/custom/NativeTypes.h"
 #include "cocos/renderer/pipeline/custom/details/Map.h"
@@ -1000,7 +1001,8 @@ struct RenderInstancingQueue {
     void clear();
     void add(const scene::Pass& pass, scene::SubModel& submodel, uint32_t passID);
     void sort();
-    void uploadBuffers(gfx::CommandBuffer *cmdBuffer) const;
+    void uploadBuffers(gfx::CommandBuffer *cmdBuffer, pipeline::InstancingStatistics *statistics = nullptr) const;
+    void preparePipelineStates(gfx::RenderPass *renderPass, uint32_t subpassIndex) const;
     void recordCommandBuffer(
         gfx::RenderPass *renderPass, uint32_t subpassIndex,
         gfx::CommandBuffer *cmdBuffer,
@@ -1018,6 +1020,14 @@ struct DrawInstance {
     float depth{0};
     uint32_t shaderID{0};
     uint32_t passIndex{0};
+    uint64_t sortKey{0}; // hash in the high word, depth as an ordered integer in the low word
+};
+
+struct InstancingDraw {
+    const scene::Pass* pass{nullptr};
+    scene::SubModel* subModel{nullptr};
+    uint32_t passIndex{0};
+    bool transparent{false};
 };
 
 struct ProbeHelperQueue {
@@ -1065,9 +1075,11 @@ struct RenderDrawQueue {
     RenderDrawQueue& operator=(RenderDrawQueue&& rhs) = default;
     RenderDrawQueue& operator=(RenderDrawQueue const& rhs) = default;
 
+    static uint64_t makeSortKey(uint32_t hash, float depth);
     void add(const scene::Model& model, float depth, uint32_t subModelIdx, uint32_t passIdx);
     void sortOpaqueOrCutout();
     void sortTransparent();
+    void preparePipelineStates(gfx::RenderPass *renderPass, uint32_t subpassIndex) const;
     void recordCommandBuffer(
         gfx::RenderPass *renderPass, uint32_t subpassIndex,
         gfx::CommandBuffer *cmdBuffer,
@@ -1094,6 +1106,7 @@ struct NativeRenderQueue {
     void sort();
     void clear() noexcept;
     bool empty() const noexcept;
+    void preparePipelineStates(gfx::RenderPass *renderPass, uint32_t subpassIndex) const;
     void recordCommands(
         gfx::CommandBuffer *cmdBuffer, gfx::RenderPass *renderPass, uint32_t subpassIndex) const;
 
@@ -1416,6 +1429,7 @@ public:
     ccstd::pmr::vector<LightBoundsCullingResult> lightBoundsCullingResults;
     ccstd::pmr::vector<NativeRenderQueue> renderQueues;
     PmrFlatMap<RenderGraph::vertex_descriptor, NativeRenderQueueDesc> renderQueueIndex;
+    ccstd::vector<ccstd::vector<InstancingDraw>> pendingInstancingDraws;
     uint32_t numFrustumCulling{0};
     uint32_t numLightBoundsCulling{0};
     uint32_t numRenderQueues{0};
@@ -1511,6 +1525,8 @@ public:
     void init(gfx::Device* deviceIn);
     void setPipeline(PipelineRuntime* pipelineIn);
     void destroy();
+    void setVariantManifestPath(const ccstd::string& path);
+    void flushVariantManifest();
 
     LayoutGraphData layoutGraph;
     PmrFlatMap<uint32_t, ProgramGroup> phases;
@@ -1523,6 +1539,9 @@ public:
     IntrusivePtr<gfx::PipelineLayout> emptyPipelineLayout;
     PipelineRuntime* pipeline{nullptr};
     gfx::Device* device{nullptr};
+    ccstd::string variantManifestPath;
+    ccstd::string pendingManifestLines;
+    ccstd::vector<ProgramVariantRequest> manifestVariants;
 };
 
 struct PipelineCustomization {
@@ -1698,6 +1717,11 @@ public:
     mutable PmrFlatMap<BuiltinCascadedShadowMapKey, BuiltinCascadedShadowMap> builtinCSMs;
     PipelineStatistics statistics;
     PipelineCustomization custom;
+    // dispatcher of the last compiled render graph, reused while its structural hash matches
+    std::unique_ptr<FrameGraphDispatcher> compiledRenderGraph;
+    // record eligible raster passes into secondary command buffers on the job system
+    bool enableMultithreadedRecording{false};
+    ccstd::vector<IntrusivePtr<gfx::CommandBuffer>> secondaryCommandBuffers;
 };
 
 class NativeProgramProxy final : public ProgramProxy {
@@ -26,7 +26,10 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/container/pmr/global_resource.hpp>
 #include <boost/container/pmr/memory_resource.hpp>
+#include <algorithm>
 #include <cctype>
+#include <fstream>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
@@ -37,6 +40,8 @@
 #include "ProgramLib.h"
 #include "base/Ptr.h"
 #include "cocos/base/Log.h"
+#include "cocos/base/ThreadPool.h"
+#include "cocos/base/job-system/JobSystem.h"
 #include "cocos/core/assets/EffectAsset.h"
 #include "cocos/renderer/core/ProgramUtils.h"
 #include "cocos/renderer/gfx-base/GFXDef-common.h"
@@ -1150,6 +1155,179 @@ ccstd::hash_t getShaderHash(ccstd::hash_t src, const T &val) {
     return src;
 }
 
+// variant table key, programs are interned per phase and macros are packed into bits
+constexpr uint64_t makeVariantTableKey(uint32_t programIndex, uint32_t bits) {
+    return (static_cast<uint64_t>(programIndex) << 32) | bits;
+}
+
+void populateVariantShaderInfo(
+    const ccstd::string &layoutConstantMacros,
+    const ProgramInfo &info, const ccstd::string &name,
+    const MacroRecord &defines, gfx::Device *device,
+    gfx::ShaderInfo &shaderInfo) {
+    const auto &programInfo = info.programInfo;
+
+    // prepare defines
+    ccstd::vector<IMacroInfo> macroArray = render::prepareDefines(defines, programInfo.defines);
+    std::string prefix;
+    prefix += layoutConstantMacros;
+    prefix += programInfo.constantMacros;
+    prefix += '\n';
+    for (const auto &m : macroArray) {
+        prefix += "#define ";
+        prefix += m.name;
+        prefix += ' ';
+        prefix += m.value;
+        prefix += '\n';
+    }
+
+    const IShaderSource *src = &programInfo.glsl3;
+    const auto *deviceShaderVersion = getDeviceShaderVersion(device);
+    if (deviceShaderVersion) {
+        src = programInfo.getSource(deviceShaderVersion);
+    } else {
+        CC_LOG_ERROR("Invalid GFX API!");
+    }
+
+    if (src->compute) {
+        shaderInfo.stages.clear();
+        shaderInfo.stages.emplace_back(
+            gfx::ShaderStage{
+                gfx::ShaderStageFlagBit::COMPUTE,
+                prefix + *src->compute});
+    } else {
+        shaderInfo.stages[0].source = prefix + src->vert;
+        shaderInfo.stages[1].source = prefix + src->frag;
+    }
+
+    // strip out the active attributes only, instancing depend on this
+    shaderInfo.attributes = getActiveAttributes(programInfo, info.attributes, defines);
+
+    shaderInfo.name = getShaderInstanceName(name, macroArray);
+    shaderInfo.hash = getShaderHash(programInfo.hash, prefix);
+}
+
+ProgramProxy *addProgramVariant(
+    ProgramGroup &phase, std::string_view key, IntrusivePtr<gfx::Shader> shader) {
+    auto res = phase.programProxies.emplace(
+        key,
+        IntrusivePtr<ProgramProxy>(new NativeProgramProxy(std::move(shader))));
+    CC_ENSURES(res.second);
+    return res.first->second.get();
+}
+
+// Newly compiled variants are buffered and appended to the manifest by
+// flushVariantManifest(), the file is never touched while compiling.
+void recordProgramVariant(
+    NativeProgramLibrary &lib, uint32_t phaseID,
+    const ccstd::string &programName, const IProgramInfo &programInfo,
+    const MacroRecord &defines) {
+    if (lib.variantManifestPath.empty()) {
+        return;
+    }
+    lib.pendingManifestLines += formatVariantManifestLine(
+        phaseID, ccstd::string(get(LayoutGraphData::NameTag{}, lib.layoutGraph, phaseID)),
+        programName, programInfo, defines);
+}
+
+bool parseProgramVariant(
+    const NativeProgramLibrary &lib, const ccstd::string &line,
+    ProgramVariantRequest &request) {
+    uint32_t phaseID = 0;
+    ccstd::string phaseName;
+    if (!parseVariantManifestLine(line, phaseID, phaseName, request.programName, request.defines)) {
+        return false;
+    }
+    if (phaseID >= num_vertices(lib.layoutGraph) ||
+        !holds<RenderPhaseTag>(phaseID, lib.layoutGraph) ||
+        std::string_view{get(LayoutGraphData::NameTag{}, lib.layoutGraph, phaseID)} != phaseName) {
+        return false; // layout graph changed since the manifest was written
+    }
+    request.phaseID = phaseID;
+    return true;
+}
+
+struct ProgramVariantTask {
+    ProgramGroup *phase{nullptr};
+    const ProgramInfo *info{nullptr};
+    const ProgramVariantRequest *request{nullptr};
+    MacroRecord defines;
+    gfx::ShaderInfo shaderInfo;
+};
+
+// Shader sources are assembled on the job system, gfx shaders are created
+// on the calling thread afterwards. The requests come from the manifest and
+// are not recorded again.
+uint32_t compileProgramVariants(
+    NativeProgramLibrary &lib, gfx::Device *device,
+    const ccstd::vector<ProgramVariantRequest> &requests) {
+    ccstd::vector<ProgramVariantTask> tasks;
+    tasks.reserve(requests.size());
+    for (const auto &request : requests) {
+        auto iter = lib.phases.find(request.phaseID);
+        if (iter == lib.phases.end()) {
+            CC_LOG_WARNING("phase %u not found", request.phaseID);
+            continue;
+        }
+        auto &phase = iter->second;
+        auto iter2 = phase.programInfos.find(std::string_view{request.programName});
+        if (iter2 == phase.programInfos.end()) {
+            CC_LOG_WARNING("program %s not found", request.programName.c_str());
+            continue;
+        }
+        const auto &info = iter2->second;
+        auto &task = tasks.emplace_back();
+        task.phase = &phase;
+        task.info = &info;
+        task.request = &request;
+        task.defines = request.defines;
+        if (lib.pipeline) {
+            for (const auto &it : lib.pipeline->getMacros()) {
+                task.defines[it.first] = it.second;
+            }
+        }
+        bool compiled = false;
+        if (info.programInfo.uber) {
+            const auto key = getVariantKey(info.programInfo, task.defines);
+            compiled = phase.programProxies.find(std::string_view{key}) != phase.programProxies.end();
+        } else {
+            const auto bits = getVariantBits(info.programInfo, task.defines);
+            compiled = phase.variantTable.find(makeVariantTableKey(info.programIndex, bits)) != nullptr;
+        }
+        if (compiled) {
+            tasks.pop_back();
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(tasks.size());
+    auto prepare = [&](uint32_t i) {
+        auto &task = tasks[i];
+        task.shaderInfo = task.info->shaderInfo;
+        populateVariantShaderInfo(
+            lib.layoutGraph.constantMacros, *task.info, task.request->programName,
+            task.defines, device, task.shaderInfo);
+    };
+    parallelFor(count, prepare);
+
+    uint32_t numCompiled = 0;
+    for (auto &task : tasks) {
+        const auto &programInfo = task.info->programInfo;
+        const auto key = getVariantKey(programInfo, task.defines);
+        if (task.phase->programProxies.find(std::string_view{key}) != task.phase->programProxies.end()) {
+            continue; // duplicated request
+        }
+        IntrusivePtr<gfx::Shader> shader = device->createShader(task.shaderInfo);
+        auto *proxy = addProgramVariant(*task.phase, key, std::move(shader));
+        if (!programInfo.uber) {
+            task.phase->variantTable.emplace(
+                makeVariantTableKey(task.info->programIndex, getVariantBits(programInfo, task.defines)),
+                proxy);
+        }
+        ++numCompiled;
+    }
+    return numCompiled;
+}
+
 } // namespace
 
 void NativeProgramLibrary::init(gfx::Device *deviceIn) {
@@ -1242,10 +1420,47 @@ void NativeProgramLibrary::setPipeline(PipelineRuntime *pipelineIn) {
 }
 
 void NativeProgramLibrary::destroy() {
+    flushVariantManifest();
     emptyDescriptorSetLayout.reset();
     emptyPipelineLayout.reset();
 }
 
+void NativeProgramLibrary::setVariantManifestPath(const ccstd::string &path) {
+    flushVariantManifest();
+    variantManifestPath = path;
+    manifestVariants.clear();
+    if (path.empty()) {
+        return;
+    }
+    std::ifstream ifs(path.c_str(), std::ios::binary);
+    ccstd::string line;
+    while (std::getline(ifs, line)) {
+        ProgramVariantRequest request;
+        if (!line.empty() && parseProgramVariant(*this, line, request)) {
+            manifestVariants.emplace_back(std::move(request));
+        }
+    }
+}
+
+void NativeProgramLibrary::flushVariantManifest() {
+    if (pendingManifestLines.empty()) {
+        return;
+    }
+    // appended on a worker thread, the mutex keeps concurrent flushes from interleaving
+    static std::mutex fileMutex;
+    LegacyThreadPool::getDefaultThreadPool()->pushTask(
+        [path = variantManifestPath, lines = std::move(pendingManifestLines)](int /*tid*/) {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            std::ofstream ofs(path.c_str(), std::ios::app | std::ios::binary);
+            if (!ofs) {
+                CC_LOG_WARNING("variant manifest %s cannot be written", path.c_str());
+                return;
+            }
+            ofs << lines;
+        });
+    pendingManifestLines.clear();
+}
+
 void NativeProgramLibrary::addEffect(const EffectAsset *effectAssetIn) {
     auto &lg = layoutGraph;
     boost::container::pmr::memory_resource *scratch = &unsycPool;
@@ -1316,6 +1531,7 @@ void NativeProgramLibrary::addEffect(const EffectAsset *effectAssetIn) {
             }
 
             // create programInfo
+            const auto programIndex = static_cast<uint32_t>(phasePrograms.size());
             auto res = phasePrograms.emplace(
                 std::piecewise_construct,
                 std::forward_as_tuple(srcShaderInfo.name),
@@ -1326,12 +1542,29 @@ void NativeProgramLibrary::addEffect(const EffectAsset *effectAssetIn) {
                     std::move(blockSizes),
                     std::move(handleMap)));
             CC_ENSURES(res.second);
+            res.first->second.programIndex = programIndex;
         }
     }
 }
 
 void NativeProgramLibrary::precompileEffect(gfx::Device *device, EffectAsset *effectAsset) {
-    // noop
+    // compile the variants of this effect recorded by earlier runs
+    ccstd::vector<ProgramVariantRequest> requests;
+    auto iter = std::remove_if(
+        manifestVariants.begin(), manifestVariants.end(),
+        [&](const ProgramVariantRequest &request) {
+            for (const auto &shader : effectAsset->_shaders) {
+                if (shader.name == request.programName) {
+                    requests.emplace_back(request);
+                    return true;
+                }
+            }
+            return false;
+        });
+    manifestVariants.erase(iter, manifestVariants.end());
+    if (!requests.empty()) {
+        compileProgramVariants(*this, device, requests);
+    }
 }
 
 ccstd::string NativeProgramLibrary::getKey(
@@ -1471,6 +1704,16 @@ ProgramProxy *NativeProgramLibrary::getProgramVariant(
 
     const auto &programInfo = info.programInfo;
 
+    // non-uber programs are looked up by packed macro bits, no string key is built
+    uint32_t bits = 0;
+    if (!programInfo.uber) {
+        bits = getVariantBits(programInfo, defines);
+        auto *const *proxy = phase.variantTable.find(makeVariantTableKey(info.programIndex, bits));
+        if (proxy) {
+            return *proxy;
+        }
+    }
+
     std::string_view key;
     ccstd::string key1;
 
@@ -1481,55 +1724,21 @@ ProgramProxy *NativeProgramLibrary::getProgramVariant(
         key = *key0;
     }
 
+    ProgramProxy *proxy = nullptr;
     auto iter3 = phase.programProxies.find(key);
     if (iter3 != phase.programProxies.end()) {
-        return iter3->second.get();
-    }
-
-    // prepare defines
-    ccstd::vector<IMacroInfo> macroArray = render::prepareDefines(defines, programInfo.defines);
-    std::stringstream ss;
-    ss << std::endl;
-    for (const auto &m : macroArray) {
-        ss << "#define " << m.name << " " << m.value << std::endl;
-    }
-
-    std::string prefix;
-    prefix += layoutGraph.constantMacros;
-    prefix += programInfo.constantMacros + ss.str();
-
-    const IShaderSource *src = &programInfo.glsl3;
-    const auto *deviceShaderVersion = getDeviceShaderVersion(device);
-    if (deviceShaderVersion) {
-        src = programInfo.getSource(deviceShaderVersion);
+        proxy = iter3->second.get();
     } else {
-        CC_LOG_ERROR("Invalid GFX API!");
+        populateVariantShaderInfo(
+            layoutGraph.constantMacros, info, name, defines, device, info.shaderInfo);
+        IntrusivePtr<gfx::Shader> shader = device->createShader(info.shaderInfo);
+        proxy = addProgramVariant(phase, key, std::move(shader));
+        recordProgramVariant(*this, phaseID, name, programInfo, defines);
     }
-
-    if (src->compute) {
-        info.shaderInfo.stages.clear();
-        info.shaderInfo.stages.emplace_back(
-            gfx::ShaderStage{
-                gfx::ShaderStageFlagBit::COMPUTE,
-                prefix + *src->compute});
-    } else {
-        info.shaderInfo.stages[0].source = prefix + src->vert;
-        info.shaderInfo.stages[1].source = prefix + src->frag;
+    if (!programInfo.uber) {
+        phase.variantTable.emplace(makeVariantTableKey(info.programIndex, bits), proxy);
     }
-
-    // strip out the active attributes only, instancing depend on this
-    info.shaderInfo.attributes = getActiveAttributes(programInfo, info.attributes, defines);
-
-    info.shaderInfo.name = getShaderInstanceName(name, macroArray);
-    info.shaderInfo.hash = getShaderHash(programInfo.hash, prefix);
-
-    IntrusivePtr<gfx::Shader> shader = device->createShader(info.shaderInfo);
-    auto res = phase.programProxies.emplace(
-        key,
-        IntrusivePtr<ProgramProxy>(new NativeProgramProxy(std::move(shader))));
-    CC_ENSURES(res.second);
-
-    return res.first->second.get();
+    return proxy;
 }
 
 gfx::PipelineState *NativeProgramLibrary::getComputePipelineState(
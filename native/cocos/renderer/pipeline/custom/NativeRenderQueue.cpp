@@ -23,6 +23,8 @@
 ****************************************************************************/
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <iterator>
 #include "NativePipelineTypes.h"
 #include "cocos/renderer/pipeline/Define.h"
@@ -103,6 +105,75 @@ void ProbeHelperQueue::applyMacro(
     }
 }
 
+namespace {
+
+// Maps a float to an unsigned integer with the same ordering, -0 and +0 compare equal
+uint32_t toOrderedBits(float value) {
+    uint32_t bits = 0;
+    const float normalized = value + 0.F;
+    memcpy(&bits, &normalized, sizeof(bits));
+    return (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+}
+
+struct DrawSortItem {
+    uint64_t key{0};
+    uint32_t tie{0};
+    uint32_t index{0};
+};
+
+// Below this size the comparison sort is faster than the histogram passes
+constexpr size_t RADIX_SORT_THRESHOLD = 256;
+
+// Stable LSD radix sort of items by one field, one pass per byte.
+// Passes where all items share the same byte are skipped, which removes most passes for real draw keys.
+template <typename T, typename GetField>
+void radixSortByField(ccstd::vector<DrawSortItem> &items, ccstd::vector<DrawSortItem> &scratch, GetField getField) {
+    constexpr uint32_t BYTE_COUNT = sizeof(T);
+    std::array<std::array<uint32_t, 256>, BYTE_COUNT> histograms{};
+    for (const auto &item : items) {
+        const T value = getField(item);
+        for (uint32_t b = 0; b != BYTE_COUNT; ++b) {
+            ++histograms[b][(value >> (b * 8)) & 0xFF];
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(items.size());
+    scratch.resize(items.size());
+    for (uint32_t b = 0; b != BYTE_COUNT; ++b) {
+        auto &histogram = histograms[b];
+        if (histogram[(getField(items.front()) >> (b * 8)) & 0xFF] == count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (auto &bucket : histogram) {
+            const auto size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+        for (const auto &item : items) {
+            scratch[histogram[(getField(item) >> (b * 8)) & 0xFF]++] = item;
+        }
+        items.swap(scratch);
+    }
+}
+
+template <typename Items>
+void applySortOrder(Items &instances, const ccstd::vector<DrawSortItem> &items) {
+    thread_local ccstd::vector<DrawInstance> sorted;
+    sorted.clear();
+    sorted.reserve(items.size());
+    for (const auto &item : items) {
+        sorted.emplace_back(instances[item.index]);
+    }
+    std::copy(sorted.begin(), sorted.end(), instances.begin());
+}
+
+} // namespace
+
+uint64_t RenderDrawQueue::makeSortKey(uint32_t hash, float depth) {
+    return (static_cast<uint64_t>(hash) << 32) | toOrderedBits(depth);
+}
+
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 void RenderDrawQueue::add(const scene::Model &model, float depth, uint32_t subModelIdx, uint32_t passIdx) {
     const auto *subModel = model.getSubModels()[subModelIdx].get();
@@ -114,21 +185,67 @@ void RenderDrawQueue::add(const scene::Model &model, float depth, uint32_t subMo
     const auto hash = (0 << 30) | (passPriority << 16) | (modelPriority << 8) | passIdx;
     const auto priority = model.getPriority();
 
-    instances.emplace_back(DrawInstance{subModel, priority, hash, depth, shaderId, passIdx});
+    instances.emplace_back(DrawInstance{subModel, priority, hash, depth, shaderId, passIdx, makeSortKey(hash, depth)});
 }
 
+// Both sorts order by the same fields as (hash, depth, shaderID) and (priority, hash, -depth, shaderID)
+// tuple comparisons. Large queues use LSD radix passes on the key words, least significant field first.
 void RenderDrawQueue::sortOpaqueOrCutout() {
-    std::sort(instances.begin(), instances.end(), [](const DrawInstance &lhs, const DrawInstance &rhs) {
-        return std::forward_as_tuple(lhs.hash, lhs.depth, lhs.shaderID) <
-               std::forward_as_tuple(rhs.hash, rhs.depth, rhs.shaderID);
-    });
+    if (instances.size() < RADIX_SORT_THRESHOLD) {
+        std::sort(instances.begin(), instances.end(), [](const DrawInstance &lhs, const DrawInstance &rhs) {
+            return std::forward_as_tuple(lhs.hash, lhs.depth, lhs.shaderID) <
+                   std::forward_as_tuple(rhs.hash, rhs.depth, rhs.shaderID);
+        });
+        return;
+    }
+
+    thread_local ccstd::vector<DrawSortItem> items;
+    thread_local ccstd::vector<DrawSortItem> scratch;
+    items.clear();
+    items.reserve(instances.size());
+    for (uint32_t i = 0; i != instances.size(); ++i) {
+        items.push_back({instances[i].sortKey, instances[i].shaderID, i});
+    }
+    radixSortByField<uint32_t>(items, scratch, [](const DrawSortItem &item) { return item.tie; });
+    radixSortByField<uint64_t>(items, scratch, [](const DrawSortItem &item) { return item.key; });
+    applySortOrder(instances, items);
 }
 
 void RenderDrawQueue::sortTransparent() {
-    std::sort(instances.begin(), instances.end(), [](const DrawInstance &lhs, const DrawInstance &rhs) {
-        return std::forward_as_tuple(lhs.priority, lhs.hash, -lhs.depth, lhs.shaderID) <
-               std::forward_as_tuple(rhs.priority, rhs.hash, -rhs.depth, rhs.shaderID);
-    });
+    if (instances.size() < RADIX_SORT_THRESHOLD) {
+        std::sort(instances.begin(), instances.end(), [](const DrawInstance &lhs, const DrawInstance &rhs) {
+            return std::forward_as_tuple(lhs.priority, lhs.hash, -lhs.depth, lhs.shaderID) <
+                   std::forward_as_tuple(rhs.priority, rhs.hash, -rhs.depth, rhs.shaderID);
+        });
+        return;
+    }
+
+    thread_local ccstd::vector<DrawSortItem> items;
+    thread_local ccstd::vector<DrawSortItem> scratch;
+    items.clear();
+    items.reserve(instances.size());
+    for (uint32_t i = 0; i != instances.size(); ++i) {
+        // flipping the depth word turns the ascending depth order into descending
+        items.push_back({instances[i].sortKey ^ 0xFFFFFFFFULL, instances[i].shaderID, i});
+    }
+    radixSortByField<uint32_t>(items, scratch, [](const DrawSortItem &item) { return item.tie; });
+    radixSortByField<uint64_t>(items, scratch, [](const DrawSortItem &item) { return item.key; });
+    // the shader id is no longer needed, reuse the tie word for the model priority
+    for (auto &item : items) {
+        item.tie = instances[item.index].priority;
+    }
+    radixSortByField<uint32_t>(items, scratch, [](const DrawSortItem &item) { return item.tie; });
+    applySortOrder(instances, items);
+}
+
+void RenderDrawQueue::preparePipelineStates(gfx::RenderPass *renderPass, uint32_t subpassIndex) const {
+    for (const auto &instance : instances) {
+        const auto *subModel = instance.subModel;
+        const auto passIdx = instance.passIndex;
+        pipeline::PipelineStateManager::getOrCreatePipelineState(
+            subModel->getPass(passIdx), subModel->getShader(passIdx),
+            subModel->getInputAssembler(), renderPass, subpassIndex);
+    }
 }
 
 void RenderDrawQueue::recordCommandBuffer(
@@ -202,11 +319,27 @@ void RenderInstancingQueue::sort() {
     }
 }
 
-void RenderInstancingQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) const {
+void RenderInstancingQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer, pipeline::InstancingStatistics *statistics) const {
     for (const auto &[pass, bufferID] : passInstances) {
         const auto &ib = instanceBuffers[bufferID];
         if (ib->hasPendingModels()) {
-            ib->uploadBuffers(cmdBuffer);
+            ib->uploadBuffers(cmdBuffer, statistics);
+        }
+    }
+}
+
+void RenderInstancingQueue::preparePipelineStates(gfx::RenderPass *renderPass, uint32_t subpassIndex) const {
+    for (const auto *instanceBuffer : sortedBatches) {
+        if (!instanceBuffer->hasPendingModels()) {
+            continue;
+        }
+        const auto *drawPass = instanceBuffer->getPass();
+        for (const auto &instance : instanceBuffer->getInstances()) {
+            if (!instance.drawInfo.instanceCount) {
+                continue;
+            }
+            pipeline::PipelineStateManager::getOrCreatePipelineState(
+                drawPass, instance.shader, instance.ia, renderPass, subpassIndex);
         }
     }
 }
@@ -252,6 +385,14 @@ void NativeRenderQueue::sort() {
     transparentInstancingQueue.sort();
 }
 
+// Creates the pipeline states recordCommands will look up, so recording itself never touches the device.
+void NativeRenderQueue::preparePipelineStates(gfx::RenderPass *renderPass, uint32_t subpassIndex) const {
+    opaqueQueue.preparePipelineStates(renderPass, subpassIndex);
+    opaqueInstancingQueue.preparePipelineStates(renderPass, subpassIndex);
+    transparentQueue.preparePipelineStates(renderPass, subpassIndex);
+    transparentInstancingQueue.preparePipelineStates(renderPass, subpassIndex);
+}
+
 void NativeRenderQueue::recordCommands(
     gfx::CommandBuffer *cmdBuffer,
     gfx::RenderPass *renderPass,
@@ -237,25 +237,37 @@ void ResourceGraph::mount(gfx::Device* device, vertex_descriptor vertID) {
             // to be removed
         },
         [&](ManagedBuffer& buffer) {
-            if (!buffer.buffer) {
+            const auto owner = static_cast<uint32_t>(vertID);
+            if (!buffer.buffer || !transientPool.isAcquiredBy(buffer.buffer.get(), owner)) {
                 auto info = getBufferInfo(desc);
-                buffer.buffer = device->createBuffer(info);
+                buffer.buffer = transientPool.acquireBuffer(device, info, owner, buffer.buffer.get());
             }
             CC_ENSURES(buffer.buffer);
             buffer.fenceValue = nextFenceValue;
         },
         [&](ManagedTexture& texture) {
-            if (!texture.checkResource(desc)) {
+            const auto owner = static_cast<uint32_t>(vertID);
+            auto* prevTexture = texture.texture.get();
+            const bool acquired = prevTexture && transientPool.isAcquiredBy(prevTexture, owner);
+            if (!acquired || !texture.checkResource(desc)) {
+                if (acquired) {
+                    transientPool.release(prevTexture, owner);
+                }
                 auto info = getTextureInfo(desc);
-                texture.texture = device->createTexture(info);
-                // recreate depth stencil views, currently is not recursive
-                for (const auto& e : makeRange(children(vertID, *this))) {
-                    const auto childID = child(e, *this);
-                    auto* view = get_if<SubresourceView>(childID, this);
-                    if (view) {
-                        const auto [originView, parentID] = getOriginView(resg, childID);
-                        CC_ENSURES(parentID == vertID);
-                        recreateTextureView(device, *this, originView, parentID, *view);
+                auto* nextTexture = transientPool.acquireTexture(device, info, owner, prevTexture);
+                if (nextTexture != prevTexture) {
+                    // prevTexture stays pooled and may already be attached by another resource in this frame,
+                    // framebuffers are invalidated when it is evicted, stale ones are recreated when fetched.
+                    texture.texture = nextTexture;
+                    // recreate depth stencil views, currently is not recursive
+                    for (const auto& e : makeRange(children(vertID, *this))) {
+                        const auto childID = child(e, *this);
+                        auto* view = get_if<SubresourceView>(childID, this);
+                        if (view) {
+                            const auto [originView, parentID] = getOriginView(resg, childID);
+                            CC_ENSURES(parentID == vertID);
+                            recreateTextureView(device, *this, originView, parentID, *view);
+                        }
                     }
                 }
             }
@@ -301,29 +313,53 @@ void ResourceGraph::mount(gfx::Device* device, vertex_descriptor vertID) {
         });
 }
 
+// Resources unused this frame are dropped, transient ones used this frame go back to the pool
+// but keep their pointer, so the next frame prefers the same resource and cached framebuffers stay valid.
+// Textures leave the pool only when evicted, which also drops the framebuffers attaching them.
 void ResourceGraph::unmount(uint64_t completedFenceValue) {
     auto& resg = *this;
     for (const auto& vertID : makeRange(vertices(resg))) {
+        const auto owner = static_cast<uint32_t>(vertID);
+        const auto& traits = get(ResourceGraph::TraitsTag{}, resg, vertID);
         // here msvc has strange behaviour when using visitObject
         // we use if-else instead.
         if (holds<ManagedBufferTag>(vertID, resg)) {
             auto& buffer = get(ManagedBufferTag{}, vertID, resg);
             if (buffer.buffer && buffer.fenceValue <= completedFenceValue) {
+                transientPool.release(buffer.buffer.get(), owner);
                 buffer.buffer.reset();
+            } else if (buffer.buffer && !traits.hasSideEffects()) {
+                transientPool.release(buffer.buffer.get(), owner);
             }
         } else if (holds<ManagedTextureTag>(vertID, resg)) {
             auto& texture = get(ManagedTextureTag{}, vertID, resg);
             if (texture.texture && texture.fenceValue <= completedFenceValue) {
-                invalidatePersistentRenderPassAndFramebuffer(texture.texture.get());
+                transientPool.release(texture.texture.get(), owner);
                 texture.texture.reset();
-                const auto& traits = get(ResourceGraph::TraitsTag{}, resg, vertID);
                 if (traits.hasSideEffects()) {
                     auto& states = get(ResourceGraph::StatesTag{}, resg, vertID);
                     states.states = cc::gfx::AccessFlagBit::NONE;
                 }
+            } else if (texture.texture && !traits.hasSideEffects()) {
+                transientPool.release(texture.texture.get(), owner);
             }
         }
     }
+    transientPool.nextFrame([this](gfx::Texture* texture) {
+        invalidatePersistentRenderPassAndFramebuffer(texture);
+    });
+}
+
+void ResourceGraph::releaseTransient(vertex_descriptor vertID) noexcept {
+    if (get(ResourceGraph::TraitsTag{}, *this, vertID).hasSideEffects()) {
+        return;
+    }
+    const auto owner = static_cast<uint32_t>(vertID);
+    if (holds<ManagedBufferTag>(vertID, *this)) {
+        transientPool.release(get(ManagedBufferTag{}, vertID, *this).buffer.get(), owner);
+    } else if (holds<ManagedTextureTag>(vertID, *this)) {
+        transientPool.release(get(ManagedTextureTag{}, vertID, *this).texture.get(), owner);
+    }
 }
 
 bool ResourceGraph::isTexture(vertex_descriptor resID) const noexcept {
@@ -1,8 +1,10 @@
+#include "cocos/base/job-system/JobSystem.h"
 #include "cocos/renderer/pipeline/Define.h"
 #include "cocos/renderer/pipeline/custom/LayoutGraphUtils.h"
 #include "cocos/renderer/pipeline/custom/NativeBuiltinUtils.h"
 #include "cocos/renderer/pipeline/custom/NativePipelineTypes.h"
 #include "cocos/renderer/pipeline/custom/NativeRenderGraphUtils.h"
+#include "cocos/renderer/pipeline/custom/NativeSceneCulling.h"
 #include "cocos/renderer/pipeline/custom/details/GslUtils.h"
 #include "cocos/renderer/pipeline/custom/details/Range.h"
 #include "cocos/scene/Octree.h"
@@ -169,8 +171,6 @@ void SceneCulling::collectCullingQueries(
 
 namespace {
 
-const pipeline::PipelineSceneData* kPipelineSceneData = nullptr;
-
 const LayoutGraphData* kLayoutGraph = nullptr;
 
 bool isNodeVisible(const Node* node, uint32_t visibility) {
@@ -189,14 +189,13 @@ bool isIntersectAABB(const geometry::AABB& lAABB, const geometry::AABB& rAABB) {
     return !lAABB.aabbAabb(rAABB);
 }
 
-bool isFrustumVisible(const scene::Model& model, const geometry::Frustum& frustum, bool castShadow) {
+bool isFrustumVisible(const scene::Model& model, const geometry::Frustum& frustum, bool castShadow, const scene::Shadows& shadows) {
     const auto* const modelWorldBounds = model.getWorldBounds();
     if (!modelWorldBounds) {
         return false;
     }
     geometry::AABB transWorldBounds{};
     transWorldBounds.set(modelWorldBounds->getCenter(), modelWorldBounds->getHalfExtents());
-    const scene::Shadows& shadows = *kPipelineSceneData->getShadows();
     if (shadows.getType() == scene::ShadowType::PLANAR && castShadow) {
         modelWorldBounds->transform(shadows.getMatLight(), &transWorldBounds);
     }
@@ -247,6 +246,7 @@ void bruteForceCulling(
     const geometry::Frustum& cameraOrLightFrustum,
     bool bCastShadow,
     const scene::ReflectionProbe* probe,
+    const scene::Shadows& shadows,
     ccstd::vector<const scene::Model*>& models) {
     const auto visibility = camera.getVisibility();
     const auto camSkyboxFlag = (static_cast<int32_t>(camera.getClearFlag()) & scene::Camera::SKYBOX_FLAG);
@@ -268,7 +268,7 @@ void bruteForceCulling(
             if (isNodeVisible(model.getNode(), visibility) || isModelVisible(model, visibility)) {
                 const auto* const wBounds = model.getWorldBounds();
                 // frustum culling
-                if (wBounds && ((!probe && isFrustumVisible(model, cameraOrLightFrustum, bCastShadow)) ||
+                if (wBounds && ((!probe && isFrustumVisible(model, cameraOrLightFrustum, bCastShadow, shadows)) ||
                                 (probe && isIntersectAABB(*wBounds, *probe->getBoundingBox())))) {
                     continue;
                 }
@@ -288,6 +288,7 @@ void sceneCulling(
     const geometry::Frustum& cameraOrLightFrustum,
     bool bCastShadow,
     const scene::ReflectionProbe* probe,
+    const scene::Shadows& shadows,
     ccstd::vector<const scene::Model*>& models) {
     const auto* const octree = scene.getOctree();
     if (octree && octree->isEnabled() && !probe) {
@@ -297,17 +298,45 @@ void sceneCulling(
     } else {
         bruteForceCulling(
             skyboxModel,
-            scene, camera, cameraOrLightFrustum, bCastShadow, probe, models);
+            scene, camera, cameraOrLightFrustum, bCastShadow, probe, shadows, models);
     }
 }
 
 } // namespace
 
+void executeFrustumCullingTasks(
+    const ccstd::vector<FrustumCullingTask>& tasks,
+    const scene::Model* skyboxModel,
+    const scene::Shadows& shadows,
+    bool bParallel) {
+    const auto cull = [&tasks, skyboxModel, &shadows](uint32_t taskID) {
+        const auto& task = tasks[taskID];
+        sceneCulling(
+            skyboxModel,
+            *task.scene, *task.camera,
+            *task.frustum,
+            task.castShadow,
+            task.probe,
+            shadows,
+            *task.models);
+    };
+    if (bParallel) {
+        parallelFor(static_cast<uint32_t>(tasks.size()), cull);
+        return;
+    }
+    for (uint32_t taskID = 0; taskID != tasks.size(); ++taskID) {
+        cull(taskID);
+    }
+}
+
 void SceneCulling::batchFrustumCulling(const NativePipeline& ppl) {
     const auto& pplSceneData = *ppl.getPipelineSceneData();
     const auto* const skybox = pplSceneData.getSkybox();
     const auto* const skyboxModel = skybox && skybox->isEnabled() ? skybox->getModel() : nullptr;
 
+    // resolve the frustum of every query up front, each query then only writes its own result slot
+    ccstd::vector<FrustumCullingTask> tasks;
+    tasks.reserve(numFrustumCulling);
     for (const auto& [scene, queries] : frustumCullings) {
         CC_ENSURES(scene);
         for (const auto& [key, frustomCulledResultID] : queries.resultIndex) {
@@ -315,60 +344,35 @@ void SceneCulling::batchFrustumCulling(const NativePipeline& ppl) {
             CC_EXPECTS(key.camera->getScene() == scene);
             const auto* light = key.light;
             const auto level = key.lightLevel;
-            const auto bCastShadow = key.castShadow;
             const auto* probe = key.probe;
             const auto& camera = probe ? *probe->getCamera() : *key.camera;
             CC_EXPECTS(frustomCulledResultID.value < frustumCullingResults.size());
-            auto& models = frustumCullingResults[frustomCulledResultID.value];
-
-            if (probe) {
-                sceneCulling(
-                    skyboxModel,
-                    *scene, camera,
-                    camera.getFrustum(),
-                    bCastShadow,
-                    probe,
-                    models);
-                continue;
-            }
 
-            if (light) {
+            const geometry::Frustum* frustum = &camera.getFrustum();
+            if (!probe && light) {
                 switch (light->getType()) {
                     case scene::LightType::SPOT:
-                        sceneCulling(
-                            skyboxModel,
-                            *scene, camera,
-                            dynamic_cast<const scene::SpotLight*>(light)->getFrustum(),
-                            bCastShadow,
-                            nullptr,
-                            models);
+                        frustum = &dynamic_cast<const scene::SpotLight*>(light)->getFrustum();
                         break;
                     case scene::LightType::DIRECTIONAL: {
                         const auto* mainLight = dynamic_cast<const scene::DirectionalLight*>(light);
-                        const auto& frustum = getBuiltinShadowFrustum(ppl, camera, mainLight, level);
-                        sceneCulling(
-                            skyboxModel,
-                            *scene, camera,
-                            frustum,
-                            bCastShadow,
-                            nullptr,
-                            models);
+                        frustum = &getBuiltinShadowFrustum(ppl, camera, mainLight, level);
                     } break;
                     default:
                         // noop
+                        frustum = nullptr;
                         break;
                 }
-            } else {
-                sceneCulling(
-                    skyboxModel,
-                    *scene, camera,
-                    camera.getFrustum(),
-                    bCastShadow,
-                    nullptr,
-                    models);
+            }
+            if (frustum) {
+                tasks.emplace_back(FrustumCullingTask{
+                    scene, &camera, frustum, probe, key.castShadow,
+                    &frustumCullingResults[frustomCulledResultID.value]});
             }
         }
     }
+
+    executeFrustumCullingTasks(tasks, skyboxModel, *pplSceneData.getShadows());
 }
 
 namespace {
@@ -437,43 +441,51 @@ void executeRangedDirectionalLightCulling(
 } // namespace
 
 void SceneCulling::batchLightBoundsCulling() {
+    ccstd::vector<std::pair<const LightBoundsCullingKey*, LightBoundsCullingID>> tasks;
+    tasks.reserve(numLightBoundsCulling);
     for (const auto& [scene, queries] : lightBoundsCullings) {
         CC_ENSURES(scene);
         for (const auto& [key, cullingID] : queries.resultIndex) {
             CC_EXPECTS(key.camera);
             CC_EXPECTS(key.camera->getScene() == scene);
-            const auto& frustumCullingResult = frustumCullingResults.at(key.frustumCullingID.value);
-            auto& lightBoundsCullingResult = lightBoundsCullingResults.at(cullingID.value);
-            CC_EXPECTS(lightBoundsCullingResult.instances.empty());
-            switch (key.cullingLight->getType()) {
-                case scene::LightType::SPHERE: {
-                    const auto* light = dynamic_cast<const scene::SphereLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executeSphereLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::SPOT: {
-                    const auto* light = dynamic_cast<const scene::SpotLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executeSpotLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::POINT: {
-                    const auto* light = dynamic_cast<const scene::PointLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executePointLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::RANGED_DIRECTIONAL: {
-                    const auto* light = dynamic_cast<const scene::RangedDirectionalLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executeRangedDirectionalLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::DIRECTIONAL:
-                case scene::LightType::UNKNOWN:
-                default:
-                    // noop
-                    break;
-            }
+            tasks.emplace_back(&key, cullingID);
         }
     }
+
+    parallelFor(static_cast<uint32_t>(tasks.size()), [this, &tasks](uint32_t taskID) {
+        const auto& key = *tasks[taskID].first;
+        const auto cullingID = tasks[taskID].second;
+        const auto& frustumCullingResult = frustumCullingResults.at(key.frustumCullingID.value);
+        auto& lightBoundsCullingResult = lightBoundsCullingResults.at(cullingID.value);
+        CC_EXPECTS(lightBoundsCullingResult.instances.empty());
+        switch (key.cullingLight->getType()) {
+            case scene::LightType::SPHERE: {
+                const auto* light = dynamic_cast<const scene::SphereLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executeSphereLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::SPOT: {
+                const auto* light = dynamic_cast<const scene::SpotLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executeSpotLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::POINT: {
+                const auto* light = dynamic_cast<const scene::PointLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executePointLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::RANGED_DIRECTIONAL: {
+                const auto* light = dynamic_cast<const scene::RangedDirectionalLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executeRangedDirectionalLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::DIRECTIONAL:
+            case scene::LightType::UNKNOWN:
+            default:
+                // noop
+                break;
+        }
+    });
 }
 
 namespace {
@@ -507,7 +519,8 @@ void addRenderObject(
     const bool bDrawProbe,
     const scene::Camera& camera,
     const scene::Model& model,
-    NativeRenderQueue& queue) {
+    NativeRenderQueue& queue,
+    ccstd::vector<InstancingDraw>* pendingInstancing = nullptr) {
     if (bDrawProbe) {
         queue.probeQueue.applyMacro(*kLayoutGraph, model, phaseLayoutID);
     }
@@ -543,7 +556,10 @@ void addRenderObject(
 
             // add object to queue
             if (pass.getBatchingScheme() == scene::BatchingSchemes::INSTANCING) {
-                if (bBlend) {
+                if (pendingInstancing) {
+                    // instanced buffers create gfx objects, they are merged later on the calling thread
+                    pendingInstancing->emplace_back(InstancingDraw{&pass, subModel.get(), passIdx, bBlend});
+                } else if (bBlend) {
                     queue.transparentInstancingQueue.add(pass, *subModel, passIdx);
                 } else {
                     queue.opaqueInstancingQueue.add(pass, *subModel, passIdx);
@@ -563,9 +579,56 @@ void addRenderObject(
 
 } // namespace
 
+void executeRenderQueueTasks(ccstd::vector<RenderQueueTask>& tasks, bool bParallel) {
+    if (!bParallel) {
+        for (const auto& task : tasks) {
+            for (const auto* const model : *task.sourceModels) {
+                addRenderObject(
+                    task.phaseLayoutID, task.bDrawOpaqueOrMask, task.bDrawBlend,
+                    false, *task.camera, *model, *task.queue);
+            }
+            task.queue->sort();
+        }
+        tasks.clear();
+        return;
+    }
+
+    // draw queues are filled and sorted in parallel, instancing queues are merged afterwards in queue order
+    parallelFor(static_cast<uint32_t>(tasks.size()), [&tasks](uint32_t taskID) {
+        const auto& task = tasks[taskID];
+        task.pendingInstancing->clear();
+        for (const auto* const model : *task.sourceModels) {
+            addRenderObject(
+                task.phaseLayoutID, task.bDrawOpaqueOrMask, task.bDrawBlend,
+                false, *task.camera, *model, *task.queue, task.pendingInstancing);
+        }
+        task.queue->opaqueQueue.sortOpaqueOrCutout();
+        task.queue->transparentQueue.sortTransparent();
+    });
+
+    for (const auto& task : tasks) {
+        auto& queue = *task.queue;
+        for (const auto& draw : *task.pendingInstancing) {
+            if (draw.transparent) {
+                queue.transparentInstancingQueue.add(*draw.pass, *draw.subModel, draw.passIndex);
+            } else {
+                queue.opaqueInstancingQueue.add(*draw.pass, *draw.subModel, draw.passIndex);
+            }
+        }
+        queue.opaqueInstancingQueue.sort();
+        queue.transparentInstancingQueue.sort();
+    }
+    tasks.clear();
+}
+
 void SceneCulling::fillRenderQueues(
     const RenderGraph& rg, const pipeline::PipelineSceneData& pplSceneData) {
     const auto* const skybox = pplSceneData.getSkybox();
+    if (pendingInstancingDraws.size() < renderQueues.size()) {
+        pendingInstancingDraws.resize(renderQueues.size());
+    }
+
+    ccstd::vector<RenderQueueTask> tasks;
     for (auto&& [sceneID, desc] : renderQueueIndex) {
         CC_EXPECTS(holds<SceneTag>(sceneID, rg));
         const auto frustomCulledResultID = desc.frustumCulledResultID;
@@ -612,6 +675,17 @@ void SceneCulling::fillRenderQueues(
         const auto* camera = sceneData.camera;
         CC_EXPECTS(camera);
 
+        if (!bDrawProbe) {
+            tasks.emplace_back(RenderQueueTask{
+                phaseLayoutID, bDrawOpaqueOrMask, bDrawBlend,
+                camera, &sourceModels, &nativeQueue,
+                &pendingInstancingDraws[targetID.value]});
+            continue;
+        }
+
+        // probe queues patch sub-model macros, flush earlier queues first to keep their shaders unchanged
+        executeRenderQueueTasks(tasks);
+
         // fill native queue
         for (const auto* const model : sourceModels) {
             addRenderObject(
@@ -622,12 +696,12 @@ void SceneCulling::fillRenderQueues(
         // post-processing
         nativeQueue.sort();
     }
+    executeRenderQueueTasks(tasks);
 }
 
 void SceneCulling::buildRenderQueues(
     const RenderGraph& rg, const LayoutGraphData& lg,
     const NativePipeline& ppl) {
-    kPipelineSceneData = ppl.pipelineSceneData;
     kLayoutGraph = &lg;
     collectCullingQueries(rg, lg);
     batchFrustumCulling(ppl);
@@ -0,0 +1,66 @@
+/****************************************************************************
+ Copyright (c) 2022-2024 Xiamen Yaji Software Co., Ltd.
+
+ https://www.cocos.com/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include "NativePipelineTypes.h"
+
+namespace cc {
+
+namespace render {
+
+struct FrustumCullingTask {
+    const scene::RenderScene* scene{nullptr};
+    const scene::Camera* camera{nullptr};
+    const geometry::Frustum* frustum{nullptr};
+    const scene::ReflectionProbe* probe{nullptr};
+    bool castShadow{false};
+    ccstd::vector<const scene::Model*>* models{nullptr};
+};
+
+// Culls the scene of each task by its frustum into the task's models, each task only writes its own models.
+// Tasks run on the job system unless bParallel is false, the results do not depend on it.
+void executeFrustumCullingTasks(
+    const ccstd::vector<FrustumCullingTask>& tasks,
+    const scene::Model* skyboxModel,
+    const scene::Shadows& shadows,
+    bool bParallel = true);
+
+struct RenderQueueTask {
+    LayoutGraphData::vertex_descriptor phaseLayoutID{LayoutGraphData::null_vertex()};
+    bool bDrawOpaqueOrMask{false};
+    bool bDrawBlend{false};
+    const scene::Camera* camera{nullptr};
+    const ccstd::vector<const scene::Model*>* sourceModels{nullptr};
+    NativeRenderQueue* queue{nullptr};
+    ccstd::vector<InstancingDraw>* pendingInstancing{nullptr};
+};
+
+// Adds the source models of each task to its queue and sorts the queue, then clears the tasks.
+// In parallel, instancing draws are collected in pendingInstancing and merged on the calling thread in task order,
+// so the queues end up the same as when bParallel is false.
+void executeRenderQueueTasks(ccstd::vector<RenderQueueTask>& tasks, bool bParallel = true);
+
+} // namespace render
+
+} // namespace cc
@@ -49,14 +49,16 @@ ProgramInfo::ProgramInfo(ProgramInfo&& rhs, const allocator_type& alloc)
   shaderInfo(std::move(rhs.shaderInfo)),
   attributes(std::move(rhs.attributes), alloc),
   blockSizes(std::move(rhs.blockSizes)),
-  handleMap(std::move(rhs.handleMap)) {}
+  handleMap(std::move(rhs.handleMap)),
+  programIndex(rhs.programIndex) {}
 
 ProgramInfo::ProgramInfo(ProgramInfo const& rhs, const allocator_type& alloc)
 : programInfo(rhs.programInfo),
   shaderInfo(rhs.shaderInfo),
   attributes(rhs.attributes, alloc),
   blockSizes(rhs.blockSizes),
-  handleMap(rhs.handleMap) {}
+  handleMap(rhs.handleMap),
+  programIndex(rhs.programIndex) {}
 
 ProgramGroup::ProgramGroup(const allocator_type& alloc) noexcept
 : programInfos(alloc),
@@ -64,11 +66,13 @@ ProgramGroup::ProgramGroup(const allocator_type& alloc) noexcept
 
 ProgramGroup::ProgramGroup(ProgramGroup&& rhs, const allocator_type& alloc)
 : programInfos(std::move(rhs.programInfos), alloc),
-  programProxies(std::move(rhs.programProxies), alloc) {}
+  programProxies(std::move(rhs.programProxies), alloc),
+  variantTable(std::move(rhs.variantTable)) {}
 
 ProgramGroup::ProgramGroup(ProgramGroup const& rhs, const allocator_type& alloc)
 : programInfos(rhs.programInfos, alloc),
-  programProxies(rhs.programProxies, alloc) {}
+  programProxies(rhs.programProxies, alloc),
+  variantTable(rhs.variantTable) {}
 
 } // namespace render
 
@@ -37,6 +37,7 @@
 #include "cocos/renderer/pipeline/custom/NativeFwd.h"
 #include "cocos/renderer/pipeline/custom/PrivateTypes.h"
 #include "cocos/renderer/pipeline/custom/details/Map.h"
+#include "cocos/renderer/pipeline/custom/details/OpenAddressingMap.h"
 
 namespace cc {
 
@@ -63,6 +64,7 @@ struct ProgramInfo {
     ccstd::pmr::vector<gfx::Attribute> attributes;
     ccstd::vector<signed> blockSizes;
     ccstd::unordered_map<ccstd::string, uint32_t> handleMap;
+    uint32_t programIndex{0};
 };
 
 struct ProgramGroup {
@@ -82,6 +84,13 @@ struct ProgramGroup {
 
     PmrTransparentMap<ccstd::pmr::string, ProgramInfo> programInfos;
     PmrFlatMap<ccstd::pmr::string, IntrusivePtr<ProgramProxy>> programProxies;
+    OpenAddressingMap<ProgramProxy*> variantTable;
+};
+
+struct ProgramVariantRequest {
+    uint32_t phaseID{0xFFFFFFFF};
+    ccstd::string programName;
+    MacroRecord defines;
 };
 
 } // namespace render
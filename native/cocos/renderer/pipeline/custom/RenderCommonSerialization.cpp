@@ -179,6 +179,20 @@ void save(OutputArchive& ar, const PipelineStatistics& v) {
     save(ar, v.numFreeDescriptorSets);
     save(ar, v.numInstancingBuffers);
     save(ar, v.numInstancingUniformBlocks);
+    save(ar, v.numInstances);
+    save(ar, v.numInstancedDrawCalls);
+    save(ar, v.numInstancingBufferResizes);
+    save(ar, v.instancingUploadedBytes);
+    save(ar, v.numRenderGraphCacheHits);
+    save(ar, v.numRenderGraphCompiles);
+    save(ar, v.renderGraphCompileMicroseconds);
+    save(ar, v.numTransientTextures);
+    save(ar, v.numTransientBuffers);
+    save(ar, v.numTransientAcquires);
+    save(ar, v.numTransientReuses);
+    save(ar, v.numTransientEvictions);
+    save(ar, v.peakTransientMemoryKB);
+    save(ar, v.totalTransientMemoryKB);
 }
 
 void load(InputArchive& ar, PipelineStatistics& v) {
@@ -193,6 +207,20 @@ void load(InputArchive& ar, PipelineStatistics& v) {
     load(ar, v.numFreeDescriptorSets);
     load(ar, v.numInstancingBuffers);
     load(ar, v.numInstancingUniformBlocks);
+    load(ar, v.numInstances);
+    load(ar, v.numInstancedDrawCalls);
+    load(ar, v.numInstancingBufferResizes);
+    load(ar, v.instancingUploadedBytes);
+    load(ar, v.numRenderGraphCacheHits);
+    load(ar, v.numRenderGraphCompiles);
+    load(ar, v.renderGraphCompileMicroseconds);
+    load(ar, v.numTransientTextures);
+    load(ar, v.numTransientBuffers);
+    load(ar, v.numTransientAcquires);
+    load(ar, v.numTransientReuses);
+    load(ar, v.numTransientEvictions);
+    load(ar, v.peakTransientMemoryKB);
+    load(ar, v.totalTransientMemoryKB);
 }
 
 } // namespace render
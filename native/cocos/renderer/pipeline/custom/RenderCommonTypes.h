@@ -457,6 +457,20 @@ struct PipelineStatistics {
     uint32_t numFreeDescriptorSets{0};
     uint32_t numInstancingBuffers{0};
     uint32_t numInstancingUniformBlocks{0};
+    uint32_t numInstances{0};
+    uint32_t numInstancedDrawCalls{0};
+    uint32_t numInstancingBufferResizes{0};
+    uint32_t instancingUploadedBytes{0};
+    uint32_t numRenderGraphCacheHits{0};
+    uint32_t numRenderGraphCompiles{0};
+    uint32_t renderGraphCompileMicroseconds{0};
+    uint32_t numTransientTextures{0};
+    uint32_t numTransientBuffers{0};
+    uint32_t numTransientAcquires{0};
+    uint32_t numTransientReuses{0};
+    uint32_t numTransientEvictions{0};
+    uint32_t peakTransientMemoryKB{0};
+    uint32_t totalTransientMemoryKB{0};
 };
 
 } // namespace render
@@ -47,6 +47,7 @@
 #include "cocos/renderer/gfx-base/states/GFXSampler.h"
 #include "cocos/renderer/pipeline/custom/RenderCommonTypes.h"
 #include "cocos/renderer/pipeline/custom/RenderGraphFwd.h"
+#include "cocos/renderer/pipeline/custom/TransientResourcePool.h"
 #include "cocos/renderer/pipeline/custom/details/GraphTypes.h"
 #include "cocos/renderer/pipeline/custom/details/Map.h"
 #include "cocos/scene/Camera.h"
@@ -674,6 +675,7 @@ struct ResourceGraph {
     void validateSwapchains();
     void mount(gfx::Device* device, vertex_descriptor vertID);
     void unmount(uint64_t completedFenceValue);
+    void releaseTransient(vertex_descriptor vertID) noexcept;
     bool isTexture(vertex_descriptor resID) const noexcept;
     bool isTextureView(vertex_descriptor resID) const noexcept;
     gfx::Texture* getTexture(vertex_descriptor resID);
@@ -734,6 +736,7 @@ struct ResourceGraph {
     ccstd::pmr::unordered_map<RasterPass, PersistentRenderPassAndFramebuffer> renderPasses;
     uint64_t nextFenceValue{0};
     uint64_t version{0};
+    TransientResourcePool transientPool;
 };
 
 struct ComputePass {
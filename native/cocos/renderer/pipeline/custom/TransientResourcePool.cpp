@@ -0,0 +1,215 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/TransientResourcePool.h"
+#include <algorithm>
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/custom/details/GslUtils.h"
+
+namespace cc {
+
+namespace render {
+
+namespace {
+
+const gfx::TextureInfo& getInfo(const gfx::Texture& texture) noexcept {
+    return texture.getInfo();
+}
+
+gfx::BufferInfo getInfo(const gfx::Buffer& buffer) noexcept {
+    return {
+        buffer.getUsage(),
+        buffer.getMemUsage(),
+        buffer.getSize(),
+        buffer.getStride(),
+        buffer.getFlags(),
+    };
+}
+
+uint64_t getMemorySize(const gfx::TextureInfo& info) noexcept {
+    uint64_t size = 0;
+    uint32_t width = info.width;
+    uint32_t height = info.height;
+    uint32_t depth = info.depth;
+    for (uint32_t level = 0; level < std::max(info.levelCount, 1U); ++level) {
+        size += gfx::formatSize(info.format, width, height, depth);
+        width = std::max(width >> 1, 1U);
+        height = std::max(height >> 1, 1U);
+        depth = std::max(depth >> 1, 1U);
+    }
+    return size * std::max(info.layerCount, 1U) * std::max(static_cast<uint32_t>(info.samples), 1U);
+}
+
+} // namespace
+
+template <class Resource, class Info, class Create>
+Resource* TransientResourcePool::acquire(
+    ccstd::unordered_map<const Resource*, Entry<Resource>>& entries,
+    const Info& info, uint32_t owner, Resource* preferred, uint64_t memorySize, Create&& create) {
+    ++statistics.numAcquires;
+
+    Entry<Resource>* found = nullptr;
+    if (preferred) {
+        auto iter = entries.find(preferred);
+        if (iter != entries.end() && !iter->second.acquired && getInfo(*preferred) == info) {
+            found = &iter->second;
+        }
+    }
+    if (!found) {
+        // oldest first, so recently released resources stay available to their previous owners
+        for (auto& [key, entry] : entries) {
+            if (entry.acquired || getInfo(*entry.resource) != info) {
+                continue;
+            }
+            if (!found || entry.lastUsedFrame < found->lastUsedFrame) {
+                found = &entry;
+            }
+        }
+    }
+
+    if (found) {
+        ++statistics.numReuses;
+        // released in this frame, so earlier passes of the frame still access the memory
+        if (found->lastUsedFrame == frame) {
+            ++statistics.numAliases;
+            aliasBarrier = true;
+        }
+    } else {
+        IntrusivePtr<Resource> resource = create();
+        CC_ENSURES(resource);
+        auto& entry = entries[resource.get()];
+        entry.resource = std::move(resource);
+        entry.memorySize = memorySize;
+        found = &entry;
+        ++statistics.numCreates;
+        statistics.totalMemory += memorySize;
+    }
+
+    found->acquired = true;
+    found->owner = owner;
+    found->lastUsedFrame = frame;
+    statistics.usedMemory += found->memorySize;
+    statistics.peakMemory = std::max(statistics.peakMemory, statistics.usedMemory);
+    return found->resource.get();
+}
+
+template <class Resource>
+void TransientResourcePool::release(
+    ccstd::unordered_map<const Resource*, Entry<Resource>>& entries, const Resource* resource, uint32_t owner) noexcept {
+    auto iter = entries.find(resource);
+    if (iter == entries.end() || !iter->second.acquired || iter->second.owner != owner) {
+        return;
+    }
+    iter->second.acquired = false;
+    iter->second.lastUsedFrame = frame;
+    CC_EXPECTS(statistics.usedMemory >= iter->second.memorySize);
+    statistics.usedMemory -= iter->second.memorySize;
+}
+
+template <class Resource>
+bool TransientResourcePool::isAcquiredBy(
+    const ccstd::unordered_map<const Resource*, Entry<Resource>>& entries,
+    const Resource* resource, uint32_t owner) noexcept {
+    auto iter = entries.find(resource);
+    return iter != entries.end() && iter->second.acquired && iter->second.owner == owner;
+}
+
+template <class Resource, class OnEvict>
+void TransientResourcePool::evict(ccstd::unordered_map<const Resource*, Entry<Resource>>& entries, OnEvict&& onEvict) {
+    for (auto iter = entries.begin(); iter != entries.end();) {
+        const auto& entry = iter->second;
+        if (!entry.acquired && entry.lastUsedFrame + maxIdleFrames < frame) {
+            onEvict(entry.resource.get());
+            statistics.totalMemory -= entry.memorySize;
+            ++statistics.numEvictions;
+            iter = entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+gfx::Texture* TransientResourcePool::acquireTexture(
+    gfx::Device* device, const gfx::TextureInfo& info, uint32_t owner, gfx::Texture* preferred) {
+    auto* texture = acquire(textures, info, owner, preferred, getMemorySize(info), [&]() {
+        return IntrusivePtr<gfx::Texture>(device->createTexture(info));
+    });
+    statistics.numTextures = static_cast<uint32_t>(textures.size());
+    return texture;
+}
+
+gfx::Buffer* TransientResourcePool::acquireBuffer(
+    gfx::Device* device, const gfx::BufferInfo& info, uint32_t owner, gfx::Buffer* preferred) {
+    auto* buffer = acquire(buffers, info, owner, preferred, info.size, [&]() {
+        return IntrusivePtr<gfx::Buffer>(device->createBuffer(info));
+    });
+    statistics.numBuffers = static_cast<uint32_t>(buffers.size());
+    return buffer;
+}
+
+void TransientResourcePool::release(const gfx::Texture* texture, uint32_t owner) noexcept {
+    release(textures, texture, owner);
+}
+
+void TransientResourcePool::release(const gfx::Buffer* buffer, uint32_t owner) noexcept {
+    release(buffers, buffer, owner);
+}
+
+bool TransientResourcePool::isAcquiredBy(const gfx::Texture* texture, uint32_t owner) const noexcept {
+    return isAcquiredBy(textures, texture, owner);
+}
+
+bool TransientResourcePool::isAcquiredBy(const gfx::Buffer* buffer, uint32_t owner) const noexcept {
+    return isAcquiredBy(buffers, buffer, owner);
+}
+
+void TransientResourcePool::nextFrame(const std::function<void(gfx::Texture*)>& onEvictTexture) {
+    ++frame;
+    aliasBarrier = false;
+    statistics.numAcquires = 0;
+    statistics.numReuses = 0;
+    statistics.numCreates = 0;
+    statistics.numEvictions = 0;
+    statistics.numAliases = 0;
+    evict(textures, [&](gfx::Texture* texture) {
+        if (onEvictTexture) {
+            onEvictTexture(texture);
+        }
+    });
+    evict(buffers, [](gfx::Buffer* /*buffer*/) {});
+    statistics.numTextures = static_cast<uint32_t>(textures.size());
+    statistics.numBuffers = static_cast<uint32_t>(buffers.size());
+    statistics.peakMemory = statistics.usedMemory;
+}
+
+void TransientResourcePool::clear() noexcept {
+    textures.clear();
+    buffers.clear();
+    statistics = {};
+    aliasBarrier = false;
+}
+
+} // namespace render
+
+} // namespace cc
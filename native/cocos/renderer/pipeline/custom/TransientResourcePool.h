@@ -0,0 +1,123 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include <functional>
+#include "cocos/base/Ptr.h"
+#include "cocos/base/std/container/unordered_map.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/gfx-base/GFXBuffer.h"
+#include "cocos/renderer/gfx-base/GFXTexture.h"
+
+namespace cc {
+
+namespace gfx {
+class Device;
+} // namespace gfx
+
+namespace render {
+
+struct TransientResourceStatistics {
+    float getReuseRate() const noexcept {
+        return numAcquires ? static_cast<float>(numReuses) / static_cast<float>(numAcquires) : 1.0F;
+    }
+
+    // current frame
+    uint32_t numAcquires{0};
+    uint32_t numReuses{0};
+    uint32_t numCreates{0};
+    uint32_t numEvictions{0};
+    uint32_t numAliases{0};
+    uint64_t peakMemory{0};
+    // pool
+    uint32_t numTextures{0};
+    uint32_t numBuffers{0};
+    uint64_t usedMemory{0};
+    uint64_t totalMemory{0};
+};
+
+// Pools render graph managed textures and buffers by their creation info across frames.
+// A released resource stays in the pool and is handed to the next request with a matching info,
+// resources that stay unused for more than maxIdleFrames frames are destroyed.
+class TransientResourcePool {
+public:
+    // Returns preferred when it is pooled, free and compatible, so an owner keeps its resource across frames.
+    // Owners are opaque ids, a resource is only released by the owner that acquired it.
+    gfx::Texture* acquireTexture(gfx::Device* device, const gfx::TextureInfo& info, uint32_t owner, gfx::Texture* preferred = nullptr);
+    gfx::Buffer* acquireBuffer(gfx::Device* device, const gfx::BufferInfo& info, uint32_t owner, gfx::Buffer* preferred = nullptr);
+    void release(const gfx::Texture* texture, uint32_t owner) noexcept;
+    void release(const gfx::Buffer* buffer, uint32_t owner) noexcept;
+    bool isAcquiredBy(const gfx::Texture* texture, uint32_t owner) const noexcept;
+    bool isAcquiredBy(const gfx::Buffer* buffer, uint32_t owner) const noexcept;
+
+    // A resource released earlier in this frame was acquired again, the memory is aliased.
+    // Returns true once per aliasing acquire, the caller must order the new writes after the previous accesses.
+    bool takeAliasBarrier() noexcept {
+        const bool pending = aliasBarrier;
+        aliasBarrier = false;
+        return pending;
+    }
+
+    // Evicts idle resources and starts the statistics of a new frame.
+    // onEvictTexture is called before an evicted texture is destroyed.
+    void nextFrame(const std::function<void(gfx::Texture*)>& onEvictTexture = {});
+    void clear() noexcept;
+
+    const TransientResourceStatistics& getStatistics() const noexcept { return statistics; }
+
+    uint32_t maxIdleFrames{8};
+    // Release managed transient resources after their last pass, so later passes may alias them.
+    bool enableAliasing{false};
+
+private:
+    template <class Resource>
+    struct Entry {
+        IntrusivePtr<Resource> resource;
+        uint64_t lastUsedFrame{0};
+        uint64_t memorySize{0};
+        uint32_t owner{0};
+        bool acquired{false};
+    };
+
+    template <class Resource, class Info, class Create>
+    Resource* acquire(
+        ccstd::unordered_map<const Resource*, Entry<Resource>>& entries,
+        const Info& info, uint32_t owner, Resource* preferred, uint64_t memorySize, Create&& create);
+    template <class Resource>
+    void release(ccstd::unordered_map<const Resource*, Entry<Resource>>& entries, const Resource* resource, uint32_t owner) noexcept;
+    template <class Resource>
+    static bool isAcquiredBy(const ccstd::unordered_map<const Resource*, Entry<Resource>>& entries, const Resource* resource, uint32_t owner) noexcept;
+    template <class Resource, class OnEvict>
+    void evict(ccstd::unordered_map<const Resource*, Entry<Resource>>& entries, OnEvict&& onEvict);
+
+    ccstd::unordered_map<const gfx::Texture*, Entry<gfx::Texture>> textures;
+    ccstd::unordered_map<const gfx::Buffer*, Entry<gfx::Buffer>> buffers;
+    TransientResourceStatistics statistics;
+    uint64_t frame{0};
+    bool aliasBarrier{false};
+};
+
+} // namespace render
+
+} // namespace cc
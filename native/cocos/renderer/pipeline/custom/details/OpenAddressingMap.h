@@ -0,0 +1,117 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <utility>
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/pipeline/custom/details/GslUtils.h"
+
+namespace cc {
+
+// Open addressing hash map keyed by a precomputed 64-bit key.
+// Linear probing over a power-of-two table, no deletion.
+// Lookups never allocate, which makes it suitable for per-frame caches.
+template <class Value>
+class OpenAddressingMap {
+public:
+    static constexpr uint64_t EMPTY_KEY = ~static_cast<uint64_t>(0);
+
+    const Value *find(uint64_t key) const noexcept {
+        if (slots.empty()) {
+            return nullptr;
+        }
+        const auto mask = slots.size() - 1;
+        for (auto pos = static_cast<size_t>(mix(key)) & mask;; pos = (pos + 1) & mask) {
+            const auto &slot = slots[pos];
+            if (slot.first == key) {
+                return &slot.second;
+            }
+            if (slot.first == EMPTY_KEY) {
+                return nullptr;
+            }
+        }
+    }
+    Value *find(uint64_t key) noexcept {
+        return const_cast<Value *>(static_cast<const OpenAddressingMap &>(*this).find(key));
+    }
+
+    // returns false if the key already exists, the stored value is kept
+    bool emplace(uint64_t key, Value value) {
+        CC_EXPECTS(key != EMPTY_KEY);
+        if ((numElements + 1) * 4 > slots.size() * 3) {
+            rehash(slots.empty() ? 16 : slots.size() * 2);
+        }
+        const auto mask = slots.size() - 1;
+        for (auto pos = static_cast<size_t>(mix(key)) & mask;; pos = (pos + 1) & mask) {
+            auto &slot = slots[pos];
+            if (slot.first == key) {
+                return false;
+            }
+            if (slot.first == EMPTY_KEY) {
+                slot.first = key;
+                slot.second = std::move(value);
+                ++numElements;
+                return true;
+            }
+        }
+    }
+
+    void clear() noexcept {
+        slots.clear();
+        numElements = 0;
+    }
+    size_t size() const noexcept {
+        return numElements;
+    }
+    bool empty() const noexcept {
+        return numElements == 0;
+    }
+
+private:
+    static uint64_t mix(uint64_t key) noexcept {
+        // splitmix64 finalizer, keys are often small packed bit fields
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBULL;
+        key ^= key >> 31;
+        return key;
+    }
+    void rehash(size_t capacity) {
+        ccstd::vector<std::pair<uint64_t, Value>> prev(capacity, {EMPTY_KEY, Value{}});
+        prev.swap(slots);
+        numElements = 0;
+        for (auto &slot : prev) {
+            if (slot.first != EMPTY_KEY) {
+                emplace(slot.first, std::move(slot.second));
+            }
+        }
+    }
+
+    ccstd::vector<std::pair<uint64_t, Value>> slots;
+    size_t numElements{0};
+};
+
+} // namespace cc
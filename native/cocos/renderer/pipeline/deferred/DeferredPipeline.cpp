@@ -105,6 +105,7 @@ bool DeferredPipeline::activate(gfx::Swapchain *swapchain) {
 
 void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     CC_PROFILE(DeferredPipelineRender);
+    _instancingStatistics = {};
 #if CC_USE_GEOMETRY_RENDERER
     updateGeometryRenderer(cameras); // for capability
 #endif
@@ -94,6 +94,7 @@ bool ForwardPipeline::activate(gfx::Swapchain *swapchain) {
 
 void ForwardPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     CC_PROFILE(ForwardPipelineRender);
+    _instancingStatistics = {};
 #if CC_USE_GEOMETRY_RENDERER
     updateGeometryRenderer(cameras); // for capability
 #endif
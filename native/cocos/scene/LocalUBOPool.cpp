@@ -0,0 +1,173 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "scene/LocalUBOPool.h"
+#include <algorithm>
+#include "base/memory/Memory.h"
+#include "profiler/Profiler.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+
+namespace cc {
+namespace scene {
+
+namespace {
+LocalUBOPool *localPool = nullptr;
+LocalUBOPool *worldBoundPool = nullptr;
+
+uint32_t alignTo(uint32_t size, uint32_t alignment) {
+    return alignment > 1 ? (size + alignment - 1) / alignment * alignment : size;
+}
+} // namespace
+
+LocalUBOPool *LocalUBOPool::getLocalPool(bool create) {
+    if (!localPool && create) {
+        localPool = ccnew LocalUBOPool(gfx::Device::getInstance(), pipeline::UBOLocal::SIZE);
+    }
+    return localPool;
+}
+
+LocalUBOPool *LocalUBOPool::getWorldBoundPool(bool create) {
+    if (!worldBoundPool && create) {
+        worldBoundPool = ccnew LocalUBOPool(gfx::Device::getInstance(), pipeline::UBOWorldBound::SIZE);
+    }
+    return worldBoundPool;
+}
+
+void LocalUBOPool::commitAll() {
+    Stats total;
+    for (auto *pool : {localPool, worldBoundPool}) {
+        if (pool) {
+            pool->commit();
+            total.bufferCount += pool->getStats().bufferCount;
+            total.uploadCalls += pool->getStats().uploadCalls;
+            total.bytesUploaded += pool->getStats().bytesUploaded;
+        }
+    }
+    CC_PROFILE_RENDER_UPDATE(LocalUBOBuffers, total.bufferCount);
+    CC_PROFILE_RENDER_UPDATE(LocalUBOUploads, total.uploadCalls);
+    CC_PROFILE_RENDER_UPDATE(LocalUBOUploadBytes, total.bytesUploaded);
+}
+
+void LocalUBOPool::destroyAll() {
+    CC_SAFE_DELETE(localPool);
+    CC_SAFE_DELETE(worldBoundPool);
+}
+
+LocalUBOPool::LocalUBOPool(gfx::Device *device, uint32_t blockSize)
+: _device(device), _blockSize(blockSize), _stride(alignTo(blockSize, device->getCapabilities().uboOffsetAlignment)) {
+}
+
+LocalUBOPool::~LocalUBOPool() {
+    for (auto &page : _pages) {
+        for (auto &view : page.views) {
+            if (view) {
+                view->destroy();
+            }
+        }
+        page.buffer->destroy();
+    }
+}
+
+void LocalUBOPool::addPage() {
+    const auto pageIndex = static_cast<uint32_t>(_pages.size());
+    const uint32_t pageSize = _stride * BLOCKS_PER_PAGE;
+
+    Page page;
+    page.buffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                                         gfx::MemoryUsageBit::DEVICE,
+                                         pageSize,
+                                         _stride});
+    page.views.resize(BLOCKS_PER_PAGE);
+    page.data.resize(pageSize, 0);
+    page.dirty.resize(BLOCKS_PER_PAGE, 0);
+    _pages.emplace_back(std::move(page));
+
+    // hand out low indices first so uploads of a partially used page stay short
+    for (uint32_t i = BLOCKS_PER_PAGE; i > 0; --i) {
+        _freeSlots.push_back({pageIndex, i - 1});
+    }
+}
+
+LocalUBOPool::Slot LocalUBOPool::allocate() {
+    if (_freeSlots.empty()) {
+        addPage();
+    }
+
+    const Slot slot = _freeSlots.back();
+    _freeSlots.pop_back();
+
+    auto &page = _pages[slot.page];
+    if (!page.views[slot.index]) {
+        page.views[slot.index] = _device->createBuffer(gfx::BufferViewInfo{page.buffer, slot.index * _stride, _blockSize});
+    }
+    std::fill_n(page.data.begin() + slot.index * _stride, _stride, 0);
+    page.dirty[slot.index] = 1;
+    return slot;
+}
+
+void LocalUBOPool::free(Slot &slot) {
+    if (!slot.isValid()) {
+        return;
+    }
+
+    _pages[slot.page].dirty[slot.index] = 0;
+    _freeSlots.push_back(slot);
+    slot = Slot{};
+}
+
+gfx::Buffer *LocalUBOPool::getBuffer(const Slot &slot) const {
+    return _pages[slot.page].views[slot.index];
+}
+
+uint8_t *LocalUBOPool::getData(const Slot &slot) {
+    return _pages[slot.page].data.data() + slot.index * _stride;
+}
+
+void LocalUBOPool::markDirty(const Slot &slot) {
+    _pages[slot.page].dirty[slot.index] = 1;
+}
+
+void LocalUBOPool::commit() {
+    _stats = {};
+    _stats.bufferCount = static_cast<uint32_t>(_pages.size());
+
+    for (auto &page : _pages) {
+        const auto first = std::find(page.dirty.begin(), page.dirty.end(), 1);
+        if (first == page.dirty.end()) {
+            continue;
+        }
+        const auto last = std::find(page.dirty.rbegin(), page.dirty.rend(), 1).base();
+        std::fill(first, last, 0);
+
+        // gfx::Buffer::update always starts at offset 0, upload the page up to its last dirty block
+        const auto size = static_cast<uint32_t>(last - page.dirty.begin()) * _stride;
+        page.buffer->update(page.data.data(), size);
+        ++_stats.uploadCalls;
+        _stats.bytesUploaded += size;
+    }
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,109 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+
+namespace cc {
+
+namespace gfx {
+class Device;
+}
+
+namespace scene {
+
+/**
+ * @en Shared storage of per model uniform blocks.
+ * Blocks are sub-allocated from large pages and written to a persistent CPU copy of each page.
+ * Dirty pages are uploaded with a single update per frame. Each block is bound through a buffer view,
+ * so the local descriptor set layout and shaders are unchanged.
+ * @zh 模型局部 UBO 的共享存储，按页分配并在每帧合并上传。
+ */
+class CC_DLL LocalUBOPool final {
+public:
+    static constexpr uint32_t INVALID_PAGE = 0xFFFFFFFF;
+    static constexpr uint32_t BLOCKS_PER_PAGE = 256;
+
+    struct Slot {
+        uint32_t page{INVALID_PAGE};
+        uint32_t index{0};
+
+        inline bool isValid() const { return page != INVALID_PAGE; }
+    };
+
+    struct Stats {
+        uint32_t bufferCount{0};
+        uint32_t uploadCalls{0};
+        uint32_t bytesUploaded{0};
+    };
+
+    // Pools of UBOLocal and UBOWorldBound blocks, created on first use unless create is false
+    static LocalUBOPool *getLocalPool(bool create = true);
+    static LocalUBOPool *getWorldBoundPool(bool create = true);
+    // Upload the dirty pages of both pools and report the counters to the profiler
+    static void commitAll();
+    static void destroyAll();
+
+    LocalUBOPool(gfx::Device *device, uint32_t blockSize);
+    ~LocalUBOPool();
+
+    Slot allocate();
+    void free(Slot &slot);
+
+    gfx::Buffer *getBuffer(const Slot &slot) const;
+    uint8_t *getData(const Slot &slot);
+    // Thread safe for distinct slots, allocation must not happen at the same time
+    void markDirty(const Slot &slot);
+    void commit();
+
+    inline const Stats &getStats() const { return _stats; }
+    inline uint32_t getBlockSize() const { return _blockSize; }
+    inline uint32_t getStride() const { return _stride; }
+
+private:
+    struct Page {
+        IntrusivePtr<gfx::Buffer> buffer;
+        ccstd::vector<IntrusivePtr<gfx::Buffer>> views;
+        ccstd::vector<uint8_t> data;
+        ccstd::vector<uint8_t> dirty;
+    };
+
+    void addPage();
+
+    gfx::Device *_device{nullptr};
+    uint32_t _blockSize{0};
+    uint32_t _stride{0};
+    ccstd::vector<Page> _pages;
+    ccstd::vector<Slot> _freeSlots;
+    Stats _stats;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(LocalUBOPool);
+};
+
+} // namespace scene
+} // namespace cc
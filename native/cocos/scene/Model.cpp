@@ -97,9 +97,9 @@ void Model::destroy() {
     }
     _subModels.clear();
 
-    CC_SAFE_DESTROY_NULL(_localBuffer);
+    releaseLocalBuffer();
     CC_SAFE_DESTROY_NULL(_localSHBuffer);
-    CC_SAFE_DESTROY_NULL(_worldBoundBuffer);
+    releaseWorldBoundBuffer();
 
     _worldBounds = nullptr;
     _modelBounds = nullptr;
@@ -170,19 +170,19 @@ void Model::updateUBOs(uint32_t stamp) {
         }
     }
 
-    for (SubModel *subModel : _subModels) {
-        subModel->update();
-    }
-    _updateStamp = stamp;
-
     updateSHUBOs();
+    commitUBOs(stageUBOs(stamp));
+}
+
+bool Model::stageUBOs(uint32_t stamp) {
+    _updateStamp = stamp;
 
     const auto *pipeline = Root::getInstance()->getPipeline();
     const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
     const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
 
     if (!_localDataUpdated) {
-        return;
+        return false;
     }
     _localDataUpdated = false;
     getTransform()->updateWorldTransform();
@@ -191,60 +191,91 @@ void Model::updateUBOs(uint32_t stamp) {
     for (const auto &subModel : _subModels) {
         const auto idx = subModel->getInstancedWorldMatrixIndex();
         if (idx >= 0) {
-            ccstd::vector<TypedArray> &attrs = subModel->getInstancedAttributeBlock().views;
             subModel->updateInstancedWorldMatrix(worldMatrix, idx);
         } else {
             hasNonInstancingPass = true;
         }
     }
 
-    if ((hasNonInstancingPass || forceUpdateUBO) && _localBuffer) {
-        Mat4 mat4;
-        Mat4::inverseTranspose(worldMatrix, &mat4);
-
-        _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
-        _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
-        _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
-        _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
-
-        auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
-        auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
-        if (probe) {
-            if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
-                const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
-                _localBuffer->write(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
-                _localBuffer->write(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            } else {
-                uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
-                const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
-                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            }
-            if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
-                _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                if (blendProbe) {
-                    uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
-                    const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
-                    Vec3 boudingBox = blendProbe->getBoudingSize();
-                    const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                    const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                    _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
-                } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                    // blend with skybox
-                    const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                }
+    if (!(hasNonInstancingPass || forceUpdateUBO) || !_localBuffer) {
+        return false;
+    }
+
+    Mat4 mat4;
+    Mat4::inverseTranspose(worldMatrix, &mat4);
+
+    // pooled blocks are written straight into the page copy owned by LocalUBOPool
+    uint8_t *localData = _localSlot.isValid() ? LocalUBOPool::getLocalPool()->getData(_localSlot) : nullptr;
+    const auto writeLocal = [&](const auto &value, uint32_t offset) {
+        if (localData) {
+            memcpy(localData + offset, &value, sizeof(value));
+        } else {
+            _localBuffer->write(value, offset);
+        }
+    };
+
+    writeLocal(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
+    writeLocal(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
+    writeLocal(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
+    writeLocal(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
+
+    auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
+    auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
+    if (probe) {
+        if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
+            const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
+            writeLocal(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
+            const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
+            writeLocal(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
+        } else {
+            uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
+            const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
+            writeLocal(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
+            const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+            writeLocal(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
+        }
+        if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
+            _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+            if (blendProbe) {
+                uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
+                const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
+                Vec3 boudingBox = blendProbe->getBoudingSize();
+                const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
+                writeLocal(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
+                const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+                writeLocal(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
+            } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+                // blend with skybox
+                const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
+                writeLocal(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
             }
         }
+    }
+
+    if (localData) {
+        LocalUBOPool::getLocalPool()->markDirty(_localSlot);
+    }
+    if (pipeline->isOcclusionQueryEnabled()) {
+        writeWorldBoundUBOs();
+    }
+    return true;
+}
+
+void Model::commitUBOs(bool staged) {
+    for (SubModel *subModel : _subModels) {
+        subModel->update();
+    }
 
+    if (!staged) {
+        return;
+    }
+
+    // pooled blocks are uploaded together by LocalUBOPool::commitAll
+    if (!_localSlot.isValid()) {
         _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
-        }
+    }
+    if (_worldBoundBuffer && !_worldBoundSlot.isValid() && Root::getInstance()->getPipeline()->isOcclusionQueryEnabled()) {
+        _worldBoundBuffer->update();
     }
 }
 
@@ -256,14 +287,30 @@ void Model::updateOctree() {
 }
 
 void Model::updateWorldBoundUBOs() {
+    if (_worldBoundBuffer) {
+        writeWorldBoundUBOs();
+        if (!_worldBoundSlot.isValid()) {
+            _worldBoundBuffer->update();
+        }
+    }
+}
+
+void Model::writeWorldBoundUBOs() {
     if (_worldBoundBuffer) {
         const Vec3 &center = _worldBounds ? _worldBounds->getCenter() : Vec3{0.0F, 0.0F, 0.0F};
         const Vec3 &halfExtents = _worldBounds ? _worldBounds->getHalfExtents() : Vec3{1.0F, 1.0F, 1.0F};
         const Vec4 worldBoundCenter{center.x, center.y, center.z, 0.0F};
         const Vec4 worldBoundHalfExtents{halfExtents.x, halfExtents.y, halfExtents.z, 1.0F};
-        _worldBoundBuffer->write(worldBoundCenter, sizeof(float) * pipeline::UBOWorldBound::WORLD_BOUND_CENTER);
-        _worldBoundBuffer->write(worldBoundHalfExtents, sizeof(float) * pipeline::UBOWorldBound::WORLD_BOUND_HALF_EXTENTS);
-        _worldBoundBuffer->update();
+        if (_worldBoundSlot.isValid()) {
+            auto *pool = LocalUBOPool::getWorldBoundPool();
+            uint8_t *data = pool->getData(_worldBoundSlot);
+            memcpy(data + sizeof(float) * pipeline::UBOWorldBound::WORLD_BOUND_CENTER, &worldBoundCenter, sizeof(worldBoundCenter));
+            memcpy(data + sizeof(float) * pipeline::UBOWorldBound::WORLD_BOUND_HALF_EXTENTS, &worldBoundHalfExtents, sizeof(worldBoundHalfExtents));
+            pool->markDirty(_worldBoundSlot);
+        } else {
+            _worldBoundBuffer->write(worldBoundCenter, sizeof(float) * pipeline::UBOWorldBound::WORLD_BOUND_CENTER);
+            _worldBoundBuffer->write(worldBoundHalfExtents, sizeof(float) * pipeline::UBOWorldBound::WORLD_BOUND_HALF_EXTENTS);
+        }
     }
 }
 
@@ -412,37 +459,49 @@ void Model::clearSHUBOs() {
     updateSHBuffer();
 }
 
-void Model::updateSHUBOs() {
+bool Model::isSHDirty() const {
     if (!isLightProbeAvailable()) {
-        return;
+        return false;
     }
 
-    const auto center = _worldBounds->getCenter();
 #if !CC_EDITOR
-    if (center.approxEquals(_lastWorldBoundCenter, math::EPSILON)) {
+    return !_worldBounds->getCenter().approxEquals(_lastWorldBoundCenter, math::EPSILON);
+#else
+    return true;
+#endif
+}
+
+void Model::applySHCoefficients(int32_t tetIndex, const Vec3 *coefficients) {
+    _lastWorldBoundCenter.set(_worldBounds->getCenter());
+    _tetrahedronIndex = tetIndex;
+    if (!coefficients || _localSHData.empty()) {
         return;
     }
-#endif
 
-    ccstd::vector<Vec3> coefficients;
-    Vec4 weights(0.0F, 0.0F, 0.0F, 0.0F);
     const auto *pipeline = Root::getInstance()->getPipeline();
     const auto *lightProbes = pipeline->getPipelineSceneData()->getLightProbes();
 
-    _lastWorldBoundCenter.set(center);
-    _tetrahedronIndex = lightProbes->getData()->getInterpolationWeights(center, _tetrahedronIndex, weights);
-    bool result = lightProbes->getData()->getInterpolationSHCoefficients(_tetrahedronIndex, weights, coefficients);
-    if (!result) {
-        return;
-    }
+    ccstd::array<Vec3, SH_BASIS_COUNT> reduced;
+    std::copy(coefficients, coefficients + SH_BASIS_COUNT, reduced.begin());
+    gi::SH::reduceRinging(reduced.data(), lightProbes->getReduceRinging());
+    gi::SH::updateUBOData(_localSHData, pipeline::UBOSH::SH_LINEAR_CONST_R_OFFSET, reduced.data());
+    updateSHBuffer();
+}
 
-    if (_localSHData.empty()) {
+void Model::updateSHUBOs() {
+    if (!isSHDirty()) {
         return;
     }
 
-    gi::SH::reduceRinging(coefficients, lightProbes->getReduceRinging());
-    gi::SH::updateUBOData(_localSHData, pipeline::UBOSH::SH_LINEAR_CONST_R_OFFSET, coefficients);
-    updateSHBuffer();
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    const auto *lightProbes = pipeline->getPipelineSceneData()->getLightProbes();
+    const auto *data = lightProbes->getData();
+
+    Vec4 weights(0.0F, 0.0F, 0.0F, 0.0F);
+    ccstd::array<Vec3, SH_BASIS_COUNT> coefficients;
+    const auto tetIndex = data->getInterpolationWeights(_worldBounds->getCenter(), _tetrahedronIndex, weights);
+    const bool result = data->getInterpolationSHCoefficients(tetIndex, weights, coefficients.data());
+    applySHCoefficients(tetIndex, result ? coefficients.data() : nullptr);
 }
 
 ccstd::vector<IMacroPatch> Model::getMacroPatches(index_t subModelIndex) {
@@ -541,12 +600,17 @@ void Model::updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attri
 }
 
 void Model::initLocalDescriptors(index_t /*subModelIndex*/) {
-    if (!_localBuffer) {
+    if (!_localBuffer && !isModelImplementedInJS()) {
+        auto *pool = LocalUBOPool::getLocalPool();
+        _localSlot = pool->allocate();
+        _localBuffer = pool->getBuffer(_localSlot);
+    } else if (!_localBuffer) {
         _localBuffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
                                               gfx::MemoryUsageBit::DEVICE,
                                               pipeline::UBOLocal::SIZE,
                                               pipeline::UBOLocal::SIZE,
                                               gfx::BufferFlagBit::ENABLE_STAGING_WRITE});
+        _ownsLocalBuffer = true;
     }
 }
 
@@ -572,13 +636,59 @@ void Model::initLocalSHDescriptors(index_t /*subModelIndex*/) {
 }
 
 void Model::initWorldBoundDescriptors(index_t /*subModelIndex*/) {
-    if (!_worldBoundBuffer) {
+    if (!_worldBoundBuffer && !isModelImplementedInJS()) {
+        auto *pool = LocalUBOPool::getWorldBoundPool();
+        _worldBoundSlot = pool->allocate();
+        _worldBoundBuffer = pool->getBuffer(_worldBoundSlot);
+    } else if (!_worldBoundBuffer) {
         _worldBoundBuffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
                                                    gfx::MemoryUsageBit::DEVICE,
                                                    pipeline::UBOWorldBound::SIZE,
                                                    pipeline::UBOWorldBound::SIZE,
                                                    gfx::BufferFlagBit::ENABLE_STAGING_WRITE});
+        _ownsWorldBoundBuffer = true;
+    }
+}
+
+void Model::setLocalBuffer(gfx::Buffer *buffer) {
+    if (buffer != _localBuffer) {
+        releaseLocalBuffer();
+        _localBuffer = buffer;
+    }
+}
+
+void Model::setWorldBoundBuffer(gfx::Buffer *buffer) {
+    if (buffer != _worldBoundBuffer) {
+        releaseWorldBoundBuffer();
+        _worldBoundBuffer = buffer;
+    }
+}
+
+void Model::releaseLocalBuffer() {
+    if (_localSlot.isValid()) {
+        // the view is owned by the pool, which may already be gone during shutdown
+        if (auto *pool = LocalUBOPool::getLocalPool(false)) {
+            pool->free(_localSlot);
+        }
+        _localSlot = {};
+    } else if (_ownsLocalBuffer && _localBuffer) {
+        _localBuffer->destroy();
+    }
+    _ownsLocalBuffer = false;
+    _localBuffer = nullptr;
+}
+
+void Model::releaseWorldBoundBuffer() {
+    if (_worldBoundSlot.isValid()) {
+        if (auto *pool = LocalUBOPool::getWorldBoundPool(false)) {
+            pool->free(_worldBoundSlot);
+        }
+        _worldBoundSlot = {};
+    } else if (_ownsWorldBoundBuffer && _worldBoundBuffer) {
+        _worldBoundBuffer->destroy();
     }
+    _ownsWorldBoundBuffer = false;
+    _worldBoundBuffer = nullptr;
 }
 
 void Model::updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet) {
@@ -40,6 +40,7 @@
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/gfx-base/GFXTexture.h"
+#include "scene/LocalUBOPool.h"
 #include "scene/SubModel.h"
 
 namespace cc {
@@ -158,9 +159,9 @@ public:
     inline void detachFromScene() { _scene = nullptr; };
     inline void setCastShadow(bool value) { _castShadow = value; }
     inline void setEnabled(bool value) { _enabled = value; }
-    inline void setLocalBuffer(gfx::Buffer *buffer) { _localBuffer = buffer; }
+    void setLocalBuffer(gfx::Buffer *buffer);
     inline void setLocalSHBuffer(gfx::Buffer *buffer) { _localSHBuffer = buffer; }
-    inline void setWorldBoundBuffer(gfx::Buffer *buffer) { _worldBoundBuffer = buffer; }
+    void setWorldBoundBuffer(gfx::Buffer *buffer);
 
     inline void setNode(Node *node) { _node = node; }
     inline void setReceiveShadow(bool value) {
@@ -257,6 +258,15 @@ protected:
     void updateAttributesAndBinding(index_t subModelIndex);
     bool isLightProbeAvailable() const;
     void updateSHBuffer();
+    // Light probe interpolation batched over all models by RenderScene
+    bool isSHDirty() const;
+    void applySHCoefficients(int32_t tetIndex, const Vec3 *coefficients);
+    // updateUBOs in two steps, staging only writes memory owned by this model and may run on a worker thread
+    bool stageUBOs(uint32_t stamp);
+    void commitUBOs(bool staged);
+    void writeWorldBoundUBOs();
+    void releaseLocalBuffer();
+    void releaseWorldBoundBuffer();
 
     // Please declare variables in descending order of memory size occupied by variables.
     Type _type{Type::DEFAULT};
@@ -280,6 +290,9 @@ protected:
     IntrusivePtr<gfx::Buffer> _localBuffer;
     IntrusivePtr<gfx::Buffer> _localSHBuffer;
     IntrusivePtr<gfx::Buffer> _worldBoundBuffer;
+    // valid when the buffers above are views into LocalUBOPool pages
+    LocalUBOPool::Slot _localSlot;
+    LocalUBOPool::Slot _worldBoundSlot;
     IntrusivePtr<geometry::AABB> _worldBounds;
     IntrusivePtr<geometry::AABB> _modelBounds;
     IntrusivePtr<Texture2D> _lightmap;
@@ -294,6 +307,9 @@ protected:
     bool _useLightProbe = false;
     bool _bakeToReflectionProbe{true};
     bool _receiveDirLight{true};
+    // buffers created by the model itself, the ones assigned by setLocalBuffer and setWorldBoundBuffer belong to the caller
+    bool _ownsLocalBuffer{false};
+    bool _ownsWorldBoundBuffer{false};
     // For JS
     bool _isCalledFromJS{false};
 
@@ -309,6 +325,8 @@ protected:
     Float32Array _localSHData;
 
 private:
+    friend class RenderScene;
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(Model);
 };
 
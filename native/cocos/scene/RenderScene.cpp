@@ -29,8 +29,11 @@
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
+#include "gi/light-probe/LightProbe.h"
+#include "gi/light-probe/SH.h"
 #include "profiler/Profiler.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -42,12 +45,19 @@
 #include "scene/Octree.h"
 #include "scene/PointLight.h"
 #include "scene/RangedDirectionalLight.h"
+#include "scene/ReflectionProbe.h"
+#include "scene/ReflectionProbeManager.h"
 #include "scene/SphereLight.h"
 #include "scene/SpotLight.h"
 
 namespace cc {
 namespace scene {
 
+namespace {
+// Models per job of the parallel update, enough work to amortize the dispatch
+constexpr uint32_t MODELS_PER_JOB = 256;
+} // namespace
+
 /**
  * @zh 管理LODGroup的使用状态，包含使用层级及其上的model可见相机列表；便于判断当前model是否被LODGroup裁剪
  * @en Manage the usage status of LODGroup, including the usage level and the list of visible cameras on its models; easy to determine whether the current mod is cropped by LODGroup。
@@ -162,7 +172,7 @@ void RenderScene::setMainLight(DirectionalLight *dl) {
     if (_mainLight) _mainLight->activate();
 }
 
-void RenderScene::update(uint32_t stamp) {
+void RenderScene::update(uint32_t stamp, bool bParallel) {
     CC_PROFILE(RenderSceneUpdate);
 
     if (_mainLight) {
@@ -180,12 +190,41 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &light : _rangedDirLights) {
         light->update();
     }
+    // Serial phase: resolve node world transforms, models share ancestors and reflection probe nodes
+    _parallelModels.clear();
     for (const auto &model : _models) {
-        if (model->isEnabled()) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (model->getType() == Model::Type::DEFAULT) {
+            model->getTransform()->updateWorldTransform();
+            _parallelModels.emplace_back(model.get());
+        } else {
             model->updateTransform(stamp);
+        }
+    }
+    for (auto *probe : ReflectionProbeManager::getInstance()->getAllProbes()) {
+        if (probe->getNode()) {
+            probe->getNode()->updateWorldTransform();
+        }
+    }
+
+    // Parallel phase: bounds and UBO staging only write memory owned by each model
+    updateModels(stamp, bParallel);
+    updateModelSH();
+
+    // Serial phase: GPU buffer commits and octree relocation, in scene order
+    uint32_t parallelIndex = 0;
+    for (const auto &model : _models) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (model->getType() == Model::Type::DEFAULT) {
+            model->commitUBOs(_stagedModels[parallelIndex++] != 0);
+        } else {
             model->updateUBOs(stamp);
-            model->updateOctree();
         }
+        model->updateOctree();
     }
 
     CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
@@ -195,6 +234,69 @@ void RenderScene::update(uint32_t stamp) {
     _lodStateCache->updateLodState();
 }
 
+void RenderScene::updateModels(uint32_t stamp, bool bParallel) {
+    const auto count = static_cast<uint32_t>(_parallelModels.size());
+    _stagedModels.assign(count, 0);
+    if (count == 0) {
+        return;
+    }
+
+    auto updateRange = [this, stamp, count](uint32_t job) {
+        const uint32_t begin = job * MODELS_PER_JOB;
+        const uint32_t end = std::min(begin + MODELS_PER_JOB, count);
+        for (uint32_t i = begin; i < end; ++i) {
+            Model *model = _parallelModels[i];
+            model->updateTransform(stamp);
+            _stagedModels[i] = model->stageUBOs(stamp) ? 1 : 0;
+        }
+    };
+
+    const uint32_t jobCount = (count - 1) / MODELS_PER_JOB + 1;
+    if (bParallel) {
+        parallelFor(jobCount, updateRange);
+    } else {
+        for (uint32_t job = 0; job < jobCount; ++job) {
+            updateRange(job);
+        }
+    }
+}
+
+void RenderScene::updateModelSH() {
+    auto *lightProbes = Root::getInstance()->getPipeline()->getPipelineSceneData()->getLightProbes();
+    if (!lightProbes || lightProbes->empty()) {
+        return;
+    }
+
+    auto *data = lightProbes->getData();
+    data->updateCache();
+
+    _shModels.clear();
+    _shPositions.clear();
+    _shTetIndices.clear();
+    for (const auto &model : _models) {
+        if (model->isEnabled() && model->isSHDirty()) {
+            _shModels.emplace_back(model.get());
+            _shPositions.emplace_back(model->getWorldBounds()->getCenter());
+            _shTetIndices.emplace_back(model->getTetrahedronIndex());
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(_shModels.size());
+    if (count == 0) {
+        return;
+    }
+
+    const auto basisCount = gi::SH::getBasisCount();
+    _shWeights.resize(count);
+    _shCoefficients.resize(count * basisCount);
+    data->getInterpolationWeights(_shPositions.data(), _shTetIndices.data(), _shWeights.data(), count);
+    const bool hasCoefficients = data->getInterpolationSHCoefficients(_shTetIndices.data(), _shWeights.data(), count, _shCoefficients.data());
+
+    for (uint32_t i = 0; i < count; i++) {
+        _shModels[i]->applySHCoefficients(_shTetIndices[i], hasCoefficients ? _shCoefficients.data() + i * basisCount : nullptr);
+    }
+}
+
 void RenderScene::destroy() {
     removeCameras();
     removeSphereLights();
@@ -29,6 +29,8 @@
 #include "base/RefCounted.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
+#include "math/Vec3.h"
+#include "math/Vec4.h"
 #include <cocos/scene/raytracing/RayTracing.h>
 
 namespace cc {
@@ -66,7 +68,8 @@ public:
     ~RenderScene() override;
 
     bool initialize(const IRenderSceneInfo &info);
-    void update(uint32_t stamp);
+    // Bounds and UBO staging of native models run on the job system unless bParallel is false, the results do not depend on it.
+    void update(uint32_t stamp, bool bParallel = true);
     void destroy();
 
     void activate();
@@ -127,6 +130,9 @@ public:
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
 
 private:
+    void updateModels(uint32_t stamp, bool bParallel);
+    void updateModelSH();
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
@@ -143,6 +149,17 @@ private:
     ccstd::vector<DrawBatch2D *> _batches;
     Octree *_octree{nullptr};
 
+    // Native models updated on job system workers and whether their UBOs were staged
+    ccstd::vector<Model *> _parallelModels;
+    ccstd::vector<uint8_t> _stagedModels;
+
+    // Scratch buffers of the batched light probe interpolation, reused every frame
+    ccstd::vector<Model *> _shModels;
+    ccstd::vector<Vec3> _shPositions;
+    ccstd::vector<int32_t> _shTetIndices;
+    ccstd::vector<Vec4> _shWeights;
+    ccstd::vector<Vec3> _shCoefficients;
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
 
@@ -0,0 +1,149 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <cmath>
+#include <cstdio>
+#include "audio/common/mixer/AudioMixerKernels.h"
+#include "audio/common/mixer/AudioSoftMixer.h"
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+constexpr uint32_t SAMPLE_RATE = 48000;
+constexpr double TWO_PI = 6.283185307179586;
+
+ccstd::vector<int16_t> makeSine(uint32_t frames, float frequency, uint32_t sampleRate) {
+    ccstd::vector<int16_t> pcm(frames);
+    for (uint32_t i = 0; i < frames; ++i) {
+        pcm[i] = static_cast<int16_t>(std::sin(TWO_PI * frequency * i / sampleRate) * 16000.0);
+    }
+    return pcm;
+}
+} // namespace
+
+TEST(audioSoftMixer, resampleLinear) {
+    const float src[] = {0.F, 1.F, 2.F, 3.F, 4.F, 5.F, 6.F, 7.F, 8.F};
+    float dst[32] = {};
+    double position = 0.0;
+    const uint32_t written = mixer::resampleLinear(src, 9, 1, position, 0.5, dst, 32);
+    EXPECT_EQ(written, 18);
+    for (uint32_t i = 0; i < written; ++i) {
+        EXPECT_FLOAT_EQ(dst[i], std::min(i * 0.5F, 8.F));
+    }
+    EXPECT_DOUBLE_EQ(position, 9.0);
+}
+
+TEST(audioSoftMixer, mixRampMatchesScalar) {
+    float mono[37];
+    float bus[74] = {};
+    for (uint32_t i = 0; i < 37; ++i) {
+        mono[i] = 0.25F;
+    }
+    mixer::mixMonoToStereoRamp(mono, 37, bus, 0.F, 1.F, 0.01F, -0.01F);
+    for (uint32_t i = 0; i < 37; ++i) {
+        EXPECT_NEAR(bus[i * 2], 0.25F * 0.01F * i, 1e-5F);
+        EXPECT_NEAR(bus[i * 2 + 1], 0.25F * (1.F - 0.01F * i), 1e-5F);
+    }
+}
+
+TEST(audioSoftMixer, convertFloatToS16Rounds) {
+    // SIMD lanes and the scalar tail all round to nearest and clamp
+    float src[13];
+    int16_t dst[13] = {};
+    for (uint32_t i = 0; i < 11; ++i) {
+        const float value = static_cast<float>(i) * 100.F + (i % 2 == 0 ? 0.75F : 0.25F);
+        src[i] = (i % 3 == 0 ? -value : value) / 32767.F;
+    }
+    src[11] = 2.F;
+    src[12] = -2.F;
+    mixer::convertFloatToS16(src, 13, dst);
+    for (uint32_t i = 0; i < 11; ++i) {
+        EXPECT_EQ(dst[i], static_cast<int16_t>(std::lrintf(src[i] * 32767.F))) << "sample " << i;
+    }
+    EXPECT_EQ(dst[0], -1);
+    EXPECT_EQ(dst[11], 32767);
+    EXPECT_EQ(dst[12], -32767);
+}
+
+TEST(audioSoftMixer, virtualizationAndStealing) {
+    AudioSoftMixer softMixer(SAMPLE_RATE, 64, 16);
+    const auto pcm = makeSine(SAMPLE_RATE / 4, 440.F, 22050);
+    const auto sound = softMixer.addSound(pcm.data(), static_cast<uint32_t>(pcm.size()), 1, 22050);
+    ASSERT_NE(sound, AudioSoftMixer::INVALID_SOUND);
+
+    AudioSoftMixer::VoiceParams params;
+    params.volume = 0.05F;
+    for (uint32_t i = 0; i < 64; ++i) {
+        EXPECT_NE(softMixer.play(sound, params), AudioSoftMixer::INVALID_VOICE);
+    }
+
+    // The pool is full: a lower priority voice is rejected, a higher one steals a slot.
+    params.priority = -1;
+    EXPECT_EQ(softMixer.play(sound, params), AudioSoftMixer::INVALID_VOICE);
+    params.priority = 1;
+    const auto important = softMixer.play(sound, params);
+    EXPECT_NE(important, AudioSoftMixer::INVALID_VOICE);
+
+    ccstd::vector<float> block(512 * 2);
+    softMixer.mix(block.data(), 512);
+    auto stats = softMixer.getStats();
+    EXPECT_EQ(stats.activeVoices, 64);
+    EXPECT_EQ(stats.mixedVoices, 16);
+    EXPECT_EQ(stats.virtualVoices, 48);
+    EXPECT_EQ(stats.stolenVoices, 1);
+    EXPECT_EQ(stats.rejectedVoices, 1);
+    EXPECT_TRUE(softMixer.isPlaying(important));
+
+    // Virtual voices keep advancing and finish with the mixed ones.
+    for (uint32_t i = 0; i < 64; ++i) {
+        softMixer.mix(block.data(), 512);
+    }
+    EXPECT_EQ(softMixer.getStats().activeVoices, 0);
+    EXPECT_FALSE(softMixer.isPlaying(important));
+}
+
+TEST(audioSoftMixer, renderToWav) {
+    AudioSoftMixer softMixer(SAMPLE_RATE, 256, 32);
+    const auto pcm = makeSine(SAMPLE_RATE / 10, 880.F, SAMPLE_RATE);
+    const auto sound = softMixer.addSound(pcm.data(), static_cast<uint32_t>(pcm.size()), 1, SAMPLE_RATE);
+    AudioSoftMixer::VoiceParams params;
+    params.volume = 0.01F;
+    for (uint32_t i = 0; i < 200; ++i) {
+        params.pan = static_cast<float>(i % 21) / 10.F - 1.F;
+        params.pitch = 0.5F + static_cast<float>(i % 8) * 0.25F;
+        softMixer.play(sound, params);
+    }
+
+    const ccstd::string path = "audio_soft_mixer_test.wav";
+    const uint32_t frames = SAMPLE_RATE / 2;
+    ASSERT_TRUE(softMixer.renderToWav(path, frames));
+
+    FILE *fp = fopen(path.c_str(), "rb");
+    ASSERT_NE(fp, nullptr);
+    fseek(fp, 0, SEEK_END);
+    EXPECT_EQ(ftell(fp), 44 + frames * 4);
+    fclose(fp);
+    remove(path.c_str());
+}
@@ -0,0 +1,157 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "cocos/base/Scheduler.h"
+#include "gtest/gtest.h"
+
+using cc::InlineTask;
+using cc::Scheduler;
+using cc::TaskPriority;
+
+TEST(InlineTaskTest, storage) {
+    int value = 0;
+    InlineTask small([&value]() { ++value; });
+    EXPECT_TRUE(small.isInline());
+
+    std::array<char, 128> payload{};
+    payload[0] = 2;
+    InlineTask large([&value, payload]() { value += payload[0]; });
+    EXPECT_FALSE(large.isInline());
+
+    auto counter = std::make_shared<int>(0);
+    InlineTask moveOnly([counter = std::unique_ptr<int>(new int(3)), &value]() { value += *counter; });
+    EXPECT_TRUE(moveOnly.isInline());
+
+    InlineTask moved(std::move(large));
+    EXPECT_FALSE(static_cast<bool>(large)); // NOLINT(bugprone-use-after-move)
+    small();
+    moved();
+    moveOnly();
+    EXPECT_EQ(value, 6);
+
+    {
+        InlineTask task([counter]() {});
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(SchedulerPerformTest, keepsOrderPerThread) {
+    Scheduler scheduler;
+    constexpr int THREAD_COUNT = 4;
+    constexpr int TASK_COUNT = 1000;
+    std::array<int, THREAD_COUNT> last{};
+    bool ordered = true;
+    std::array<std::thread, THREAD_COUNT> threads;
+    for (int t = 0; t < THREAD_COUNT; ++t) {
+        threads[t] = std::thread([&, t]() {
+            for (int i = 0; i < TASK_COUNT; ++i) {
+                scheduler.performFunctionInCocosThread([&, t, i]() {
+                    ordered = ordered && last[t] == i;
+                    last[t] = i + 1;
+                });
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(scheduler.getPendingFunctionCount(), THREAD_COUNT * TASK_COUNT);
+    scheduler.setPerformFunctionTimeBudget(1000.F);
+    scheduler.update(0.F);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(scheduler.getPendingFunctionCount(), 0);
+    for (auto count : last) {
+        EXPECT_EQ(count, TASK_COUNT);
+    }
+}
+
+TEST(SchedulerPerformTest, priorityLanes) {
+    Scheduler scheduler;
+    ccstd::vector<int> order;
+    scheduler.performFunctionInCocosThread([&]() { order.push_back(2); }, TaskPriority::LOW);
+    scheduler.performFunctionInCocosThread([&]() { order.push_back(1); });
+    scheduler.performFunctionInCocosThread([&]() { order.push_back(0); }, TaskPriority::HIGH);
+    scheduler.update(0.F);
+    EXPECT_EQ(order, (ccstd::vector<int>{0, 1, 2}));
+}
+
+TEST(SchedulerPerformTest, timeBudget) {
+    Scheduler scheduler;
+    scheduler.setPerformFunctionTimeBudget(0.F);
+    int high = 0;
+    int normal = 0;
+    int low = 0;
+    for (int i = 0; i < 10; ++i) {
+        scheduler.performFunctionInCocosThread([&]() { ++high; }, TaskPriority::HIGH);
+        scheduler.performFunctionInCocosThread([&]() { ++normal; });
+        scheduler.performFunctionInCocosThread([&]() { ++low; }, TaskPriority::LOW);
+    }
+    // the HIGH lane ignores the budget, the others perform one function at least
+    scheduler.update(0.F);
+    EXPECT_EQ(high, 10);
+    EXPECT_EQ(normal, 1);
+    EXPECT_EQ(low, 1);
+    EXPECT_EQ(scheduler.getPendingFunctionCount(), 18);
+
+    scheduler.setPerformFunctionTimeBudget(1000.F);
+    scheduler.update(0.F);
+    EXPECT_EQ(normal, 10);
+    EXPECT_EQ(low, 10);
+}
+
+TEST(SchedulerPerformTest, repostedFunctionsWaitForNextFrame) {
+    Scheduler scheduler;
+    int count = 0;
+    std::function<void()> repost = [&]() {
+        ++count;
+        scheduler.performFunctionInCocosThread(repost, TaskPriority::HIGH);
+    };
+    scheduler.performFunctionInCocosThread(repost, TaskPriority::HIGH);
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 1);
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 2);
+    scheduler.removeAllFunctionsToBePerformedInCocosThread();
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 2);
+}
+
+TEST(SchedulerPerformTest, removeAll) {
+    Scheduler scheduler;
+    auto counter = std::make_shared<int>(0);
+    for (int i = 0; i < 40; ++i) {
+        scheduler.performFunctionInCocosThread([counter]() { ++*counter; }, static_cast<TaskPriority>(i % 3));
+    }
+    EXPECT_EQ(counter.use_count(), 41);
+    scheduler.removeAllFunctionsToBePerformedInCocosThread();
+    EXPECT_EQ(counter.use_count(), 1);
+    EXPECT_EQ(scheduler.getPendingFunctionCount(), 0);
+    scheduler.update(0.F);
+    EXPECT_EQ(*counter, 0);
+}
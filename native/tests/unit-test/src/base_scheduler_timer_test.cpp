@@ -0,0 +1,317 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <memory>
+#include <random>
+#include "cocos/base/Scheduler.h"
+#include "cocos/base/TimerWheel.h"
+#include "gtest/gtest.h"
+
+using cc::Scheduler;
+using cc::TimerWheel;
+
+namespace {
+
+struct TestNode : TimerWheel::Node {
+    uint64_t expiredAt{0};
+    bool expired{false};
+};
+
+} // namespace
+
+TEST(TimerWheelTest, expiresAtTick) {
+    constexpr size_t NODE_COUNT = 2000;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<uint64_t> distribution(0, 1 << 18);
+
+    TimerWheel wheel;
+    ccstd::vector<TestNode> nodes(NODE_COUNT);
+    for (auto &node : nodes) {
+        wheel.insert(&node, distribution(random));
+    }
+    // removed nodes never expire
+    for (size_t i = 0; i < NODE_COUNT; i += 10) {
+        wheel.remove(&nodes[i]);
+    }
+    EXPECT_EQ(wheel.size(), NODE_COUNT - NODE_COUNT / 10);
+
+    std::uniform_int_distribution<uint64_t> step(0, 3000);
+    while (!wheel.empty()) {
+        const uint64_t tick = wheel.getCurrentTick() + step(random);
+        wheel.advance(tick, [&](TimerWheel::Node *node) {
+            auto *testNode = static_cast<TestNode *>(node);
+            EXPECT_FALSE(testNode->isLinked());
+            testNode->expired = true;
+            testNode->expiredAt = tick;
+        });
+        EXPECT_EQ(wheel.getCurrentTick(), tick);
+    }
+
+    for (size_t i = 0; i < NODE_COUNT; ++i) {
+        const auto &node = nodes[i];
+        if (i % 10 == 0) {
+            EXPECT_FALSE(node.expired);
+            continue;
+        }
+        // expired in the first advance that reached its tick
+        EXPECT_TRUE(node.expired);
+        EXPECT_GE(node.expiredAt, node.tick);
+        EXPECT_LT(node.expiredAt - node.tick, 3001);
+    }
+}
+
+TEST(TimerWheelTest, reinsertFromCallback) {
+    TimerWheel wheel;
+    TestNode node;
+    wheel.insert(&node, 5);
+    int count = 0;
+    for (uint64_t tick = 1; tick <= 20; ++tick) {
+        wheel.advance(tick, [&](TimerWheel::Node *expired) {
+            ++count;
+            // the current tick expires in the next advance
+            wheel.insert(expired, wheel.getCurrentTick());
+        });
+    }
+    EXPECT_EQ(count, 16);
+    EXPECT_EQ(wheel.size(), 1);
+    wheel.remove(&node);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(SchedulerTimerTest, interval) {
+    Scheduler scheduler;
+    int target = 0;
+    int count = 0;
+    scheduler.schedule([&](float dt) {
+        EXPECT_FLOAT_EQ(dt, 0.25F);
+        ++count;
+    },
+                       &target, 0.25F, false, "interval");
+    // timers start counting from the next update
+    scheduler.update(1.F);
+    EXPECT_EQ(count, 0);
+    for (int i = 0; i < 8; ++i) {
+        scheduler.update(0.125F);
+    }
+    EXPECT_EQ(count, 4);
+    // catch up with the intervals of a long frame
+    scheduler.update(1.F);
+    EXPECT_EQ(count, 8);
+    EXPECT_TRUE(scheduler.isScheduled("interval", &target));
+}
+
+TEST(SchedulerTimerTest, everyFrame) {
+    Scheduler scheduler;
+    int target = 0;
+    float total = 0.F;
+    scheduler.schedule([&](float dt) { total += dt; }, &target, 0.F, 2, 0.F, false, "frame");
+    scheduler.update(0.5F);
+    EXPECT_FLOAT_EQ(total, 0.F);
+    scheduler.update(0.125F);
+    scheduler.update(0.25F);
+    scheduler.update(0.5F);
+    EXPECT_FLOAT_EQ(total, 0.875F);
+    // repeated 2 times after the first one
+    scheduler.update(0.5F);
+    EXPECT_FLOAT_EQ(total, 0.875F);
+    EXPECT_FALSE(scheduler.isScheduled("frame", &target));
+}
+
+TEST(SchedulerTimerTest, delayAndRepeat) {
+    Scheduler scheduler;
+    int target = 0;
+    ccstd::vector<float> triggers;
+    scheduler.schedule([&](float dt) { triggers.push_back(dt); }, &target, 0.25F, 2, 0.5F, false, "delay");
+    scheduler.update(0.F);
+    for (int i = 0; i < 16; ++i) {
+        scheduler.update(0.125F);
+    }
+    EXPECT_EQ(triggers, (ccstd::vector<float>{0.5F, 0.25F, 0.25F}));
+    EXPECT_FALSE(scheduler.isScheduled("delay", &target));
+}
+
+TEST(SchedulerTimerTest, unscheduleFromCallback) {
+    Scheduler scheduler;
+    int target = 0;
+    int first = 0;
+    int second = 0;
+    scheduler.schedule([&](float /*dt*/) {
+        ++first;
+        scheduler.unschedule("first", &target);
+        scheduler.schedule([&](float /*dt*/) { ++second; }, &target, 0.125F, false, "second");
+    },
+                       &target, 0.125F, false, "first");
+    scheduler.update(0.F);
+    scheduler.update(0.125F);
+    EXPECT_EQ(first, 1);
+    EXPECT_FALSE(scheduler.isScheduled("first", &target));
+    EXPECT_TRUE(scheduler.isScheduled("second", &target));
+    scheduler.update(0.125F);
+    scheduler.update(0.125F);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 2);
+
+    scheduler.unscheduleAllForTarget(&target);
+    EXPECT_FALSE(scheduler.isScheduled("second", &target));
+}
+
+TEST(SchedulerTimerTest, pauseKeepsRemainingTime) {
+    Scheduler scheduler;
+    int target = 0;
+    int count = 0;
+    scheduler.schedule([&](float /*dt*/) { ++count; }, &target, 1.F, false, "pause");
+    scheduler.update(0.F);
+    scheduler.update(0.75F);
+    scheduler.pauseTarget(&target);
+    EXPECT_TRUE(scheduler.isTargetPaused(&target));
+    scheduler.update(10.F);
+    EXPECT_EQ(count, 0);
+    scheduler.resumeTarget(&target);
+    scheduler.update(0.125F);
+    EXPECT_EQ(count, 0);
+    scheduler.update(0.125F);
+    EXPECT_EQ(count, 1);
+}
+
+TEST(SchedulerTimerTest, pauseFromCallbackCountsRepeat) {
+    Scheduler scheduler;
+    int target = 0;
+    int count = 0;
+    // runs twice, each run pauses its target
+    scheduler.schedule([&](float /*dt*/) {
+        ++count;
+        scheduler.pauseTarget(&target);
+    },
+                       &target, 0.25F, 1, 0.F, false, "repeat");
+    scheduler.update(0.F);
+    for (int i = 0; i < 8; ++i) {
+        scheduler.update(0.25F);
+        scheduler.resumeTarget(&target);
+    }
+    EXPECT_EQ(count, 2);
+    EXPECT_FALSE(scheduler.isScheduled("repeat", &target));
+}
+
+TEST(SchedulerTimerTest, updateInterval) {
+    Scheduler scheduler;
+    int target = 0;
+    int count = 0;
+    auto callback = [&](float /*dt*/) { ++count; };
+    scheduler.schedule(callback, &target, 0.F, false, "update");
+    scheduler.update(0.F);
+    scheduler.update(0.125F);
+    EXPECT_EQ(count, 1);
+    // scheduling the same key only updates the interval
+    scheduler.schedule(callback, &target, 0.5F, false, "update");
+    scheduler.update(0.125F);
+    for (int i = 0; i < 4; ++i) {
+        scheduler.update(0.125F);
+    }
+    EXPECT_EQ(count, 2);
+}
+
+TEST(SchedulerTimerTest, internedKeys) {
+    const uint32_t key = Scheduler::internKey("interned");
+    EXPECT_NE(key, 0);
+    EXPECT_EQ(Scheduler::internKey("interned"), key);
+    EXPECT_NE(Scheduler::internKey("other"), key);
+    EXPECT_EQ(Scheduler::getKeyName(key), "interned");
+    EXPECT_EQ(Scheduler::internKey(""), 0);
+
+    Scheduler scheduler;
+    int target = 0;
+    scheduler.schedule([](float /*dt*/) {}, &target, 1.F, false, key);
+    EXPECT_TRUE(scheduler.isScheduled("interned", &target));
+    EXPECT_TRUE(scheduler.isScheduled(key, &target));
+    EXPECT_FALSE(scheduler.isScheduled("never interned", &target));
+    scheduler.unschedule("interned", &target);
+    EXPECT_FALSE(scheduler.isScheduled(key, &target));
+}
+
+TEST(SchedulerTimerTest, releasesUniqueKeys) {
+    Scheduler scheduler;
+    int targets[2] = {};
+    auto callback = [](float /*dt*/) {};
+    const size_t keyCount = Scheduler::getKeyCount();
+
+    // keys built from a pointer, like the ones of downloaders
+    for (int i = 0; i < 100; ++i) {
+        const ccstd::string key = "instance(" + std::to_string(i) + ")";
+        scheduler.schedule(callback, &targets[0], 0.F, false, key);
+        scheduler.schedule(callback, &targets[1], 0.F, false, key);
+        scheduler.update(0.F);
+        EXPECT_EQ(Scheduler::getKeyCount(), keyCount + 1);
+        scheduler.unschedule(key, &targets[0]);
+        EXPECT_EQ(Scheduler::getKeyCount(), keyCount + 1);
+        EXPECT_TRUE(scheduler.isScheduled(key, &targets[1]));
+        scheduler.unschedule(key, &targets[1]);
+        EXPECT_EQ(Scheduler::getKeyCount(), keyCount);
+    }
+
+    // interned keys stay valid after their timers are gone
+    const uint32_t key = Scheduler::internKey("pinned");
+    scheduler.schedule(callback, &targets[0], 0.F, false, "pinned");
+    scheduler.unscheduleAll();
+    scheduler.update(0.F);
+    EXPECT_EQ(Scheduler::internKey("pinned"), key);
+    EXPECT_EQ(Scheduler::getKeyName(key), "pinned");
+}
+
+TEST(SchedulerTimerTest, releasesCallbacks) {
+    auto counter = std::make_shared<int>(0);
+    {
+        Scheduler scheduler;
+        int targets[2] = {};
+        scheduler.schedule([counter](float /*dt*/) {}, &targets[0], 1.F, false, "release");
+        scheduler.schedule([counter](float /*dt*/) {}, &targets[1], 0.F, false, "release");
+        EXPECT_EQ(counter.use_count(), 3);
+        scheduler.unschedule("release", &targets[0]);
+        EXPECT_EQ(counter.use_count(), 2);
+        scheduler.update(0.F);
+        scheduler.unscheduleAll();
+        scheduler.update(0.F);
+        EXPECT_EQ(counter.use_count(), 1);
+        scheduler.schedule([counter](float /*dt*/) {}, &targets[0], 1.F, false, "release");
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(SchedulerTimerTest, manyTimers) {
+    constexpr int TIMER_COUNT = 20000;
+    Scheduler scheduler;
+    ccstd::vector<int> counts(TIMER_COUNT);
+    for (int i = 0; i < TIMER_COUNT; ++i) {
+        // intervals from 1/64 to 64 seconds
+        const float interval = static_cast<float>(1 + i % 4096) / 64.F;
+        scheduler.schedule([&counts, i](float /*dt*/) { ++counts[i]; }, &counts[i], interval, false, "many");
+    }
+    scheduler.update(0.F);
+    // 128 seconds at 64 fps
+    for (int frame = 0; frame < 128 * 64; ++frame) {
+        scheduler.update(1.F / 64.F);
+    }
+    for (int i = 0; i < TIMER_COUNT; ++i) {
+        EXPECT_EQ(counts[i], 128 * 64 / (1 + i % 4096)) << i;
+    }
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include "bindings/dop/ScriptBufferArena.h"
+#include "bindings/jswrapper/SeApi.h"
+#include "gtest/gtest.h"
+
+using se::ScriptBuffer;
+using se::ScriptBufferArena;
+
+namespace {
+
+uint32_t readGeneration(uint32_t slot) {
+    uint8_t *data = nullptr;
+    size_t length = 0;
+    ScriptBufferArena::getInstance().getGenerationTable()->getTypedArrayData(&data, &length);
+    EXPECT_LT(slot * sizeof(uint32_t), length);
+    return reinterpret_cast<const uint32_t *>(data)[slot];
+}
+
+} // namespace
+
+TEST(scriptBuffer, growsInPlace) {
+    const auto before = ScriptBufferArena::getInstance().getStatistics();
+    ScriptBuffer buffer(64 * 1024, 1024 * 1024);
+    uint8_t *data = buffer.getData();
+    for (uint32_t i = 0; i < buffer.getByteLength(); ++i) {
+        EXPECT_EQ(data[i], 0);
+        data[i] = static_cast<uint8_t>(i);
+    }
+    const uint32_t generation = buffer.getGeneration();
+
+    buffer.resize(512 * 1024);
+    EXPECT_EQ(buffer.getData(), data);
+    EXPECT_EQ(buffer.getByteLength(), 512 * 1024);
+    EXPECT_GT(buffer.getGeneration(), generation);
+    for (uint32_t i = 0; i < 64 * 1024; ++i) {
+        ASSERT_EQ(data[i], static_cast<uint8_t>(i));
+    }
+    // newly committed memory is zeroed and writable
+    EXPECT_EQ(data[buffer.getByteLength() - 1], 0);
+    data[buffer.getByteLength() - 1] = 1;
+
+    const auto &stats = ScriptBufferArena::getInstance().getStatistics();
+    EXPECT_EQ(stats.growCount, before.growCount + 1);
+    EXPECT_EQ(stats.moveCount, before.moveCount);
+    EXPECT_EQ(stats.bufferCount, before.bufferCount + 1);
+}
+
+TEST(scriptBuffer, movesBeyondReservation) {
+    const auto before = ScriptBufferArena::getInstance().getStatistics();
+    ScriptBuffer buffer(16, 16);
+    memcpy(buffer.getData(), "0123456789abcdef", 16);
+    const uint32_t generation = buffer.getGeneration();
+
+    buffer.resize(256 * 1024);
+    EXPECT_EQ(buffer.getByteLength(), 256 * 1024);
+    EXPECT_GE(buffer.getReservedLength(), 256 * 1024);
+    EXPECT_EQ(memcmp(buffer.getData(), "0123456789abcdef", 16), 0);
+    EXPECT_GT(buffer.getGeneration(), generation);
+    EXPECT_EQ(ScriptBufferArena::getInstance().getStatistics().moveCount, before.moveCount + 1);
+}
+
+TEST(scriptBuffer, releasesMemory) {
+    const auto before = ScriptBufferArena::getInstance().getStatistics();
+    {
+        ScriptBuffer buffer(1024);
+        EXPECT_EQ(ScriptBufferArena::getInstance().getStatistics().bufferCount, before.bufferCount + 1);
+    }
+    EXPECT_EQ(ScriptBufferArena::getInstance().getStatistics().bufferCount, before.bufferCount);
+    EXPECT_EQ(ScriptBufferArena::getInstance().getStatistics().reservedBytes, before.reservedBytes);
+    EXPECT_EQ(ScriptBufferArena::getInstance().getStatistics().committedBytes, before.committedBytes);
+}
+
+TEST(scriptBuffer, reusesSlots) {
+    uint32_t slot = ScriptBuffer::INVALID_SLOT;
+    uint32_t generation = 0;
+    {
+        ScriptBuffer buffer(1024);
+        slot = buffer.getSlot();
+        ASSERT_LT(slot, ScriptBufferArena::GENERATION_TABLE_SIZE);
+        buffer.resize(4096);
+        generation = buffer.getGeneration();
+        EXPECT_EQ(readGeneration(slot), generation);
+    }
+
+    // a script still holding the generation of the destroyed buffer sees the new one as changed
+    ScriptBuffer buffer(1024);
+    EXPECT_EQ(buffer.getSlot(), slot);
+    EXPECT_GT(buffer.getGeneration(), generation);
+    EXPECT_EQ(readGeneration(slot), buffer.getGeneration());
+}
+
+TEST(scriptBuffer, recreatesViewOnlyAfterGrowth) {
+    const auto before = ScriptBufferArena::getInstance().getStatistics();
+    ScriptBuffer buffer(4096, 64 * 1024);
+
+    se::Object *view = buffer.getTypedArray(se::Object::TypedArrayType::FLOAT32);
+    ASSERT_NE(view, nullptr);
+    EXPECT_EQ(buffer.getTypedArray(se::Object::TypedArrayType::FLOAT32), view);
+    EXPECT_EQ(readGeneration(buffer.getSlot()), buffer.getGeneration());
+
+    uint8_t *data = nullptr;
+    size_t length = 0;
+    ASSERT_TRUE(view->getTypedArrayData(&data, &length));
+    EXPECT_EQ(data, buffer.getData());
+    EXPECT_EQ(length, 4096);
+
+    buffer.resize(8192);
+    EXPECT_EQ(readGeneration(buffer.getSlot()), buffer.getGeneration());
+    se::Object *grown = buffer.getTypedArray(se::Object::TypedArrayType::FLOAT32);
+    ASSERT_TRUE(grown->getTypedArrayData(&data, &length));
+    EXPECT_EQ(data, buffer.getData());
+    EXPECT_EQ(length, 8192);
+
+    const auto &stats = ScriptBufferArena::getInstance().getStatistics();
+    EXPECT_EQ(stats.viewsCreated, before.viewsCreated + 2);
+    EXPECT_EQ(stats.viewsReused, before.viewsReused + 1);
+}
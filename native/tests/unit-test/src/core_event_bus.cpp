@@ -1,4 +1,5 @@
 #include "core/event/EventBus.h"
+#include "engine/EngineEvents.h"
 #include "utils.h"
 namespace {
 DECLARE_EVENT_BUS(Test1)
@@ -210,3 +211,144 @@ TEST(eventBus, del_event_bus_in_listener) {
     // delete listener_2;
     delete listener_3;
 }
+
+TEST(eventBus, listeners_keep_order_after_removal) {
+    std::vector<std::unique_ptr<BusEvent1_Test1::Listener>> listeners;
+    std::vector<int> calls;
+    for (int i = 0; i < 8; i++) {
+        listeners.emplace_back(std::make_unique<BusEvent1_Test1::Listener>());
+        listeners.back()->bind([&calls, i](int) {
+            calls.push_back(i);
+        });
+    }
+    logLabel = "remove from the middle and the end";
+    listeners[1].reset();
+    listeners[4].reset();
+    listeners[5].reset();
+    listeners[7].reset();
+    BusEvent1_Test1::broadcast(0);
+    EXPECT_EQ(calls, (std::vector<int>{0, 2, 3, 6}));
+
+    logLabel = "added listeners go last";
+    listeners[1] = std::make_unique<BusEvent1_Test1::Listener>();
+    listeners[1]->bind([&calls](int) {
+        calls.push_back(100);
+    });
+    calls.clear();
+    BusEvent1_Test1::broadcast(0);
+    EXPECT_EQ(calls, (std::vector<int>{0, 2, 3, 6, 100}));
+}
+
+TEST(eventBus, remove_listeners_in_listener) {
+    std::vector<std::unique_ptr<BusEvent1_Test1::Listener>> listeners(6);
+    std::vector<int> calls;
+    for (int i = 0; i < 6; i++) {
+        listeners[i] = std::make_unique<BusEvent1_Test1::Listener>();
+        listeners[i]->bind([&, i](int) {
+            calls.push_back(i);
+            if (i == 2) {
+                // one that was called and one that is not called yet
+                listeners[1].reset();
+                listeners[3].reset();
+            }
+        });
+    }
+    BusEvent1_Test1::broadcast(0);
+    EXPECT_EQ(calls, (std::vector<int>{0, 1, 2, 4, 5}));
+    calls.clear();
+    BusEvent1_Test1::broadcast(0);
+    EXPECT_EQ(calls, (std::vector<int>{0, 2, 4, 5}));
+}
+
+TEST(eventBus, nested_broadcast_skips_added_listeners) {
+    BusEvent1_Test1::Listener outer;
+    std::unique_ptr<BusEvent1_Test1::Listener> added;
+    int addedCalls = 0;
+    outer.bind([&](int depth) {
+        if (depth == 0) {
+            added = std::make_unique<BusEvent1_Test1::Listener>();
+            added->bind([&](int) {
+                addedCalls++;
+            });
+            // the same event from inside the broadcast still doesn't reach the new listener
+            BusEvent1_Test1::broadcast(1);
+        }
+    });
+    BusEvent1_Test1::broadcast(0);
+    EXPECT_EQ(addedCalls, 0);
+    BusEvent1_Test1::broadcast(1);
+    EXPECT_EQ(addedCalls, 1);
+}
+
+TEST(eventBus, deferred_broadcast_coalesces_events) {
+    BusEvent2_Test1::Listener listener;
+    std::vector<std::pair<int, const char *>> calls;
+    listener.bind([&](int n, const char *s) {
+        calls.emplace_back(n, s);
+    });
+    const char *a = "a";
+    const char *b = "b";
+    BusEvent2_Test1::broadcastDeferred(1, a);
+    BusEvent2_Test1::broadcastDeferred(2, a);
+    BusEvent2_Test1::broadcastDeferred(1, a);
+    BusEvent2_Test1::broadcastDeferred(1, b);
+    EXPECT_TRUE(calls.empty());
+
+    cc::event::flushDeferredBroadcasts();
+    ASSERT_EQ(calls.size(), 3U);
+    EXPECT_EQ(calls[0], std::make_pair(1, a));
+    EXPECT_EQ(calls[1], std::make_pair(2, a));
+    EXPECT_EQ(calls[2], std::make_pair(1, b));
+
+    logLabel = "queue is empty after flush";
+    cc::event::flushDeferredBroadcasts();
+    EXPECT_EQ(calls.size(), 3U);
+
+    logLabel = "same event can be queued again in the next frame";
+    BusEvent2_Test1::broadcastDeferred(1, a);
+    cc::event::flushDeferredBroadcasts();
+    EXPECT_EQ(calls.size(), 4U);
+}
+
+TEST(eventBus, deferred_broadcast_from_listener_goes_to_next_flush) {
+    BusEvent0_Test1::Listener listener;
+    int calls = 0;
+    listener.bind([&]() {
+        calls++;
+        BusEvent0_Test1::broadcastDeferred();
+    });
+    BusEvent0_Test1::broadcastDeferred();
+    BusEvent0_Test1::broadcastDeferred();
+    cc::event::flushDeferredBroadcasts();
+    EXPECT_EQ(calls, 1);
+    cc::event::flushDeferredBroadcasts();
+    EXPECT_EQ(calls, 2);
+    listener.reset();
+    cc::event::flushDeferredBroadcasts();
+}
+
+TEST(eventBus, deferred_broadcast_engine_events) {
+    // argument types without hash_value/operator== are queued without coalescing
+    cc::events::WindowEvent::Listener windowListener;
+    int windowCalls = 0;
+    windowListener.bind([&](const cc::WindowEvent &ev) {
+        EXPECT_EQ(ev.width, 10);
+        windowCalls++;
+    });
+    cc::WindowEvent ev;
+    ev.width = 10;
+    cc::events::WindowEvent::broadcastDeferred(ev);
+    cc::events::WindowEvent::broadcastDeferred(ev);
+
+    cc::events::Resize::Listener resizeListener;
+    int resizeCalls = 0;
+    resizeListener.bind([&](int, int, uint32_t) {
+        resizeCalls++;
+    });
+    cc::events::Resize::broadcastDeferred(1, 2, 0U);
+    cc::events::Resize::broadcastDeferred(1, 2, 0U);
+
+    cc::event::flushDeferredBroadcasts();
+    EXPECT_EQ(windowCalls, 2);
+    EXPECT_EQ(resizeCalls, 1);
+}
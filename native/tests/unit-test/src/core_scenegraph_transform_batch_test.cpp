@@ -0,0 +1,256 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include "base/Log.h"
+#include "base/std/container/vector.h"
+#include "bindings/jswrapper/SeApi.h"
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/NodeTransformBatch.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+constexpr uint32_t NODE_COUNT = 10000;
+constexpr uint32_t PARENT_COUNT = 100;
+constexpr uint32_t FRAME_COUNT = 10;
+
+template <typename Fn>
+double measureMs(const Fn &fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void pushPosition(Node *node, const Vec3 &position) {
+    auto &batch = NodeTransformBatch::getInstance();
+    batch.push(batch.getSlot(node), TransformBit::POSITION, position, Quaternion::identity(), Vec3::ONE);
+}
+
+void enableTransformEvents(Node *node) {
+    // the event mask is the first word of the memory shared with script
+    uint8_t *data = nullptr;
+    size_t length = 0;
+    ASSERT_TRUE(node->_getSharedArrayBufferObject()->getArrayBufferData(&data, &length));
+    *reinterpret_cast<uint32_t *>(data) |= Node::TRANSFORM_ON;
+}
+} // namespace
+
+TEST(nodeTransformBatch, appliesRecords) {
+    auto &batch = NodeTransformBatch::getInstance();
+    IntrusivePtr<Node> parent = ccnew Node();
+    IntrusivePtr<Node> child = ccnew Node();
+    child->setParent(parent);
+    parent->updateWorldTransform();
+
+    const auto slot = batch.getSlot(parent);
+    EXPECT_EQ(batch.getSlot(parent), slot);
+    Quaternion rotation;
+    Quaternion::fromEuler(0.F, 90.F, 0.F, &rotation);
+    batch.push(slot, TransformBit::POSITION | TransformBit::SCALE, Vec3(1.F, 2.F, 3.F), rotation, Vec3(2.F, 2.F, 2.F));
+    EXPECT_EQ(batch.size(), 1);
+
+    // later records of the same node win, fields not in the dirty bits are kept
+    batch.push(slot, TransformBit::ROTATION, Vec3::ZERO, rotation, Vec3::ONE);
+    EXPECT_EQ(batch.size(), 2);
+    EXPECT_EQ(batch.apply(), 2);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(parent->getPosition(), Vec3(1.F, 2.F, 3.F));
+    EXPECT_EQ(parent->getScale(), Vec3(2.F, 2.F, 2.F));
+    EXPECT_TRUE(parent->getRotation().approxEquals(rotation));
+
+    // the dirty bits reach the children once
+    EXPECT_EQ(child->getChangedFlags() & static_cast<uint32_t>(TransformBit::TRS), static_cast<uint32_t>(TransformBit::TRS));
+    EXPECT_TRUE(child->getWorldPosition().approxEquals(Vec3(1.F, 2.F, 3.F)));
+}
+
+TEST(nodeTransformBatch, appliedBeforeNativeAccess) {
+    IntrusivePtr<Node> node = ccnew Node();
+    node->updateWorldTransform();
+
+    pushPosition(node, Vec3(5.F, 0.F, 0.F));
+    EXPECT_TRUE(node->getWorldPosition().approxEquals(Vec3(5.F, 0.F, 0.F)));
+    EXPECT_TRUE(NodeTransformBatch::getInstance().empty());
+
+    // a native write after a batched one keeps its order
+    pushPosition(node, Vec3(6.F, 0.F, 0.F));
+    node->setPosition(7.F, 0.F, 0.F);
+    EXPECT_EQ(node->getPosition(), Vec3(7.F, 0.F, 0.F));
+}
+
+TEST(nodeTransformBatch, appliedBeforeLocalGetters) {
+    auto &batch = NodeTransformBatch::getInstance();
+    IntrusivePtr<Node> node = ccnew Node();
+    const auto slot = batch.getSlot(node);
+
+    pushPosition(node, Vec3(1.F, 2.F, 3.F));
+    EXPECT_EQ(node->getPosition(), Vec3(1.F, 2.F, 3.F));
+    EXPECT_TRUE(batch.empty());
+
+    Quaternion rotation;
+    Quaternion::fromEuler(0.F, 0.F, 30.F, &rotation);
+    batch.push(slot, TransformBit::ROTATION, Vec3::ZERO, rotation, Vec3::ONE);
+    EXPECT_NEAR(node->getAngle(), 30.F, 1e-4F);
+    batch.push(slot, TransformBit::ROTATION, Vec3::ZERO, Quaternion::identity(), Vec3::ONE);
+    EXPECT_TRUE(node->getRotation().approxEquals(Quaternion::identity()));
+
+    batch.push(slot, TransformBit::SCALE, Vec3::ZERO, Quaternion::identity(), Vec3(1.F, 1.F, 4.F));
+    // the 2D setter keeps the batched z
+    node->setScale(2.F, 3.F);
+    EXPECT_EQ(node->getScale(), Vec3(2.F, 3.F, 4.F));
+}
+
+TEST(nodeTransformBatch, listenerOverflowsBatch) {
+    auto &batch = NodeTransformBatch::getInstance();
+    IntrusivePtr<Node> node = ccnew Node();
+    IntrusivePtr<Node> other = ccnew Node();
+    enableTransformEvents(node);
+    const uint32_t capacity = batch.getCapacity();
+
+    // the listener fills the shared buffer and pushes more while the batch is applied
+    uint32_t events = 0;
+    node->on<Node::TransformChanged>([&](Node * /*emitter*/, TransformBit /*bits*/) {
+        if (events++ == 0) {
+            for (uint32_t i = 0; i <= capacity; ++i) {
+                pushPosition(other, Vec3(static_cast<float>(i), 0.F, 0.F));
+            }
+        }
+    });
+
+    pushPosition(node, Vec3(1.F, 0.F, 0.F));
+    EXPECT_EQ(batch.apply(), capacity + 2);
+    EXPECT_EQ(events, 1);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(other->getPosition(), Vec3(static_cast<float>(capacity), 0.F, 0.F));
+}
+
+TEST(nodeTransformBatch, destroyedNodeDropsRecords) {
+    auto &batch = NodeTransformBatch::getInstance();
+    IntrusivePtr<Node> node = ccnew Node();
+    const auto slot = batch.getSlot(node);
+    pushPosition(node, Vec3(1.F, 1.F, 1.F));
+    node = nullptr;
+
+    // the freed slot is reused, stale records must not reach the new node
+    IntrusivePtr<Node> other = ccnew Node();
+    EXPECT_EQ(batch.getSlot(other), slot);
+    batch.apply();
+    EXPECT_EQ(other->getPosition(), Vec3::ZERO);
+}
+
+TEST(nodeTransformBatch, appliesWhenFull) {
+    auto &batch = NodeTransformBatch::getInstance();
+    IntrusivePtr<Node> node = ccnew Node();
+    for (uint32_t i = 0; i <= batch.getCapacity(); ++i) {
+        pushPosition(node, Vec3(static_cast<float>(i), 0.F, 0.F));
+    }
+    // the full batch was applied by the last push, which started a new one
+    EXPECT_EQ(batch.size(), 1);
+    EXPECT_EQ(node->getPosition(), Vec3(static_cast<float>(batch.getCapacity()), 0.F, 0.F));
+    EXPECT_TRUE(batch.empty());
+}
+
+// Only the native side of the batch is covered, script bindings aren't registered in unit tests.
+TEST(nodeTransformBatch, matchesPerCallSetters) {
+    auto &batch = NodeTransformBatch::getInstance();
+    ccstd::vector<IntrusivePtr<Node>> parents;
+    for (uint32_t i = 0; i < PARENT_COUNT; ++i) {
+        parents.emplace_back(ccnew Node());
+    }
+    // nodes moved by the per-call setters and nodes moved by the batch end up with the same world transforms
+    ccstd::vector<IntrusivePtr<Node>> singleNodes;
+    ccstd::vector<IntrusivePtr<Node>> batchNodes;
+    ccstd::vector<uint32_t> slots;
+    for (uint32_t i = 0; i < NODE_COUNT; ++i) {
+        auto *single = ccnew Node();
+        single->setParent(parents[i % PARENT_COUNT]);
+        singleNodes.emplace_back(single);
+        auto *batched = ccnew Node();
+        batched->setParent(parents[i % PARENT_COUNT]);
+        batchNodes.emplace_back(batched);
+        slots.emplace_back(batch.getSlot(batched));
+    }
+
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        Node::resetChangedFlags();
+        const auto offset = static_cast<float>(frame);
+        Quaternion rotation;
+        Quaternion::fromEuler(0.F, offset * 10.F, 0.F, &rotation);
+        for (uint32_t i = 0; i < NODE_COUNT; ++i) {
+            Vec3 position{offset, static_cast<float>(i), 0.F};
+            Vec3 scale{1.F, 1.F, offset + 1.F};
+            singleNodes[i]->setRTS(&rotation, &position, &scale);
+            batch.push(slots[i], TransformBit::TRS, position, rotation, scale);
+        }
+        batch.apply();
+
+        for (uint32_t i = 0; i < NODE_COUNT; i += NODE_COUNT / PARENT_COUNT + 1) {
+            ASSERT_TRUE(batchNodes[i]->getWorldMatrix().approxEquals(singleNodes[i]->getWorldMatrix()));
+        }
+    }
+}
+
+TEST(nodeTransformBatch, DISABLED_applyBenchmark) {
+    auto &batch = NodeTransformBatch::getInstance();
+    ccstd::vector<IntrusivePtr<Node>> parents;
+    for (uint32_t i = 0; i < PARENT_COUNT; ++i) {
+        parents.emplace_back(ccnew Node());
+    }
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    ccstd::vector<uint32_t> slots;
+    for (uint32_t i = 0; i < NODE_COUNT; ++i) {
+        auto *node = ccnew Node();
+        node->setParent(parents[i % PARENT_COUNT]);
+        nodes.emplace_back(node);
+        slots.emplace_back(batch.getSlot(node));
+    }
+
+    double perCallMs = 0.0;
+    double batchMs = 0.0;
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        const auto offset = static_cast<float>(frame);
+        Quaternion rotation;
+        Quaternion::fromEuler(0.F, offset * 10.F, 0.F, &rotation);
+
+        Node::resetChangedFlags();
+        perCallMs += measureMs([&]() {
+            for (uint32_t i = 0; i < NODE_COUNT; ++i) {
+                nodes[i]->setPosition(offset, static_cast<float>(i), 0.F);
+                nodes[i]->setRotation(rotation);
+                nodes[i]->setScale(1.F, 1.F, offset + 1.F);
+            }
+        });
+
+        Node::resetChangedFlags();
+        batchMs += measureMs([&]() {
+            for (uint32_t i = 0; i < NODE_COUNT; ++i) {
+                batch.push(slots[i], TransformBit::TRS, Vec3{offset, static_cast<float>(i), 0.F}, rotation, Vec3{1.F, 1.F, offset + 1.F});
+            }
+            batch.apply();
+        });
+    }
+    CC_LOG_INFO("%u nodes: per-call setters %.3f ms, batched apply %.3f ms per frame",
+                NODE_COUNT, perCallMs / FRAME_COUNT, batchMs / FRAME_COUNT);
+}
@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <memory>
+#include "cocos/renderer/pipeline/custom/NativeExecutorRenderGraph.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// compiles until the cache settles, a new graph may feed back into the resource states once
+template <typename Compile>
+void settle(Compile &&compile, const cc::render::PipelineStatistics &statistics) {
+    for (uint32_t i = 0; i != 3; ++i) {
+        const auto hits = statistics.numRenderGraphCacheHits;
+        compile();
+        if (statistics.numRenderGraphCacheHits != hits) {
+            return;
+        }
+    }
+    FAIL() << "the compiled render graph is never reused";
+}
+
+} // namespace
+
+TEST(compiledRenderGraphCache, recompilesOnlyOnStructuralChange) {
+    TEST_CASE_1;
+
+    boost::container::pmr::memory_resource *resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    std::unique_ptr<FrameGraphDispatcher> cached;
+    PipelineStatistics statistics;
+    const auto compile = [&]() -> const FrameGraphDispatcher & {
+        return compileRenderGraph(cached, rescGraph, renderGraph, layoutGraphData, resource, statistics);
+    };
+
+    compile();
+    EXPECT_EQ(statistics.numRenderGraphCompiles, 1U);
+    EXPECT_EQ(statistics.numRenderGraphCacheHits, 0U);
+    settle(compile, statistics);
+
+    // an identical graph reuses the dispatcher
+    const auto *dispatcher = &compile();
+    auto compiles = statistics.numRenderGraphCompiles;
+    auto hits = statistics.numRenderGraphCacheHits;
+    EXPECT_EQ(&compile(), dispatcher);
+    EXPECT_EQ(statistics.numRenderGraphCompiles, compiles);
+    EXPECT_EQ(statistics.numRenderGraphCacheHits, hits + 1);
+
+    const auto expectRecompile = [&](const char *change) {
+        compiles = statistics.numRenderGraphCompiles;
+        hits = statistics.numRenderGraphCacheHits;
+        compile();
+        EXPECT_EQ(statistics.numRenderGraphCompiles, compiles + 1) << change;
+        EXPECT_EQ(statistics.numRenderGraphCacheHits, hits) << change;
+        settle(compile, statistics);
+    };
+
+    ASSERT_EQ(renderGraph.sortedVertices.size(), 2U);
+    const auto firstPass = renderGraph.sortedVertices[0];
+    const auto lastPass = renderGraph.sortedVertices[1];
+
+    // pass
+    auto &raster = get(RasterPassTag{}, lastPass, renderGraph);
+    ASSERT_FALSE(raster.rasterViews.empty());
+    raster.rasterViews.begin()->second.storeOp = cc::gfx::StoreOp::DISCARD;
+    expectRecompile("pass");
+
+    // edge
+    add_edge(firstPass, lastPass, renderGraph);
+    expectRecompile("edge");
+
+    // resource descriptor
+    const auto resID = findVertex(ccstd::pmr::string("3", resource), rescGraph);
+    ASSERT_NE(resID, ResourceGraph::null_vertex());
+    get(ResourceGraph::DescTag{}, rescGraph, resID).width = 1920;
+    expectRecompile("resource descriptor");
+
+    // resource state
+    auto &states = get(ResourceGraph::StatesTag{}, rescGraph, resID).states;
+    states = states == AccessFlagBit::TRANSFER_READ ? AccessFlagBit::TRANSFER_WRITE : AccessFlagBit::TRANSFER_READ;
+    expectRecompile("resource state");
+
+    // once settled the changed graph is reused again
+    compiles = statistics.numRenderGraphCompiles;
+    compile();
+    EXPECT_EQ(statistics.numRenderGraphCompiles, compiles);
+}
@@ -0,0 +1,240 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/gfx-base/GFXPersistentCache.h"
+#include "gtest/gtest.h"
+
+using cc::gfx::PersistentCache;
+using cc::gfx::PersistentCacheInfo;
+
+namespace {
+
+class PersistentCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // the headless test runner creates an empty device
+        _device = cc::gfx::Device::getInstance();
+        ASSERT_NE(_device, nullptr);
+        _path = testing::TempDir() + "gfx_persistent_cache_test.bin";
+        std::remove(_path.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(_path.c_str());
+    }
+
+    PersistentCacheInfo makeInfo(uint32_t maxSize = 1024U) const {
+        PersistentCacheInfo info;
+        info.path = _path;
+        info.identity = PersistentCache::makeIdentity(*_device);
+        info.maxSize = maxSize;
+        return info;
+    }
+
+    static ccstd::vector<char> makeData(uint32_t size, char value) {
+        return ccstd::vector<char>(size, value);
+    }
+
+    ccstd::string readFile() const {
+        std::ifstream ifs(_path, std::ios::binary);
+        return ccstd::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const ccstd::string &content) const {
+        std::ofstream ofs(_path, std::ios::binary | std::ios::trunc);
+        ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    // stores a single item and overwrites the 32 bit length found at offset in the file
+    void writeCorruptedLength(std::function<size_t(const ccstd::string &)> offset, uint32_t length) {
+        {
+            PersistentCache cache(makeInfo());
+            const auto data = makeData(64, 'g');
+            cache.store("shader", 1, data.data(), static_cast<uint32_t>(data.size()));
+        }
+        auto content = readFile();
+        const size_t pos = offset(content);
+        ASSERT_LE(pos + sizeof(length), content.size());
+        memcpy(&content[pos], &length, sizeof(length));
+        writeFile(content);
+    }
+
+    cc::gfx::Device *_device{nullptr};
+    ccstd::string _path;
+};
+
+// reaches the driver strings a backend fills in while it initializes
+struct DriverStrings : cc::gfx::Device {
+    static ccstd::string &renderer(cc::gfx::Device &device) { return device.*(&DriverStrings::_renderer); }
+    static ccstd::string &vendor(cc::gfx::Device &device) { return device.*(&DriverStrings::_vendor); }
+    static ccstd::string &version(cc::gfx::Device &device) { return device.*(&DriverStrings::_version); }
+};
+
+} // namespace
+
+TEST_F(PersistentCacheTest, saveAndLoad) {
+    {
+        PersistentCache cache(makeInfo());
+        const auto data = makeData(100, 'a');
+        cache.store("shader", 7, data.data(), static_cast<uint32_t>(data.size()));
+        EXPECT_TRUE(cache.flush());
+    }
+    PersistentCache cache(makeInfo());
+    ccstd::vector<char> data;
+    EXPECT_TRUE(cache.load("shader", 7, data));
+    EXPECT_EQ(data, makeData(100, 'a'));
+    EXPECT_FALSE(cache.load("missing", 7, data));
+    EXPECT_EQ(cache.getCount(), 1);
+    EXPECT_EQ(cache.getSize(), 100);
+}
+
+TEST_F(PersistentCacheTest, hashMismatchDropsItem) {
+    PersistentCache cache(makeInfo());
+    const auto data = makeData(10, 'b');
+    cache.store("shader", 1, data.data(), static_cast<uint32_t>(data.size()));
+    ccstd::vector<char> out;
+    EXPECT_FALSE(cache.load("shader", 2, out));
+    EXPECT_EQ(cache.getCount(), 0);
+    EXPECT_FALSE(cache.load("shader", 1, out));
+}
+
+TEST_F(PersistentCacheTest, identityMismatchInvalidates) {
+    {
+        PersistentCache cache(makeInfo());
+        const auto data = makeData(10, 'c');
+        cache.store("shader", 1, data.data(), static_cast<uint32_t>(data.size()));
+    } // flushed on destruction
+    {
+        auto info = makeInfo();
+        info.identity += "|driver update";
+        PersistentCache cache(std::move(info));
+        ccstd::vector<char> out;
+        EXPECT_FALSE(cache.load("shader", 1, out));
+        EXPECT_EQ(cache.getCount(), 0);
+        EXPECT_TRUE(cache.flush());
+    }
+    // the file has been rewritten for the new identity
+    PersistentCache cache(makeInfo());
+    EXPECT_EQ(cache.getCount(), 0);
+}
+
+TEST_F(PersistentCacheTest, corruptedFileIsIgnored) {
+    {
+        PersistentCache cache(makeInfo());
+        const auto data = makeData(64, 'd');
+        cache.store("shader", 1, data.data(), static_cast<uint32_t>(data.size()));
+    }
+    // truncate the item data
+    const auto content = readFile();
+    writeFile(content.substr(0, content.size() - 8));
+    PersistentCache cache(makeInfo());
+    EXPECT_EQ(cache.getCount(), 0);
+}
+
+TEST_F(PersistentCacheTest, oversizedDataLengthIsIgnored) {
+    // the data size is stored right in front of the data
+    writeCorruptedLength([](const ccstd::string &content) { return content.size() - 64 - sizeof(uint32_t); }, 0xFFFFFFF0U);
+    PersistentCache cache(makeInfo());
+    EXPECT_EQ(cache.getCount(), 0);
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST_F(PersistentCacheTest, dataLengthOverMaxSizeIsIgnored) {
+    // fits in the file, but not in a cache allowing 32 bytes
+    writeCorruptedLength([](const ccstd::string &content) { return content.size() - 64 - sizeof(uint32_t); }, 64);
+    PersistentCache cache(makeInfo(32));
+    EXPECT_EQ(cache.getCount(), 0);
+}
+
+TEST_F(PersistentCacheTest, oversizedKeyLengthIsIgnored) {
+    // magic, version, identity, count and use counter come before the key
+    const size_t keyOffset = 2 * sizeof(uint32_t) + sizeof(uint32_t) + makeInfo().identity.size() + 2 * sizeof(uint32_t);
+    writeCorruptedLength([keyOffset](const ccstd::string & /*content*/) { return keyOffset; }, 0x7FFFFFFFU);
+    PersistentCache cache(makeInfo());
+    EXPECT_EQ(cache.getCount(), 0);
+}
+
+TEST_F(PersistentCacheTest, oversizedIdentityLengthIsIgnored) {
+    writeCorruptedLength([](const ccstd::string & /*content*/) { return 2 * sizeof(uint32_t); }, 0xFFFFFFFFU);
+    PersistentCache cache(makeInfo());
+    EXPECT_EQ(cache.getCount(), 0);
+    // the corrupted file is replaced by the next flush
+    const auto data = makeData(8, 'h');
+    cache.store("shader", 1, data.data(), static_cast<uint32_t>(data.size()));
+    EXPECT_TRUE(cache.flush());
+    PersistentCache reloaded(makeInfo());
+    EXPECT_EQ(reloaded.getCount(), 1);
+}
+
+TEST_F(PersistentCacheTest, evictsLeastRecentlyUsed) {
+    PersistentCache cache(makeInfo(100));
+    const auto data = makeData(40, 'e');
+    cache.store("a", 1, data.data(), 40);
+    cache.store("b", 1, data.data(), 40);
+    ccstd::vector<char> out;
+    EXPECT_TRUE(cache.load("a", 1, out)); // b is now the oldest
+    cache.store("c", 1, data.data(), 40);
+    EXPECT_EQ(cache.getSize(), 80);
+    EXPECT_TRUE(cache.load("a", 1, out));
+    EXPECT_FALSE(cache.load("b", 1, out));
+    EXPECT_TRUE(cache.load("c", 1, out));
+    // larger than the whole cache
+    cache.store("d", 1, makeData(200, 'f').data(), 200);
+    EXPECT_FALSE(cache.load("d", 1, out));
+}
+
+TEST_F(PersistentCacheTest, deviceOwnsCache) {
+    auto *cache = _device->getPersistentCache();
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(cache, _device->getPersistentCache());
+    EXPECT_EQ(cache->getIdentity(), PersistentCache::makeIdentity(*_device));
+}
+
+TEST_F(PersistentCacheTest, identityNamesDriver) {
+    auto &renderer = DriverStrings::renderer(*_device);
+    auto &vendor = DriverStrings::vendor(*_device);
+    auto &version = DriverStrings::version(*_device);
+    const auto saved = std::make_tuple(renderer, vendor, version);
+    renderer = "Test Renderer";
+    vendor = "Test Vendor";
+    version = "1.2.3";
+
+    const auto identity = PersistentCache::makeIdentity(*_device);
+    EXPECT_NE(identity.find("Test Renderer"), ccstd::string::npos);
+    EXPECT_NE(identity.find("Test Vendor"), ccstd::string::npos);
+    EXPECT_NE(identity.find("1.2.3"), ccstd::string::npos);
+
+    // a driver update invalidates the cache
+    version = "1.2.4";
+    EXPECT_NE(PersistentCache::makeIdentity(*_device), identity);
+
+    std::tie(renderer, vendor, version) = saved;
+}
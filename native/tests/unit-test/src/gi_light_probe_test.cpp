@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <cmath>
+#include "gi/light-probe/LightProbe.h"
+#include "gi/light-probe/SH.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+using namespace cc::gi;
+
+namespace {
+constexpr int32_t PROBE_GRID = 5;
+
+// Coefficients are a linear function of the probe position, so barycentric interpolation inside the hull reproduces it.
+Vec3 expectedCoefficient(const Vec3 &position, uint32_t basis) {
+    const auto b = static_cast<float>(basis + 1);
+    return Vec3(position.x * b, position.y + b, position.z - position.x * 0.5F * b);
+}
+
+IntrusivePtr<LightProbesData> createProbes() {
+    ccstd::vector<Vec3> points;
+    for (int32_t x = 0; x < PROBE_GRID; x++) {
+        for (int32_t y = 0; y < PROBE_GRID; y++) {
+            for (int32_t z = 0; z < PROBE_GRID; z++) {
+                // small jitter keeps the Delaunay triangulation unambiguous
+                const auto jitter = static_cast<float>((x * 7 + y * 13 + z * 17) % 5) * 0.01F;
+                points.emplace_back(static_cast<float>(x) * 2.0F + jitter, static_cast<float>(y) * 2.0F - jitter, static_cast<float>(z) * 2.0F + jitter * 0.5F);
+            }
+        }
+    }
+
+    IntrusivePtr<LightProbesData> data = new LightProbesData();
+    data->updateProbes(points);
+    data->updateTetrahedrons();
+    for (auto &probe : data->_probes) {
+        probe.coefficients.resize(SH::getBasisCount());
+        for (uint32_t i = 0; i < SH::getBasisCount(); i++) {
+            probe.coefficients[i] = expectedCoefficient(probe.position, i);
+        }
+    }
+    return data;
+}
+
+ccstd::vector<Vec3> createQueries(uint32_t count) {
+    ccstd::vector<Vec3> positions;
+    uint32_t seed = 12345;
+    const auto next = [&seed]() {
+        seed = seed * 1664525U + 1013904223U;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1U << 24);
+    };
+    for (uint32_t i = 0; i < count; i++) {
+        positions.emplace_back(0.5F + next() * 7.0F, 0.5F + next() * 7.0F, 0.5F + next() * 7.0F);
+    }
+    return positions;
+}
+} // namespace
+
+TEST(giLightProbe, gridLookupFindsContainingTetrahedron) {
+    auto data = createProbes();
+    ASSERT_FALSE(data->empty());
+    data->updateCache();
+    ASSERT_FALSE(data->isCacheDirty());
+
+    const auto basisCount = SH::getBasisCount();
+    ccstd::vector<Vec3> coefficients(basisCount);
+    for (const auto &position : createQueries(500)) {
+        Vec4 weights;
+        // -1 forces the lookup to start from the grid, like a teleported model
+        const auto tetIndex = data->getInterpolationWeights(position, -1, weights);
+        ASSERT_GE(tetIndex, 0);
+        EXPECT_TRUE(data->_tetrahedrons[tetIndex].isInnerTetrahedron());
+        EXPECT_GE(weights.x, -1e-4F);
+        EXPECT_GE(weights.y, -1e-4F);
+        EXPECT_GE(weights.z, -1e-4F);
+        EXPECT_GE(weights.w, -1e-4F);
+        ASSERT_TRUE(data->getInterpolationSHCoefficients(tetIndex, weights, coefficients.data()));
+        for (uint32_t i = 0; i < basisCount; i++) {
+            const auto expected = expectedCoefficient(position, i);
+            EXPECT_NEAR(coefficients[i].x, expected.x, 1e-3F);
+            EXPECT_NEAR(coefficients[i].y, expected.y, 1e-3F);
+            EXPECT_NEAR(coefficients[i].z, expected.z, 1e-3F);
+        }
+    }
+}
+
+TEST(giLightProbe, batchedInterpolationMatchesProbeVertices) {
+    auto data = createProbes();
+    const auto positions = createQueries(256);
+    const auto count = static_cast<uint32_t>(positions.size());
+    const auto basisCount = SH::getBasisCount();
+
+    // dirty cache, interpolation reads the per probe vectors
+    ccstd::vector<int32_t> tetIndices(count, -1);
+    ccstd::vector<Vec4> weights(count);
+    data->getInterpolationWeights(positions.data(), tetIndices.data(), weights.data(), count);
+    ccstd::vector<Vec3> reference(count * basisCount);
+    ASSERT_TRUE(data->getInterpolationSHCoefficients(tetIndices.data(), weights.data(), count, reference.data()));
+
+    data->updateCache();
+    ccstd::vector<int32_t> cachedIndices(count, -1);
+    ccstd::vector<Vec4> cachedWeights(count);
+    data->getInterpolationWeights(positions.data(), cachedIndices.data(), cachedWeights.data(), count);
+    ccstd::vector<Vec3> batched(count * basisCount);
+    ASSERT_TRUE(data->getInterpolationSHCoefficients(cachedIndices.data(), cachedWeights.data(), count, batched.data()));
+
+    for (uint32_t i = 0; i < count * basisCount; i++) {
+        EXPECT_NEAR(batched[i].x, reference[i].x, 1e-3F);
+        EXPECT_NEAR(batched[i].y, reference[i].y, 1e-3F);
+        EXPECT_NEAR(batched[i].z, reference[i].z, 1e-3F);
+    }
+
+    // legacy vector api keeps working
+    ccstd::vector<Vec3> single;
+    ASSERT_TRUE(data->getInterpolationSHCoefficients(cachedIndices[0], cachedWeights[0], single));
+    ASSERT_EQ(single.size(), basisCount);
+    EXPECT_NEAR(single[4].x, batched[4].x, 1e-5F);
+}
+
+TEST(giLightProbe, probeChangesInvalidateCache) {
+    auto data = createProbes();
+    data->updateCache();
+    EXPECT_FALSE(data->isCacheDirty());
+
+    EXPECT_FALSE(data->getProbes().empty());
+    EXPECT_FALSE(data->getTetrahedrons().empty());
+    EXPECT_FALSE(data->isCacheDirty());
+
+    data->_probes[0].coefficients.clear();
+    data->markDirty();
+    EXPECT_TRUE(data->isCacheDirty());
+    data->updateCache();
+    EXPECT_FALSE(data->isCacheDirty());
+
+    data->setProbes(data->getProbes());
+    EXPECT_TRUE(data->isCacheDirty());
+    data->updateCache();
+    EXPECT_FALSE(data->isCacheDirty());
+
+    data->reset();
+    EXPECT_TRUE(data->isCacheDirty());
+    data->updateCache();
+    Vec4 weights;
+    EXPECT_FALSE(data->getInterpolationSHCoefficients(0, weights, static_cast<Vec3 *>(nullptr)));
+}
@@ -0,0 +1,193 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "bindings/jswrapper/SeApi.h"
+#include "gtest/gtest.h"
+#include "platform/FileUtils.h"
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+
+namespace {
+
+// size of the header in front of the data generated by V8
+constexpr uint32_t CODE_CACHE_HEADER_SIZE = 24;
+
+class CodeCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _engine = se::ScriptEngine::getInstance();
+        ASSERT_NE(_engine, nullptr);
+        _dir = testing::TempDir() + "se_code_cache_test/";
+        _engine->setCodeCacheDirectory(_dir);
+        ASSERT_EQ(_engine->getCodeCacheDirectory(), _dir);
+        removeCacheFiles();
+        _engine->markStartupFinished();
+    }
+
+    void TearDown() override {
+        removeCacheFiles();
+        _engine->setCodeCacheDirectory("");
+    }
+
+    ccstd::vector<ccstd::string> listCacheFiles() const {
+        ccstd::vector<ccstd::string> files;
+        for (const auto &file : cc::FileUtils::getInstance()->listFiles(_dir)) {
+            if (file.size() > 5 && file.compare(file.size() - 5, 5, ".jscc") == 0) {
+                files.push_back(file);
+            }
+        }
+        return files;
+    }
+
+    void removeCacheFiles() const {
+        for (const auto &file : listCacheFiles()) {
+            cc::FileUtils::getInstance()->removeFile(file);
+        }
+    }
+
+    // caches are written by later frames, they are flushed here so each eval sees the files of the previous one
+    int32_t eval(const char *script, const char *fileName = "code_cache_test.js") const {
+        se::Value ret;
+        EXPECT_TRUE(_engine->evalString(script, 0, &ret, fileName));
+        _engine->flushCodeCaches();
+        return ret.isNumber() ? ret.toInt32() : -1;
+    }
+
+    se::ScriptEngine *_engine{nullptr};
+    ccstd::string _dir;
+};
+
+} // namespace
+
+TEST_F(CodeCacheTest, writesAndConsumesCache) {
+    const char *script = "(function () { var sum = 0; for (var i = 0; i < 10; ++i) { sum += i; } return sum; })()";
+    const auto before = _engine->getCodeCacheStatistics();
+
+    EXPECT_EQ(eval(script), 45);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().misses, before.misses + 1);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().written, before.written + 1);
+    EXPECT_EQ(listCacheFiles().size(), 1);
+
+    EXPECT_EQ(eval(script), 45);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().hits, before.hits + 1);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().written, before.written + 1);
+
+    // a new version of the script replaces the cache of the file
+    EXPECT_EQ(eval("(function () { return 7; })()"), 7);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().misses, before.misses + 2);
+    EXPECT_EQ(listCacheFiles().size(), 1);
+
+    EXPECT_EQ(eval("(function () { return 7; })()", "code_cache_test_2.js"), 7);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().misses, before.misses + 3);
+    EXPECT_EQ(listCacheFiles().size(), 2);
+}
+
+TEST_F(CodeCacheTest, removesStaleFiles) {
+    EXPECT_EQ(eval("(function () { return 1; })()"), 1);
+    auto files = listCacheFiles();
+    ASSERT_EQ(files.size(), 1);
+
+    // a cache of the previous format and the leftover of an interrupted write
+    auto *fu = cc::FileUtils::getInstance();
+    cc::Data data;
+    data.copy(reinterpret_cast<const unsigned char *>("stale"), 5);
+    const ccstd::string oldVersion = _dir + "0123456789abcdef.jscc";
+    const ccstd::string tmp = files[0] + ".0.tmp";
+    ASSERT_TRUE(fu->writeDataToFile(data, oldVersion));
+    ASSERT_TRUE(fu->writeDataToFile(data, tmp));
+
+    _engine->setCodeCacheDirectory(_dir);
+    EXPECT_FALSE(fu->isFileExist(oldVersion));
+    EXPECT_FALSE(fu->isFileExist(tmp));
+    EXPECT_TRUE(fu->isFileExist(files[0]));
+}
+
+TEST_F(CodeCacheTest, writesCachesAfterStartup) {
+    const auto before = _engine->getCodeCacheStatistics();
+    se::Value ret;
+    ASSERT_TRUE(_engine->evalString("(function () { return 2; })()", 0, &ret, "code_cache_test.js"));
+    EXPECT_EQ(_engine->getCodeCacheStatistics().written, before.written);
+
+    _engine->mainLoopUpdate();
+    EXPECT_EQ(_engine->getCodeCacheStatistics().written, before.written + 1);
+    _engine->flushCodeCaches();
+    EXPECT_EQ(listCacheFiles().size(), 1);
+}
+
+TEST_F(CodeCacheTest, rewritesRejectedCache) {
+    const char *script = "(function (a, b) { return a * b; })(6, 7)";
+    const auto before = _engine->getCodeCacheStatistics();
+
+    EXPECT_EQ(eval(script), 42);
+    auto files = listCacheFiles();
+    ASSERT_EQ(files.size(), 1);
+
+    // break the magic number of V8's data, the header is still valid
+    auto *fu = cc::FileUtils::getInstance();
+    cc::Data data = fu->getDataFromFile(files[0]);
+    ASSERT_GT(data.getSize(), CODE_CACHE_HEADER_SIZE + 4);
+    memset(data.getBytes() + CODE_CACHE_HEADER_SIZE, 0, 4);
+    ASSERT_TRUE(fu->writeDataToFile(data, files[0]));
+
+    EXPECT_EQ(eval(script), 42);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().rejected, before.rejected + 1);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().written, before.written + 2);
+
+    EXPECT_EQ(eval(script), 42);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().hits, before.hits + 1);
+}
+
+TEST_F(CodeCacheTest, ignoresCorruptedFile) {
+    const char *script = "(function () { return 3; })()";
+    const auto before = _engine->getCodeCacheStatistics();
+
+    EXPECT_EQ(eval(script), 3);
+    auto files = listCacheFiles();
+    ASSERT_EQ(files.size(), 1);
+
+    // truncated file fails the header check and isn't passed to V8
+    cc::Data data;
+    data.copy(reinterpret_cast<const unsigned char *>("broken"), 6);
+    ASSERT_TRUE(cc::FileUtils::getInstance()->writeDataToFile(data, files[0]));
+
+    EXPECT_EQ(eval(script), 3);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().misses, before.misses + 2);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().rejected, before.rejected);
+
+    EXPECT_EQ(eval(script), 3);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().hits, before.hits + 1);
+}
+
+TEST_F(CodeCacheTest, disabledWithoutDirectory) {
+    _engine->setCodeCacheDirectory("");
+    const auto before = _engine->getCodeCacheStatistics();
+
+    EXPECT_EQ(eval("(function () { return 5; })()"), 5);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().misses, before.misses);
+    EXPECT_EQ(_engine->getCodeCacheStatistics().hits, before.hits);
+
+    _engine->setCodeCacheDirectory(_dir);
+}
+
+#endif
@@ -0,0 +1,203 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include "cocos/network/DownloadCache.h"
+#include "gtest/gtest.h"
+
+using cc::network::DownloadCache;
+using cc::network::Sha256;
+
+namespace {
+
+ccstd::string digestOf(const ccstd::string &content) {
+    Sha256 sha;
+    sha.update(content.data(), content.size());
+    return sha.finish();
+}
+
+void writeFile(const ccstd::string &path, const ccstd::string &content) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream << content;
+}
+
+ccstd::string readFile(const ccstd::string &path) {
+    std::ifstream stream(path, std::ios::binary);
+    return ccstd::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+class DownloadCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _directory = testing::TempDir();
+        _source = _directory + "download_cache_test_source";
+        _target = _directory + "download_cache_test_target";
+        clear();
+    }
+
+    void TearDown() override {
+        clear();
+    }
+
+    void clear() {
+        DownloadCache cache(_directory, 0);
+        for (char c : ccstd::string("abcd")) {
+            cache.erase(digestOf(ccstd::string(100, c)));
+        }
+        cache.flush();
+        std::remove((_directory + "index.bin").c_str());
+        std::remove(_source.c_str());
+        std::remove(_target.c_str());
+    }
+
+    ccstd::string storeContent(DownloadCache &cache, const ccstd::string &content) {
+        writeFile(_source, content);
+        const auto digest = digestOf(content);
+        EXPECT_TRUE(cache.store(digest, _source));
+        return digest;
+    }
+
+    ccstd::string _directory;
+    ccstd::string _source;
+    ccstd::string _target;
+};
+
+} // namespace
+
+TEST(Sha256Test, knownDigests) {
+    EXPECT_EQ(digestOf(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(digestOf("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(digestOf("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(Sha256Test, incrementalUpdate) {
+    const ccstd::string content(1000000, 'a');
+    Sha256 sha;
+    for (size_t offset = 0; offset < content.size(); offset += 777) {
+        sha.update(content.data() + offset, std::min<size_t>(777, content.size() - offset));
+    }
+    EXPECT_EQ(sha.finish(), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    sha.reset();
+    sha.update("abc", 3);
+    EXPECT_EQ(sha.finish(), digestOf("abc"));
+}
+
+TEST_F(DownloadCacheTest, storeAndFetch) {
+    DownloadCache cache(_directory, 1024);
+    const ccstd::string content(100, 'a');
+    const auto digest = storeContent(cache, content);
+    std::remove(_source.c_str());
+
+    EXPECT_TRUE(cache.contains(digest));
+    EXPECT_EQ(cache.getCount(), 1);
+    EXPECT_EQ(cache.getSize(), 100);
+    EXPECT_TRUE(cache.fetch(digest, _target));
+    EXPECT_EQ(readFile(_target), content);
+    EXPECT_EQ(Sha256::digestFile(_target), digest);
+    EXPECT_FALSE(cache.fetch(digestOf(ccstd::string(100, 'b')), _target));
+}
+
+TEST_F(DownloadCacheTest, rejectsInvalidEntries) {
+    DownloadCache cache(_directory, 150);
+    writeFile(_source, ccstd::string(100, 'a'));
+    EXPECT_FALSE(cache.store("../escape", _source));
+    EXPECT_FALSE(cache.store(ccstd::string(64, 'A'), _source));
+    writeFile(_source, ccstd::string(200, 'a'));
+    EXPECT_FALSE(cache.store(digestOf(ccstd::string(200, 'a')), _source));
+    EXPECT_EQ(cache.getCount(), 0);
+}
+
+TEST_F(DownloadCacheTest, evictsLeastRecentlyUsed) {
+    DownloadCache cache(_directory, 250);
+    const auto first = storeContent(cache, ccstd::string(100, 'a'));
+    const auto second = storeContent(cache, ccstd::string(100, 'b'));
+    EXPECT_TRUE(cache.fetch(first, _target));
+    const auto third = storeContent(cache, ccstd::string(100, 'c'));
+
+    EXPECT_TRUE(cache.contains(first));
+    EXPECT_FALSE(cache.contains(second));
+    EXPECT_TRUE(cache.contains(third));
+    EXPECT_EQ(cache.getSize(), 200);
+}
+
+TEST_F(DownloadCacheTest, reloadIndex) {
+    ccstd::string digest;
+    {
+        DownloadCache cache(_directory, 1024);
+        digest = storeContent(cache, ccstd::string(100, 'd'));
+    }
+    DownloadCache cache(_directory, 1024);
+    EXPECT_EQ(cache.getCount(), 1);
+    EXPECT_TRUE(cache.fetch(digest, _target));
+    EXPECT_EQ(readFile(_target), ccstd::string(100, 'd'));
+}
+
+TEST_F(DownloadCacheTest, dropsDamagedEntries) {
+    DownloadCache cache(_directory, 1024);
+    const auto digest = storeContent(cache, ccstd::string(100, 'a'));
+    std::remove(_source.c_str());
+    writeFile(_directory + digest, "truncated");
+
+    EXPECT_FALSE(cache.fetch(digest, _target));
+    EXPECT_FALSE(cache.contains(digest));
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST_F(DownloadCacheTest, entriesDontShareCallerFiles) {
+    DownloadCache cache(_directory, 1024);
+    const ccstd::string content(100, 'a');
+    const auto digest = storeContent(cache, content);
+    ASSERT_TRUE(cache.fetch(digest, _target));
+
+    // the game may write the files it got in place
+    for (const auto &path : {_source, _target}) {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(10);
+        stream << "patched";
+    }
+
+    std::remove(_target.c_str());
+    EXPECT_TRUE(cache.fetch(digest, _target));
+    EXPECT_EQ(readFile(_target), content);
+}
+
+TEST_F(DownloadCacheTest, dropsCorruptedEntries) {
+    DownloadCache cache(_directory, 1024);
+    const auto digest = storeContent(cache, ccstd::string(100, 'a'));
+    // same size, different content
+    writeFile(_directory + digest, ccstd::string(100, 'b'));
+
+    EXPECT_FALSE(cache.fetch(digest, _target));
+    EXPECT_FALSE(cache.contains(digest));
+    EXPECT_NE(readFile(_target), ccstd::string(100, 'b'));
+}
+
+TEST_F(DownloadCacheTest, sharedInstances) {
+    auto first = DownloadCache::open(_directory, 1024);
+    auto second = DownloadCache::open(_directory, 1024);
+    EXPECT_EQ(first, second);
+}
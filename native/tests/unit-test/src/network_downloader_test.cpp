@@ -0,0 +1,300 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Macros.h"
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+    #include <algorithm>
+    #include <atomic>
+    #include <chrono>
+    #include <cstdio>
+    #include <fstream>
+    #include <iterator>
+    #include <memory>
+    #include <thread>
+    #include "network/DownloadCache.h"
+    #include "network/Downloader.h"
+    #include "platform/FileUtils.h"
+    #include "utils.h"
+
+using namespace cc;
+using namespace cc::network;
+
+namespace {
+
+constexpr uint32_t CONTENT_SIZE = 3 * 1024 * 1024;
+constexpr uint32_t SEGMENT_THRESHOLD = 1024 * 1024;
+
+// serves the content at "/content.bin", answers Range requests with the requested part unless told otherwise
+class ContentServer {
+public:
+    ContentServer(ccstd::string content, ccstd::string acceptRanges, bool honorRanges)
+    : _content(std::move(content)),
+      _acceptRanges(std::move(acceptRanges)),
+      _honorRanges(honorRanges) {}
+
+    ccstd::string url() const { return _server.url("/content.bin"); }
+
+    int port() const { return _server.port(); }
+    uint32_t contentRequests() const { return _contentRequests; }
+    uint32_t rangeRequests() const { return _rangeRequests; }
+
+private:
+    ccstd::string respond(const ccstd::string &request) {
+        const bool head = request.compare(0, 5, "HEAD ") == 0;
+        int64_t begin = 0;
+        int64_t end = static_cast<int64_t>(_content.size()) - 1;
+        bool ranged = false;
+        const size_t range = request.find("\r\nRange: bytes=");
+        if (!head && range != ccstd::string::npos) {
+            ++_rangeRequests;
+            long long first = 0;
+            long long last = -1;
+            if (sscanf(request.c_str() + range, "\r\nRange: bytes=%lld-%lld", &first, &last) >= 1 && _honorRanges) {
+                ranged = true;
+                begin = first;
+                end = last >= 0 ? std::min<int64_t>(last, end) : end;
+            }
+        }
+        if (!head) {
+            ++_contentRequests;
+        }
+
+        char header[512];
+        int length = snprintf(header, sizeof(header),
+                              "HTTP/1.1 %s\r\nContent-Length: %lld\r\n%s%sConnection: close\r\n\r\n",
+                              ranged ? "206 Partial Content" : "200 OK",
+                              static_cast<long long>(end - begin + 1),
+                              _acceptRanges.c_str(),
+                              _acceptRanges.empty() ? "" : "\r\n");
+        ccstd::string response(header, length);
+        if (!head) {
+            response.append(_content, static_cast<size_t>(begin), static_cast<size_t>(end - begin + 1));
+        }
+        return response;
+    }
+
+    ccstd::string _content;
+    ccstd::string _acceptRanges;
+    bool _honorRanges{true};
+    std::atomic<uint32_t> _contentRequests{0};
+    std::atomic<uint32_t> _rangeRequests{0};
+    // declared last, so the handler threads are joined before the state they read goes away
+    TestHttpServer _server{[this](const ccstd::string &request) { return respond(request); }};
+};
+
+ccstd::string makeContent() {
+    ccstd::string content(CONTENT_SIZE, '\0');
+    uint32_t seed = 0x12345678;
+    for (auto &c : content) {
+        seed = seed * 1664525U + 1013904223U;
+        c = static_cast<char>(seed >> 24);
+    }
+    return content;
+}
+
+ccstd::string digestOf(const ccstd::string &content) {
+    Sha256 sha;
+    sha.update(content.data(), content.size());
+    return sha.finish();
+}
+
+ccstd::string readFile(const ccstd::string &path) {
+    std::ifstream stream(path, std::ios::binary);
+    return ccstd::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+class DownloaderTest : public testing::Test {
+protected:
+    void SetUp() override {
+        if (!FileUtils::getInstance()) {
+            _fileUtils = createFileUtils();
+        }
+        CC_APPLICATION_MANAGER()->createApplication<TestApplication>(0, nullptr);
+        _directory = testing::TempDir() + "downloader_test/";
+        _content = makeContent();
+        clear();
+        FileUtils::getInstance()->createDirectory(_directory);
+    }
+
+    void TearDown() override {
+        clear();
+        CC_APPLICATION_MANAGER()->releaseAllApplications();
+        delete _fileUtils;
+    }
+
+    void clear() {
+        FileUtils::getInstance()->removeDirectory(_directory);
+    }
+
+    std::shared_ptr<Downloader> createDownloader(const DownloaderHints &hints) {
+        auto downloader = std::make_shared<Downloader>(hints);
+        downloader->setOnSuccess([this](const DownloadTask & /*task*/) {
+            ++_succeeded;
+        });
+        downloader->setOnError([this](const DownloadTask & /*task*/, int errorCode, int /*errorCodeInternal*/, const ccstd::string & /*errorStr*/) {
+            _errors.push_back(errorCode);
+        });
+        return downloader;
+    }
+
+    // ticks the scheduler of the current engine until every task has finished
+    bool waitFor(uint32_t count, int timeoutMs = 10000) {
+        auto scheduler = CC_CURRENT_ENGINE()->getScheduler();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (_succeeded + _errors.size() < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            scheduler->update(0.1F);
+        }
+        return true;
+    }
+
+    FileUtils *_fileUtils{nullptr};
+    ccstd::string _directory;
+    ccstd::string _content;
+    uint32_t _succeeded{0};
+    ccstd::vector<int> _errors;
+};
+
+} // namespace
+
+TEST_F(DownloaderTest, segmentedDownload) {
+    // lower case header names, as sent over HTTP/2
+    ContentServer server(_content, "accept-ranges: bytes", true);
+    ASSERT_NE(server.port(), 0);
+
+    DownloaderHints hints;
+    hints.segmentThreshold = SEGMENT_THRESHOLD;
+    auto downloader = createDownloader(hints);
+    const auto path = _directory + "segmented.bin";
+    downloader->createDownloadTask(server.url(), path, {}, "", digestOf(_content));
+
+    ASSERT_TRUE(waitFor(1));
+    EXPECT_EQ(_succeeded, 1);
+    EXPECT_EQ(server.rangeRequests(), CONTENT_SIZE / SEGMENT_THRESHOLD);
+    EXPECT_EQ(server.contentRequests(), CONTENT_SIZE / SEGMENT_THRESHOLD);
+    EXPECT_TRUE(readFile(path) == _content);
+}
+
+TEST_F(DownloaderTest, segmentationIsOptIn) {
+    ContentServer server(_content, "Accept-Ranges: bytes", true);
+    ASSERT_NE(server.port(), 0);
+
+    auto downloader = createDownloader(DownloaderHints());
+    const auto path = _directory + "single.bin";
+    downloader->createDownloadTask(server.url(), path);
+
+    ASSERT_TRUE(waitFor(1));
+    EXPECT_EQ(_succeeded, 1);
+    EXPECT_EQ(server.rangeRequests(), 0);
+    EXPECT_EQ(server.contentRequests(), 1);
+    EXPECT_TRUE(readFile(path) == _content);
+}
+
+TEST_F(DownloaderTest, requiresByteRanges) {
+    ContentServer server(_content, "Accept-Ranges: none", true);
+    ASSERT_NE(server.port(), 0);
+
+    DownloaderHints hints;
+    hints.segmentThreshold = SEGMENT_THRESHOLD;
+    auto downloader = createDownloader(hints);
+    const auto path = _directory + "none.bin";
+    downloader->createDownloadTask(server.url(), path);
+
+    ASSERT_TRUE(waitFor(1));
+    EXPECT_EQ(_succeeded, 1);
+    EXPECT_EQ(server.rangeRequests(), 0);
+    EXPECT_TRUE(readFile(path) == _content);
+}
+
+TEST_F(DownloaderTest, fallsBackWhenRangesAreIgnored) {
+    // advertises ranges but answers every request with the whole content
+    ContentServer server(_content, "Accept-Ranges: bytes", false);
+    ASSERT_NE(server.port(), 0);
+
+    DownloaderHints hints;
+    hints.segmentThreshold = SEGMENT_THRESHOLD;
+    auto downloader = createDownloader(hints);
+    const auto path = _directory + "fallback.bin";
+    downloader->createDownloadTask(server.url(), path, {}, "", digestOf(_content));
+
+    ASSERT_TRUE(waitFor(1));
+    EXPECT_EQ(_succeeded, 1);
+    EXPECT_TRUE(_errors.empty());
+    EXPECT_GT(server.rangeRequests(), 0);
+    EXPECT_TRUE(readFile(path) == _content);
+}
+
+TEST_F(DownloaderTest, checksumMismatch) {
+    ContentServer server(_content, "Accept-Ranges: bytes", true);
+    ASSERT_NE(server.port(), 0);
+
+    auto downloader = createDownloader(DownloaderHints());
+    const auto path = _directory + "mismatch.bin";
+    downloader->createDownloadTask(server.url(), path, {}, "", digestOf("other content"));
+
+    ASSERT_TRUE(waitFor(1));
+    EXPECT_EQ(_succeeded, 0);
+    ASSERT_EQ(_errors.size(), 1);
+    EXPECT_TRUE(_errors[0] == DownloadTask::ERROR_CHECKSUM_MISMATCH);
+    EXPECT_FALSE(FileUtils::getInstance()->isFileExist(path));
+}
+
+TEST_F(DownloaderTest, sameChecksumIsServedByCache) {
+    ContentServer server(_content, "Accept-Ranges: bytes", true);
+    ASSERT_NE(server.port(), 0);
+
+    DownloaderHints hints;
+    hints.cacheDirectory = _directory + "cache/";
+    auto downloader = createDownloader(hints);
+    const auto checksum = digestOf(_content);
+    downloader->createDownloadTask(server.url(), _directory + "first.bin", {}, "", checksum);
+    downloader->createDownloadTask(server.url(), _directory + "second.bin", {}, "", checksum);
+
+    ASSERT_TRUE(waitFor(2));
+    EXPECT_EQ(_succeeded, 2);
+    EXPECT_EQ(server.contentRequests(), 1);
+    EXPECT_TRUE(readFile(_directory + "first.bin") == _content);
+    EXPECT_TRUE(readFile(_directory + "second.bin") == _content);
+}
+
+TEST_F(DownloaderTest, sameChecksumWithoutCacheDownloadsInParallel) {
+    ContentServer server(_content, "Accept-Ranges: bytes", true);
+    ASSERT_NE(server.port(), 0);
+
+    auto downloader = createDownloader(DownloaderHints());
+    const auto checksum = digestOf(_content);
+    downloader->createDownloadTask(server.url(), _directory + "first.bin", {}, "", checksum);
+    downloader->createDownloadTask(server.url(), _directory + "second.bin", {}, "", checksum);
+
+    ASSERT_TRUE(waitFor(2));
+    EXPECT_EQ(_succeeded, 2);
+    EXPECT_EQ(server.contentRequests(), 2);
+    EXPECT_TRUE(readFile(_directory + "second.bin") == _content);
+}
+
+#endif
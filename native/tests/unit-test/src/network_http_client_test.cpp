@@ -0,0 +1,291 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Macros.h"
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+    #include <algorithm>
+    #include <chrono>
+    #include <cstdio>
+    #include <cstring>
+    #include <fstream>
+    #include <iterator>
+    #include <mutex>
+    #include <thread>
+    #include "network/HttpClient.h"
+    #include "utils.h"
+
+using namespace cc;
+using namespace cc::network;
+
+namespace {
+
+struct Result {
+    bool finished{false};
+    bool succeeded{false};
+    long code{0};
+    std::chrono::steady_clock::time_point time;
+};
+
+class HttpClientTest : public testing::Test {
+protected:
+    void SetUp() override {
+        CC_APPLICATION_MANAGER()->createApplication<TestApplication>(0, nullptr);
+        // the client binds the scheduler of the current engine when it's created
+        _client = HttpClient::getInstance();
+        ASSERT_NE(_server.port(), 0);
+    }
+
+    void TearDown() override {
+        for (auto *request : _requests) {
+            request->release();
+        }
+        HttpClient::destroyInstance();
+        CC_APPLICATION_MANAGER()->releaseAllApplications();
+    }
+
+    // "/delay/<ms>" answers after the given time
+    ccstd::string url(uint32_t delayMs) const {
+        return _server.url("/delay/" + std::to_string(delayMs));
+    }
+
+    // the response also sets a session cookie
+    ccstd::string cookieUrl(uint32_t delayMs) const {
+        return url(delayMs) + "?cookie=set";
+    }
+
+    // the Cookie header of the last request, empty if it had none
+    ccstd::string lastCookie() {
+        std::lock_guard<std::mutex> lock(_cookieMutex);
+        return _lastCookie;
+    }
+
+    HttpRequest *createRequest(uint32_t delayMs, Result &result) {
+        return createRequest(url(delayMs), result);
+    }
+
+    HttpRequest *createRequest(const ccstd::string &url, Result &result) {
+        auto *request = ccnew HttpRequest();
+        request->addRef();
+        request->setUrl(url);
+        request->setRequestType(HttpRequest::Type::GET);
+        request->setResponseCallback([&result](HttpClient * /*client*/, HttpResponse *response) {
+            result.finished = true;
+            result.succeeded = response->isSucceed();
+            result.code = response->getResponseCode();
+            result.time = std::chrono::steady_clock::now();
+        });
+        _requests.push_back(request);
+        return request;
+    }
+
+    // ticks the scheduler of the current engine until the condition holds
+    template <typename F>
+    bool waitFor(F &&condition, int timeoutMs = 10000) {
+        auto scheduler = CC_CURRENT_ENGINE()->getScheduler();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            scheduler->update(0.002F);
+        }
+        return true;
+    }
+
+    // the Cookie header of each request is recorded
+    ccstd::string respond(const ccstd::string &request) {
+        unsigned delayMs = 0;
+        sscanf(request.c_str(), "GET /delay/%u", &delayMs);
+        const bool setCookie = request.find("?cookie=set ") != ccstd::string::npos;
+        ccstd::string cookie;
+        const size_t cookieBegin = request.find("\r\nCookie: ");
+        if (cookieBegin != ccstd::string::npos) {
+            const size_t valueBegin = cookieBegin + strlen("\r\nCookie: ");
+            cookie = request.substr(valueBegin, request.find("\r\n", valueBegin) - valueBegin);
+        }
+        {
+            std::lock_guard<std::mutex> lock(_cookieMutex);
+            _lastCookie = cookie;
+        }
+        _server.sleep(delayMs);
+
+        ccstd::string response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n";
+        if (setCookie) {
+            response += "Set-Cookie: session=42; Path=/\r\n";
+        }
+        response += "\r\nok";
+        return response;
+    }
+
+    std::mutex _cookieMutex;
+    ccstd::string _lastCookie;
+    // declared after the state its handler touches, so the handler threads are joined first
+    TestHttpServer _server{[this](const ccstd::string &request) { return respond(request); }};
+    HttpClient *_client{nullptr};
+    ccstd::vector<HttpRequest *> _requests;
+};
+
+bool allFinished(const ccstd::vector<Result> &results) {
+    return std::all_of(results.begin(), results.end(), [](const Result &result) { return result.finished; });
+}
+
+} // namespace
+
+TEST_F(HttpClientTest, limitsRequestsPerHost) {
+    constexpr uint32_t REQUEST_COUNT = 12;
+    _client->setMaxConnectionsPerHost(3);
+
+    ccstd::vector<Result> results(REQUEST_COUNT);
+    for (auto &result : results) {
+        _client->send(createRequest(50, result));
+    }
+    ASSERT_TRUE(waitFor([&]() { return allFinished(results); }));
+
+    for (const auto &result : results) {
+        EXPECT_TRUE(result.succeeded);
+        EXPECT_EQ(result.code, 200);
+    }
+    EXPECT_EQ(_server.requests(), REQUEST_COUNT);
+    // the limit is reached and never exceeded
+    EXPECT_EQ(_server.maxRunning(), 3);
+}
+
+TEST_F(HttpClientTest, startsByPriority) {
+    _client->setMaxConnectionsPerHost(1);
+
+    // keeps the host busy while the other requests are queued
+    Result busy;
+    _client->send(createRequest(200, busy));
+    ASSERT_TRUE(waitFor([&]() { return _server.running() == 1; }));
+
+    Result low;
+    Result normal;
+    Result high;
+    auto *lowRequest = createRequest(0, low);
+    lowRequest->setPriority(HttpRequest::Priority::LOW);
+    _client->send(lowRequest);
+    _client->send(createRequest(0, normal));
+    auto *highRequest = createRequest(0, high);
+    highRequest->setPriority(HttpRequest::Priority::HIGH);
+    _client->send(highRequest);
+
+    ASSERT_TRUE(waitFor([&]() { return low.finished; }));
+    EXPECT_TRUE(busy.finished);
+    EXPECT_LT(high.time, normal.time);
+    EXPECT_LT(normal.time, low.time);
+}
+
+TEST_F(HttpClientTest, sendImmediateBypassesHostLimit) {
+    _client->setMaxConnectionsPerHost(1);
+
+    Result busy;
+    _client->send(createRequest(2000, busy));
+    ASSERT_TRUE(waitFor([&]() { return _server.running() == 1; }));
+
+    Result queued;
+    _client->send(createRequest(0, queued));
+    Result immediate;
+    _client->sendImmediate(createRequest(0, immediate));
+
+    ASSERT_TRUE(waitFor([&]() { return immediate.finished; }, 1500));
+    EXPECT_TRUE(immediate.succeeded);
+    // the queued request still waits for the host
+    EXPECT_FALSE(busy.finished);
+    EXPECT_FALSE(queued.finished);
+    EXPECT_EQ(_server.maxRunning(), 2);
+
+    ASSERT_TRUE(waitFor([&]() { return queued.finished; }));
+    EXPECT_TRUE(queued.succeeded);
+}
+
+TEST_F(HttpClientTest, timesOut) {
+    Result slow;
+    auto *request = createRequest(5000, slow);
+    request->setTimeout(1);
+    const auto start = std::chrono::steady_clock::now();
+    _client->send(request);
+
+    // a timed out request must not hold back the others to the same host
+    Result fast;
+    _client->send(createRequest(0, fast));
+
+    ASSERT_TRUE(waitFor([&]() { return slow.finished; }, 4000));
+    EXPECT_FALSE(slow.succeeded);
+    EXPECT_LT(slow.time - start, std::chrono::milliseconds(3000));
+    EXPECT_TRUE(fast.finished);
+    EXPECT_TRUE(fast.succeeded);
+}
+
+TEST_F(HttpClientTest, sharesCookiesBetweenHandles) {
+    const ccstd::string cookieFile = testing::TempDir() + "http_client_cookies.txt";
+    std::remove(cookieFile.c_str());
+    _client->enableCookies(cookieFile.c_str());
+    _client->setMaxConnectionsPerHost(2);
+
+    // the request setting the cookie finishes first, so its handle isn't the one reused next
+    Result setter;
+    _client->send(createRequest(cookieUrl(100), setter));
+    Result other;
+    _client->send(createRequest(300, other));
+    ASSERT_TRUE(waitFor([&]() { return setter.finished && other.finished; }));
+    EXPECT_TRUE(setter.succeeded);
+
+    // the jar is written when the response is received
+    std::ifstream jar(cookieFile);
+    const ccstd::string content{std::istreambuf_iterator<char>(jar), std::istreambuf_iterator<char>()};
+    EXPECT_NE(content.find("session"), ccstd::string::npos);
+
+    Result reader;
+    _client->send(createRequest(0, reader));
+    ASSERT_TRUE(waitFor([&]() { return reader.finished; }));
+    EXPECT_TRUE(reader.succeeded);
+    EXPECT_EQ(lastCookie(), "session=42");
+
+    std::remove(cookieFile.c_str());
+}
+
+TEST_F(HttpClientTest, destroyCancelsRequests) {
+    _client->setMaxConnectionsPerHost(2);
+
+    ccstd::vector<Result> results(6);
+    for (auto &result : results) {
+        _client->send(createRequest(5000, result));
+    }
+    ASSERT_TRUE(waitFor([&]() { return _server.running() == 2; }));
+
+    // running and queued requests are dropped without invoking their callbacks
+    HttpClient::destroyInstance();
+    const bool released = waitFor([&]() {
+        return std::all_of(_requests.begin(), _requests.end(), [](HttpRequest *request) { return request->getRefCount() == 1; });
+    });
+    EXPECT_TRUE(released);
+    for (const auto &result : results) {
+        EXPECT_FALSE(result.finished);
+    }
+    EXPECT_EQ(_server.requests(), 2);
+}
+
+#endif
@@ -0,0 +1,235 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Macros.h"
+
+#if CC_USE_SOCKET && CC_USE_WEBSOCKET_SERVER && CC_PLATFORM == CC_PLATFORM_LINUX
+    #include <chrono>
+    #include <memory>
+    #include <thread>
+    #include "network/WebSocket.h"
+    #include "network/WebSocketServer.h"
+    #include "utils.h"
+
+using namespace cc;
+using namespace cc::network;
+
+namespace {
+
+constexpr uint32_t MESSAGE_COUNT = 512;
+// larger than the receive buffer of the client, arrives in several fragments
+constexpr uint32_t LARGE_MESSAGE_SIZE = 200 * 1024;
+
+struct Message {
+    ccstd::string payload;
+    bool isBinary{false};
+};
+
+class TestDelegate : public WebSocket::Delegate {
+public:
+    void onOpen(WebSocket * /*ws*/) override { opened = true; }
+
+    void onMessage(WebSocket * /*ws*/, const WebSocket::Data &data) override {
+        messages.push_back({ccstd::string(data.bytes, data.len), data.isBinary});
+        if (keepNextBinary && data.isBinary && data.detach()) {
+            keepNextBinary = false;
+            kept = data;
+        }
+    }
+
+    void onClose(WebSocket *ws, uint16_t /*code*/, const ccstd::string & /*reason*/, bool /*wasClean*/) override {
+        closed = true;
+        ws->release();
+    }
+
+    void onError(WebSocket * /*ws*/, const WebSocket::ErrorCode & /*error*/) override { ++errors; }
+
+    bool opened{false};
+    bool closed{false};
+    uint32_t errors{0};
+    ccstd::vector<Message> messages;
+    bool keepNextBinary{false};
+    WebSocket::Data kept;
+};
+
+ccstd::string makePayload(uint32_t index) {
+    const uint32_t size = index % 64 == 63 ? LARGE_MESSAGE_SIZE : 1 + (index * 37) % 2048;
+    ccstd::string payload(size, '\0');
+    for (uint32_t i = 0; i < size; ++i) {
+        // text payloads stay printable, binary ones contain zeros
+        payload[i] = static_cast<char>(index % 2 == 0 ? 'a' + (index + i) % 26 : (index + i * 7) % 256);
+    }
+    return payload;
+}
+
+class WebSocketClientTest : public testing::Test {
+protected:
+    void SetUp() override {
+        CC_APPLICATION_MANAGER()->createApplication<TestApplication>(0, nullptr);
+        _server = std::make_shared<WebSocketServer>();
+        // echo every message back with the same type
+        _server->setOnConnection([](const std::shared_ptr<WebSocketServerConnection> &conn) {
+            std::weak_ptr<WebSocketServerConnection> weakConn = conn;
+            conn->setOnMessage([weakConn](const std::shared_ptr<DataFrame> &frame) {
+                auto conn = weakConn.lock();
+                if (!conn) {
+                    return;
+                }
+                const ccstd::string payload = frame->toString();
+                if (frame->isBinary()) {
+                    conn->sendBinaryAsync(payload.data(), payload.size(), nullptr);
+                } else {
+                    conn->sendTextAsync(payload, nullptr);
+                }
+            });
+        });
+        bool listening = false;
+        // the system picks a free port
+        WebSocketServer::listenAsync(_server, 0, "127.0.0.1", [&listening](const ccstd::string &errorMsg) {
+            EXPECT_TRUE(errorMsg.empty());
+            listening = true;
+        });
+        ASSERT_TRUE(waitFor([&]() { return listening; }));
+        _port = _server->getPort();
+        ASSERT_NE(_port, 0);
+    }
+
+    void TearDown() override {
+        bool closed = false;
+        _server->closeAsync([&closed](const ccstd::string & /*errorMsg*/) { closed = true; });
+        waitFor([&]() { return closed; });
+        _server.reset();
+        CC_APPLICATION_MANAGER()->releaseAllApplications();
+    }
+
+    WebSocket *connect(TestDelegate &delegate) {
+        auto *ws = ccnew WebSocket();
+        if (!ws->init(delegate, "ws://127.0.0.1:" + std::to_string(_port))) {
+            ws->release();
+            return nullptr;
+        }
+        if (!waitFor([&]() { return delegate.opened || delegate.errors > 0; }) || !delegate.opened) {
+            return nullptr;
+        }
+        return ws;
+    }
+
+    // ticks the scheduler of the current engine until the condition holds
+    template <typename F>
+    bool waitFor(F &&condition, int timeoutMs = 10000) {
+        auto scheduler = CC_CURRENT_ENGINE()->getScheduler();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            scheduler->update(0.001F);
+        }
+        return true;
+    }
+
+    std::shared_ptr<WebSocketServer> _server;
+    int _port{0};
+};
+
+} // namespace
+
+TEST_F(WebSocketClientTest, echoesMessagesInOrder) {
+    TestDelegate delegate;
+    auto *ws = connect(delegate);
+    ASSERT_NE(ws, nullptr);
+
+    uint64_t bytesSent = 0;
+    for (uint32_t i = 0; i < MESSAGE_COUNT; ++i) {
+        const auto payload = makePayload(i);
+        if (i % 2 == 0) {
+            ws->send(payload);
+        } else {
+            ws->send(reinterpret_cast<const unsigned char *>(payload.data()), static_cast<unsigned int>(payload.size()));
+        }
+        bytesSent += payload.size();
+    }
+    ASSERT_TRUE(waitFor([&]() { return delegate.messages.size() >= MESSAGE_COUNT; }));
+
+    ASSERT_EQ(delegate.messages.size(), MESSAGE_COUNT);
+    for (uint32_t i = 0; i < MESSAGE_COUNT; ++i) {
+        EXPECT_EQ(delegate.messages[i].isBinary, i % 2 != 0);
+        EXPECT_TRUE(delegate.messages[i].payload == makePayload(i)) << "message " << i;
+    }
+
+    const auto stats = ws->getStats();
+    EXPECT_EQ(stats.messagesSent, MESSAGE_COUNT);
+    EXPECT_EQ(stats.bytesSent, bytesSent);
+    EXPECT_EQ(stats.messagesReceived, MESSAGE_COUNT);
+    EXPECT_EQ(stats.bytesReceived, bytesSent);
+    EXPECT_EQ(stats.bufferedAmount, 0);
+    EXPECT_EQ(stats.pendingMessages, 0);
+    EXPECT_GE(stats.peakBufferedAmount, LARGE_MESSAGE_SIZE);
+    EXPECT_EQ(delegate.errors, 0);
+
+    ws->closeAsync();
+    EXPECT_TRUE(waitFor([&]() { return delegate.closed; }));
+}
+
+TEST_F(WebSocketClientTest, detachedBufferOutlivesMessage) {
+    TestDelegate delegate;
+    auto *ws = connect(delegate);
+    ASSERT_NE(ws, nullptr);
+
+    const ccstd::string first(1024, '\x5A');
+    delegate.keepNextBinary = true;
+    ws->send(reinterpret_cast<const unsigned char *>(first.data()), static_cast<unsigned int>(first.size()));
+    ASSERT_TRUE(waitFor([&]() { return delegate.messages.size() == 1; }));
+    ASSERT_NE(delegate.kept.bytes, nullptr);
+    ASSERT_NE(delegate.kept.freeFunc, nullptr);
+    EXPECT_FALSE(delegate.kept.detach());
+
+    // buffers released to the pool meanwhile must not reuse the detached one
+    for (uint32_t i = 0; i < 64; ++i) {
+        const ccstd::string payload(1024, static_cast<char>(i));
+        ws->send(reinterpret_cast<const unsigned char *>(payload.data()), static_cast<unsigned int>(payload.size()));
+    }
+    ASSERT_TRUE(waitFor([&]() { return delegate.messages.size() == 65; }));
+    EXPECT_TRUE(ccstd::string(delegate.kept.bytes, delegate.kept.len) == first);
+    delegate.kept.freeFunc(delegate.kept.bytes, delegate.kept.len, delegate.kept.freeUserData);
+
+    ws->closeAsync();
+    EXPECT_TRUE(waitFor([&]() { return delegate.closed; }));
+}
+
+TEST_F(WebSocketClientTest, closesWhenServerCloses) {
+    TestDelegate delegate;
+    auto *ws = connect(delegate);
+    ASSERT_NE(ws, nullptr);
+    ASSERT_TRUE(waitFor([&]() { return !_server->getConnections().empty(); }));
+
+    for (auto &conn : _server->getConnections()) {
+        conn->closeAsync(1000, "bye");
+    }
+    EXPECT_TRUE(waitFor([&]() { return delegate.closed; }));
+    EXPECT_EQ(delegate.messages.size(), 0);
+}
+
+#endif
@@ -0,0 +1,280 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+
+#if CC_USE_WEBSOCKET_SERVER && !defined(_WIN32)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #include <atomic>
+    #include <chrono>
+    #include <cstdio>
+    #include <cstring>
+    #include <memory>
+    #include <thread>
+    #include "base/Log.h"
+    #include "base/std/container/string.h"
+    #include "base/std/container/vector.h"
+    #include "network/WebSocketServer.h"
+
+using namespace cc::network;
+
+namespace {
+constexpr uint32_t CLIENT_COUNT = 32;
+constexpr uint32_t MESSAGE_COUNT = 2000;
+constexpr uint32_t MESSAGE_SIZE = 256;
+
+// Minimal websocket client reading unmasked server frames on a plain socket.
+class TestClient {
+public:
+    ~TestClient() {
+        disconnect();
+    }
+
+    bool connectTo(int port) {
+        disconnect();
+        _pending.clear();
+        _fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        if (_fd < 0 || connect(_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            disconnect();
+            return false;
+        }
+        char request[256];
+        snprintf(request, sizeof(request),
+                 "GET / HTTP/1.1\r\nHost: 127.0.0.1:%d\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                 "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n",
+                 port);
+        if (::send(_fd, request, strlen(request), 0) < 0) {
+            return false;
+        }
+        // bytes after the response header already belong to frames
+        char chunk[1024];
+        while (_pending.find("\r\n\r\n") == ccstd::string::npos) {
+            ssize_t n = recv(_fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                return false;
+            }
+            _pending.append(chunk, n);
+        }
+        size_t end = _pending.find("\r\n\r\n");
+        if (_pending.compare(0, 12, "HTTP/1.1 101") != 0) {
+            return false;
+        }
+        _pending.erase(0, end + 4);
+        _reader = std::thread([this]() { readFrames(); });
+        return true;
+    }
+
+    void disconnect() {
+        if (_fd >= 0) {
+            shutdown(_fd, SHUT_RDWR);
+        }
+        if (_reader.joinable()) {
+            _reader.join();
+        }
+        if (_fd >= 0) {
+            close(_fd);
+            _fd = -1;
+        }
+    }
+
+    uint32_t received() const { return _received; }
+    bool inOrder() const { return _inOrder; }
+
+private:
+    bool fill(size_t size) {
+        char chunk[16384];
+        while (_pending.size() < size) {
+            ssize_t n = recv(_fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                return false;
+            }
+            _pending.append(chunk, n);
+        }
+        return true;
+    }
+
+    void readFrames() {
+        ccstd::string message;
+        while (fill(2)) {
+            const auto b0 = static_cast<uint8_t>(_pending[0]);
+            const auto b1 = static_cast<uint8_t>(_pending[1]);
+            size_t header = 2;
+            uint64_t length = b1 & 0x7F;
+            if (length == 126) {
+                header = 4;
+            } else if (length == 127) {
+                header = 10;
+            }
+            if (!fill(header)) {
+                break;
+            }
+            if (header > 2) {
+                length = 0;
+                for (size_t i = 2; i < header; ++i) {
+                    length = (length << 8) | static_cast<uint8_t>(_pending[i]);
+                }
+            }
+            if (!fill(header + length)) {
+                break;
+            }
+            const uint8_t opcode = b0 & 0x0F;
+            if (opcode == 0x8) {
+                break;
+            }
+            message.append(_pending, header, length);
+            _pending.erase(0, header + length);
+            if ((b0 & 0x80) != 0) {
+                uint32_t seq = 0;
+                memcpy(&seq, message.data(), sizeof(seq));
+                if (message.size() != MESSAGE_SIZE || seq != _received) {
+                    _inOrder = false;
+                }
+                ++_received;
+                message.clear();
+            }
+        }
+    }
+
+    int _fd{-1};
+    ccstd::string _pending;
+    std::thread _reader;
+    std::atomic<uint32_t> _received{0};
+    std::atomic<bool> _inOrder{true};
+};
+
+template <typename F>
+bool waitFor(F &&condition, int timeoutMs = 10000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+bool allReceived(const ccstd::vector<std::unique_ptr<TestClient>> &clients, uint32_t count) {
+    for (const auto &client : clients) {
+        if (client->received() < count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A server on a system-assigned port with CLIENT_COUNT clients connected to it.
+class WebSocketServerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _server = std::make_shared<WebSocketServer>();
+        WebSocketServer::listenAsync(_server, 0, "127.0.0.1", nullptr);
+        ASSERT_TRUE(waitFor([&]() { return _server->getPort() != 0; }, 5000));
+        _port = _server->getPort();
+
+        for (uint32_t i = 0; i < CLIENT_COUNT; ++i) {
+            auto client = std::make_unique<TestClient>();
+            ASSERT_TRUE(client->connectTo(_port));
+            _clients.emplace_back(std::move(client));
+        }
+        ASSERT_TRUE(waitFor([&]() { return _server->getConnections().size() >= CLIENT_COUNT; }));
+    }
+
+    void TearDown() override {
+        _clients.clear();
+        if (_port == 0) {
+            return;
+        }
+        _server->closeAsync();
+        // listenAsync holds its own reference until the loop has stopped
+        TestClient probe;
+        EXPECT_TRUE(waitFor([&]() { return !probe.connectTo(_port); }));
+        EXPECT_EQ(_server->getPort(), 0);
+    }
+
+    // every connection is sent its own copy
+    void sendToEach(uint32_t count) {
+        auto connections = _server->getConnections();
+        for (uint32_t i = 0; i < count; ++i, ++_seq) {
+            memcpy(_payload.data(), &_seq, sizeof(_seq));
+            for (auto &conn : connections) {
+                conn->sendBinaryAsync(_payload.data(), _payload.size(), nullptr);
+            }
+        }
+    }
+
+    // one frame shared by all connections
+    void broadcast(uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i, ++_seq) {
+            memcpy(_payload.data(), &_seq, sizeof(_seq));
+            _server->broadcastBinaryAsync(_payload.data(), _payload.size());
+        }
+    }
+
+    std::shared_ptr<WebSocketServer> _server;
+    int _port{0};
+    ccstd::vector<std::unique_ptr<TestClient>> _clients;
+    ccstd::vector<uint8_t> _payload = ccstd::vector<uint8_t>(MESSAGE_SIZE, 0x5A);
+    uint32_t _seq{0};
+};
+} // namespace
+
+// Checks that per-connection sends and broadcasts reach every client complete and in order.
+TEST_F(WebSocketServerTest, broadcastDeliversInOrder) {
+    sendToEach(MESSAGE_COUNT);
+    ASSERT_TRUE(waitFor([&]() { return allReceived(_clients, _seq); }));
+    broadcast(MESSAGE_COUNT);
+    ASSERT_TRUE(waitFor([&]() { return allReceived(_clients, _seq); }));
+
+    for (const auto &client : _clients) {
+        EXPECT_TRUE(client->inOrder());
+        EXPECT_EQ(client->received(), _seq);
+    }
+}
+
+// Messages delivered per second, run with --gtest_also_run_disabled_tests.
+// The rates depend too much on the machine to be asserted, they are only logged.
+TEST_F(WebSocketServerTest, DISABLED_sendThroughputBenchmark) {
+    auto start = std::chrono::steady_clock::now();
+    sendToEach(MESSAGE_COUNT);
+    ASSERT_TRUE(waitFor([&]() { return allReceived(_clients, _seq); }));
+    const double perConnectionMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    broadcast(MESSAGE_COUNT);
+    ASSERT_TRUE(waitFor([&]() { return allReceived(_clients, _seq); }));
+    const double broadcastMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const double deliveries = static_cast<double>(MESSAGE_COUNT) * CLIENT_COUNT;
+    CC_LOG_INFO("%u clients x %u messages: per-connection send %.0f msg/s, broadcast %.0f msg/s",
+                CLIENT_COUNT, MESSAGE_COUNT, deliveries * 1000.0 / perConnectionMs, deliveries * 1000.0 / broadcastMs);
+}
+
+#endif
@@ -0,0 +1,193 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+
+#if CC_USE_PHYSICS_PHYSX
+    #include <chrono>
+    #include "base/Log.h"
+    #include "base/std/container/vector.h"
+    #include "physics/physx/PhysXInc.h"
+    #include "physics/physx/PhysXUtils.h"
+    #include "physics/physx/PhysXWorld.h"
+
+using namespace cc::physics;
+
+namespace {
+constexpr uint32_t GRID_SIZE = 32;
+constexpr uint32_t QUERY_COUNT = 8192;
+
+void buildScene(PhysXWorld &world, ccstd::vector<physx::PxRigidStatic *> &actors) {
+    auto &physics = PhysXWorld::getPhysics();
+    physx::PxMaterial *material = physics.createMaterial(0.5F, 0.5F, 0.1F);
+    uint32_t id = 1;
+    for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+        for (uint32_t z = 0; z < GRID_SIZE; ++z) {
+            physx::PxTransform pose{physx::PxVec3{static_cast<float>(x) * 2.F, 0.F, static_cast<float>(z) * 2.F}};
+            auto *actor = physics.createRigidStatic(pose);
+            auto *shape = physx::PxRigidActorExt::createExclusiveShape(*actor, physx::PxBoxGeometry{0.5F, 0.5F, 0.5F}, *material);
+            shape->setQueryFilterData(physx::PxFilterData{0xFFFFFFFF, 0, 0, 0});
+            getPxShapeMap()[reinterpret_cast<uintptr_t>(shape)] = id++;
+            world.getScene().addActor(*actor);
+            actors.push_back(actor);
+        }
+    }
+    material->release();
+}
+
+void destroyScene(PhysXWorld &world, ccstd::vector<physx::PxRigidStatic *> &actors) {
+    for (auto *actor : actors) {
+        physx::PxShape *shape = nullptr;
+        actor->getShapes(&shape, 1);
+        getPxShapeMap().erase(reinterpret_cast<uintptr_t>(shape));
+        world.getScene().removeActor(*actor);
+        actor->release();
+    }
+    actors.clear();
+}
+
+ccstd::vector<RaycastOptions> makeQueries() {
+    ccstd::vector<RaycastOptions> opts(QUERY_COUNT);
+    for (uint32_t i = 0; i < QUERY_COUNT; ++i) {
+        auto &opt = opts[i];
+        // Rays fall from above the grid, a quarter of them land between the boxes.
+        const float x = static_cast<float>(i % (GRID_SIZE * 4)) * 0.5F;
+        const float z = static_cast<float>((i / (GRID_SIZE * 4)) % (GRID_SIZE * 4)) * 0.5F;
+        opt.origin.set(x, 10.F, z);
+        opt.unitDir.set(0.F, -1.F, 0.F);
+        opt.distance = 100.F;
+        opt.mask = 0xFFFFFFFF;
+        opt.queryTrigger = true;
+    }
+    return opts;
+}
+
+template <typename Fn>
+double measureMs(const Fn &fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void expectSameResult(const RaycastResult &a, const RaycastResult &b) {
+    EXPECT_EQ(a.shape, b.shape);
+    if (a.shape != 0) {
+        EXPECT_FLOAT_EQ(a.distance, b.distance);
+        EXPECT_FLOAT_EQ(a.hitPoint.y, b.hitPoint.y);
+    }
+}
+} // namespace
+
+TEST(physicsBatchQuery, raycastBatchMatchesSingleQueries) {
+    auto *world = ccnew PhysXWorld();
+    ccstd::vector<physx::PxRigidStatic *> actors;
+    buildScene(*world, actors);
+
+    auto opts = makeQueries();
+    ccstd::vector<RaycastResult> single(QUERY_COUNT);
+    ccstd::vector<RaycastResult> batched(QUERY_COUNT);
+
+    uint32_t singleHits = 0;
+    for (uint32_t i = 0; i < QUERY_COUNT; ++i) {
+        if (world->raycastClosest(opts[i])) {
+            single[i] = world->raycastClosestResult();
+            ++singleHits;
+        }
+    }
+    const uint32_t batchHits = world->raycastClosestBatch(opts.data(), QUERY_COUNT, batched.data());
+
+    EXPECT_GT(singleHits, 0U);
+    EXPECT_EQ(singleHits, batchHits);
+    for (uint32_t i = 0; i < QUERY_COUNT; ++i) {
+        expectSameResult(single[i], batched[i]);
+    }
+
+    destroyScene(*world, actors);
+    delete world;
+}
+
+TEST(physicsBatchQuery, sweepBatchMatchesSingleQueries) {
+    auto *world = ccnew PhysXWorld();
+    ccstd::vector<physx::PxRigidStatic *> actors;
+    buildScene(*world, actors);
+
+    auto opts = makeQueries();
+    ccstd::vector<RaycastResult> single(QUERY_COUNT);
+    ccstd::vector<RaycastResult> batched(QUERY_COUNT);
+
+    uint32_t singleHits = 0;
+    for (uint32_t i = 0; i < QUERY_COUNT; ++i) {
+        if (world->sweepSphereClosest(opts[i], 0.2F)) {
+            single[i] = world->sweepClosestResult();
+            ++singleHits;
+        }
+    }
+    const uint32_t batchHits = world->sweepSphereClosestBatch(opts.data(), QUERY_COUNT, 0.2F, batched.data());
+
+    EXPECT_EQ(singleHits, batchHits);
+    for (uint32_t i = 0; i < QUERY_COUNT; ++i) {
+        expectSameResult(single[i], batched[i]);
+    }
+
+    EXPECT_EQ(world->sweepBoxClosestBatch(opts.data(), 0, 0.2F, 0.2F, 0.2F, 1.F, 0.F, 0.F, 0.F, batched.data()), 0U);
+
+    destroyScene(*world, actors);
+    delete world;
+}
+
+TEST(physicsBatchQuery, DISABLED_queryThroughputBenchmark) {
+    auto *world = ccnew PhysXWorld();
+    ccstd::vector<physx::PxRigidStatic *> actors;
+    buildScene(*world, actors);
+
+    auto opts = makeQueries();
+    ccstd::vector<RaycastResult> batched(QUERY_COUNT);
+
+    const double raycastSingleMs = measureMs([&]() {
+        for (const auto &opt : opts) {
+            world->raycastClosest(opt);
+        }
+    });
+    const double raycastBatchMs = measureMs([&]() {
+        world->raycastClosestBatch(opts.data(), QUERY_COUNT, batched.data());
+    });
+    const double sweepSingleMs = measureMs([&]() {
+        for (const auto &opt : opts) {
+            world->sweepSphereClosest(opt, 0.2F);
+        }
+    });
+    const double sweepBatchMs = measureMs([&]() {
+        world->sweepSphereClosestBatch(opts.data(), QUERY_COUNT, 0.2F, batched.data());
+    });
+
+    const double queries = static_cast<double>(QUERY_COUNT) * 1000.0;
+    CC_LOG_INFO("%u raycasts: single %.0f queries/s, batched %.0f queries/s",
+                QUERY_COUNT, queries / raycastSingleMs, queries / raycastBatchMs);
+    CC_LOG_INFO("%u sphere sweeps: single %.0f queries/s, batched %.0f queries/s",
+                QUERY_COUNT, queries / sweepSingleMs, queries / sweepBatchMs);
+
+    destroyScene(*world, actors);
+    delete world;
+}
+
+#endif
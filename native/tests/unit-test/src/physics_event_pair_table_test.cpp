@@ -0,0 +1,127 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "physics/physx/PhysXEventPairTable.h"
+#include "gtest/gtest.h"
+
+using namespace cc::physics;
+
+namespace {
+struct TestPair {
+    uint32_t shapeA;
+    uint32_t shapeB;
+    uint32_t state{0};
+    uint32_t contactOffset{0};
+    uint32_t contactCount{0};
+    TestPair(uint32_t a, uint32_t b) : shapeA(a), shapeB(b) {}
+};
+
+struct TestContact {
+    float data[12];
+};
+
+constexpr uint32_t PAIR_COUNT = 5000;
+constexpr uint32_t CONTACTS_PER_PAIR = 4;
+} // namespace
+
+TEST(physicsEventPairTable, keyIsOrderIndependent) {
+    EXPECT_EQ(PhysXEventPairTable<TestPair>::makeKey(3, 7), PhysXEventPairTable<TestPair>::makeKey(7, 3));
+    EXPECT_NE(PhysXEventPairTable<TestPair>::makeKey(3, 7), PhysXEventPairTable<TestPair>::makeKey(3, 8));
+}
+
+TEST(physicsEventPairTable, emplaceFindErase) {
+    PhysXEventPairTable<TestPair> table;
+    for (uint32_t i = 0; i < PAIR_COUNT; ++i) {
+        auto result = table.emplace(PhysXEventPairTable<TestPair>::makeKey(i, i + PAIR_COUNT), i, i + PAIR_COUNT);
+        EXPECT_TRUE(result.second);
+    }
+    // Reporting the same pair again, in any order, hits the existing record.
+    auto again = table.emplace(PhysXEventPairTable<TestPair>::makeKey(PAIR_COUNT + 10, 10), PAIR_COUNT + 10, 10);
+    EXPECT_FALSE(again.second);
+    EXPECT_EQ(again.first->shapeA, 10);
+    EXPECT_EQ(table.size(), PAIR_COUNT);
+
+    // Remove every odd pair, the remaining ones must all still be reachable.
+    table.eraseIf([](const TestPair &pair) { return pair.shapeA % 2 == 1; });
+    EXPECT_EQ(table.size(), PAIR_COUNT / 2);
+    for (uint32_t i = 0; i < PAIR_COUNT; ++i) {
+        auto *pair = table.find(PhysXEventPairTable<TestPair>::makeKey(i, i + PAIR_COUNT));
+        if (i % 2 == 1) {
+            EXPECT_EQ(pair, nullptr);
+        } else {
+            ASSERT_NE(pair, nullptr);
+            EXPECT_EQ(pair->shapeA, i);
+        }
+    }
+}
+
+// Simulates thousands of simultaneous contacts reported every step, the way PhysXEventManager
+// fills and resets its tables, and checks that steady state steps do not grow any storage.
+TEST(physicsEventPairTable, contactStress) {
+    PhysXEventPairTable<TestPair> contacts;
+    PhysXEventPairTable<TestPair> triggers;
+    ccstd::vector<TestContact> points;
+
+    size_t contactCapacity = 0;
+    size_t triggerCapacity = 0;
+    size_t pointCapacity = 0;
+    for (uint32_t step = 0; step < 100; ++step) {
+        for (uint32_t i = 0; i < PAIR_COUNT; ++i) {
+            auto *pair = contacts.emplace(PhysXEventPairTable<TestPair>::makeKey(i, i + 1), i, i + 1).first;
+            pair->contactOffset = static_cast<uint32_t>(points.size());
+            pair->contactCount = CONTACTS_PER_PAIR;
+            points.resize(points.size() + CONTACTS_PER_PAIR);
+
+            // Half of the triggers toggle each step so records keep entering and leaving.
+            if (i % 2 == 0 || step % 2 == 0) {
+                triggers.emplace(PhysXEventPairTable<TestPair>::makeKey(i, i + 2), i, i + 2);
+            } else if (auto *trigger = triggers.find(PhysXEventPairTable<TestPair>::makeKey(i, i + 2))) {
+                trigger->state = 2;
+            }
+        }
+        EXPECT_EQ(contacts.size(), PAIR_COUNT);
+        EXPECT_EQ(points.size(), PAIR_COUNT * CONTACTS_PER_PAIR);
+        EXPECT_EQ(contacts.records().back().contactOffset, (PAIR_COUNT - 1) * CONTACTS_PER_PAIR);
+
+        if (step == 1) {
+            contactCapacity = contacts.capacity();
+            triggerCapacity = triggers.capacity();
+            pointCapacity = points.capacity();
+        } else if (step > 1) {
+            EXPECT_EQ(contacts.capacity(), contactCapacity);
+            EXPECT_EQ(triggers.capacity(), triggerCapacity);
+            EXPECT_EQ(points.capacity(), pointCapacity);
+        }
+
+        triggers.eraseIf([](TestPair &pair) {
+            if (pair.state == 2) {
+                return true;
+            }
+            pair.state = 1;
+            return false;
+        });
+        contacts.clear();
+        points.clear();
+    }
+    EXPECT_EQ(triggers.size(), PAIR_COUNT / 2);
+}
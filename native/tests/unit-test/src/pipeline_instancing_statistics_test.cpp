@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/custom/NativePipelineTypes.h"
+#include "cocos/scene/Pass.h"
+#include "cocos/scene/SubModel.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t STRIDE = 16;
+
+// a sub-model with one per-instance vec4 attribute, enough for InstancedBuffer::merge
+IntrusivePtr<scene::SubModel> createSubModel(gfx::InputAssembler *ia, gfx::DescriptorSet *descriptorSet) {
+    IntrusivePtr<scene::SubModel> subModel = ccnew scene::SubModel();
+    subModel->setInputAssembler(ia);
+    subModel->setDescriptorSet(descriptorSet);
+    subModel->setShaders({nullptr});
+    auto &attrs = subModel->getInstancedAttributeBlock();
+    attrs.buffer = Uint8Array(STRIDE);
+    attrs.attributes.emplace_back(gfx::Attribute{"a_instanced_color", gfx::Format::RGBA32F});
+    return subModel;
+}
+
+} // namespace
+
+TEST(renderInstancingQueue, reportsStatistics) {
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    IntrusivePtr<gfx::DescriptorSetLayout> layout = device->createDescriptorSetLayout({});
+    IntrusivePtr<gfx::DescriptorSet> descriptorSet = device->createDescriptorSet({layout});
+    IntrusivePtr<gfx::Buffer> vb = device->createBuffer({
+        gfx::BufferUsageBit::VERTEX,
+        gfx::MemoryUsageBit::DEVICE,
+        12 * 3,
+        12,
+    });
+    IntrusivePtr<gfx::InputAssembler> ia = device->createInputAssembler({
+        {gfx::Attribute{"a_position", gfx::Format::RGB32F}},
+        {vb},
+    });
+
+    IntrusivePtr<scene::Pass> pass = ccnew scene::Pass();
+    const uint32_t count = pipeline::InstancedBuffer::INITIAL_CAPACITY + 1;
+    ccstd::vector<IntrusivePtr<scene::SubModel>> subModels;
+    render::RenderInstancingQueue queue(boost::container::pmr::get_default_resource());
+    for (uint32_t i = 0; i != count; ++i) {
+        subModels.emplace_back(createSubModel(ia, descriptorSet));
+        queue.add(*pass, *subModels.back(), 0);
+    }
+    queue.sort();
+
+    // all sub-models share one batch, which outgrows its initial vertex buffer
+    pipeline::InstancingStatistics statistics;
+    queue.uploadBuffers(device->getCommandBuffer(), &statistics);
+    EXPECT_EQ(statistics.numInstances, count);
+    EXPECT_EQ(statistics.numDrawCalls, 1);
+    EXPECT_EQ(statistics.getDrawCallsSaved(), count - 1);
+    EXPECT_EQ(statistics.numBufferResizes, 1);
+    EXPECT_EQ(statistics.uploadedBytes, count * STRIDE);
+
+    // the next frame reuses the grown buffer
+    queue.clear();
+    for (const auto &subModel : subModels) {
+        queue.add(*pass, *subModel, 0);
+    }
+    queue.sort();
+    statistics = {};
+    queue.uploadBuffers(device->getCommandBuffer(), &statistics);
+    EXPECT_EQ(statistics.numInstances, count);
+    EXPECT_EQ(statistics.numBufferResizes, 0);
+}
@@ -0,0 +1,201 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/custom/NativeExecutorRenderGraph.h"
+#include "cocos/renderer/pipeline/custom/NativeRenderGraphUtils.h"
+#include "gtest/gtest.h"
+
+using namespace cc::render; // NOLINT
+
+namespace {
+
+class ParallelRecordingTest : public testing::Test {
+protected:
+    RenderGraph::vertex_descriptor addPass(const ccstd::string &name) {
+        RasterPass pass(rg.get_allocator());
+        pass.width = 64;
+        pass.height = 64;
+        return addVertex2(
+            RasterPassTag{},
+            std::forward_as_tuple(name),
+            std::forward_as_tuple(name),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(std::move(pass)),
+            rg);
+    }
+    RenderGraph::vertex_descriptor addQueue(RenderGraph::vertex_descriptor passID) {
+        return addVertex2(
+            QueueTag{},
+            std::forward_as_tuple("default"),
+            std::forward_as_tuple("default"),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(QueueHint::NONE, 0U),
+            rg, passID);
+    }
+    RenderGraph::vertex_descriptor addScene(RenderGraph::vertex_descriptor queueID, SceneFlags flags) {
+        SceneData scene;
+        scene.flags = flags;
+        return addVertex2(
+            SceneTag{},
+            std::forward_as_tuple("Scene"),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(std::move(scene)),
+            rg, queueID);
+    }
+    RenderGraph::vertex_descriptor addBlit(RenderGraph::vertex_descriptor queueID) {
+        return addVertex2(
+            BlitTag{},
+            std::forward_as_tuple("FullscreenQuad"),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(nullptr, 0U, SceneFlags::NONE, nullptr),
+            rg, queueID);
+    }
+    bool supported(RenderGraph::vertex_descriptor passID) {
+        validPasses.resize(num_vertices(rg), true);
+        return supportsParallelRecording(rg, validPasses, passID);
+    }
+
+    RenderGraph rg{boost::container::pmr::get_default_resource()};
+    ccstd::pmr::vector<bool> validPasses{boost::container::pmr::get_default_resource()};
+};
+
+} // namespace
+
+TEST_F(ParallelRecordingTest, sceneQueuesAreSupported) {
+    const auto passID = addPass("forward");
+    addScene(addQueue(passID), SceneFlags::OPAQUE);
+    addScene(addQueue(passID), SceneFlags::BLEND);
+    EXPECT_TRUE(supported(passID));
+}
+
+TEST_F(ParallelRecordingTest, emptyPassIsSupported) {
+    EXPECT_TRUE(supported(addPass("clear")));
+}
+
+TEST_F(ParallelRecordingTest, blitIsRecordedInline) {
+    const auto passID = addPass("post");
+    addBlit(addQueue(passID));
+    EXPECT_FALSE(supported(passID));
+}
+
+TEST_F(ParallelRecordingTest, culledChildrenAreIgnored) {
+    const auto passID = addPass("forward");
+    const auto queueID = addQueue(passID);
+    addScene(queueID, SceneFlags::OPAQUE);
+    const auto blitID = addBlit(queueID);
+    validPasses.resize(num_vertices(rg), true);
+    validPasses[blitID] = false;
+    EXPECT_TRUE(supportsParallelRecording(rg, validPasses, passID));
+}
+
+TEST_F(ParallelRecordingTest, uiAndProbeScenesAreRecordedInline) {
+    const auto uiPassID = addPass("ui");
+    addScene(addQueue(uiPassID), SceneFlags::UI);
+    const auto probePassID = addPass("probe");
+    addScene(addQueue(probePassID), SceneFlags::OPAQUE | SceneFlags::REFLECTION_PROBE);
+    EXPECT_FALSE(supported(uiPassID));
+    EXPECT_FALSE(supported(probePassID));
+}
+
+TEST_F(ParallelRecordingTest, customAndStatisticsPassesAreRecordedInline) {
+    const auto customPassID = addPass("custom");
+    get(RenderGraph::DataTag{}, rg, customPassID).custom = "myPass";
+    const auto statsPassID = addPass("stats");
+    get(RasterPassTag{}, statsPassID, rg).showStatistics = true;
+    EXPECT_FALSE(supported(customPassID));
+    EXPECT_FALSE(supported(statsPassID));
+}
+
+TEST_F(ParallelRecordingTest, nonRasterPassIsNotSupported) {
+    const auto passID = addPass("forward");
+    const auto queueID = addQueue(passID);
+    EXPECT_FALSE(supported(queueID));
+}
+
+TEST(ParallelRecordingDeviceTest, recordsSecondariesConcurrently) {
+    // the headless test runner creates an empty device, wrapped by the validator in debug builds
+    auto *device = cc::gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+
+    constexpr uint32_t SIZE = 64;
+    cc::IntrusivePtr<cc::gfx::Texture> color = device->createTexture({
+        cc::gfx::TextureType::TEX2D,
+        cc::gfx::TextureUsageBit::COLOR_ATTACHMENT,
+        cc::gfx::Format::RGBA8,
+        SIZE,
+        SIZE,
+    });
+    cc::gfx::RenderPassInfo renderPassInfo;
+    renderPassInfo.colorAttachments.emplace_back().format = cc::gfx::Format::RGBA8;
+
+    SecondaryRenderPass target;
+    target.renderPass = device->createRenderPass(renderPassInfo);
+    target.framebuffer = device->createFramebuffer({target.renderPass.get(), {color.get()}});
+    target.clearColors.emplace_back();
+    target.clearDepth = 1.0F;
+    target.scissor = cc::gfx::Rect{0, 0, SIZE, SIZE};
+
+    constexpr uint32_t COUNT = 8;
+    ccstd::vector<cc::IntrusivePtr<cc::gfx::CommandBuffer>> secondaries;
+    ccstd::vector<cc::gfx::CommandBuffer *> cmdBuffs;
+    for (uint32_t i = 0; i != COUNT; ++i) {
+        secondaries.emplace_back(device->createCommandBuffer({device->getQueue(), cc::gfx::CommandBufferType::SECONDARY}));
+        cmdBuffs.emplace_back(secondaries.back().get());
+    }
+
+    std::atomic<uint32_t> recorded{0};
+    const auto record = [&](uint32_t index) {
+        beginSecondaryCommandBuffer(cmdBuffs[index], target);
+        cmdBuffs[index]->end();
+        ++recorded;
+    };
+
+    // one thread per secondary, whatever job system the runner is built with
+    ccstd::vector<std::thread> threads;
+    for (uint32_t i = 0; i != COUNT; ++i) {
+        threads.emplace_back(record, i);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(recorded.load(), COUNT);
+
+    // the job system path used by the executor
+    recordSecondaryCommandBuffers(COUNT, record);
+    EXPECT_EQ(recorded.load(), 2 * COUNT);
+
+    auto *primary = device->getCommandBuffer();
+    primary->begin();
+    executeSecondaryCommandBuffers(primary, target, cmdBuffs.data(), COUNT);
+    primary->end();
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include "cocos/renderer/core/ProgramUtils.h"
+#include "cocos/renderer/pipeline/custom/details/OpenAddressingMap.h"
+#include "gtest/gtest.h"
+
+using cc::OpenAddressingMap;
+
+namespace {
+
+cc::IProgramInfo makeProgram() {
+    cc::IProgramInfo info;
+    info.hash = 1234;
+    cc::IDefineRecord useA;
+    useA.name = "USE_A";
+    useA.type = "boolean";
+    cc::IDefineRecord count;
+    count.name = "COUNT";
+    count.type = "number";
+    count.range = ccstd::vector<int32_t>{0, 3};
+    cc::IDefineRecord mode;
+    mode.name = "MODE";
+    mode.type = "string";
+    mode.options = ccstd::vector<ccstd::string>{"LOW", "MID", "HIGH"};
+    info.defines = {useA, count, mode};
+    cc::render::populateMacros(info);
+    return info;
+}
+
+} // namespace
+
+TEST(OpenAddressingMapTest, insertAndFind) {
+    OpenAddressingMap<uint32_t> map;
+    EXPECT_EQ(map.find(42), nullptr);
+    for (uint64_t i = 0; i != 1000; ++i) {
+        EXPECT_TRUE(map.emplace(i * 0x100000000ULL + (i & 7), static_cast<uint32_t>(i)));
+    }
+    EXPECT_EQ(map.size(), 1000);
+    for (uint64_t i = 0; i != 1000; ++i) {
+        const auto *value = map.find(i * 0x100000000ULL + (i & 7));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, i);
+    }
+    EXPECT_EQ(map.find(5), nullptr);
+    // existing keys keep their value
+    EXPECT_FALSE(map.emplace(0, 7));
+    EXPECT_EQ(*map.find(0), 0);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(0), nullptr);
+}
+
+TEST(ProgramVariantTest, packedBitsMatchVariantKey) {
+    const auto info = makeProgram();
+    ASSERT_FALSE(info.uber);
+
+    cc::MacroRecord defines;
+    EXPECT_EQ(cc::render::getVariantBits(info, defines), 0);
+    EXPECT_EQ(cc::render::getVariantKey(info, defines), "0|1234");
+
+    defines["USE_A"] = true;
+    defines["COUNT"] = 3;
+    defines["MODE"] = ccstd::string("HIGH");
+    defines["UNRELATED"] = true;
+    // USE_A at bit 0, COUNT at bits 1-2, MODE at bits 3-4
+    const uint32_t bits = 1U | (3U << 1) | (2U << 3);
+    EXPECT_EQ(cc::render::getVariantBits(info, defines), bits);
+    EXPECT_EQ(cc::render::getVariantKey(info, defines), "17|1234");
+}
+
+TEST(ProgramVariantTest, manifestLineRoundTrip) {
+    const auto info = makeProgram();
+
+    cc::MacroRecord defines;
+    defines["USE_A"] = true;
+    defines["COUNT"] = 2;
+    defines["MODE"] = ccstd::string("HIGH\t\\n\nLOW");
+    defines["UNRELATED"] = true;
+    const ccstd::string programName = "builtin-standard|standard-vs:vert|standard-fs:frag";
+    const auto line = cc::render::formatVariantManifestLine(7, "default", programName, info, defines);
+    // escaped values keep the record on a single line
+    ASSERT_EQ(std::count(line.begin(), line.end(), '\n'), 1);
+    EXPECT_EQ(line.back(), '\n');
+
+    uint32_t phaseID = 0;
+    ccstd::string phaseName;
+    ccstd::string parsedProgram;
+    cc::MacroRecord parsed;
+    ASSERT_TRUE(cc::render::parseVariantManifestLine(line, phaseID, phaseName, parsedProgram, parsed));
+    EXPECT_EQ(phaseID, 7);
+    EXPECT_EQ(phaseName, "default");
+    EXPECT_EQ(parsedProgram, programName);
+    // only the macros declared by the program are recorded
+    EXPECT_EQ(parsed.size(), 3);
+    EXPECT_EQ(parsed.count("UNRELATED"), 0);
+    EXPECT_EQ(ccstd::get<bool>(parsed["USE_A"]), true);
+    EXPECT_EQ(ccstd::get<int32_t>(parsed["COUNT"]), 2);
+    EXPECT_EQ(ccstd::get<ccstd::string>(parsed["MODE"]), "HIGH\t\\n\nLOW");
+    EXPECT_EQ(cc::render::getVariantKey(info, parsed), cc::render::getVariantKey(info, defines));
+}
+
+TEST(ProgramVariantTest, manifestRejectsMalformedLines) {
+    uint32_t phaseID = 0;
+    ccstd::string phaseName;
+    ccstd::string programName;
+    cc::MacroRecord defines;
+    const char *lines[] = {
+        "",
+        "x\tdefault\tprogram",
+        "1\tdefault",
+        "1\tdefault\tprogram\tUSE_A",
+        "1\tdefault\tprogram\tUSE_A=x1",
+        "1\tdefault\tprogram\tMODE=sHIGH\\q",
+    };
+    for (const auto *line : lines) {
+        EXPECT_FALSE(cc::render::parseVariantManifestLine(line, phaseID, phaseName, programName, defines)) << line;
+    }
+    EXPECT_TRUE(cc::render::parseVariantManifestLine("1\tdefault\tprogram", phaseID, phaseName, programName, defines));
+    EXPECT_TRUE(defines.empty());
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include "cocos/renderer/pipeline/custom/NativePipelineTypes.h"
+#include "gtest/gtest.h"
+
+using cc::render::DrawInstance;
+using cc::render::RenderDrawQueue;
+
+namespace {
+
+void fillQueue(RenderDrawQueue &queue, uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> small(0, 3);
+    std::uniform_int_distribution<uint32_t> shader(0, 15);
+    std::uniform_real_distribution<float> depth(-50.F, 50.F);
+    for (uint32_t i = 0; i != count; ++i) {
+        DrawInstance instance;
+        instance.priority = small(rng);
+        instance.hash = (small(rng) << 16) | (small(rng) << 8) | small(rng);
+        // many equal depths to exercise the shader id tie break
+        instance.depth = (i % 3 == 0) ? static_cast<float>(small(rng)) : depth(rng);
+        instance.shaderID = shader(rng) * 0x1000;
+        instance.passIndex = i;
+        instance.sortKey = RenderDrawQueue::makeSortKey(instance.hash, instance.depth);
+        queue.instances.emplace_back(instance);
+    }
+}
+
+template <typename Key>
+void expectSorted(const RenderDrawQueue &queue, Key key) {
+    for (size_t i = 1; i < queue.instances.size(); ++i) {
+        EXPECT_FALSE(key(queue.instances[i]) < key(queue.instances[i - 1])) << "at " << i;
+    }
+}
+
+} // namespace
+
+TEST(renderDrawQueueSort, opaqueMatchesTupleOrder) {
+    for (uint32_t count : {10U, 300U, 30000U}) {
+        RenderDrawQueue queue(boost::container::pmr::get_default_resource());
+        fillQueue(queue, count, count);
+        queue.sortOpaqueOrCutout();
+        ASSERT_EQ(queue.instances.size(), count);
+        expectSorted(queue, [](const DrawInstance &d) {
+            return std::make_tuple(d.hash, d.depth, d.shaderID);
+        });
+    }
+}
+
+TEST(renderDrawQueueSort, transparentMatchesTupleOrder) {
+    for (uint32_t count : {10U, 300U, 30000U}) {
+        RenderDrawQueue queue(boost::container::pmr::get_default_resource());
+        fillQueue(queue, count, count + 1);
+        queue.sortTransparent();
+        ASSERT_EQ(queue.instances.size(), count);
+        expectSorted(queue, [](const DrawInstance &d) {
+            return std::make_tuple(d.priority, d.hash, -d.depth, d.shaderID);
+        });
+    }
+}
+
+TEST(renderDrawQueueSort, keepsEveryInstance) {
+    RenderDrawQueue queue(boost::container::pmr::get_default_resource());
+    fillQueue(queue, 5000, 7);
+    queue.sortTransparent();
+    std::vector<uint32_t> ids;
+    for (const auto &instance : queue.instances) {
+        ids.push_back(instance.passIndex);
+    }
+    std::sort(ids.begin(), ids.end());
+    for (uint32_t i = 0; i != ids.size(); ++i) {
+        ASSERT_EQ(ids[i], i);
+    }
+}
@@ -0,0 +1,237 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/gfx-base/GFXShader.h"
+#include "cocos/renderer/pipeline/custom/NativeSceneCulling.h"
+#include "cocos/scene/Camera.h"
+#include "cocos/scene/Model.h"
+#include "cocos/scene/Pass.h"
+#include "cocos/scene/RenderScene.h"
+#include "cocos/scene/Shadow.h"
+#include "cocos/scene/SubModel.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t MODEL_COUNT = 256;
+constexpr uint32_t PHASE_ID = 0;
+constexpr uint32_t STRIDE = 16;
+
+// stands in for a compiled variant, passes only compare shader pointers while queues are filled
+class TestShader final : public gfx::Shader {
+protected:
+    void doInit(const gfx::ShaderInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+// a pass with its shader set up front, so sub-models never compile a program
+class TestPass final : public scene::Pass {
+public:
+    TestPass(gfx::Shader *shader, uint32_t phaseID, bool blend, scene::BatchingSchemes batchingScheme, pipeline::RenderPriority priority) {
+        _shader = shader;
+        _phaseID = phaseID;
+        _blendState.targets[0].blend = blend;
+        _batchingScheme = batchingScheme;
+        _priority = priority;
+    }
+};
+
+class TestModel final : public scene::Model {
+public:
+    void addSubModel(scene::SubModel *subModel) {
+        subModel->setOwner(this);
+        _subModels.emplace_back(subModel);
+    }
+};
+
+void expectSameDrawQueue(const render::RenderDrawQueue &serial, const render::RenderDrawQueue &parallel) {
+    ASSERT_EQ(serial.instances.size(), parallel.instances.size());
+    for (size_t i = 0; i != serial.instances.size(); ++i) {
+        const auto &lhs = serial.instances[i];
+        const auto &rhs = parallel.instances[i];
+        EXPECT_EQ(lhs.subModel, rhs.subModel);
+        EXPECT_EQ(lhs.passIndex, rhs.passIndex);
+        EXPECT_EQ(lhs.priority, rhs.priority);
+        EXPECT_EQ(lhs.hash, rhs.hash);
+        EXPECT_EQ(lhs.depth, rhs.depth);
+        EXPECT_EQ(lhs.shaderID, rhs.shaderID);
+    }
+}
+
+void expectSameInstancingQueue(const render::RenderInstancingQueue &serial, const render::RenderInstancingQueue &parallel) {
+    ASSERT_EQ(serial.sortedBatches.size(), parallel.sortedBatches.size());
+    for (size_t i = 0; i != serial.sortedBatches.size(); ++i) {
+        const auto *lhs = serial.sortedBatches[i];
+        const auto *rhs = parallel.sortedBatches[i];
+        EXPECT_EQ(lhs->getPass(), rhs->getPass());
+        ASSERT_EQ(lhs->getInstances().size(), rhs->getInstances().size());
+        for (size_t j = 0; j != lhs->getInstances().size(); ++j) {
+            EXPECT_EQ(lhs->getInstances()[j].drawInfo.instanceCount, rhs->getInstances()[j].drawInfo.instanceCount);
+            EXPECT_EQ(lhs->getInstances()[j].shader, rhs->getInstances()[j].shader);
+        }
+    }
+}
+
+} // namespace
+
+TEST(nativeSceneCulling, parallelMatchesSerial) {
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    IntrusivePtr<gfx::DescriptorSetLayout> layout = device->createDescriptorSetLayout({});
+    IntrusivePtr<gfx::DescriptorSet> descriptorSet = device->createDescriptorSet({layout});
+    IntrusivePtr<gfx::Buffer> vb = device->createBuffer({
+        gfx::BufferUsageBit::VERTEX,
+        gfx::MemoryUsageBit::DEVICE,
+        12 * 3,
+        12,
+    });
+    IntrusivePtr<gfx::InputAssembler> ia = device->createInputAssembler({
+        {gfx::Attribute{"a_position", gfx::Format::RGB32F}},
+        {vb},
+    });
+
+    // opaque and transparent passes, drawn one by one or instanced, and one pass of another phase
+    IntrusivePtr<gfx::Shader> shaders[] = {ccnew TestShader(), ccnew TestShader()};
+    ccstd::vector<IntrusivePtr<scene::Pass>> passes{
+        ccnew TestPass(shaders[0], PHASE_ID, false, scene::BatchingSchemes::NONE, pipeline::RenderPriority::DEFAULT),
+        ccnew TestPass(shaders[1], PHASE_ID, false, scene::BatchingSchemes::NONE, pipeline::RenderPriority::MIN),
+        ccnew TestPass(shaders[0], PHASE_ID, true, scene::BatchingSchemes::NONE, pipeline::RenderPriority::DEFAULT),
+        ccnew TestPass(shaders[1], PHASE_ID, false, scene::BatchingSchemes::INSTANCING, pipeline::RenderPriority::DEFAULT),
+        ccnew TestPass(shaders[0], PHASE_ID, true, scene::BatchingSchemes::INSTANCING, pipeline::RenderPriority::DEFAULT),
+        ccnew TestPass(shaders[0], PHASE_ID + 1, false, scene::BatchingSchemes::NONE, pipeline::RenderPriority::DEFAULT),
+    };
+
+    IntrusivePtr<scene::RenderScene> renderScene = ccnew scene::RenderScene();
+    scene::IRenderSceneInfo info;
+    info.name = "culling";
+    renderScene->initialize(info);
+
+    // a grid wider than the frustums, some models have no bounds, cast shadows or are disabled
+    ccstd::vector<IntrusivePtr<TestModel>> models;
+    for (uint32_t i = 0; i != MODEL_COUNT; ++i) {
+        const auto x = static_cast<float>(i % 16) * 3.F - 24.F;
+        const auto y = static_cast<float>(i / 16 % 4) * 3.F - 6.F;
+        const auto z = -static_cast<float>(i % 7) * 5.F - 5.F;
+        IntrusivePtr<Node> node = ccnew Node();
+        node->setPosition(x, y, z);
+
+        IntrusivePtr<TestModel> model = ccnew TestModel();
+        model->initialize();
+        model->setNode(node);
+        model->setTransform(node);
+        model->setCastShadow(i % 3 == 0);
+        model->setEnabled(i % 17 != 0);
+        model->setPriority(i % 5);
+        if (i % 11 != 0) {
+            model->setWorldBounds(ccnew geometry::AABB(x, y, z, 0.5F, 0.5F, 0.5F));
+        }
+        for (uint32_t j = 0; j != 2; ++j) {
+            IntrusivePtr<scene::SubModel> subModel = ccnew scene::SubModel();
+            subModel->setPasses(std::make_shared<ccstd::vector<IntrusivePtr<scene::Pass>>>(
+                ccstd::vector<IntrusivePtr<scene::Pass>>{passes[(i + j) % passes.size()], passes[(i * 7 + j) % passes.size()]}));
+            subModel->setInputAssembler(ia);
+            subModel->setDescriptorSet(descriptorSet);
+            subModel->setPriority(static_cast<pipeline::RenderPriority>(i % 3));
+            auto &attrs = subModel->getInstancedAttributeBlock();
+            attrs.buffer = Uint8Array(STRIDE);
+            attrs.attributes.emplace_back(gfx::Attribute{"a_instanced_color", gfx::Format::RGBA32F});
+            model->addSubModel(subModel);
+        }
+        renderScene->addModel(model);
+        models.emplace_back(model);
+    }
+
+    IntrusivePtr<scene::Camera> camera = ccnew scene::Camera(device);
+    camera->setPosition(Vec3::ZERO);
+    camera->setForward(Vec3(0.F, 0.F, -1.F));
+    geometry::Frustum wide;
+    geometry::Frustum::createOrthographic(&wide, 20.F, 20.F, 0.1F, 100.F, Mat4::IDENTITY);
+    geometry::Frustum narrow;
+    geometry::Frustum::createOrthographic(&narrow, 8.F, 8.F, 0.1F, 20.F, Mat4::IDENTITY);
+    scene::Shadows shadows;
+
+    constexpr uint32_t QUERY_COUNT = 3;
+    const geometry::Frustum *frustums[QUERY_COUNT] = {&wide, &wide, &narrow};
+    const bool castShadows[QUERY_COUNT] = {false, true, false};
+
+    auto *scratch = boost::container::pmr::get_default_resource();
+    struct Results {
+        ccstd::vector<const scene::Model *> culled[QUERY_COUNT];
+        ccstd::vector<render::NativeRenderQueue> queues;
+        ccstd::vector<ccstd::vector<render::InstancingDraw>> pendingInstancing;
+    };
+    const auto run = [&](bool bParallel, Results &results) {
+        ccstd::vector<render::FrustumCullingTask> cullingTasks;
+        for (uint32_t i = 0; i != QUERY_COUNT; ++i) {
+            cullingTasks.emplace_back(render::FrustumCullingTask{
+                renderScene.get(), camera.get(), frustums[i], nullptr, castShadows[i], &results.culled[i]});
+        }
+        render::executeFrustumCullingTasks(cullingTasks, nullptr, shadows, bParallel);
+
+        // every query fills a queue of both kinds of objects, the first one also an opaque-only queue
+        results.queues.reserve(QUERY_COUNT + 1);
+        results.pendingInstancing.resize(QUERY_COUNT + 1);
+        ccstd::vector<render::RenderQueueTask> queueTasks;
+        for (uint32_t i = 0; i != QUERY_COUNT + 1; ++i) {
+            results.queues.emplace_back(scratch);
+            queueTasks.emplace_back(render::RenderQueueTask{
+                PHASE_ID, true, i != QUERY_COUNT, camera.get(), &results.culled[i % QUERY_COUNT],
+                &results.queues.back(), &results.pendingInstancing[i]});
+        }
+        render::executeRenderQueueTasks(queueTasks, bParallel);
+        EXPECT_TRUE(queueTasks.empty());
+    };
+
+    Results serial;
+    run(false, serial);
+    Results parallel;
+    run(true, parallel);
+
+    // the wide frustum culls part of the grid and keeps models without bounds
+    EXPECT_FALSE(serial.culled[0].empty());
+    EXPECT_LT(serial.culled[0].size(), MODEL_COUNT);
+    EXPECT_LT(serial.culled[1].size(), serial.culled[0].size());
+    EXPECT_LT(serial.culled[2].size(), serial.culled[0].size());
+    for (uint32_t i = 0; i != QUERY_COUNT; ++i) {
+        EXPECT_EQ(serial.culled[i], parallel.culled[i]);
+    }
+
+    EXPECT_FALSE(serial.queues[0].opaqueQueue.instances.empty());
+    EXPECT_FALSE(serial.queues[0].transparentQueue.instances.empty());
+    EXPECT_FALSE(serial.queues[0].opaqueInstancingQueue.empty());
+    EXPECT_FALSE(serial.queues[0].transparentInstancingQueue.empty());
+    EXPECT_TRUE(serial.queues[QUERY_COUNT].transparentQueue.instances.empty());
+    for (uint32_t i = 0; i != QUERY_COUNT + 1; ++i) {
+        expectSameDrawQueue(serial.queues[i].opaqueQueue, parallel.queues[i].opaqueQueue);
+        expectSameDrawQueue(serial.queues[i].transparentQueue, parallel.queues[i].transparentQueue);
+        expectSameInstancingQueue(serial.queues[i].opaqueInstancingQueue, parallel.queues[i].opaqueInstancingQueue);
+        expectSameInstancingQueue(serial.queues[i].transparentInstancingQueue, parallel.queues[i].transparentInstancingQueue);
+    }
+
+    renderScene->destroy();
+}
@@ -0,0 +1,199 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/custom/TransientResourcePool.h"
+#include "gtest/gtest.h"
+
+using cc::render::TransientResourcePool;
+
+namespace {
+
+class TransientResourcePoolTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // the headless test runner creates an empty device
+        _device = cc::gfx::Device::getInstance();
+        ASSERT_NE(_device, nullptr);
+    }
+
+    void TearDown() override {
+        _pool.clear();
+    }
+
+    static cc::gfx::TextureInfo makeTextureInfo(uint32_t width, uint32_t height) {
+        return {
+            cc::gfx::TextureType::TEX2D,
+            cc::gfx::TextureUsageBit::COLOR_ATTACHMENT | cc::gfx::TextureUsageBit::SAMPLED,
+            cc::gfx::Format::RGBA8,
+            width,
+            height,
+        };
+    }
+
+    static cc::gfx::BufferInfo makeBufferInfo(uint32_t size) {
+        return {
+            cc::gfx::BufferUsageBit::STORAGE,
+            cc::gfx::MemoryUsageBit::DEVICE,
+            size,
+            size,
+        };
+    }
+
+    cc::gfx::Device *_device{nullptr};
+    TransientResourcePool _pool;
+};
+
+} // namespace
+
+TEST_F(TransientResourcePoolTest, reusesReleasedTexture) {
+    const auto info = makeTextureInfo(64, 64);
+    auto *texture = _pool.acquireTexture(_device, info, 1);
+    ASSERT_NE(texture, nullptr);
+    EXPECT_TRUE(_pool.isAcquiredBy(texture, 1));
+
+    // still acquired, a second request creates a new texture
+    auto *other = _pool.acquireTexture(_device, info, 2);
+    EXPECT_NE(other, texture);
+
+    _pool.release(texture, 1);
+    EXPECT_FALSE(_pool.isAcquiredBy(texture, 1));
+    EXPECT_EQ(_pool.acquireTexture(_device, info, 3), texture);
+    EXPECT_TRUE(_pool.isAcquiredBy(texture, 3));
+
+    // incompatible info never reuses
+    _pool.release(texture, 3);
+    EXPECT_NE(_pool.acquireTexture(_device, makeTextureInfo(32, 32), 4), texture);
+
+    const auto &stats = _pool.getStatistics();
+    EXPECT_EQ(stats.numAcquires, 4);
+    EXPECT_EQ(stats.numReuses, 1);
+    EXPECT_EQ(stats.numCreates, 3);
+    EXPECT_EQ(stats.numTextures, 3);
+}
+
+TEST_F(TransientResourcePoolTest, keepsPreferredResource) {
+    const auto info = makeTextureInfo(16, 16);
+    auto *first = _pool.acquireTexture(_device, info, 1);
+    auto *second = _pool.acquireTexture(_device, info, 2);
+    _pool.release(first, 1);
+    _pool.release(second, 2);
+    _pool.nextFrame();
+
+    // owners get their own textures back, whatever the order of requests
+    EXPECT_EQ(_pool.acquireTexture(_device, info, 2, second), second);
+    EXPECT_EQ(_pool.acquireTexture(_device, info, 1, first), first);
+}
+
+TEST_F(TransientResourcePoolTest, releaseChecksOwner) {
+    auto *buffer = _pool.acquireBuffer(_device, makeBufferInfo(256), 1);
+    ASSERT_NE(buffer, nullptr);
+    _pool.release(buffer, 2);
+    EXPECT_TRUE(_pool.isAcquiredBy(buffer, 1));
+    _pool.release(buffer, 1);
+    EXPECT_FALSE(_pool.isAcquiredBy(buffer, 1));
+    EXPECT_EQ(_pool.acquireBuffer(_device, makeBufferInfo(256), 2), buffer);
+    EXPECT_EQ(_pool.getStatistics().numBuffers, 1);
+}
+
+TEST_F(TransientResourcePoolTest, evictsIdleResources) {
+    _pool.maxIdleFrames = 2;
+    const auto info = makeTextureInfo(8, 8);
+    auto *texture = _pool.acquireTexture(_device, info, 1);
+    _pool.release(texture, 1);
+
+    _pool.nextFrame();
+    _pool.nextFrame();
+    EXPECT_EQ(_pool.getStatistics().numTextures, 1);
+    _pool.nextFrame();
+    EXPECT_EQ(_pool.getStatistics().numTextures, 0);
+    EXPECT_EQ(_pool.getStatistics().numEvictions, 1);
+    EXPECT_EQ(_pool.getStatistics().totalMemory, 0);
+
+    // acquired resources are never evicted
+    auto *held = _pool.acquireTexture(_device, info, 1);
+    for (int i = 0; i != 4; ++i) {
+        _pool.nextFrame();
+    }
+    EXPECT_TRUE(_pool.isAcquiredBy(held, 1));
+    EXPECT_EQ(_pool.getStatistics().numTextures, 1);
+}
+
+TEST_F(TransientResourcePoolTest, tracksPeakMemory) {
+    const auto info = makeTextureInfo(16, 16);
+    const uint64_t size = 16 * 16 * 4;
+    auto *a = _pool.acquireTexture(_device, info, 1);
+    auto *b = _pool.acquireTexture(_device, info, 2);
+    EXPECT_EQ(_pool.getStatistics().usedMemory, 2 * size);
+    _pool.release(a, 1);
+    _pool.release(b, 2);
+
+    // a resource released after its last pass is aliased by the next one
+    _pool.nextFrame();
+    auto *c = _pool.acquireTexture(_device, info, 3);
+    _pool.release(c, 3);
+    auto *d = _pool.acquireTexture(_device, info, 4);
+    EXPECT_TRUE(d == a || d == b);
+
+    const auto &stats = _pool.getStatistics();
+    EXPECT_EQ(stats.peakMemory, size);
+    EXPECT_EQ(stats.totalMemory, 2 * size);
+    EXPECT_EQ(stats.numCreates, 0);
+    EXPECT_FLOAT_EQ(stats.getReuseRate(), 1.0F);
+}
+
+TEST_F(TransientResourcePoolTest, flagsAliasingInSameFrame) {
+    const auto info = makeTextureInfo(16, 16);
+    auto *a = _pool.acquireTexture(_device, info, 1);
+    _pool.release(a, 1);
+    _pool.nextFrame();
+
+    // reused from a previous frame, no pass of this frame accessed it
+    EXPECT_EQ(_pool.acquireTexture(_device, info, 2), a);
+    EXPECT_FALSE(_pool.takeAliasBarrier());
+
+    // released and reacquired in the same frame, the previous accesses must be waited for
+    _pool.release(a, 2);
+    EXPECT_EQ(_pool.acquireTexture(_device, info, 3), a);
+    EXPECT_TRUE(_pool.takeAliasBarrier());
+    EXPECT_FALSE(_pool.takeAliasBarrier());
+    EXPECT_EQ(_pool.getStatistics().numAliases, 1);
+}
+
+TEST_F(TransientResourcePoolTest, reportsEvictedTextures) {
+    _pool.maxIdleFrames = 1;
+    const auto info = makeTextureInfo(8, 8);
+    auto *texture = _pool.acquireTexture(_device, info, 1);
+    _pool.release(texture, 1);
+
+    std::vector<cc::gfx::Texture *> evicted;
+    const auto onEvict = [&evicted](cc::gfx::Texture *tex) {
+        evicted.emplace_back(tex);
+    };
+    _pool.nextFrame(onEvict);
+    EXPECT_TRUE(evicted.empty());
+    _pool.nextFrame(onEvict);
+    ASSERT_EQ(evicted.size(), 1U);
+    EXPECT_EQ(evicted[0], texture);
+}
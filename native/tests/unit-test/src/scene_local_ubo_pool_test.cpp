@@ -0,0 +1,185 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/Root.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/LocalUBOPool.h"
+#include "scene/Model.h"
+
+using namespace cc;
+using namespace cc::scene;
+
+namespace {
+
+gfx::Buffer *createBuffer(gfx::Device *device, uint32_t size) {
+    return device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                                 gfx::MemoryUsageBit::DEVICE,
+                                 size,
+                                 size});
+}
+
+} // namespace
+
+TEST(sceneLocalUBOPool, reusesFreedSlots) {
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    LocalUBOPool pool(device, pipeline::UBOLocal::SIZE);
+    EXPECT_GE(pool.getStride(), pool.getBlockSize());
+
+    auto first = pool.allocate();
+    auto second = pool.allocate();
+    ASSERT_TRUE(first.isValid());
+    ASSERT_TRUE(second.isValid());
+    EXPECT_NE(pool.getBuffer(first), pool.getBuffer(second));
+    EXPECT_EQ(pool.getBuffer(first)->getSize(), pipeline::UBOLocal::SIZE);
+
+    auto *view = pool.getBuffer(first);
+    const auto freed = first;
+    pool.free(first);
+    EXPECT_FALSE(first.isValid());
+
+    // the view of a freed slot is kept and handed out again
+    auto third = pool.allocate();
+    EXPECT_EQ(third.page, freed.page);
+    EXPECT_EQ(third.index, freed.index);
+    EXPECT_EQ(pool.getBuffer(third), view);
+
+    pool.free(second);
+    pool.free(third);
+}
+
+TEST(sceneLocalUBOPool, uploadsDirtyBlocksOnce) {
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    LocalUBOPool pool(device, pipeline::UBOWorldBound::SIZE);
+
+    ccstd::vector<LocalUBOPool::Slot> slots;
+    for (uint32_t i = 0; i < 3; ++i) {
+        slots.push_back(pool.allocate());
+    }
+    pool.commit();
+    EXPECT_EQ(pool.getStats().bufferCount, 1);
+    EXPECT_EQ(pool.getStats().uploadCalls, 1);
+    EXPECT_EQ(pool.getStats().bytesUploaded, 3 * pool.getStride());
+
+    // nothing changed
+    pool.commit();
+    EXPECT_EQ(pool.getStats().uploadCalls, 0);
+
+    // a single upload covers the page up to the last dirty block
+    pool.markDirty(slots[1]);
+    pool.commit();
+    EXPECT_EQ(pool.getStats().uploadCalls, 1);
+    EXPECT_EQ(pool.getStats().bytesUploaded, 2 * pool.getStride());
+
+    for (auto &slot : slots) {
+        pool.free(slot);
+    }
+}
+
+TEST(sceneLocalUBOPool, growsByPages) {
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    LocalUBOPool pool(device, pipeline::UBOLocal::SIZE);
+
+    ccstd::vector<LocalUBOPool::Slot> slots;
+    for (uint32_t i = 0; i <= LocalUBOPool::BLOCKS_PER_PAGE; ++i) {
+        slots.push_back(pool.allocate());
+    }
+    EXPECT_EQ(slots.back().page, 1);
+    pool.commit();
+    EXPECT_EQ(pool.getStats().bufferCount, 2);
+    EXPECT_EQ(pool.getStats().uploadCalls, 2);
+
+    for (auto &slot : slots) {
+        pool.free(slot);
+    }
+}
+
+TEST(sceneLocalUBOPool, modelKeepsCallerBuffers) {
+    auto *device = gfx::Device::getInstance();
+    if (!Root::getInstance() || !device) {
+        GTEST_SKIP() << "device is required to create models";
+    }
+
+    IntrusivePtr<Model> model = ccnew Model();
+    model->initialize();
+    model->initLocalDescriptors(0);
+    model->initWorldBoundDescriptors(0);
+    IntrusivePtr<gfx::Buffer> pooledLocal = model->getLocalBuffer();
+    IntrusivePtr<gfx::Buffer> pooledWorldBound = model->getWorldBoundBuffer();
+    ASSERT_NE(pooledLocal, nullptr);
+    ASSERT_NE(pooledWorldBound, nullptr);
+
+    IntrusivePtr<gfx::Buffer> localBuffer = createBuffer(device, pipeline::UBOLocal::SIZE);
+    IntrusivePtr<gfx::Buffer> worldBoundBuffer = createBuffer(device, pipeline::UBOWorldBound::SIZE);
+    model->setLocalBuffer(localBuffer);
+    model->setWorldBoundBuffer(worldBoundBuffer);
+    EXPECT_EQ(model->getLocalBuffer(), localBuffer);
+    EXPECT_EQ(model->getWorldBoundBuffer(), worldBoundBuffer);
+
+    // the slots went back to the pools, their views are still alive and handed out again
+    EXPECT_EQ(pooledLocal->getSize(), pipeline::UBOLocal::SIZE);
+    auto *localPool = LocalUBOPool::getLocalPool();
+    auto localSlot = localPool->allocate();
+    EXPECT_EQ(localPool->getBuffer(localSlot), pooledLocal);
+    localPool->free(localSlot);
+    auto *worldBoundPool = LocalUBOPool::getWorldBoundPool();
+    auto worldBoundSlot = worldBoundPool->allocate();
+    EXPECT_EQ(worldBoundPool->getBuffer(worldBoundSlot), pooledWorldBound);
+    worldBoundPool->free(worldBoundSlot);
+
+    // replacing and destroying never destroys buffers owned by the caller
+    model->setLocalBuffer(nullptr);
+    EXPECT_EQ(localBuffer->getSize(), pipeline::UBOLocal::SIZE);
+    model->setLocalBuffer(localBuffer);
+    model->destroy();
+    EXPECT_EQ(localBuffer->getSize(), pipeline::UBOLocal::SIZE);
+    EXPECT_EQ(worldBoundBuffer->getSize(), pipeline::UBOWorldBound::SIZE);
+
+    localBuffer->destroy();
+    worldBoundBuffer->destroy();
+}
+
+TEST(sceneLocalUBOPool, modelDestroysOwnBuffers) {
+    auto *device = gfx::Device::getInstance();
+    if (!Root::getInstance() || !device) {
+        GTEST_SKIP() << "device is required to create models";
+    }
+
+    // models implemented in JS don't use the pools
+    IntrusivePtr<Model> model = ccnew Model();
+    model->setType(Model::Type::LINE);
+    model->initialize();
+    model->initLocalDescriptors(0);
+    IntrusivePtr<gfx::Buffer> ownBuffer = model->getLocalBuffer();
+    ASSERT_NE(ownBuffer, nullptr);
+    EXPECT_EQ(ownBuffer->getSize(), pipeline::UBOLocal::SIZE);
+
+    model->destroy();
+    EXPECT_EQ(model->getLocalBuffer(), nullptr);
+    EXPECT_EQ(ownBuffer->getSize(), 0);
+}
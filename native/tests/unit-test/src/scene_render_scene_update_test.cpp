@@ -0,0 +1,209 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <chrono>
+#include <cstring>
+#include "base/Log.h"
+#include "base/std/container/vector.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/RenderPipeline.h"
+#include "scene/Model.h"
+#include "scene/Pass.h"
+#include "scene/RenderScene.h"
+#include "scene/SubModel.h"
+
+using namespace cc;
+using namespace cc::scene;
+
+namespace {
+constexpr uint32_t MODEL_COUNT = 50000;
+constexpr uint32_t PARENT_COUNT = 64;
+constexpr uint32_t FRAME_COUNT = 10;
+
+// Only owns the scene data models read while updating, nothing is activated or rendered.
+class HeadlessPipeline final : public pipeline::RenderPipeline {
+public:
+    HeadlessPipeline() {
+        _pipelineSceneData = ccnew pipeline::PipelineSceneData();
+    }
+
+    bool activate(gfx::Swapchain * /*swapchain*/) override {
+        return true;
+    }
+
+    bool destroy() override {
+        CC_SAFE_DELETE(_globalDSManager);
+        CC_SAFE_DELETE(_pipelineUBO);
+        _pipelineSceneData = nullptr;
+        return Asset::destroy();
+    }
+};
+
+// One sub-model without passes, so the local UBO is staged but nothing is compiled.
+class TestModel final : public Model {
+public:
+    void addSubModel(SubModel *subModel) {
+        subModel->setOwner(this);
+        _subModels.emplace_back(subModel);
+    }
+};
+
+// Reads what a model staged into its local buffer.
+struct StagingData : gfx::Buffer {
+    static const uint8_t *of(gfx::Buffer *buffer) { return getBufferStagingAddress(buffer); }
+};
+
+// Built the same way every time, so two scenes can be compared model by model.
+struct TestScene {
+    void build(gfx::DescriptorSet *descriptorSet) {
+        renderScene = ccnew RenderScene();
+        IRenderSceneInfo info;
+        info.name = "benchmark";
+        renderScene->initialize(info);
+
+        // models share a few parents so the serial ancestor resolution is exercised too
+        for (uint32_t i = 0; i < PARENT_COUNT; ++i) {
+            parents.emplace_back(ccnew Node());
+        }
+
+        auto *device = gfx::Device::getInstance();
+        models.reserve(MODEL_COUNT);
+        localBuffers.reserve(MODEL_COUNT);
+        for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+            auto *node = ccnew Node();
+            node->setParent(parents[i % PARENT_COUNT]);
+            node->setPosition(static_cast<float>(i % 100), static_cast<float>(i / 100 % 100), static_cast<float>(i / 10000));
+            node->setScale(1.F + static_cast<float>(i % 3), 1.F, 1.F);
+
+            IntrusivePtr<SubModel> subModel = ccnew SubModel();
+            subModel->setPasses(std::make_shared<ccstd::vector<IntrusivePtr<Pass>>>());
+            subModel->setDescriptorSet(descriptorSet);
+            IntrusivePtr<gfx::Buffer> localBuffer = device->createBuffer({
+                gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                gfx::MemoryUsageBit::DEVICE,
+                pipeline::UBOLocal::SIZE,
+                pipeline::UBOLocal::SIZE,
+                gfx::BufferFlagBit::ENABLE_STAGING_WRITE,
+            });
+
+            IntrusivePtr<TestModel> model = ccnew TestModel();
+            model->initialize();
+            model->setNode(node);
+            model->setTransform(node);
+            model->createBoundingShape(Vec3(-0.5F, -0.5F, -0.5F), Vec3(0.5F, 0.5F, 0.5F));
+            model->addSubModel(subModel);
+            model->setLocalBuffer(localBuffer);
+            renderScene->addModel(model);
+            models.emplace_back(model);
+            localBuffers.emplace_back(localBuffer);
+        }
+    }
+
+    void moveParents(uint32_t frame) {
+        for (uint32_t i = 0; i < PARENT_COUNT; ++i) {
+            parents[i]->setPosition(static_cast<float>(frame), static_cast<float>(i), 0.F);
+            parents[i]->setRotationFromEuler(0.F, static_cast<float>(frame * 10 + i), 0.F);
+        }
+    }
+
+    IntrusivePtr<RenderScene> renderScene;
+    ccstd::vector<IntrusivePtr<Node>> parents;
+    ccstd::vector<IntrusivePtr<TestModel>> models;
+    ccstd::vector<IntrusivePtr<gfx::Buffer>> localBuffers;
+};
+
+template <typename F>
+double measureMs(F &&func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Installs a headless pipeline when the root has none and destroys it again, so later tests see the root unchanged.
+class RenderSceneUpdateTest : public testing::Test {
+protected:
+    void SetUp() override {
+        auto *root = Root::getInstance();
+        ASSERT_NE(root, nullptr);
+        if (!root->getPipeline()) {
+            _ownsPipeline = true;
+            ASSERT_TRUE(root->setRenderPipeline(ccnew HeadlessPipeline()));
+        }
+    }
+
+    void TearDown() override {
+        if (_ownsPipeline) {
+            Root::getInstance()->destroyRenderPipeline();
+        }
+    }
+
+private:
+    bool _ownsPipeline{false};
+};
+} // namespace
+
+TEST_F(RenderSceneUpdateTest, parallelUpdateBenchmark) {
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    IntrusivePtr<gfx::DescriptorSetLayout> layout = device->createDescriptorSetLayout({});
+    IntrusivePtr<gfx::DescriptorSet> descriptorSet = device->createDescriptorSet({layout});
+
+    TestScene serial;
+    serial.build(descriptorSet);
+    TestScene parallel;
+    parallel.build(descriptorSet);
+
+    double serialMs = 0.0;
+    double parallelMs = 0.0;
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        serial.moveParents(frame);
+        parallel.moveParents(frame);
+        serialMs += measureMs([&]() { serial.renderScene->update(frame + 1, false); });
+        parallelMs += measureMs([&]() { parallel.renderScene->update(frame + 1, true); });
+
+        // results must not depend on how the models were scheduled
+        for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+            const Model *lhs = serial.models[i];
+            const Model *rhs = parallel.models[i];
+            ASSERT_EQ(lhs->getUpdateStamp(), frame + 1);
+            ASSERT_EQ(rhs->getUpdateStamp(), frame + 1);
+            ASSERT_EQ(memcmp(&lhs->getTransform()->getWorldMatrix(), &rhs->getTransform()->getWorldMatrix(), sizeof(Mat4)), 0) << "model " << i;
+            ASSERT_EQ(lhs->getWorldBounds()->getCenter(), rhs->getWorldBounds()->getCenter()) << "model " << i;
+            ASSERT_EQ(memcmp(StagingData::of(serial.localBuffers[i]), StagingData::of(parallel.localBuffers[i]), pipeline::UBOLocal::SIZE), 0) << "model " << i;
+        }
+    }
+    // the staged world matrix is the one of the transform
+    const uint8_t *world = StagingData::of(parallel.localBuffers[0]) + sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET;
+    EXPECT_EQ(memcmp(world, &parallel.models[0]->getTransform()->getWorldMatrix(), sizeof(Mat4)), 0);
+
+    CC_LOG_INFO("RenderScene::update with %u models: %.3f ms per frame serial, %.3f ms per frame parallel",
+                MODEL_COUNT, serialMs / FRAME_COUNT, parallelMs / FRAME_COUNT);
+
+    serial.renderScene->destroy();
+    parallel.renderScene->destroy();
+}
@@ -1,5 +1,13 @@
 #include "utils.h"
 
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #include <chrono>
+#endif
+
 #ifdef CC_USE_VULKAN
     #undef CC_USE_VULKAN
 #endif
@@ -66,3 +74,92 @@ void destroyCocos() {
     DeviceManager::destroy();
 }
 */
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+TestHttpServer::TestHttpServer(Handler handler)
+: _handler(std::move(handler)) {
+    _fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    socklen_t length = sizeof(addr);
+    if (_fd < 0 || bind(_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(_fd, 64) != 0 ||
+        getsockname(_fd, reinterpret_cast<sockaddr *>(&addr), &length) != 0) {
+        return;
+    }
+    _port = ntohs(addr.sin_port);
+    _acceptor = std::thread([this]() { acceptConnections(); });
+}
+
+TestHttpServer::~TestHttpServer() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _stopCondition.notify_all();
+    if (_fd >= 0) {
+        shutdown(_fd, SHUT_RDWR);
+        close(_fd);
+    }
+    if (_acceptor.joinable()) {
+        _acceptor.join();
+    }
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+ccstd::string TestHttpServer::url(const ccstd::string &path) const {
+    return "http://127.0.0.1:" + std::to_string(_port) + path;
+}
+
+void TestHttpServer::sleep(uint32_t ms) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _stopCondition.wait_for(lock, std::chrono::milliseconds(ms), [this]() { return _stopping; });
+}
+
+void TestHttpServer::acceptConnections() {
+    while (true) {
+        int client = accept(_fd, nullptr, nullptr);
+        if (client < 0) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _workers.emplace_back([this, client]() {
+            serve(client);
+            close(client);
+        });
+    }
+}
+
+void TestHttpServer::serve(int client) {
+    ccstd::string request;
+    char chunk[1024];
+    while (request.find("\r\n\r\n") == ccstd::string::npos) {
+        ssize_t n = recv(client, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return;
+        }
+        request.append(chunk, n);
+    }
+    ++_requests;
+    const uint32_t running = ++_running;
+    uint32_t maxRunning = _maxRunning;
+    while (running > maxRunning && !_maxRunning.compare_exchange_weak(maxRunning, running)) {
+    }
+    const ccstd::string response = _handler(request);
+    --_running;
+
+    const char *data = response.data();
+    size_t size = response.size();
+    while (size) {
+        ssize_t n = ::send(client, data, size, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return;
+        }
+        data += n;
+        size -= n;
+    }
+}
+#endif
@@ -23,8 +23,19 @@ THE SOFTWARE.
 ****************************************************************************/
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "application/ApplicationManager.h"
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 #include "cocos/math/Math.h"
 #include "gtest/gtest.h"
 
@@ -38,3 +49,79 @@ static void ExpectEq(bool lf, bool rt) {
 
 void initCocos(int width, int height);
 void destroyCocos();
+
+// Engine stub whose scheduler is ticked by the tests, network modules deliver their callbacks through it.
+class TestEngine : public cc::BaseEngine {
+public:
+    int32_t init() override { return 0; }
+    int32_t run() override { return 0; }
+    void pause() override {}
+    void resume() override {}
+    int restart() override { return 0; }
+    void close() override {}
+    uint getTotalFrames() const override { return 0; }
+    void setPreferredFramesPerSecond(int /*fps*/) override {}
+    SchedulerPtr getScheduler() const override { return _scheduler; }
+    bool isInited() const override { return true; }
+
+private:
+    SchedulerPtr _scheduler{std::make_shared<cc::Scheduler>()};
+};
+
+class TestApplication : public cc::BaseApplication {
+public:
+    int32_t init() override { return 0; }
+    int32_t run(int /*argc*/, const char ** /*argv*/) override { return 0; }
+    void pause() override {}
+    void resume() override {}
+    void restart() override {}
+    void close() override {}
+    cc::BaseEngine::Ptr getEngine() const override { return _engine; }
+    const std::vector<std::string> &getArguments() const override { return _arguments; }
+
+protected:
+    void setArgumentsInternal(int /*argc*/, const char * /*argv*/[]) override {}
+
+private:
+    cc::BaseEngine::Ptr _engine{std::make_shared<TestEngine>()};
+    std::vector<std::string> _arguments;
+};
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+// HTTP/1.1 server on the loopback interface, every connection serves one request.
+// The handler receives the request head and returns the whole response, it runs on a thread per connection.
+class TestHttpServer {
+public:
+    using Handler = std::function<ccstd::string(const ccstd::string &request)>;
+
+    explicit TestHttpServer(Handler handler);
+    ~TestHttpServer();
+
+    // path starts with '/'
+    ccstd::string url(const ccstd::string &path) const;
+
+    // blocks the calling handler for the given time, returns early once the server is destroyed
+    void sleep(uint32_t ms);
+
+    int port() const { return _port; }
+    uint32_t requests() const { return _requests; }
+    uint32_t running() const { return _running; }
+    uint32_t maxRunning() const { return _maxRunning; }
+
+private:
+    void acceptConnections();
+    void serve(int client);
+
+    Handler _handler;
+    int _fd{-1};
+    int _port{0};
+    std::thread _acceptor;
+    std::mutex _mutex;
+    std::condition_variable _stopCondition;
+    bool _stopping{false};
+    ccstd::vector<std::thread> _workers;
+    std::atomic<uint32_t> _requests{0};
+    std::atomic<uint32_t> _running{0};
+    std::atomic<uint32_t> _maxRunning{0};
+};
+#endif
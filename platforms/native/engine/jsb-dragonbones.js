@@ -692,8 +692,7 @@ const cacheManager = require('./jsb-cache-manager');
 
         const sockets = this.sockets;
         if (sockets.length > 0) {
-            const attachInfoMgr = middleware.attachInfoMgr;
-            const attachInfo = attachInfoMgr.attachInfo;
+            const attachInfo = middleware.getAttachInfo();
 
             const attachInfoOffset = sharedBufferOffset[0];
             // reset attach info offset
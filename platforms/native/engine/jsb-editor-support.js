@@ -75,11 +75,23 @@
 
     const attachInfoMgr = middlewareMgr.getAttachInfoMgr();
     attachInfoMgr.attachInfo = attachInfoMgr.getSharedBuffer();
-    attachInfoMgr.setResizeCallback(function () {
-        this.attachInfo = this.getSharedBuffer();
-    });
     middleware.attachInfoMgr = attachInfoMgr;
 
+    // the attach info grows natively, its typed array is fetched again only if the generation in its slot changed
+    const generations = jsb.scriptBufferGenerations;
+    const attachInfoSlot = attachInfoMgr.getGenerationSlot();
+    let attachInfoGeneration = attachInfoSlot < generations.length ? generations[attachInfoSlot] : 0;
+    middleware.getAttachInfo = function () {
+        if (attachInfoSlot >= generations.length) {
+            // beyond the generation table, ask native every time
+            attachInfoMgr.attachInfo = attachInfoMgr.getSharedBuffer();
+        } else if (generations[attachInfoSlot] !== attachInfoGeneration) {
+            attachInfoGeneration = generations[attachInfoSlot];
+            attachInfoMgr.attachInfo = attachInfoMgr.getSharedBuffer();
+        }
+        return attachInfoMgr.attachInfo;
+    };
+
     // generate get set function
     middleware.generateGetSet = function (moduleObj) {
         for (const classKey in moduleObj) {
@@ -134,17 +134,16 @@ class ContactPoint {
     }
 }
 
-function emitCollisionEvent (t, c0, c1, impl, b) {
+function emitCollisionEvent (t, c0, c1, impl, b, offset, contactCount) {
     CollisionEventObject.type = t;
     CollisionEventObject.impl = impl;
     const contacts = CollisionEventObject.contacts;
     contactsPool.push.apply(contactsPool, contacts);
     contacts.length = 0;
-    const contactCount = b.length / contactBufferElementLength;
     for (let i = 0; i < contactCount; i++) {
         const c = contactsPool.length > 0 ? contactsPool.pop() : new ContactPoint(CollisionEventObject);
         c.colliderA = c0; c.colliderB = c1;
-        c.impl = b; c.index = i; contacts.push(c);
+        c.impl = b; c.index = offset + i; contacts.push(c);
     }
     if (c0.needCollisionEvent) {
         CollisionEventObject.selfCollider = c0;
@@ -192,6 +191,12 @@ class PhysicsWorld {
         this._impl.step(f);
     }
 
+    beginStep (f) { this._impl.beginStep(f); }
+
+    endStep () { this._impl.endStep(); }
+
+    isStepping () { return this._impl.isStepping(); }
+
     set debugDrawFlags (v) {
         this._impl.setDebugDrawFlags(v);
     }
@@ -407,21 +412,24 @@ class PhysicsWorld {
 
     emitCollisionEvent () {
         const ceps = this._impl.getContactEventPairs();
-        const len2 = ceps.length / 4;
+        const len2 = ceps.length / 5;
+        // contact points of all pairs, each pair addresses its range by offset and count
+        const points = len2 > 0 ? this._impl.getContactPoints() : null;
         for (let i = 0; i < len2; i++) {
-            const t = i * 4;
+            const t = i * 5;
             const sa = ptrToObj[ceps[t + 0]]; const sb = ptrToObj[ceps[t + 1]];
             if (!sa || !sb) continue;
             const c0 = sa.collider; const c1 = sb.collider;
             if (!(c0 && c0.isValid && c1 && c1.isValid)) continue;
             if (!c0.needCollisionEvent && !c1.needCollisionEvent) continue;
             const state = ceps[t + 2];
+            const offset = ceps[t + 3]; const count = ceps[t + 4];
             if (state === 1) {
-                emitCollisionEvent('onCollisionStay', c0, c1, ceps, ceps[t + 3]);
+                emitCollisionEvent('onCollisionStay', c0, c1, ceps, points, offset, count);
             } else if (state === 0) {
-                emitCollisionEvent('onCollisionEnter', c0, c1, ceps, ceps[t + 3]);
+                emitCollisionEvent('onCollisionEnter', c0, c1, ceps, points, offset, count);
             } else {
-                emitCollisionEvent('onCollisionExit', c0, c1, ceps, ceps[t + 3]);
+                emitCollisionEvent('onCollisionExit', c0, c1, ceps, points, offset, count);
             }
         }
     }
@@ -1082,3 +1090,65 @@ cc.physics.selector.register('physx', {
     CapsuleCharacterController,
     BoxCharacterController,
 });
+
+// Overlap the simulation with the rest of the frame: the last sub step started in postUpdate is
+// finished at the end of the frame, or earlier by the first query or sync that needs it.
+// Everything else follows the stock postUpdate.
+function overlapPhysicsWithFrame () {
+    const physX = cc.settings.querySettings('physics', 'physX');
+    if (!physX || !physX.multiThread) return;
+
+    const PhysicsSystem = cc.physics.PhysicsSystem;
+    PhysicsSystem.prototype.postUpdate = function postUpdate (deltaTime) {
+        if (__EDITOR__ && !cc.GAME_VIEW && !this._executeInEditMode && !cc.physics.selector.runInEditor) return;
+
+        if (!this.physicsWorld) return;
+
+        if (!this._enable) {
+            this.physicsWorld.syncSceneToPhysics();
+            return;
+        }
+
+        if (this._autoSimulation) {
+            this._subStepCount = 0;
+            this._accumulator += deltaTime;
+            cc.director.emit(cc.Director.EVENT_BEFORE_PHYSICS);
+            while (this._subStepCount < this._maxSubSteps) {
+                if (this._accumulator >= this._fixedTimeStep) {
+                    this.physicsWorld.syncSceneToPhysics();
+                    this._accumulator -= this._fixedTimeStep;
+                    this._subStepCount++;
+                    if (this._subStepCount === this._maxSubSteps || this._accumulator < this._fixedTimeStep) {
+                        this.physicsWorld.beginStep(this._fixedTimeStep);
+                        this._stepPending = true;
+                        return;
+                    }
+                    this.physicsWorld.step(this._fixedTimeStep);
+                    this.physicsWorld.emitEvents();
+                    this.physicsWorld.syncAfterEvents();
+                } else {
+                    this.physicsWorld.syncSceneToPhysics();
+                    break;
+                }
+            }
+            cc.director.emit(cc.Director.EVENT_AFTER_PHYSICS);
+        }
+    };
+
+    cc.director.on(cc.Director.EVENT_END_FRAME, () => {
+        const sys = PhysicsSystem.instance;
+        if (!sys || !sys._stepPending) return;
+        sys._stepPending = false;
+        const world = sys.physicsWorld;
+        // the debug shapes are drawn by endStep, with the poses of this step
+        world.endStep();
+        world.emitEvents();
+        world.syncAfterEvents();
+        if (sys._subStepCount < sys._maxSubSteps) {
+            world.syncSceneToPhysics();
+        }
+        cc.director.emit(cc.Director.EVENT_AFTER_PHYSICS);
+    });
+}
+
+cc.game.once(cc.Game.EVENT_PRE_SUBSYSTEM_INIT, overlapPhysicsWithFrame);
@@ -792,8 +792,7 @@ const cacheManager = require('./jsb-cache-manager');
         if (socketNodes.size > 0 && this._useAttach) {
             const sharedBufferOffset = this._sharedBufferOffset;
             if (!sharedBufferOffset) return;
-            const attachInfoMgr = middleware.attachInfoMgr;
-            const attachInfo = attachInfoMgr.attachInfo;
+            const attachInfo = middleware.getAttachInfo();
 
             const attachInfoOffset = sharedBufferOffset[0];
             // reset attach info offset